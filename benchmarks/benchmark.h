@@ -0,0 +1,103 @@
+/**************************************************************************/
+/*  benchmark.h                                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "core/os/os.h"
+#include "core/typedefs.h"
+
+// State handed to a benchmark function. The function must run its measured
+// code get_iterations() times, the runner picks the iteration count so that
+// each sample runs long enough to be timed reliably.
+class BenchmarkState {
+	friend class BenchmarkRunner;
+
+	uint64_t iterations = 0;
+	uint64_t begin_usec = 0;
+	uint64_t excluded_usec = 0;
+	uint64_t pause_begin_usec = 0;
+
+public:
+	_FORCE_INLINE_ uint64_t get_iterations() const { return iterations; }
+
+	// Excludes everything done so far (typically the setup) from the sample.
+	void reset_timer() {
+		begin_usec = OS::get_singleton()->get_ticks_usec();
+		excluded_usec = 0;
+	}
+
+	// Excludes the code between the two calls from the sample.
+	void pause_timer() {
+		pause_begin_usec = OS::get_singleton()->get_ticks_usec();
+	}
+	void resume_timer() {
+		excluded_usec += OS::get_singleton()->get_ticks_usec() - pause_begin_usec;
+	}
+
+	// Prevents the compiler from optimizing away the computation of p_value.
+	template <typename T>
+	static _FORCE_INLINE_ void do_not_optimize(const T &p_value) {
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(p_value) : "memory");
+#else
+		static volatile const void *sink;
+		sink = &p_value;
+#endif
+	}
+};
+
+typedef void (*BenchmarkFunc)(BenchmarkState &p_state);
+
+// Benchmarks register themselves through static instances of this class, see REGISTER_BENCHMARK.
+// It doesn't allocate, so registration is safe before the engine is initialized.
+class BenchmarkRegistration {
+	static BenchmarkRegistration *first;
+	static BenchmarkRegistration *last;
+
+	const char *name = nullptr;
+	BenchmarkFunc func = nullptr;
+	BenchmarkRegistration *next = nullptr;
+
+public:
+	static const BenchmarkRegistration *get_first() { return first; }
+
+	const char *get_name() const { return name; }
+	BenchmarkFunc get_func() const { return func; }
+	const BenchmarkRegistration *get_next() const { return next; }
+
+	BenchmarkRegistration(const char *p_name, BenchmarkFunc p_func);
+};
+
+// Names are "Category/Benchmark", use slashes to group related benchmarks.
+#define REGISTER_BENCHMARK(m_name, m_func) \
+	static BenchmarkRegistration m_func##_registration(m_name, m_func)
+
+#endif // BENCHMARK_H
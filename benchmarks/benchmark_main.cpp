@@ -0,0 +1,260 @@
+/**************************************************************************/
+/*  benchmark_main.cpp                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "benchmark_main.h"
+
+#include "benchmarks/benchmark.h"
+
+#include "benchmarks/core/benchmark_dynamic_bvh.h"
+#include "benchmarks/core/benchmark_hash_map.h"
+#include "benchmarks/core/benchmark_math_batch.h"
+#include "benchmarks/core/benchmark_string_name.h"
+#include "benchmarks/core/benchmark_variant.h"
+#include "benchmarks/modules/benchmark_gdscript.h"
+#include "benchmarks/scene/benchmark_node.h"
+
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/math/math_batch.h"
+#include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/local_vector.h"
+#include "core/version.h"
+
+BenchmarkRegistration *BenchmarkRegistration::first = nullptr;
+BenchmarkRegistration *BenchmarkRegistration::last = nullptr;
+
+BenchmarkRegistration::BenchmarkRegistration(const char *p_name, BenchmarkFunc p_func) {
+	name = p_name;
+	func = p_func;
+	if (last) {
+		last->next = this;
+	} else {
+		first = this;
+	}
+	last = this;
+}
+
+class BenchmarkRunner {
+public:
+	struct Options {
+		String filter = "*";
+		String output_path;
+		int warmup = 3;
+		int samples = 30;
+		uint64_t min_sample_usec = 10000;
+		bool list = false;
+	};
+
+	struct Result {
+		String name;
+		uint64_t iterations = 0;
+		int samples = 0;
+		// Per-iteration times, in nanoseconds.
+		double min = 0.0;
+		double max = 0.0;
+		double mean = 0.0;
+		double median = 0.0;
+		double p99 = 0.0;
+		double stddev = 0.0;
+	};
+
+private:
+	Options options;
+
+	static uint64_t _run_sample(BenchmarkFunc p_func, uint64_t p_iterations) {
+		BenchmarkState state;
+		state.iterations = p_iterations;
+		state.reset_timer();
+		p_func(state);
+		uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - state.begin_usec;
+		return elapsed > state.excluded_usec ? elapsed - state.excluded_usec : 0;
+	}
+
+	uint64_t _calibrate(BenchmarkFunc p_func) const {
+		uint64_t iterations = 1;
+		while (iterations < (uint64_t(1) << 32)) {
+			uint64_t elapsed = _run_sample(p_func, iterations);
+			if (elapsed >= options.min_sample_usec) {
+				break;
+			}
+			// Aim slightly above the minimum, growing at most tenfold per step.
+			uint64_t factor = elapsed == 0 ? 10 : CLAMP(options.min_sample_usec * 12 / (elapsed * 10), uint64_t(2), uint64_t(10));
+			iterations *= factor;
+		}
+		return iterations;
+	}
+
+	// Nearest-rank percentile of sorted values.
+	static double _percentile(const LocalVector<double> &p_sorted, double p_percentile) {
+		uint32_t rank = (uint32_t)Math::ceil(p_percentile * p_sorted.size());
+		return p_sorted[CLAMP(rank, 1u, p_sorted.size()) - 1];
+	}
+
+public:
+	Result run(const BenchmarkRegistration *p_benchmark) const {
+		Result result;
+		result.name = String::utf8(p_benchmark->get_name());
+		result.iterations = _calibrate(p_benchmark->get_func());
+		result.samples = options.samples;
+
+		for (int i = 0; i < options.warmup; i++) {
+			_run_sample(p_benchmark->get_func(), result.iterations);
+		}
+
+		LocalVector<double> times;
+		times.reserve(options.samples);
+		for (int i = 0; i < options.samples; i++) {
+			uint64_t elapsed = _run_sample(p_benchmark->get_func(), result.iterations);
+			times.push_back(double(elapsed) * 1000.0 / double(result.iterations));
+		}
+		times.sort();
+
+		double sum = 0.0;
+		for (double time : times) {
+			sum += time;
+		}
+		result.mean = sum / times.size();
+		double variance = 0.0;
+		for (double time : times) {
+			variance += (time - result.mean) * (time - result.mean);
+		}
+		result.stddev = times.size() > 1 ? Math::sqrt(variance / (times.size() - 1)) : 0.0;
+		result.min = times[0];
+		result.max = times[times.size() - 1];
+		uint32_t middle = times.size() / 2;
+		result.median = times.size() % 2 ? times[middle] : (times[middle - 1] + times[middle]) * 0.5;
+		result.p99 = _percentile(times, 0.99);
+		return result;
+	}
+
+	int run_all() {
+		LocalVector<const BenchmarkRegistration *> benchmarks;
+		for (const BenchmarkRegistration *E = BenchmarkRegistration::get_first(); E; E = E->get_next()) {
+			if (String::utf8(E->get_name()).matchn(options.filter)) {
+				benchmarks.push_back(E);
+			}
+		}
+
+		if (options.list) {
+			for (const BenchmarkRegistration *E : benchmarks) {
+				print_line(E->get_name());
+			}
+			return EXIT_SUCCESS;
+		}
+
+		if (benchmarks.is_empty()) {
+			ERR_PRINT(vformat("No benchmark matches the filter \"%s\".", options.filter));
+			return EXIT_FAILURE;
+		}
+
+		Array json_results;
+		for (const BenchmarkRegistration *E : benchmarks) {
+			Result result = run(E);
+			print_line(vformat("%-56s %12.1f ns median %12.1f ns p99 %8.1f%% stddev (%d iterations x %d samples)",
+					result.name, result.median, result.p99, result.mean > 0.0 ? result.stddev * 100.0 / result.mean : 0.0, result.iterations, result.samples));
+
+			Dictionary json_result;
+			json_result["name"] = result.name;
+			json_result["iterations"] = result.iterations;
+			json_result["samples"] = result.samples;
+			json_result["min_ns"] = result.min;
+			json_result["max_ns"] = result.max;
+			json_result["mean_ns"] = result.mean;
+			json_result["median_ns"] = result.median;
+			json_result["p99_ns"] = result.p99;
+			json_result["stddev_ns"] = result.stddev;
+			json_results.push_back(json_result);
+		}
+
+		if (!options.output_path.is_empty()) {
+			Dictionary json;
+			json["version"] = VERSION_FULL_BUILD;
+			json["hash"] = String(VERSION_HASH);
+			json["simd"] = MathBatch::get_simd_name();
+			json["processor_count"] = OS::get_singleton()->get_processor_count();
+			json["warmup"] = options.warmup;
+			json["min_sample_usec"] = options.min_sample_usec;
+			json["benchmarks"] = json_results;
+
+			Ref<FileAccess> f = FileAccess::open(options.output_path, FileAccess::WRITE);
+			ERR_FAIL_COND_V_MSG(f.is_null(), EXIT_FAILURE, vformat("Cannot write benchmark results to \"%s\".", options.output_path));
+			f->store_string(JSON::stringify(json, "\t", false, true));
+		}
+
+		return EXIT_SUCCESS;
+	}
+
+	BenchmarkRunner(const Options &p_options) {
+		options = p_options;
+	}
+};
+
+static void print_benchmark_help() {
+	print_line("Usage: --run-benchmarks [options]");
+	print_line("  --filter=<pattern>       Only run benchmarks whose name matches the wildcard pattern (case-insensitive).");
+	print_line("  --list                   List the matching benchmarks without running them.");
+	print_line("  --output=<path>          Write the results to <path> as JSON.");
+	print_line("  --samples=<count>        Number of measured samples per benchmark (default: 30).");
+	print_line("  --warmup=<count>         Number of discarded samples before measuring (default: 3).");
+	print_line("  --min-sample-time=<usec> Minimum duration of a sample, in microseconds (default: 10000).");
+}
+
+int benchmark_main(int argc, char *argv[]) {
+	BenchmarkRunner::Options options;
+	for (int i = 0; i < argc; i++) {
+		const String arg = String::utf8(argv[i]);
+		if (arg == "--help") {
+			print_benchmark_help();
+			return EXIT_SUCCESS;
+		} else if (arg == "--list") {
+			options.list = true;
+		} else if (arg.begins_with("--filter=")) {
+			options.filter = arg.trim_prefix("--filter=");
+		} else if (arg.begins_with("--output=")) {
+			options.output_path = arg.trim_prefix("--output=");
+		} else if (arg.begins_with("--samples=")) {
+			options.samples = MAX(1, arg.trim_prefix("--samples=").to_int());
+		} else if (arg.begins_with("--warmup=")) {
+			options.warmup = MAX(0, arg.trim_prefix("--warmup=").to_int());
+		} else if (arg.begins_with("--min-sample-time=")) {
+			options.min_sample_usec = MAX(1, arg.trim_prefix("--min-sample-time=").to_int());
+		}
+	}
+
+	WorkerThreadPool::get_singleton()->init();
+	ScriptServer::init_languages();
+
+	BenchmarkRunner runner(options);
+	int status = runner.run_all();
+
+	ScriptServer::finish_languages();
+	return status;
+}
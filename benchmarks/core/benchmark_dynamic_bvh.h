@@ -0,0 +1,121 @@
+/**************************************************************************/
+/*  benchmark_dynamic_bvh.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCHMARK_DYNAMIC_BVH_H
+#define BENCHMARK_DYNAMIC_BVH_H
+
+#include "benchmarks/benchmark.h"
+
+#include "core/math/dynamic_bvh.h"
+#include "core/math/random_pcg.h"
+#include "core/templates/local_vector.h"
+
+namespace BenchmarkDynamicBVH {
+
+const int ELEMENT_COUNT = 10000;
+
+struct CountQueryResult {
+	uint32_t count = 0;
+
+	_FORCE_INLINE_ bool operator()(void *p_data) {
+		count++;
+		return false;
+	}
+};
+
+AABB random_aabb(RandomPCG &p_rng, real_t p_size) {
+	return AABB(Vector3(p_rng.random(-500.0, 500.0), p_rng.random(-500.0, 500.0), p_rng.random(-500.0, 500.0)), Vector3(p_size, p_size, p_size));
+}
+
+void build(DynamicBVH &r_bvh, LocalVector<DynamicBVH::ID> &r_ids) {
+	RandomPCG rng(12345);
+	for (int i = 0; i < ELEMENT_COUNT; i++) {
+		r_ids.push_back(r_bvh.insert(random_aabb(rng, 2.0), nullptr));
+	}
+}
+
+void aabb_query(BenchmarkState &p_state) {
+	DynamicBVH bvh;
+	LocalVector<DynamicBVH::ID> ids;
+	build(bvh, ids);
+
+	RandomPCG rng(54321);
+	LocalVector<AABB> queries;
+	for (int i = 0; i < 1024; i++) {
+		queries.push_back(random_aabb(rng, 50.0));
+	}
+	p_state.reset_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		CountQueryResult result;
+		bvh.aabb_query(queries[i % queries.size()], result);
+		BenchmarkState::do_not_optimize(result.count);
+	}
+}
+REGISTER_BENCHMARK("DynamicBVH/AABB query in 10000 elements", aabb_query);
+
+void ray_query(BenchmarkState &p_state) {
+	DynamicBVH bvh;
+	LocalVector<DynamicBVH::ID> ids;
+	build(bvh, ids);
+
+	RandomPCG rng(54321);
+	LocalVector<AABB> rays;
+	for (int i = 0; i < 1024; i++) {
+		rays.push_back(random_aabb(rng, 0.0));
+	}
+	p_state.reset_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		const AABB &ray = rays[i % rays.size()];
+		CountQueryResult result;
+		bvh.ray_query(ray.position, -ray.position, result);
+		BenchmarkState::do_not_optimize(result.count);
+	}
+}
+REGISTER_BENCHMARK("DynamicBVH/Ray query in 10000 elements", ray_query);
+
+void update(BenchmarkState &p_state) {
+	DynamicBVH bvh;
+	LocalVector<DynamicBVH::ID> ids;
+	build(bvh, ids);
+
+	RandomPCG rng(54321);
+	p_state.reset_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		bvh.update(ids[i % ids.size()], random_aabb(rng, 2.0));
+	}
+}
+REGISTER_BENCHMARK("DynamicBVH/Move element among 10000", update);
+
+} // namespace BenchmarkDynamicBVH
+
+#endif // BENCHMARK_DYNAMIC_BVH_H
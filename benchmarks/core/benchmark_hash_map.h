@@ -0,0 +1,100 @@
+/**************************************************************************/
+/*  benchmark_hash_map.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCHMARK_HASH_MAP_H
+#define BENCHMARK_HASH_MAP_H
+
+#include "benchmarks/benchmark.h"
+
+#include "core/templates/hash_map.h"
+
+namespace BenchmarkHashMap {
+
+const int ELEMENT_COUNT = 4096;
+
+void insert_ints(BenchmarkState &p_state) {
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		HashMap<int, int> map;
+		for (int j = 0; j < ELEMENT_COUNT; j++) {
+			map.insert(j, j);
+		}
+		BenchmarkState::do_not_optimize(map);
+	}
+}
+REGISTER_BENCHMARK("HashMap/Insert 4096 ints", insert_ints);
+
+void lookup_ints(BenchmarkState &p_state) {
+	HashMap<int, int> map;
+	for (int j = 0; j < ELEMENT_COUNT; j++) {
+		map.insert(j * 7, j);
+	}
+	p_state.reset_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		const int *value = map.getptr(int(i % ELEMENT_COUNT) * 7);
+		BenchmarkState::do_not_optimize(value);
+	}
+}
+REGISTER_BENCHMARK("HashMap/Lookup int", lookup_ints);
+
+void lookup_strings(BenchmarkState &p_state) {
+	HashMap<String, int> map;
+	LocalVector<String> keys;
+	for (int j = 0; j < ELEMENT_COUNT; j++) {
+		keys.push_back(vformat("key_%d", j));
+		map.insert(keys[j], j);
+	}
+	p_state.reset_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		const int *value = map.getptr(keys[i % ELEMENT_COUNT]);
+		BenchmarkState::do_not_optimize(value);
+	}
+}
+REGISTER_BENCHMARK("HashMap/Lookup String", lookup_strings);
+
+void insert_and_erase_ints(BenchmarkState &p_state) {
+	HashMap<int, int> map;
+	for (int j = 0; j < ELEMENT_COUNT; j++) {
+		map.insert(j, j);
+	}
+	p_state.reset_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		int key = ELEMENT_COUNT + int(i % ELEMENT_COUNT);
+		map.insert(key, key);
+		map.erase(key);
+	}
+}
+REGISTER_BENCHMARK("HashMap/Insert and erase int", insert_and_erase_ints);
+
+} // namespace BenchmarkHashMap
+
+#endif // BENCHMARK_HASH_MAP_H
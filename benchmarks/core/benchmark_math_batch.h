@@ -0,0 +1,123 @@
+/**************************************************************************/
+/*  benchmark_math_batch.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCHMARK_MATH_BATCH_H
+#define BENCHMARK_MATH_BATCH_H
+
+#include "benchmarks/benchmark.h"
+
+#include "core/math/math_batch.h"
+#include "core/templates/local_vector.h"
+
+namespace BenchmarkMathBatch {
+
+const uint32_t ELEMENT_COUNT = 1024;
+
+Transform3D test_transform() {
+	return Transform3D(Basis::from_euler(Vector3(0.1, 0.2, 0.3)).scaled(Vector3(1.5, 1.5, 1.5)), Vector3(1, 2, 3));
+}
+
+void xform_aabbs_scalar(BenchmarkState &p_state) {
+	LocalVector<Transform3D> transforms;
+	LocalVector<AABB> aabbs;
+	LocalVector<AABB> results;
+	for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+		transforms.push_back(test_transform().translated(Vector3(i, 0, 0)));
+		aabbs.push_back(AABB(Vector3(i, i, i), Vector3(1, 2, 3)));
+	}
+	results.resize(ELEMENT_COUNT);
+	p_state.reset_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		for (uint32_t j = 0; j < ELEMENT_COUNT; j++) {
+			results[j] = transforms[j].xform(aabbs[j]);
+		}
+		BenchmarkState::do_not_optimize(results[0]);
+	}
+}
+REGISTER_BENCHMARK("MathBatch/Transform 1024 AABBs (scalar)", xform_aabbs_scalar);
+
+void xform_aabbs_batch(BenchmarkState &p_state) {
+	LocalVector<Transform3D> transforms;
+	LocalVector<AABB> aabbs;
+	LocalVector<AABB> results;
+	for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+		transforms.push_back(test_transform().translated(Vector3(i, 0, 0)));
+		aabbs.push_back(AABB(Vector3(i, i, i), Vector3(1, 2, 3)));
+	}
+	results.resize(ELEMENT_COUNT);
+	p_state.reset_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		MathBatch::xform_aabbs(transforms.ptr(), aabbs.ptr(), results.ptr(), ELEMENT_COUNT);
+		BenchmarkState::do_not_optimize(results[0]);
+	}
+}
+REGISTER_BENCHMARK("MathBatch/Transform 1024 AABBs (batched)", xform_aabbs_batch);
+
+void multiply_transforms_scalar(BenchmarkState &p_state) {
+	const Transform3D parent = test_transform();
+	LocalVector<Transform3D> transforms;
+	LocalVector<Transform3D> results;
+	for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+		transforms.push_back(test_transform().translated(Vector3(i, 0, 0)));
+	}
+	results.resize(ELEMENT_COUNT);
+	p_state.reset_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		for (uint32_t j = 0; j < ELEMENT_COUNT; j++) {
+			results[j] = parent * transforms[j];
+		}
+		BenchmarkState::do_not_optimize(results[0]);
+	}
+}
+REGISTER_BENCHMARK("MathBatch/Multiply 1024 transforms (scalar)", multiply_transforms_scalar);
+
+void multiply_transforms_batch(BenchmarkState &p_state) {
+	const Transform3D parent = test_transform();
+	LocalVector<Transform3D> transforms;
+	LocalVector<Transform3D> results;
+	for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+		transforms.push_back(test_transform().translated(Vector3(i, 0, 0)));
+	}
+	results.resize(ELEMENT_COUNT);
+	p_state.reset_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		MathBatch::multiply_transforms(parent, transforms.ptr(), results.ptr(), ELEMENT_COUNT);
+		BenchmarkState::do_not_optimize(results[0]);
+	}
+}
+REGISTER_BENCHMARK("MathBatch/Multiply 1024 transforms (batched)", multiply_transforms_batch);
+
+} // namespace BenchmarkMathBatch
+
+#endif // BENCHMARK_MATH_BATCH_H
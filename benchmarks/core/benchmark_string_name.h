@@ -0,0 +1,207 @@
+/**************************************************************************/
+/*  benchmark_string_name.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCHMARK_STRING_NAME_H
+#define BENCHMARK_STRING_NAME_H
+
+#include "benchmarks/benchmark.h"
+
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+namespace BenchmarkStringName {
+
+void create_existing_from_string(BenchmarkState &p_state) {
+	const String string = "benchmark_string_name";
+	StringName keep_alive = string;
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		StringName name = string;
+		BenchmarkState::do_not_optimize(name);
+	}
+}
+REGISTER_BENCHMARK("StringName/Create existing from String", create_existing_from_string);
+
+void create_existing_from_c_string(BenchmarkState &p_state) {
+	StringName keep_alive = "benchmark_string_name";
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		StringName name = "benchmark_string_name";
+		BenchmarkState::do_not_optimize(name);
+	}
+}
+REGISTER_BENCHMARK("StringName/Create existing from C string", create_existing_from_c_string);
+
+void create_unique(BenchmarkState &p_state) {
+	LocalVector<String> strings;
+	strings.resize(p_state.get_iterations());
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		strings[i] = vformat("benchmark_unique_%d", i);
+	}
+	LocalVector<StringName> names;
+	names.resize(p_state.get_iterations());
+	p_state.reset_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		names[i] = strings[i];
+	}
+
+	// Releasing the names is part of the cost of churning through unique names.
+	names.clear();
+}
+REGISTER_BENCHMARK("StringName/Create and free unique", create_unique);
+
+void compare(BenchmarkState &p_state) {
+	const StringName a = "benchmark_a";
+	const StringName b = "benchmark_b";
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		bool equal = a == b;
+		BenchmarkState::do_not_optimize(equal);
+	}
+}
+REGISTER_BENCHMARK("StringName/Compare", compare);
+
+// Interning from several threads at once, the iterations are split between the threads.
+
+struct ThreadedWork {
+	void (*func)(ThreadedWork &p_work) = nullptr;
+	uint64_t iterations = 0;
+	int index = 0;
+	LocalVector<String> strings;
+	const SafeFlag *start = nullptr;
+};
+
+void _threaded_work_func(void *p_userdata) {
+	ThreadedWork *work = static_cast<ThreadedWork *>(p_userdata);
+	while (!work->start->is_set()) {
+		// Spin so all the threads begin at the same time.
+	}
+	work->func(*work);
+}
+
+void _run_threaded(BenchmarkState &p_state, int p_thread_count, void (*p_setup)(ThreadedWork &p_work), void (*p_func)(ThreadedWork &p_work)) {
+	SafeFlag start;
+	ThreadedWork *works = memnew_arr(ThreadedWork, p_thread_count);
+	Thread *threads = memnew_arr(Thread, p_thread_count);
+
+	for (int i = 0; i < p_thread_count; i++) {
+		works[i].func = p_func;
+		works[i].iterations = (p_state.get_iterations() + p_thread_count - 1) / p_thread_count;
+		works[i].index = i;
+		works[i].start = &start;
+		p_setup(works[i]);
+		threads[i].start(_threaded_work_func, &works[i]);
+	}
+
+	p_state.reset_timer();
+	start.set();
+	for (int i = 0; i < p_thread_count; i++) {
+		threads[i].wait_to_finish();
+	}
+	p_state.pause_timer();
+
+	memdelete_arr(threads);
+	memdelete_arr(works);
+	p_state.resume_timer();
+}
+
+// A shared vocabulary, as when several threads load resources referring to the same properties.
+constexpr int THREADED_NAME_COUNT = 1024;
+
+void _setup_existing(ThreadedWork &p_work) {
+	p_work.strings.resize(THREADED_NAME_COUNT);
+	for (int i = 0; i < THREADED_NAME_COUNT; i++) {
+		p_work.strings[i] = vformat("benchmark_shared_%d", i);
+	}
+}
+
+void _create_existing(ThreadedWork &p_work) {
+	// Threads walk the vocabulary from different offsets, the names are kept alive by the caller.
+	for (uint64_t i = 0; i < p_work.iterations; i++) {
+		StringName name = p_work.strings[(i + p_work.index * 97) % THREADED_NAME_COUNT];
+		BenchmarkState::do_not_optimize(name);
+	}
+}
+
+void _create_existing_threaded(BenchmarkState &p_state, int p_thread_count) {
+	LocalVector<StringName> keep_alive;
+	for (int i = 0; i < THREADED_NAME_COUNT; i++) {
+		keep_alive.push_back(StringName(vformat("benchmark_shared_%d", i)));
+	}
+	_run_threaded(p_state, p_thread_count, _setup_existing, _create_existing);
+}
+
+void _setup_unique(ThreadedWork &p_work) {
+	p_work.strings.resize(p_work.iterations);
+	for (uint64_t i = 0; i < p_work.iterations; i++) {
+		p_work.strings[i] = vformat("benchmark_unique_%d_%d", p_work.index, i);
+	}
+}
+
+void _create_unique(ThreadedWork &p_work) {
+	for (uint64_t i = 0; i < p_work.iterations; i++) {
+		StringName name = p_work.strings[i];
+		BenchmarkState::do_not_optimize(name);
+	}
+}
+
+void create_existing_1_thread(BenchmarkState &p_state) {
+	_create_existing_threaded(p_state, 1);
+}
+REGISTER_BENCHMARK("StringName/Create existing, 1 thread", create_existing_1_thread);
+
+void create_existing_8_threads(BenchmarkState &p_state) {
+	_create_existing_threaded(p_state, 8);
+}
+REGISTER_BENCHMARK("StringName/Create existing, 8 threads", create_existing_8_threads);
+
+void create_existing_32_threads(BenchmarkState &p_state) {
+	_create_existing_threaded(p_state, 32);
+}
+REGISTER_BENCHMARK("StringName/Create existing, 32 threads", create_existing_32_threads);
+
+void create_unique_1_thread(BenchmarkState &p_state) {
+	_run_threaded(p_state, 1, _setup_unique, _create_unique);
+}
+REGISTER_BENCHMARK("StringName/Create and free unique, 1 thread", create_unique_1_thread);
+
+void create_unique_8_threads(BenchmarkState &p_state) {
+	_run_threaded(p_state, 8, _setup_unique, _create_unique);
+}
+REGISTER_BENCHMARK("StringName/Create and free unique, 8 threads", create_unique_8_threads);
+
+void create_unique_32_threads(BenchmarkState &p_state) {
+	_run_threaded(p_state, 32, _setup_unique, _create_unique);
+}
+REGISTER_BENCHMARK("StringName/Create and free unique, 32 threads", create_unique_32_threads);
+
+} // namespace BenchmarkStringName
+
+#endif // BENCHMARK_STRING_NAME_H
@@ -0,0 +1,102 @@
+/**************************************************************************/
+/*  benchmark_variant.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCHMARK_VARIANT_H
+#define BENCHMARK_VARIANT_H
+
+#include "benchmarks/benchmark.h"
+
+#include "core/variant/variant.h"
+
+namespace BenchmarkVariant {
+
+void add_ints(BenchmarkState &p_state) {
+	Variant a = 1;
+	Variant b = 2;
+	Variant result;
+	bool valid = false;
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		Variant::evaluate(Variant::OP_ADD, a, b, result, valid);
+		BenchmarkState::do_not_optimize(result);
+	}
+}
+REGISTER_BENCHMARK("Variant/Add ints", add_ints);
+
+void multiply_vector3_by_float(BenchmarkState &p_state) {
+	Variant a = Vector3(1, 2, 3);
+	Variant b = 0.5;
+	Variant result;
+	bool valid = false;
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		Variant::evaluate(Variant::OP_MULTIPLY, a, b, result, valid);
+		BenchmarkState::do_not_optimize(result);
+	}
+}
+REGISTER_BENCHMARK("Variant/Multiply Vector3 by float", multiply_vector3_by_float);
+
+void construct_from_string(BenchmarkState &p_state) {
+	const String string = "Benchmark string";
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		Variant variant = string;
+		BenchmarkState::do_not_optimize(variant);
+	}
+}
+REGISTER_BENCHMARK("Variant/Construct from String", construct_from_string);
+
+void call_builtin_method(BenchmarkState &p_state) {
+	Variant string = "Benchmark string";
+	const StringName method = "length";
+	Callable::CallError ce;
+	Variant result;
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		string.callp(method, nullptr, 0, result, ce);
+		BenchmarkState::do_not_optimize(result);
+	}
+}
+REGISTER_BENCHMARK("Variant/Call builtin method", call_builtin_method);
+
+void get_dictionary_key(BenchmarkState &p_state) {
+	Dictionary dictionary;
+	for (int i = 0; i < 64; i++) {
+		dictionary[vformat("key_%d", i)] = i;
+	}
+	Variant variant = dictionary;
+	const Variant key = "key_42";
+	bool valid = false;
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		Variant value = variant.get(key, &valid);
+		BenchmarkState::do_not_optimize(value);
+	}
+}
+REGISTER_BENCHMARK("Variant/Get Dictionary key", get_dictionary_key);
+
+} // namespace BenchmarkVariant
+
+#endif // BENCHMARK_VARIANT_H
@@ -0,0 +1,128 @@
+/**************************************************************************/
+/*  benchmark_gdscript.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCHMARK_GDSCRIPT_H
+#define BENCHMARK_GDSCRIPT_H
+
+#include "modules/modules_enabled.gen.h" // For gdscript.
+
+#ifdef MODULE_GDSCRIPT_ENABLED
+
+#include "benchmarks/benchmark.h"
+
+#include "modules/gdscript/gdscript.h"
+
+namespace BenchmarkGDScript {
+
+const char *SCRIPT_SOURCE = R"(
+extends RefCounted
+
+var counter := 0
+
+func add(a: int, b: int) -> int:
+	return a + b
+
+func increment() -> void:
+	counter += 1
+
+func sum_loop(count: int) -> int:
+	var total := 0
+	for i in count:
+		total += add(i, 1)
+	return total
+)";
+
+Ref<RefCounted> create_instance() {
+	Ref<GDScript> script;
+	script.instantiate();
+	script->set_source_code(SCRIPT_SOURCE);
+	Error err = script->reload();
+	ERR_FAIL_COND_V_MSG(err != OK, Ref<RefCounted>(), "Failed to compile the benchmark script.");
+
+	Ref<RefCounted> instance;
+	instance.instantiate();
+	instance->set_script(script);
+	return instance;
+}
+
+void call_from_native(BenchmarkState &p_state) {
+	Ref<RefCounted> instance = create_instance();
+	ERR_FAIL_COND(instance.is_null());
+
+	const StringName method = "add";
+	const Variant a = 1;
+	const Variant b = 2;
+	const Variant *args[2] = { &a, &b };
+	Callable::CallError ce;
+	p_state.reset_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		Variant result = instance->callp(method, args, 2, ce);
+		BenchmarkState::do_not_optimize(result);
+	}
+}
+REGISTER_BENCHMARK("GDScript/Call typed method from native", call_from_native);
+
+void set_member(BenchmarkState &p_state) {
+	Ref<RefCounted> instance = create_instance();
+	ERR_FAIL_COND(instance.is_null());
+
+	const StringName method = "increment";
+	Callable::CallError ce;
+	p_state.reset_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		instance->callp(method, nullptr, 0, ce);
+	}
+}
+REGISTER_BENCHMARK("GDScript/Increment member variable", set_member);
+
+void script_to_script_calls(BenchmarkState &p_state) {
+	Ref<RefCounted> instance = create_instance();
+	ERR_FAIL_COND(instance.is_null());
+
+	const StringName method = "sum_loop";
+	const Variant count = 1000;
+	const Variant *args[1] = { &count };
+	Callable::CallError ce;
+	p_state.reset_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		Variant result = instance->callp(method, args, 1, ce);
+		BenchmarkState::do_not_optimize(result);
+	}
+}
+REGISTER_BENCHMARK("GDScript/Loop of 1000 script-to-script calls", script_to_script_calls);
+
+} // namespace BenchmarkGDScript
+
+#endif // MODULE_GDSCRIPT_ENABLED
+
+#endif // BENCHMARK_GDSCRIPT_H
@@ -0,0 +1,96 @@
+/**************************************************************************/
+/*  benchmark_node.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCHMARK_NODE_H
+#define BENCHMARK_NODE_H
+
+#include "benchmarks/benchmark.h"
+
+#include "core/templates/local_vector.h"
+#include "scene/main/node.h"
+
+namespace BenchmarkNode {
+
+const int CHILD_COUNT = 256;
+
+void add_and_remove_children(BenchmarkState &p_state) {
+	Node *parent = memnew(Node);
+	LocalVector<Node *> children;
+	for (int i = 0; i < CHILD_COUNT; i++) {
+		children.push_back(memnew(Node));
+	}
+	p_state.reset_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		for (Node *child : children) {
+			parent->add_child(child);
+		}
+		// Remove from the back, the common case when clearing a container.
+		for (int j = CHILD_COUNT - 1; j >= 0; j--) {
+			parent->remove_child(children[j]);
+		}
+	}
+
+	p_state.pause_timer();
+	for (Node *child : children) {
+		memdelete(child);
+	}
+	memdelete(parent);
+	p_state.resume_timer();
+}
+REGISTER_BENCHMARK("Node/Add and remove 256 children", add_and_remove_children);
+
+void get_node_by_path(BenchmarkState &p_state) {
+	Node *root = memnew(Node);
+	root->set_name("Root");
+	Node *parent = root;
+	for (int i = 0; i < 8; i++) {
+		Node *child = memnew(Node);
+		child->set_name(vformat("Child%d", i));
+		parent->add_child(child);
+		parent = child;
+	}
+	const NodePath path("Child0/Child1/Child2/Child3/Child4/Child5/Child6/Child7");
+	p_state.reset_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		Node *node = root->get_node(path);
+		BenchmarkState::do_not_optimize(node);
+	}
+
+	p_state.pause_timer();
+	memdelete(root);
+	p_state.resume_timer();
+}
+REGISTER_BENCHMARK("Node/Get node by path 8 levels deep", get_node_by_path);
+
+} // namespace BenchmarkNode
+
+#endif // BENCHMARK_NODE_H
@@ -30,8 +30,13 @@
 
 #include "file_access_compressed.h"
 
+#include "core/io/marshalls.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/string/print_string.h"
 
+// Reads that cover fewer bytes than this in whole blocks are decompressed on the calling thread.
+static constexpr uint64_t THREADED_READ_MIN_SIZE = 256 * 1024;
+
 void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_mode, uint32_t p_block_size) {
 	magic = p_magic.ascii().get_data();
 	magic = (magic + "    ").substr(0, 4);
@@ -52,6 +57,41 @@ void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_
 		}                                                   \
 	}
 
+Vector<uint8_t> FileAccessCompressed::compress_blocks(const uint8_t *p_src, uint64_t p_size, const String &p_magic, Compression::Mode p_mode, uint32_t p_block_size) {
+	ERR_FAIL_COND_V(p_block_size == 0, Vector<uint8_t>());
+	ERR_FAIL_COND_V_MSG(p_size > UINT32_MAX, Vector<uint8_t>(), "Compressed files can't be larger than 4 GiB.");
+
+	CharString mgc = (p_magic + "    ").substr(0, 4).ascii();
+	uint32_t bc = (p_size / p_block_size) + 1;
+
+	Vector<uint8_t> data;
+	data.resize(16 + bc * 4);
+	uint8_t *w = data.ptrw();
+	memcpy(w, mgc.get_data(), 4); //write header 4
+	encode_uint32(p_mode, w + 4); //write compression mode 4
+	encode_uint32(p_block_size, w + 8); //write block size 4
+	encode_uint32(p_size, w + 12); //max amount of data written 4
+
+	for (uint32_t i = 0; i < bc; i++) {
+		uint32_t bl = i == (bc - 1) ? p_size % p_block_size : p_block_size;
+		const uint8_t *bp = &p_src[(uint64_t)i * p_block_size];
+
+		int64_t pos = data.size();
+		data.resize(pos + Compression::get_max_compressed_buffer_size(bl, p_mode));
+		int s = Compression::compress(data.ptrw() + pos, bp, bl, p_mode);
+		ERR_FAIL_COND_V(s < 0, Vector<uint8_t>());
+		data.resize(pos + s);
+
+		encode_uint32(s, data.ptrw() + 16 + i * 4); //compressed size of the block
+	}
+
+	int64_t pos = data.size();
+	data.resize(pos + 4);
+	memcpy(data.ptrw() + pos, mgc.get_data(), 4); //magic at the end too
+
+	return data;
+}
+
 Error FileAccessCompressed::open_after_magic(Ref<FileAccess> p_base) {
 	f = p_base;
 	cmode = (Compression::Mode)f->get_32();
@@ -132,37 +172,8 @@ void FileAccessCompressed::_close() {
 
 	if (writing) {
 		//save block table and all compressed blocks
-
-		CharString mgc = magic.utf8();
-		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //write header 4
-		f->store_32(cmode); //write compression mode 4
-		f->store_32(block_size); //write block size 4
-		f->store_32(write_max); //max amount of data written 4
-		uint32_t bc = (write_max / block_size) + 1;
-
-		for (uint32_t i = 0; i < bc; i++) {
-			f->store_32(0); //compressed sizes, will update later
-		}
-
-		Vector<int> block_sizes;
-		for (uint32_t i = 0; i < bc; i++) {
-			uint32_t bl = i == (bc - 1) ? write_max % block_size : block_size;
-			uint8_t *bp = &write_ptr[i * block_size];
-
-			Vector<uint8_t> cblock;
-			cblock.resize(Compression::get_max_compressed_buffer_size(bl, cmode));
-			int s = Compression::compress(cblock.ptrw(), bp, bl, cmode);
-
-			f->store_buffer(cblock.ptr(), s);
-			block_sizes.push_back(s);
-		}
-
-		f->seek(16); //ok write block sizes
-		for (uint32_t i = 0; i < bc; i++) {
-			f->store_32(block_sizes[i]);
-		}
-		f->seek_end();
-		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //magic at the end too
+		Vector<uint8_t> data = compress_blocks(write_ptr, write_max, magic, cmode, block_size);
+		f->store_buffer(data.ptr(), data.size());
 
 		buffer.clear();
 
@@ -270,32 +281,95 @@ uint64_t FileAccessCompressed::get_buffer(uint8_t *p_dst, uint64_t p_length) con
 		return 0;
 	}
 
-	for (uint64_t i = 0; i < p_length; i++) {
-		p_dst[i] = read_ptr[read_pos];
-		read_pos++;
-		if (read_pos >= read_block_size) {
-			read_block++;
+	uint64_t done = 0;
+	while (true) {
+		uint64_t to_copy = MIN((uint64_t)(read_block_size - read_pos), p_length - done);
+		memcpy(p_dst + done, read_ptr + read_pos, to_copy);
+		read_pos += to_copy;
+		done += to_copy;
 
-			if (read_block < read_block_count) {
-				//read another block of compressed data
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				int ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-				ERR_FAIL_COND_V_MSG(ret == -1, -1, "Compressed file is corrupt.");
-				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
-				read_pos = 0;
-
-			} else {
-				read_block--;
-				at_end = true;
-				if (i + 1 < p_length) {
-					read_eof = true;
-				}
-				return i + 1;
+		if (read_pos < read_block_size) {
+			return done;
+		}
+
+		if (read_block + 1 >= read_block_count) {
+			at_end = true;
+			if (done < p_length) {
+				read_eof = true;
 			}
+			return done;
 		}
+
+		// Blocks fully covered by the rest of the request can go straight to the destination, the last one is excluded as it may be partial.
+		uint64_t whole_blocks = MIN((p_length - done) / block_size, (uint64_t)(read_block_count - read_block - 2));
+		if (whole_blocks > 1 && whole_blocks * block_size >= THREADED_READ_MIN_SIZE) {
+			Error err = _read_blocks_threaded(p_dst + done, read_block + 1, (uint32_t)whole_blocks);
+			ERR_FAIL_COND_V_MSG(err == ERR_FILE_CORRUPT, -1, "Compressed file is corrupt.");
+			if (err == OK) {
+				read_block += whole_blocks;
+				done += whole_blocks * block_size;
+				// Keep the current block cached, so seeking inside it doesn't decompress it again.
+				memcpy(read_ptr, p_dst + done - block_size, block_size);
+				read_block_size = block_size;
+				read_pos = block_size;
+				continue;
+			}
+		}
+
+		//read another block of compressed data
+		read_block++;
+		f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
+		int ret = Compression::decompress(read_ptr, block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
+		ERR_FAIL_COND_V_MSG(ret == -1, -1, "Compressed file is corrupt.");
+		read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+		read_pos = 0;
+	}
+}
+
+Error FileAccessCompressed::_read_blocks_threaded(uint8_t *p_dst, uint32_t p_first_block, uint32_t p_count) const {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	// Waiting for a group blocks the waiting thread, doing so from pool threads could starve the pool.
+	if (!pool || pool->get_thread_count() < 2 || WorkerThreadPool::get_thread_index() != -1) {
+		return ERR_UNAVAILABLE;
+	}
+
+	const ReadBlock &first = read_blocks[p_first_block];
+	const ReadBlock &last = read_blocks[p_first_block + p_count - 1];
+	uint64_t src_end = last.offset + last.csize;
+	ERR_FAIL_COND_V(src_end > f->get_length(), ERR_FILE_CORRUPT);
+
+	ThreadedRead tr;
+	tr.dst = p_dst;
+	tr.first_block = p_first_block;
+
+	// Mapped files are decompressed in place, anything else is read in one go first.
+	Vector<uint8_t> src;
+	const uint8_t *view = f->get_mapped_view();
+	if (view) {
+		tr.src = view;
+	} else {
+		src.resize(src_end - first.offset);
+		f->seek(first.offset);
+		ERR_FAIL_COND_V(f->get_buffer(src.ptrw(), src.size()) != (uint64_t)src.size(), ERR_FILE_CORRUPT);
+		tr.src = src.ptr();
+		tr.src_offset = first.offset;
 	}
 
-	return p_length;
+	WorkerThreadPool::GroupID group_task = pool->add_template_group_task(this, &FileAccessCompressed::_decompress_block_threaded, &tr, p_count, -1, true, SNAME("FileAccessCompressedRead"));
+	pool->wait_for_group_task_completion(group_task);
+
+	// Sequential reads continue right after the blocks decoded here.
+	f->seek(read_blocks[p_first_block + p_count].offset);
+
+	return tr.failed ? ERR_FILE_CORRUPT : OK;
+}
+
+void FileAccessCompressed::_decompress_block_threaded(uint32_t p_index, ThreadedRead *p_read) const {
+	const ReadBlock &rb = read_blocks[p_read->first_block + p_index];
+	int ret = Compression::decompress(p_read->dst + (uint64_t)p_index * block_size, block_size, p_read->src + (rb.offset - p_read->src_offset), rb.csize, cmode);
+	if (ret != (int)block_size) {
+		p_read->failed = true;
+	}
 }
 
 Error FileAccessCompressed::get_error() const {
@@ -34,6 +34,8 @@
 #include "core/io/compression.h"
 #include "core/io/file_access.h"
 
+#include <atomic>
+
 class FileAccessCompressed : public FileAccess {
 	Compression::Mode cmode = Compression::MODE_ZSTD;
 	bool writing = false;
@@ -63,11 +65,24 @@ class FileAccessCompressed : public FileAccess {
 	mutable Vector<uint8_t> buffer;
 	Ref<FileAccess> f;
 
+	struct ThreadedRead {
+		uint8_t *dst = nullptr;
+		const uint8_t *src = nullptr;
+		uint64_t src_offset = 0;
+		uint32_t first_block = 0;
+		std::atomic<bool> failed = false;
+	};
+
 	void _close();
+	Error _read_blocks_threaded(uint8_t *p_dst, uint32_t p_first_block, uint32_t p_count) const;
+	void _decompress_block_threaded(uint32_t p_index, ThreadedRead *p_read) const;
 
 public:
 	void configure(const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, uint32_t p_block_size = 4096);
 
+	// Encodes a whole buffer in the format written by this class, so it can be read back with open_after_magic().
+	static Vector<uint8_t> compress_blocks(const uint8_t *p_src, uint64_t p_size, const String &p_magic, Compression::Mode p_mode, uint32_t p_block_size);
+
 	Error open_after_magic(Ref<FileAccess> p_base);
 
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override; ///< open a file
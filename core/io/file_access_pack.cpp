@@ -30,6 +30,7 @@
 
 #include "file_access_pack.h"
 
+#include "core/io/file_access_compressed.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/object/script_language.h"
 #include "core/os/os.h"
@@ -47,7 +48,7 @@ Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t
 	return ERR_FILE_UNRECOGNIZED;
 }
 
-void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted) {
+void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_compressed) {
 	String simplified_path = p_path.simplify_path();
 	PathMD5 pmd5(simplified_path.md5_buffer());
 
@@ -55,6 +56,7 @@ void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64
 
 	PackedFile pf;
 	pf.encrypted = p_encrypted;
+	pf.compressed = p_compressed;
 	pf.pack = p_pkg_path;
 	pf.offset = p_ofs;
 	pf.size = p_size;
@@ -129,6 +131,19 @@ PackedData::~PackedData() {
 	_free_packed_dirs(root);
 }
 
+Vector<uint8_t> PackedData::compress_file(const uint8_t *p_data, uint64_t p_size) {
+	if (p_size == 0 || p_size > UINT32_MAX) {
+		return Vector<uint8_t>();
+	}
+
+	Vector<uint8_t> compressed = FileAccessCompressed::compress_blocks(p_data, p_size, PACK_COMPRESSED_MAGIC, Compression::MODE_ZSTD, PACK_COMPRESSED_BLOCK_SIZE);
+	// Already compressed formats barely shrink, keeping them raw avoids decompressing them for nothing.
+	if (compressed.is_empty() || (uint64_t)compressed.size() > p_size - p_size / 8) {
+		return Vector<uint8_t>();
+	}
+	return compressed;
+}
+
 //////////////////////////////////////////////////////////////////
 
 bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) {
@@ -207,7 +222,7 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	uint32_t ver_minor = f->get_32();
 	f->get_32(); // patch number, not used for validation.
 
-	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION, false, "Pack version unsupported: " + itos(version) + ".");
+	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION && version != PACK_FORMAT_VERSION_NO_COMPRESSION, false, "Pack version unsupported: " + itos(version) + ".");
 	ERR_FAIL_COND_V_MSG(ver_major > VERSION_MAJOR || (ver_major == VERSION_MAJOR && ver_minor > VERSION_MINOR), false, "Pack created with a newer version of the engine: " + itos(ver_major) + "." + itos(ver_minor) + ".");
 
 	uint32_t pack_flags = f->get_32();
@@ -243,6 +258,13 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		f = fae;
 	}
 
+	{
+		// The pack may have been rewritten since it was last mapped, map it again on next use.
+		// Files that are still open keep their own reference to the old mapping.
+		MutexLock lock(mapped_packs_mutex);
+		mapped_packs.erase(p_path);
+	}
+
 	for (int i = 0; i < file_count; i++) {
 		uint32_t sl = f->get_32();
 		CharString cs;
@@ -259,14 +281,68 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		f->get_buffer(md5, 16);
 		uint32_t flags = f->get_32();
 
-		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED));
+		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), (flags & PACK_FILE_COMPRESSED));
 	}
 
 	return true;
 }
 
+PackedSourcePCK::MappedPack PackedSourcePCK::_get_mapped_pack(const String &p_pack) {
+	MutexLock lock(mapped_packs_mutex);
+
+	HashMap<String, MappedPack>::Iterator E = mapped_packs.find(p_pack);
+	if (E) {
+		return E->value;
+	}
+
+	// Failures are cached too, so packs that can't be mapped don't pay for a new attempt on every open.
+	MappedPack &mp = mapped_packs[p_pack];
+
+	// Mapping whole packs could exhaust the address space of 32-bit processes.
+	if (sizeof(void *) < 8) {
+		return mp;
+	}
+
+	Ref<FileAccess> f = FileAccess::open(p_pack, FileAccess::READ);
+	if (f.is_null()) {
+		return mp;
+	}
+
+	const uint8_t *view = f->get_mapped_view();
+	if (view) {
+		mp.file = f;
+		mp.view = view;
+		mp.length = f->get_length();
+	}
+	return mp;
+}
+
 Ref<FileAccess> PackedSourcePCK::get_file(const String &p_path, PackedData::PackedFile *p_file) {
-	return memnew(FileAccessPack(p_path, *p_file));
+	Ref<FileAccess> f;
+	if (!p_file->encrypted) {
+		const MappedPack mp = _get_mapped_pack(p_file->pack);
+		if (mp.view && p_file->offset <= mp.length && p_file->size <= mp.length - p_file->offset) {
+			f = Ref<FileAccess>(memnew(FileAccessPack(p_path, *p_file, mp.file, mp.view + p_file->offset)));
+		}
+	}
+	if (f.is_null()) {
+		f = Ref<FileAccess>(memnew(FileAccessPack(p_path, *p_file)));
+	}
+
+	if (p_file->compressed) {
+		// Compression is applied before encryption, so the compressed stream is read from the decrypted contents.
+		char magic[5] = {};
+		f->get_buffer((uint8_t *)magic, 4);
+		ERR_FAIL_COND_V_MSG(String(magic) != PACK_COMPRESSED_MAGIC, Ref<FileAccess>(), "Can't open compressed pack-referenced file '" + p_path + "'.");
+
+		Ref<FileAccessCompressed> fac;
+		fac.instantiate();
+		fac->configure(PACK_COMPRESSED_MAGIC);
+		Error err = fac->open_after_magic(f);
+		ERR_FAIL_COND_V_MSG(err, Ref<FileAccess>(), "Can't open compressed pack-referenced file '" + p_path + "'.");
+		f = fac;
+	}
+	return f;
 }
 
 //////////////////////////////////////////////////////////////////
@@ -293,7 +369,9 @@ void FileAccessPack::seek(uint64_t p_position) {
 		eof = false;
 	}
 
-	f->seek(off + p_position);
+	if (!mapped) {
+		f->seek(off + p_position);
+	}
 	pos = p_position;
 }
 
@@ -327,12 +405,16 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 		to_read = (int64_t)pf.size - (int64_t)pos;
 	}
 
-	pos += to_read;
-
 	if (to_read <= 0) {
+		pos += to_read;
 		return 0;
 	}
-	f->get_buffer(p_dst, to_read);
+	if (mapped) {
+		memcpy(p_dst, mapped + pos, to_read);
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
+	pos += to_read;
 
 	return to_read;
 }
@@ -341,7 +423,9 @@ void FileAccessPack::set_big_endian(bool p_big_endian) {
 	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
 
 	FileAccess::set_big_endian(p_big_endian);
-	f->set_big_endian(p_big_endian);
+	if (!mapped) {
+		f->set_big_endian(p_big_endian);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -365,6 +449,7 @@ bool FileAccessPack::file_exists(const String &p_name) {
 
 void FileAccessPack::close() {
 	f = Ref<FileAccess>();
+	mapped = nullptr;
 }
 
 FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) :
@@ -395,6 +480,15 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 	eof = false;
 }
 
+FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const Ref<FileAccess> &p_mapped_pack, const uint8_t *p_mapped_view) :
+		pf(p_file),
+		pos(0),
+		eof(false),
+		off(p_file.offset),
+		f(p_mapped_pack),
+		mapped(p_mapped_view) {
+}
+
 //////////////////////////////////////////////////////////////////////////////////
 // DIR ACCESS
 //////////////////////////////////////////////////////////////////////////////////
@@ -33,6 +33,7 @@
 
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/os/mutex.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
@@ -41,7 +42,12 @@
 // Godot's packed file magic header ("GDPC" in ASCII).
 #define PACK_HEADER_MAGIC 0x43504447
 // The current packed file format version number.
-#define PACK_FORMAT_VERSION 2
+#define PACK_FORMAT_VERSION 3
+// Version 2 packs only lack compressed files, packs without them are still written as such so older versions can read them.
+#define PACK_FORMAT_VERSION_NO_COMPRESSION 2
+// Compressed files are stored as seekable blocks of this size, so seeking only decompresses a single block.
+#define PACK_COMPRESSED_BLOCK_SIZE (64 * 1024)
+#define PACK_COMPRESSED_MAGIC "GCPK"
 
 enum PackFlags {
 	PACK_DIR_ENCRYPTED = 1 << 0,
@@ -49,7 +55,8 @@ enum PackFlags {
 };
 
 enum PackFileFlags {
-	PACK_FILE_ENCRYPTED = 1 << 0
+	PACK_FILE_ENCRYPTED = 1 << 0,
+	PACK_FILE_COMPRESSED = 1 << 1,
 };
 
 class PackSource;
@@ -67,6 +74,7 @@ public:
 		uint8_t md5[16];
 		PackSource *src = nullptr;
 		bool encrypted;
+		bool compressed;
 	};
 
 private:
@@ -110,16 +118,18 @@ private:
 
 public:
 	void add_pack_source(PackSource *p_source);
-	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false); // for PackSource
+	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_compressed = false); // for PackSource
 
 	void set_disabled(bool p_disabled) { disabled = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled() const { return disabled; }
 
 	static PackedData *get_singleton() { return singleton; }
+	static Vector<uint8_t> compress_file(const uint8_t *p_data, uint64_t p_size); // Returns an empty buffer if the file should be stored raw.
 	Error add_pack(const String &p_path, bool p_replace_files, uint64_t p_offset);
 
 	_FORCE_INLINE_ Ref<FileAccess> try_open_path(const String &p_path);
 	_FORCE_INLINE_ bool has_path(const String &p_path);
+	_FORCE_INLINE_ bool get_packed_file(const String &p_path, PackedFile &r_file) const; // Returns false if the path isn't in a loaded pack.
 
 	_FORCE_INLINE_ Ref<DirAccess> try_open_directory(const String &p_path);
 	_FORCE_INLINE_ bool has_directory(const String &p_path);
@@ -136,6 +146,18 @@ public:
 };
 
 class PackedSourcePCK : public PackSource {
+	struct MappedPack {
+		Ref<FileAccess> file;
+		const uint8_t *view = nullptr;
+		uint64_t length = 0;
+	};
+
+	// Packs stay open and mapped for the lifetime of the source, so entries can be read straight from memory.
+	HashMap<String, MappedPack> mapped_packs;
+	Mutex mapped_packs_mutex;
+
+	MappedPack _get_mapped_pack(const String &p_pack);
+
 public:
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) override;
 	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file) override;
@@ -149,6 +171,8 @@ class FileAccessPack : public FileAccess {
 	uint64_t off;
 
 	Ref<FileAccess> f;
+	const uint8_t *mapped = nullptr; // Start of this file inside the mapped pack, reads don't touch `f` when set.
+
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
 	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
 	virtual BitField<FileAccess::UnixPermissionFlags> _get_unix_permissions(const String &p_file) override { return 0; }
@@ -170,6 +194,7 @@ public:
 	virtual bool eof_reached() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_mapped_view() const override { return mapped; }
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
@@ -184,6 +209,7 @@ public:
 	virtual void close() override;
 
 	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file);
+	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const Ref<FileAccess> &p_mapped_pack, const uint8_t *p_mapped_view);
 };
 
 Ref<FileAccess> PackedData::try_open_path(const String &p_path) {
@@ -204,6 +230,16 @@ bool PackedData::has_path(const String &p_path) {
 	return files.has(PathMD5(p_path.simplify_path().md5_buffer()));
 }
 
+bool PackedData::get_packed_file(const String &p_path, PackedFile &r_file) const {
+	const PackedFile *file = files.getptr(PathMD5(p_path.simplify_path().md5_buffer()));
+	if (!file) {
+		return false;
+	}
+
+	r_file = *file;
+	return true;
+}
+
 bool PackedData::has_directory(const String &p_path) {
 	Ref<DirAccess> da = try_open_directory(p_path);
 	if (da.is_valid()) {
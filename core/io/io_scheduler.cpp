@@ -0,0 +1,283 @@
+/**************************************************************************/
+/*  io_scheduler.cpp                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "io_scheduler.h"
+
+#include "core/io/file_access.h"
+#include "core/io/file_access_pack.h"
+#include "core/io/resource_loader.h"
+
+IOScheduler *IOScheduler::singleton = nullptr;
+
+void IOScheduler::_thread_func(void *p_userdata) {
+	IOScheduler *scheduler = (IOScheduler *)p_userdata;
+	scheduler->_process();
+}
+
+void IOScheduler::_process() {
+	LocalVector<uint8_t> scratch;
+	scratch.resize(READ_CHUNK_SIZE);
+
+	while (true) {
+		LocalVector<String> paths;
+		{
+			MutexLock lock(mutex);
+			while (!exit_thread.is_set() && queue.is_empty()) {
+				queue_cond.wait(lock);
+			}
+
+			if (exit_thread.is_set()) {
+				return;
+			}
+
+			// Requests stay queued until their own read starts, so waiters can still take them over.
+			paths = queue;
+			queue.clear();
+		}
+
+		LocalVector<Read> batch;
+		batch.resize(paths.size());
+		for (uint32_t i = 0; i < paths.size(); i++) {
+			batch[i].path = paths[i];
+			_resolve(paths[i], batch[i]);
+		}
+
+		// Files in the same pack are read front to back, which is the order the disk likes best.
+		batch.sort();
+		_read_batch(batch, scratch);
+	}
+}
+
+void IOScheduler::_resolve(const String &p_path, Read &r_read) const {
+	String path = ResourceLoader::path_remap(p_path);
+	String imported_path = ResourceLoader::import_remap(path);
+	if (!imported_path.is_empty()) {
+		path = imported_path;
+	}
+
+	r_read.file = path;
+
+	PackedData *packed_data = PackedData::get_singleton();
+	PackedData::PackedFile packed_file;
+	// Files from ZIP packs have no range recorded, they are read from the pack path like loose files.
+	if (packed_data && !packed_data->is_disabled() && packed_data->get_packed_file(path, packed_file) && packed_file.size > 0) {
+		r_read.file = packed_file.pack;
+		r_read.offset = packed_file.offset;
+		r_read.size = packed_file.size;
+	}
+}
+
+void IOScheduler::_read_batch(LocalVector<Read> &p_batch, LocalVector<uint8_t> &r_scratch) {
+	Ref<FileAccess> f;
+	String open_file;
+
+	for (const Read &read : p_batch) {
+		if (exit_thread.is_set()) {
+			return;
+		}
+
+		ReadCallback callback;
+		void *callback_userdata;
+		{
+			MutexLock lock(mutex);
+			RequestStatus *status = requests.getptr(read.path);
+			if (!status || *status != REQUEST_QUEUED) {
+				// Dropped by a waiter that reads the file by itself.
+				continue;
+			}
+			*status = REQUEST_READING;
+			callback = read_callback;
+			callback_userdata = read_callback_userdata;
+		}
+
+		if (callback) {
+			callback(read.path, callback_userdata);
+		}
+
+		if (read.file != open_file) {
+			open_file = read.file;
+			f = FileAccess::open(open_file, FileAccess::READ);
+		}
+
+		if (f.is_valid()) {
+			f->seek(read.offset);
+			uint64_t left = read.size > 0 ? read.size : f->get_length() - read.offset;
+			while (left > 0 && !exit_thread.is_set()) {
+				uint64_t read_size = f->get_buffer(r_scratch.ptr(), MIN(left, (uint64_t)READ_CHUNK_SIZE));
+				if (read_size == 0) {
+					break;
+				}
+				left -= MIN(left, read_size);
+			}
+		}
+
+		_finish_request(read.path);
+	}
+}
+
+void IOScheduler::_finish_request(const String &p_path) {
+	MutexLock lock(mutex);
+	requests.erase(p_path);
+
+	for (const KeyValue<WorkerThreadPool::TaskID, String> &E : yielding_tasks) {
+		if (E.value == p_path) {
+			WorkerThreadPool::get_singleton()->notify_yield_over(E.key);
+		}
+	}
+	done_cond.notify_all();
+}
+
+bool IOScheduler::_wake_finished_waiters() {
+	bool woke = false;
+	for (const KeyValue<WorkerThreadPool::TaskID, String> &E : yielding_tasks) {
+		if (!requests.has(E.value)) {
+			WorkerThreadPool::get_singleton()->notify_yield_over(E.key);
+			woke = true;
+		}
+	}
+	return woke;
+}
+
+void IOScheduler::init() {
+	MutexLock lock(mutex);
+	ERR_FAIL_COND_MSG(running, "The I/O scheduler is already running.");
+
+	exit_thread.clear();
+	running = true;
+	thread.start(_thread_func, this);
+}
+
+void IOScheduler::finish() {
+	{
+		MutexLock lock(mutex);
+		if (!running) {
+			return;
+		}
+		exit_thread.set();
+		queue_cond.notify_one();
+	}
+
+	thread.wait_to_finish();
+
+	MutexLock lock(mutex);
+	running = false;
+	requests.clear();
+	queue.clear();
+	// Nothing is pending anymore, so every waiter can go on and read by itself.
+	_wake_finished_waiters();
+	done_cond.notify_all();
+}
+
+bool IOScheduler::is_running() const {
+	MutexLock lock(mutex);
+	return running;
+}
+
+void IOScheduler::prefetch(const String &p_path) {
+	MutexLock lock(mutex);
+	if (!running || requests.has(p_path)) {
+		return;
+	}
+
+	requests.insert(p_path, REQUEST_QUEUED);
+	queue.push_back(p_path);
+	queue_cond.notify_one();
+}
+
+void IOScheduler::prefetch(const Vector<String> &p_paths) {
+	MutexLock lock(mutex);
+	if (!running) {
+		return;
+	}
+
+	for (const String &path : p_paths) {
+		if (!requests.has(path)) {
+			requests.insert(path, REQUEST_QUEUED);
+			queue.push_back(path);
+		}
+	}
+	queue_cond.notify_one();
+}
+
+void IOScheduler::wait(const String &p_path) {
+	MutexLock lock(mutex);
+	const RequestStatus *status = requests.getptr(p_path);
+	if (!status) {
+		return;
+	}
+
+	if (*status == REQUEST_QUEUED) {
+		// Not picked up yet, so waiting would only add latency. The caller is better off reading it.
+		requests.erase(p_path);
+		queue.erase(p_path);
+		return;
+	}
+
+	WorkerThreadPool::TaskID task_id = WorkerThreadPool::get_caller_task_id();
+	if (task_id == WorkerThreadPool::INVALID_TASK_ID) {
+		while (requests.has(p_path)) {
+			done_cond.wait(lock);
+		}
+		return;
+	}
+
+	yielding_tasks.insert(task_id, p_path);
+	while (requests.has(p_path)) {
+		lock.temp_unlock();
+		WorkerThreadPool::get_singleton()->yield();
+		lock.temp_relock();
+	}
+	yielding_tasks.erase(task_id);
+
+	// The pool keeps a single yield flag per thread. If this task ran on top of another one that yields
+	// on the same thread, it may have consumed the wake-up meant for it. That one can only resume once
+	// this task returns, so hand the wake-ups over again now.
+	_wake_finished_waiters();
+}
+
+bool IOScheduler::is_pending(const String &p_path) const {
+	MutexLock lock(mutex);
+	return requests.has(p_path);
+}
+
+void IOScheduler::set_read_callback(ReadCallback p_callback, void *p_userdata) {
+	MutexLock lock(mutex);
+	read_callback = p_callback;
+	read_callback_userdata = p_userdata;
+}
+
+IOScheduler::IOScheduler() {
+	singleton = this;
+}
+
+IOScheduler::~IOScheduler() {
+	finish();
+	singleton = nullptr;
+}
@@ -0,0 +1,117 @@
+/**************************************************************************/
+/*  io_scheduler.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef IO_SCHEDULER_H
+#define IO_SCHEDULER_H
+
+#include "core/object/worker_thread_pool.h"
+#include "core/os/condition_variable.h"
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+// Reads the files behind resource paths on a dedicated thread before the loaders get to them.
+// Requests are batched and read in pack offset order, so the OS cache is already warm by the
+// time a load task opens the file. Load tasks running on the WorkerThreadPool yield while they
+// wait, leaving their thread free to run other tasks.
+class IOScheduler {
+public:
+	typedef void (*ReadCallback)(const String &p_path, void *p_userdata);
+
+private:
+	static IOScheduler *singleton;
+
+	enum {
+		READ_CHUNK_SIZE = 256 * 1024,
+	};
+
+	enum RequestStatus {
+		REQUEST_QUEUED,
+		REQUEST_READING,
+	};
+
+	struct Read {
+		String path;
+		String file;
+		uint64_t offset = 0;
+		uint64_t size = 0; // Zero reads the file up to its end.
+
+		bool operator<(const Read &p_other) const {
+			if (file == p_other.file) {
+				return offset < p_other.offset;
+			}
+			return file < p_other.file;
+		}
+	};
+
+	Thread thread;
+	BinaryMutex mutex;
+	ConditionVariable queue_cond;
+	ConditionVariable done_cond;
+	SafeFlag exit_thread;
+	bool running = false;
+
+	HashMap<String, RequestStatus> requests;
+	LocalVector<String> queue;
+	HashMap<WorkerThreadPool::TaskID, String> yielding_tasks;
+
+	ReadCallback read_callback = nullptr;
+	void *read_callback_userdata = nullptr;
+
+	static void _thread_func(void *p_userdata);
+	void _process();
+	void _resolve(const String &p_path, Read &r_read) const;
+	void _read_batch(LocalVector<Read> &p_batch, LocalVector<uint8_t> &r_scratch);
+	void _finish_request(const String &p_path);
+	bool _wake_finished_waiters();
+
+public:
+	static IOScheduler *get_singleton() { return singleton; }
+
+	void init();
+	void finish();
+	bool is_running() const;
+
+	void prefetch(const String &p_path);
+	void prefetch(const Vector<String> &p_paths);
+	void wait(const String &p_path);
+	bool is_pending(const String &p_path) const;
+
+	// Called on the I/O thread right before a request is read. Used by tests to observe and hold back reads.
+	void set_read_callback(ReadCallback p_callback, void *p_userdata);
+
+	IOScheduler();
+	~IOScheduler();
+};
+
+#endif // IO_SCHEDULER_H
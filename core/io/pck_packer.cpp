@@ -29,6 +29,7 @@
 /**************************************************************************/
 
 #include "pck_packer.h"
+#include "pck_packer.compat.inc"
 
 #include "core/crypto/crypto_core.h"
 #include "core/io/file_access.h"
@@ -48,7 +49,7 @@ static int _get_pad(int p_alignment, int p_n) {
 
 void PCKPacker::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("pck_start", "pck_name", "alignment", "key", "encrypt_directory"), &PCKPacker::pck_start, DEFVAL(32), DEFVAL("0000000000000000000000000000000000000000000000000000000000000000"), DEFVAL(false));
-	ClassDB::bind_method(D_METHOD("add_file", "pck_path", "source_path", "encrypt"), &PCKPacker::add_file, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("add_file", "pck_path", "source_path", "encrypt", "compress"), &PCKPacker::add_file, DEFVAL(false), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("flush", "verbose"), &PCKPacker::flush, DEFVAL(false));
 }
 
@@ -89,7 +90,7 @@ Error PCKPacker::pck_start(const String &p_file, int p_alignment, const String &
 	alignment = p_alignment;
 
 	file->store_32(PACK_HEADER_MAGIC);
-	file->store_32(PACK_FORMAT_VERSION);
+	file->store_32(PACK_FORMAT_VERSION_NO_COMPRESSION); // Updated on flush if any file is compressed.
 	file->store_32(VERSION_MAJOR);
 	file->store_32(VERSION_MINOR);
 	file->store_32(VERSION_PATCH);
@@ -101,12 +102,11 @@ Error PCKPacker::pck_start(const String &p_file, int p_alignment, const String &
 	file->store_32(pack_flags); // flags
 
 	files.clear();
-	ofs = 0;
 
 	return OK;
 }
 
-Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_encrypt) {
+Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_encrypt, bool p_compress) {
 	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
 
 	Ref<FileAccess> f = FileAccess::open(p_src, FileAccess::READ);
@@ -119,7 +119,6 @@ Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_encr
 	// symbols in them still match to the MD5 hash for the saved path.
 	pf.path = p_file.simplify_path();
 	pf.src_path = p_src;
-	pf.ofs = ofs;
 	pf.size = f->get_length();
 
 	Vector<uint8_t> data = FileAccess::get_file_as_bytes(p_src);
@@ -132,38 +131,16 @@ Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_encr
 		}
 	}
 	pf.encrypted = p_encrypt;
-
-	uint64_t _size = pf.size;
-	if (p_encrypt) { // Add encryption overhead.
-		if (_size % 16) { // Pad to encryption block size.
-			_size += 16 - (_size % 16);
-		}
-		_size += 16; // hash
-		_size += 8; // data size
-		_size += 16; // iv
-	}
-
-	int pad = _get_pad(alignment, ofs + _size);
-	ofs = ofs + _size + pad;
+	// Compressed when written by flush(), so only one file is held in memory at a time.
+	pf.compress = p_compress;
+	pf.stored_size = pf.size;
 
 	files.push_back(pf);
 
 	return OK;
 }
 
-Error PCKPacker::flush(bool p_verbose) {
-	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
-
-	int64_t file_base_ofs = file->get_position();
-	file->store_64(0); // files base
-
-	for (int i = 0; i < 16; i++) {
-		file->store_32(0); // reserved
-	}
-
-	// write the index
-	file->store_32(files.size());
-
+Error PCKPacker::_store_directory() {
 	Ref<FileAccessEncrypted> fae;
 	Ref<FileAccess> fhead = file;
 
@@ -188,21 +165,41 @@ Error PCKPacker::flush(bool p_verbose) {
 		}
 
 		fhead->store_64(files[i].ofs);
-		fhead->store_64(files[i].size); // pay attention here, this is where file is
+		fhead->store_64(files[i].stored_size); // pay attention here, this is where file is
 		fhead->store_buffer(files[i].md5.ptr(), 16); //also save md5 for file
 
 		uint32_t flags = 0;
 		if (files[i].encrypted) {
 			flags |= PACK_FILE_ENCRYPTED;
 		}
+		if (files[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		fhead->store_32(flags);
 	}
 
-	if (fae.is_valid()) {
-		fhead.unref();
-		fae.unref();
+	return OK;
+}
+
+Error PCKPacker::flush(bool p_verbose) {
+	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
+
+	int64_t file_base_ofs = file->get_position();
+	file->store_64(0); // files base
+
+	for (int i = 0; i < 16; i++) {
+		file->store_32(0); // reserved
 	}
 
+	// write the index
+	file->store_32(files.size());
+
+	// Offsets and sizes of compressed files are only known once they are written. The index is
+	// written first to reserve its space, its size doesn't depend on them, and again at the end.
+	int64_t directory_ofs = file->get_position();
+	Error err = _store_directory();
+	ERR_FAIL_COND_V(err != OK, err);
+
 	int header_padding = _get_pad(alignment, file->get_position());
 	for (int i = 0; i < header_padding; i++) {
 		file->store_8(0);
@@ -216,25 +213,42 @@ Error PCKPacker::flush(bool p_verbose) {
 	const uint32_t buf_max = 65536;
 	uint8_t *buf = memnew_arr(uint8_t, buf_max);
 
+	bool has_compressed_files = false;
 	int count = 0;
 	for (int i = 0; i < files.size(); i++) {
-		Ref<FileAccess> src = FileAccess::open(files[i].src_path, FileAccess::READ);
-		uint64_t to_write = files[i].size;
+		File &pf = files.write[i];
+		pf.ofs = file->get_position() - file_base;
+
+		Vector<uint8_t> compressed_data;
+		if (pf.compress) {
+			Vector<uint8_t> data = FileAccess::get_file_as_bytes(pf.src_path);
+			compressed_data = PackedData::compress_file(data.ptr(), data.size());
+		}
+		pf.compressed = !compressed_data.is_empty();
+		pf.stored_size = pf.compressed ? compressed_data.size() : pf.size;
+		has_compressed_files = has_compressed_files || pf.compressed;
 
+		Ref<FileAccessEncrypted> fae;
 		Ref<FileAccess> ftmp = file;
-		if (files[i].encrypted) {
+		if (pf.encrypted) {
 			fae.instantiate();
 			ERR_FAIL_COND_V(fae.is_null(), ERR_CANT_CREATE);
 
-			Error err = fae->open_and_parse(file, key, FileAccessEncrypted::MODE_WRITE_AES256, false);
+			err = fae->open_and_parse(file, key, FileAccessEncrypted::MODE_WRITE_AES256, false);
 			ERR_FAIL_COND_V(err != OK, ERR_CANT_CREATE);
 			ftmp = fae;
 		}
 
-		while (to_write > 0) {
-			uint64_t read = src->get_buffer(buf, MIN(to_write, buf_max));
-			ftmp->store_buffer(buf, read);
-			to_write -= read;
+		if (pf.compressed) {
+			ftmp->store_buffer(compressed_data.ptr(), compressed_data.size());
+		} else {
+			Ref<FileAccess> src = FileAccess::open(pf.src_path, FileAccess::READ);
+			uint64_t to_write = pf.size;
+			while (to_write > 0) {
+				uint64_t read = src->get_buffer(buf, MIN(to_write, buf_max));
+				ftmp->store_buffer(buf, read);
+				to_write -= read;
+			}
 		}
 
 		if (fae.is_valid()) {
@@ -250,12 +264,21 @@ Error PCKPacker::flush(bool p_verbose) {
 		count += 1;
 		const int file_num = files.size();
 		if (p_verbose && (file_num > 0)) {
-			print_line(vformat("[%d/%d - %d%%] PCKPacker flush: %s -> %s", count, file_num, float(count) / file_num * 100, files[i].src_path, files[i].path));
+			print_line(vformat("[%d/%d - %d%%] PCKPacker flush: %s -> %s", count, file_num, float(count) / file_num * 100, pf.src_path, pf.path));
 		}
 	}
 
-	file.unref();
 	memdelete_arr(buf);
 
+	file->seek(directory_ofs);
+	err = _store_directory();
+	ERR_FAIL_COND_V(err != OK, err);
+	if (has_compressed_files) {
+		file->seek(4);
+		file->store_32(PACK_FORMAT_VERSION);
+	}
+
+	file.unref();
+
 	return OK;
 }
@@ -40,26 +40,35 @@ class PCKPacker : public RefCounted {
 
 	Ref<FileAccess> file;
 	int alignment = 0;
-	uint64_t ofs = 0;
 
 	Vector<uint8_t> key;
 	bool enc_dir = false;
 
 	static void _bind_methods();
 
+#ifndef DISABLE_DEPRECATED
+	Error _add_file_bind_compat_3args(const String &p_file, const String &p_src, bool p_encrypt);
+	static void _bind_compatibility_methods();
+#endif
+
 	struct File {
 		String path;
 		String src_path;
-		uint64_t ofs = 0;
+		uint64_t ofs = 0; // Known once written by flush().
 		uint64_t size = 0;
+		uint64_t stored_size = 0; // Size in the pack, known once written by flush().
 		bool encrypted = false;
+		bool compress = false;
+		bool compressed = false; // Compression is skipped when it doesn't save enough space.
 		Vector<uint8_t> md5;
 	};
 	Vector<File> files;
 
+	Error _store_directory();
+
 public:
 	Error pck_start(const String &p_file, int p_alignment = 32, const String &p_key = "0000000000000000000000000000000000000000000000000000000000000000", bool p_encrypt_directory = false);
-	Error add_file(const String &p_file, const String &p_src, bool p_encrypt = false);
+	Error add_file(const String &p_file, const String &p_src, bool p_encrypt = false, bool p_compress = false);
 	Error flush(bool p_verbose = false);
 
 	PCKPacker() {}
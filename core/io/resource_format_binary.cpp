@@ -34,14 +34,19 @@
 #include "core/io/dir_access.h"
 #include "core/io/file_access_compressed.h"
 #include "core/io/image.h"
+#include "core/io/io_scheduler.h"
 #include "core/io/marshalls.h"
 #include "core/io/missing_resource.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/version.h"
 
 //#define print_bl(m_what) print_line(m_what)
 #define print_bl(m_what) (void)(m_what)
 
+// Files with less sub-resource data than this are decoded on the loading thread only.
+static constexpr uint64_t PARALLEL_DECODE_MIN_SIZE = 1024 * 1024;
+
 enum {
 	//numbering must be different from variant, in case new variant types are added (variant must be always contiguous for jumptable optimization)
 	VARIANT_NIL = 1,
@@ -448,8 +453,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 						WARN_PRINT("Broken external resource! (index out of size)");
 						r_v = Variant();
 					} else {
-						Ref<ResourceLoader::LoadToken> &load_token = external_resources.write[erindex].load_token;
-						if (load_token.is_valid()) { // If not valid, it's OK since then we know this load accepts broken dependencies.
+						const Ref<ResourceLoader::LoadToken> &load_token = external_resources[erindex].load_token;
+						if (external_resources[erindex].cache.is_valid()) {
+							r_v = external_resources[erindex].cache;
+						} else if (load_token.is_valid()) { // If not valid, it's OK since then we know this load accepts broken dependencies.
 							Error err;
 							Ref<Resource> res = ResourceLoader::_load_complete(*load_token.ptr(), &err);
 							if (res.is_null()) {
@@ -685,6 +692,8 @@ Error ResourceLoaderBinary::load() {
 		return error;
 	}
 
+	Vector<String> prefetch_paths;
+
 	for (int i = 0; i < external_resources.size(); i++) {
 		String path = external_resources[i].path;
 
@@ -698,6 +707,20 @@ Error ResourceLoaderBinary::load() {
 		}
 
 		external_resources.write[i].path = path; //remap happens here, not on load because on load it can actually be used for filesystem dock resource remap
+
+		if (!use_sub_threads && !ResourceCache::has(path)) {
+			prefetch_paths.push_back(path);
+		}
+	}
+
+	// Dependencies are loaded one after the other on this thread, so have the next ones read while the current one is parsed.
+	// Sub-threaded loads prefetch their own file when their task is queued.
+	if (prefetch_paths.size() > 1) {
+		IOScheduler::get_singleton()->prefetch(prefetch_paths);
+	}
+
+	for (int i = 0; i < external_resources.size(); i++) {
+		String path = external_resources[i].path;
 		external_resources.write[i].load_token = ResourceLoader::_load_start(path, external_resources[i].type, use_sub_threads ? ResourceLoader::LOAD_THREAD_DISTRIBUTE : ResourceLoader::LOAD_THREAD_FROM_CURRENT, cache_mode_for_external);
 		if (!external_resources[i].load_token.is_valid()) {
 			if (!ResourceLoader::get_abort_on_missing_resources()) {
@@ -709,202 +732,352 @@ Error ResourceLoaderBinary::load() {
 		}
 	}
 
-	for (int i = 0; i < internal_resources.size(); i++) {
-		bool main = i == (internal_resources.size() - 1);
-
-		//maybe it is loaded already
-		String path;
-		String id;
+	LocalVector<InternalResourceLoad> loads;
+	loads.resize(internal_resources.size());
 
-		if (!main) {
-			path = internal_resources[i].path;
+	bool parallel = _should_decode_in_parallel();
+	if (parallel) {
+		// Create every object first, so references between sub-resources resolve regardless of which one is decoded first.
+		for (int i = 0; i < internal_resources.size(); i++) {
+			error = _create_internal_resource(i, loads[i]);
+			if (error) {
+				return error;
+			}
+		}
 
-			if (path.begins_with("local://")) {
-				path = path.replace_first("local://", "");
-				id = path;
-				path = res_path + "::" + path;
+		error = _decode_internal_resources_threaded(loads);
+		if (error) {
+			return error;
+		}
+	}
 
-				internal_resources.write[i].path = path; // Update path.
+	for (int i = 0; i < internal_resources.size(); i++) {
+		if (!parallel) {
+			error = _create_internal_resource(i, loads[i]);
+			if (error) {
+				return error;
 			}
-
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
-				Ref<Resource> cached = ResourceCache::get_ref(path);
-				if (cached.is_valid()) {
-					//already loaded, don't do anything
-					error = OK;
-					internal_index_cache[path] = cached;
-					continue;
+			if (loads[i].resource.is_valid()) {
+				error = _parse_internal_resource_properties(i, loads[i]);
+				if (error) {
+					return error;
 				}
 			}
-		} else {
-			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
-				path = res_path;
-			}
 		}
 
-		uint64_t offset = internal_resources[i].offset;
+		if (loads[i].resource.is_null()) {
+			continue;
+		}
 
-		f->seek(offset);
+		_set_internal_resource_properties(i, loads[i]);
 
-		String t = get_unicode_string();
+		if (progress) {
+			*progress = (i + 1) / float(internal_resources.size());
+		}
+
+		resource_cache.push_back(loads[i].resource);
+
+		if (i == internal_resources.size() - 1) {
+			f.unref();
+			resource = loads[i].resource;
+			resource->set_as_translation_remapped(translation_remapped);
+			error = OK;
+			return OK;
+		}
+	}
+
+	return ERR_FILE_EOF;
+}
+
+Error ResourceLoaderBinary::_create_internal_resource(int p_index, InternalResourceLoad &r_load) {
+	bool main = p_index == (internal_resources.size() - 1);
 
-		Ref<Resource> res;
-		Resource *r = nullptr;
+	//maybe it is loaded already
+	String path;
+	String id;
 
-		MissingResource *missing_resource = nullptr;
+	if (!main) {
+		path = internal_resources[p_index].path;
 
-		if (main) {
-			res = ResourceLoader::get_resource_ref_override(local_path);
-			r = res.ptr();
+		if (path.begins_with("local://")) {
+			path = path.replace_first("local://", "");
+			id = path;
+			path = res_path + "::" + path;
+
+			internal_resources.write[p_index].path = path; // Update path.
 		}
-		if (!r) {
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
-				//use the existing one
-				Ref<Resource> cached = ResourceCache::get_ref(path);
-				if (cached->get_class() == t) {
-					cached->reset_state();
-					res = cached;
-				}
+
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
+			Ref<Resource> cached = ResourceCache::get_ref(path);
+			if (cached.is_valid()) {
+				//already loaded, don't do anything
+				internal_index_cache[path] = cached;
+				return OK;
 			}
+		}
+	} else {
+		if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
+			path = res_path;
+		}
+	}
 
-			if (res.is_null()) {
-				//did not replace
-
-				Object *obj = ClassDB::instantiate(t);
-				if (!obj) {
-					if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
-						//create a missing resource
-						missing_resource = memnew(MissingResource);
-						missing_resource->set_original_class(t);
-						missing_resource->set_recording_properties(true);
-						obj = missing_resource;
-					} else {
-						error = ERR_FILE_CORRUPT;
-						ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource of unrecognized type in file: " + t + ".");
-					}
-				}
+	uint64_t offset = internal_resources[p_index].offset;
 
-				r = Object::cast_to<Resource>(obj);
-				if (!r) {
-					String obj_class = obj->get_class();
-					error = ERR_FILE_CORRUPT;
-					memdelete(obj); //bye
-					ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource type in resource field not a resource, type is: " + obj_class + ".");
-				}
+	f->seek(offset);
+
+	String t = get_unicode_string();
 
-				res = Ref<Resource>(r);
+	Ref<Resource> res;
+	Resource *r = nullptr;
+
+	if (main) {
+		res = ResourceLoader::get_resource_ref_override(local_path);
+		r = res.ptr();
+	}
+	if (!r) {
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
+			//use the existing one
+			Ref<Resource> cached = ResourceCache::get_ref(path);
+			if (cached->get_class() == t) {
+				cached->reset_state();
+				res = cached;
 			}
 		}
 
-		if (r) {
-			if (!path.is_empty()) {
-				if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
-					r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); // If got here because the resource with same path has different type, replace it.
+		if (res.is_null()) {
+			//did not replace
+
+			Object *obj = ClassDB::instantiate(t);
+			if (!obj) {
+				if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
+					//create a missing resource
+					r_load.missing_resource = memnew(MissingResource);
+					r_load.missing_resource->set_original_class(t);
+					r_load.missing_resource->set_recording_properties(true);
+					obj = r_load.missing_resource;
 				} else {
-					r->set_path_cache(path);
+					ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource of unrecognized type in file: " + t + ".");
 				}
 			}
-			r->set_scene_unique_id(id);
+
+			r = Object::cast_to<Resource>(obj);
+			if (!r) {
+				String obj_class = obj->get_class();
+				memdelete(obj); //bye
+				ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource type in resource field not a resource, type is: " + obj_class + ".");
+			}
+
+			res = Ref<Resource>(r);
 		}
+	}
 
-		if (!main) {
-			internal_index_cache[path] = res;
+	if (r) {
+		if (!path.is_empty()) {
+			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
+				r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); // If got here because the resource with same path has different type, replace it.
+			} else {
+				r->set_path_cache(path);
+			}
 		}
+		r->set_scene_unique_id(id);
+	}
+
+	if (!main) {
+		internal_index_cache[path] = res;
+	}
+
+	r_load.resource = res;
+	return OK;
+}
 
-		int pc = f->get_32();
+Error ResourceLoaderBinary::_parse_internal_resource_properties(int p_index, InternalResourceLoad &r_load) {
+	f->seek(internal_resources[p_index].offset);
+	get_unicode_string(); // Type, already handled when creating the resource.
 
-		//set properties
+	int pc = f->get_32();
 
-		Dictionary missing_resource_properties;
+	for (int j = 0; j < pc; j++) {
+		StringName name = _get_string();
 
-		for (int j = 0; j < pc; j++) {
-			StringName name = _get_string();
+		ERR_FAIL_COND_V(name == StringName(), ERR_FILE_CORRUPT);
 
-			if (name == StringName()) {
-				error = ERR_FILE_CORRUPT;
-				ERR_FAIL_V(ERR_FILE_CORRUPT);
-			}
+		Variant value;
 
-			Variant value;
+		Error err = parse_variant(value);
+		if (err) {
+			return err;
+		}
 
-			error = parse_variant(value);
-			if (error) {
-				return error;
-			}
+		r_load.properties.push_back(Pair<StringName, Variant>(name, value));
+	}
 
-			bool set_valid = true;
-			if (value.get_type() == Variant::OBJECT && missing_resource != nullptr) {
-				// If the property being set is a missing resource (and the parent is not),
-				// then setting it will most likely not work.
-				// Instead, save it as metadata.
+	return OK;
+}
 
-				Ref<MissingResource> mr = value;
-				if (mr.is_valid()) {
-					missing_resource_properties[name] = mr;
-					set_valid = false;
-				}
+void ResourceLoaderBinary::_set_internal_resource_properties(int p_index, InternalResourceLoad &r_load) {
+	Ref<Resource> res = r_load.resource;
+
+	//set properties
+
+	Dictionary missing_resource_properties;
+
+	for (Pair<StringName, Variant> &property : r_load.properties) {
+		const StringName &name = property.first;
+		Variant &value = property.second;
+
+		bool set_valid = true;
+		if (value.get_type() == Variant::OBJECT && r_load.missing_resource != nullptr) {
+			// If the property being set is a missing resource (and the parent is not),
+			// then setting it will most likely not work.
+			// Instead, save it as metadata.
+
+			Ref<MissingResource> mr = value;
+			if (mr.is_valid()) {
+				missing_resource_properties[name] = mr;
+				set_valid = false;
 			}
+		}
 
-			if (ClassDB::has_property(res->get_class_name(), name)) {
-				if (value.get_type() == Variant::ARRAY) {
-					Array set_array = value;
-					bool is_get_valid = false;
-					Variant get_value = res->get(name, &is_get_valid);
-					if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
-						Array get_array = get_value;
-						if (!set_array.is_same_typed(get_array)) {
-							value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
-						}
+		if (ClassDB::has_property(res->get_class_name(), name)) {
+			if (value.get_type() == Variant::ARRAY) {
+				Array set_array = value;
+				bool is_get_valid = false;
+				Variant get_value = res->get(name, &is_get_valid);
+				if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
+					Array get_array = get_value;
+					if (!set_array.is_same_typed(get_array)) {
+						value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
 					}
 				}
+			}
 
-				if (value.get_type() == Variant::DICTIONARY) {
-					Dictionary set_dict = value;
-					bool is_get_valid = false;
-					Variant get_value = res->get(name, &is_get_valid);
-					if (is_get_valid && get_value.get_type() == Variant::DICTIONARY) {
-						Dictionary get_dict = get_value;
-						if (!set_dict.is_same_typed(get_dict)) {
-							value = Dictionary(set_dict, get_dict.get_typed_key_builtin(), get_dict.get_typed_key_class_name(), get_dict.get_typed_key_script(),
-									get_dict.get_typed_value_builtin(), get_dict.get_typed_value_class_name(), get_dict.get_typed_value_script());
-						}
+			if (value.get_type() == Variant::DICTIONARY) {
+				Dictionary set_dict = value;
+				bool is_get_valid = false;
+				Variant get_value = res->get(name, &is_get_valid);
+				if (is_get_valid && get_value.get_type() == Variant::DICTIONARY) {
+					Dictionary get_dict = get_value;
+					if (!set_dict.is_same_typed(get_dict)) {
+						value = Dictionary(set_dict, get_dict.get_typed_key_builtin(), get_dict.get_typed_key_class_name(), get_dict.get_typed_key_script(),
+								get_dict.get_typed_value_builtin(), get_dict.get_typed_value_class_name(), get_dict.get_typed_value_script());
 					}
 				}
 			}
-
-			if (set_valid) {
-				res->set(name, value);
-			}
 		}
 
-		if (missing_resource) {
-			missing_resource->set_recording_properties(false);
+		if (set_valid) {
+			res->set(name, value);
 		}
+	}
 
-		if (!missing_resource_properties.is_empty()) {
-			res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
-		}
+	// Decoded values are no longer needed, don't keep them alive until the whole file is loaded.
+	r_load.properties.reset();
+
+	if (r_load.missing_resource) {
+		r_load.missing_resource->set_recording_properties(false);
+	}
+
+	if (!missing_resource_properties.is_empty()) {
+		res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+	}
 
 #ifdef TOOLS_ENABLED
-		res->set_edited(false);
+	res->set_edited(false);
 #endif
+}
 
-		if (progress) {
-			*progress = (i + 1) / float(internal_resources.size());
+bool ResourceLoaderBinary::_should_decode_in_parallel() const {
+	// Files in the old format may load dependencies while decoding, which has to stay on the loading thread.
+	if (!using_named_scene_ids || file_path.is_empty() || internal_resources.size() < 2) {
+		return false;
+	}
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (!pool || pool->get_thread_count() < 2) {
+		return false;
+	}
+
+	// Small files load faster than the threads could be put to work.
+	return f->get_length() - internal_resources[0].offset >= PARALLEL_DECODE_MIN_SIZE;
+}
+
+Ref<FileAccess> ResourceLoaderBinary::_reopen_file() const {
+	Ref<FileAccess> fa = FileAccess::open(file_path, FileAccess::READ);
+	ERR_FAIL_COND_V(fa.is_null(), Ref<FileAccess>());
+
+	if (file_compressed) {
+		fa->seek(4); // Magic was already checked by open().
+		Ref<FileAccessCompressed> fac;
+		fac.instantiate();
+		ERR_FAIL_COND_V(fac->open_after_magic(fa) != OK, Ref<FileAccess>());
+		fa = fac;
+	}
+
+	fa->set_big_endian(f->is_big_endian());
+	fa->real_is_double = f->real_is_double;
+	return fa;
+}
+
+Error ResourceLoaderBinary::_decode_internal_resources_threaded(LocalVector<InternalResourceLoad> &r_loads) {
+	// Wait for dependencies here, otherwise whichever thread references one first would end up loading it.
+	// The helpers copy the results, so they don't go through the loader again.
+	for (int i = 0; i < external_resources.size(); i++) {
+		if (external_resources[i].load_token.is_valid()) {
+			Error err;
+			external_resources.write[i].cache = ResourceLoader::_load_complete(*external_resources[i].load_token.ptr(), &err);
 		}
+	}
 
-		resource_cache.push_back(res);
+	ThreadedDecode decode;
+	decode.loads = &r_loads;
 
-		if (main) {
-			f.unref();
-			resource = res;
-			resource->set_as_translation_remapped(translation_remapped);
-			error = OK;
-			return OK;
+	// Each helper works with its own copy of the loader state and its own file cursor.
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	uint32_t helper_count = MIN((uint32_t)pool->get_thread_count(), r_loads.size()) - 1;
+	LocalVector<ResourceLoaderBinary> helpers;
+	helpers.resize(helper_count);
+	LocalVector<WorkerThreadPool::TaskID> tasks;
+	for (ResourceLoaderBinary &helper : helpers) {
+		Ref<FileAccess> fa = _reopen_file();
+		if (fa.is_null()) {
+			break;
 		}
+		helper = *this;
+		helper.f = fa;
+		tasks.push_back(pool->add_template_task(&helper, &ResourceLoaderBinary::_decode_internal_resources_lane, &decode, true, SNAME("ResourceLoaderBinaryDecode")));
 	}
 
-	return ERR_FILE_EOF;
+	_decode_internal_resources_lane(&decode);
+
+	for (WorkerThreadPool::TaskID task : tasks) {
+		pool->wait_for_task_completion(task);
+	}
+
+	for (const InternalResourceLoad &load : r_loads) {
+		if (load.error != OK) {
+			return load.error;
+		}
+	}
+	return OK;
+}
+
+void ResourceLoaderBinary::_decode_internal_resources_lane(ThreadedDecode *p_decode) {
+	LocalVector<InternalResourceLoad> &loads = *p_decode->loads;
+	while (!p_decode->failed) {
+		uint32_t index = p_decode->next.fetch_add(1);
+		if (index >= loads.size()) {
+			break;
+		}
+		if (loads[index].resource.is_null()) {
+			continue;
+		}
+
+		Error err = _parse_internal_resource_properties(index, loads[index]);
+		if (err != OK) {
+			loads[index].error = err;
+			p_decode->failed = true;
+		}
+	}
 }
 
 void ResourceLoaderBinary::set_translation_remapped(bool p_remapped) {
@@ -1004,6 +1177,7 @@ void ResourceLoaderBinary::open(Ref<FileAccess> p_f, bool p_no_resources, bool p
 			ERR_FAIL_MSG("Failed to open binary resource file: " + local_path + ".");
 		}
 		f = fac;
+		file_compressed = true;
 
 	} else if (header[0] != 'R' || header[1] != 'S' || header[2] != 'R' || header[3] != 'C') {
 		// Not normal.
@@ -1142,6 +1316,7 @@ String ResourceLoaderBinary::recognize(Ref<FileAccess> p_f) {
 			return "";
 		}
 		f = fac;
+		file_compressed = true;
 
 	} else if (header[0] != 'R' || header[1] != 'S' || header[2] != 'R' || header[3] != 'C') {
 		// Not normal.
@@ -1183,6 +1358,7 @@ String ResourceLoaderBinary::recognize_script_class(Ref<FileAccess> p_f) {
 			return "";
 		}
 		f = fac;
+		file_compressed = true;
 
 	} else if (header[0] != 'R' || header[1] != 'S' || header[2] != 'R' || header[3] != 'C') {
 		// Not normal.
@@ -1250,6 +1426,7 @@ Ref<Resource> ResourceFormatLoaderBinary::load(const String &p_path, const Strin
 	String path = !p_original_path.is_empty() ? p_original_path : p_path;
 	loader.local_path = ProjectSettings::get_singleton()->localize_path(path);
 	loader.res_path = loader.local_path;
+	loader.file_path = p_path;
 	loader.open(f);
 
 	err = loader.load();
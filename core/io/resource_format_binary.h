@@ -34,6 +34,12 @@
 #include "core/io/file_access.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/pair.h"
+
+#include <atomic>
+
+class MissingResource;
 
 class ResourceLoaderBinary {
 	bool translation_remapped = false;
@@ -44,6 +50,8 @@ class ResourceLoaderBinary {
 	uint32_t ver_format = 0;
 
 	Ref<FileAccess> f;
+	String file_path; // Used to open the file again when decoding sub-resources on several threads.
+	bool file_compressed = false;
 
 	uint64_t importmd_ofs = 0;
 
@@ -61,6 +69,7 @@ class ResourceLoaderBinary {
 		String type;
 		ResourceUID::ID uid = ResourceUID::INVALID_ID;
 		Ref<ResourceLoader::LoadToken> load_token;
+		Ref<Resource> cache; // Loaded dependency, set before sub-resources are decoded on several threads.
 	};
 
 	bool using_named_scene_ids = false;
@@ -78,6 +87,19 @@ class ResourceLoaderBinary {
 	Vector<IntResource> internal_resources;
 	HashMap<String, Ref<Resource>> internal_index_cache;
 
+	struct InternalResourceLoad {
+		Ref<Resource> resource; // Null if an already loaded resource was reused.
+		MissingResource *missing_resource = nullptr;
+		LocalVector<Pair<StringName, Variant>> properties;
+		Error error = OK;
+	};
+
+	struct ThreadedDecode {
+		LocalVector<InternalResourceLoad> *loads = nullptr;
+		std::atomic<uint32_t> next = 0;
+		std::atomic<bool> failed = false;
+	};
+
 	String get_unicode_string();
 	void _advance_padding(uint32_t p_len);
 
@@ -91,6 +113,15 @@ class ResourceLoaderBinary {
 
 	Error parse_variant(Variant &r_v);
 
+	Error _create_internal_resource(int p_index, InternalResourceLoad &r_load);
+	Error _parse_internal_resource_properties(int p_index, InternalResourceLoad &r_load);
+	void _set_internal_resource_properties(int p_index, InternalResourceLoad &r_load);
+
+	bool _should_decode_in_parallel() const;
+	Ref<FileAccess> _reopen_file() const;
+	Error _decode_internal_resources_threaded(LocalVector<InternalResourceLoad> &r_loads);
+	void _decode_internal_resources_lane(ThreadedDecode *p_decode);
+
 	HashMap<String, Ref<Resource>> dependency_cache;
 
 public:
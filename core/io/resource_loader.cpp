@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/core_bind.h"
 #include "core/io/file_access.h"
+#include "core/io/io_scheduler.h"
 #include "core/io/resource_importer.h"
 #include "core/object/script_language.h"
 #include "core/os/condition_variable.h"
@@ -349,6 +350,9 @@ void ResourceLoader::_run_load_task(void *p_userdata) {
 	}
 	// --
 
+	// If the file is being prefetched right now, let other tasks run until it's done.
+	IOScheduler::get_singleton()->wait(load_task.local_path);
+
 	bool xl_remapped = false;
 	const String &remapped_path = _path_remap(load_task.local_path, &xl_remapped);
 
@@ -617,6 +621,7 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 				load_task_ptr->thread_id = Thread::get_caller_id();
 			}
 		} else {
+			IOScheduler::get_singleton()->prefetch(local_path);
 			load_task_ptr->task_id = WorkerThreadPool::get_singleton()->add_native_task(&ResourceLoader::_run_load_task, load_task_ptr);
 		}
 	} // MutexLock(thread_load_mutex).
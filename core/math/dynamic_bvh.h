@@ -306,7 +306,7 @@ public:
 	};
 
 	template <typename QueryResult>
-	_FORCE_INLINE_ void aabb_query(const AABB &p_aabb, QueryResult &r_result);
+	_FORCE_INLINE_ void aabb_query(const AABB &p_aabb, QueryResult &r_result) const;
 	template <typename QueryResult>
 	_FORCE_INLINE_ void convex_query(const Plane *p_planes, int p_plane_count, const Vector3 *p_points, int p_point_count, QueryResult &r_result);
 	template <typename QueryResult>
@@ -319,7 +319,7 @@ public:
 };
 
 template <typename QueryResult>
-void DynamicBVH::aabb_query(const AABB &p_box, QueryResult &r_result) {
+void DynamicBVH::aabb_query(const AABB &p_box, QueryResult &r_result) const {
 	if (!bvh_root) {
 		return;
 	}
@@ -0,0 +1,340 @@
+/**************************************************************************/
+/*  math_batch.cpp                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "math_batch.h"
+
+// The kernels work on four floats at a time, double precision builds always use the scalar code.
+#if !defined(REAL_T_IS_DOUBLE) && !defined(MATH_SIMD_DISABLED)
+#if defined(MATH_SIMD_SSE2) || (!defined(MATH_SIMD_NEON) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)))
+#define MATH_BATCH_SSE2
+#elif defined(MATH_SIMD_NEON) || defined(__ARM_NEON) || defined(_M_ARM64)
+#define MATH_BATCH_NEON
+#endif
+#endif
+
+#if defined(MATH_BATCH_SSE2)
+
+#include <emmintrin.h>
+
+typedef __m128 vec4f;
+
+static _FORCE_INLINE_ vec4f v_set(float p_x, float p_y, float p_z, float p_w) {
+	return _mm_setr_ps(p_x, p_y, p_z, p_w);
+}
+static _FORCE_INLINE_ vec4f v_splat(float p_value) {
+	return _mm_set1_ps(p_value);
+}
+static _FORCE_INLINE_ vec4f v_load(const float *p_src) {
+	return _mm_loadu_ps(p_src);
+}
+static _FORCE_INLINE_ void v_store(float *r_dst, vec4f p_value) {
+	_mm_storeu_ps(r_dst, p_value);
+}
+static _FORCE_INLINE_ vec4f v_add(vec4f p_a, vec4f p_b) {
+	return _mm_add_ps(p_a, p_b);
+}
+static _FORCE_INLINE_ vec4f v_mul(vec4f p_a, vec4f p_b) {
+	return _mm_mul_ps(p_a, p_b);
+}
+static _FORCE_INLINE_ vec4f v_min(vec4f p_a, vec4f p_b) {
+	return _mm_min_ps(p_a, p_b);
+}
+static _FORCE_INLINE_ vec4f v_max(vec4f p_a, vec4f p_b) {
+	return _mm_max_ps(p_a, p_b);
+}
+
+#elif defined(MATH_BATCH_NEON)
+
+#include <arm_neon.h>
+
+typedef float32x4_t vec4f;
+
+static _FORCE_INLINE_ vec4f v_set(float p_x, float p_y, float p_z, float p_w) {
+	const float values[4] = { p_x, p_y, p_z, p_w };
+	return vld1q_f32(values);
+}
+static _FORCE_INLINE_ vec4f v_splat(float p_value) {
+	return vdupq_n_f32(p_value);
+}
+static _FORCE_INLINE_ vec4f v_load(const float *p_src) {
+	return vld1q_f32(p_src);
+}
+static _FORCE_INLINE_ void v_store(float *r_dst, vec4f p_value) {
+	vst1q_f32(r_dst, p_value);
+}
+static _FORCE_INLINE_ vec4f v_add(vec4f p_a, vec4f p_b) {
+	return vaddq_f32(p_a, p_b);
+}
+static _FORCE_INLINE_ vec4f v_mul(vec4f p_a, vec4f p_b) {
+	// Kept separate from the add on purpose, fused multiply-add rounds differently than the scalar code.
+	return vmulq_f32(p_a, p_b);
+}
+static _FORCE_INLINE_ vec4f v_min(vec4f p_a, vec4f p_b) {
+	return vminq_f32(p_a, p_b);
+}
+static _FORCE_INLINE_ vec4f v_max(vec4f p_a, vec4f p_b) {
+	return vmaxq_f32(p_a, p_b);
+}
+
+#endif
+
+#if defined(MATH_BATCH_SSE2) || defined(MATH_BATCH_NEON)
+
+// Operations are applied in the same order as the scalar operators, so that
+// results only differ where the compiler contracts the scalar code.
+
+struct BatchTransform {
+	vec4f columns[3];
+	vec4f origin;
+
+	_FORCE_INLINE_ vec4f xform(const Vector3 &p_vector) const {
+		return v_add(v_add(v_add(v_mul(columns[0], v_splat(p_vector.x)), v_mul(columns[1], v_splat(p_vector.y))), v_mul(columns[2], v_splat(p_vector.z))), origin);
+	}
+
+	_FORCE_INLINE_ AABB xform(const AABB &p_aabb) const {
+		const Vector3 min = p_aabb.position;
+		const Vector3 max = p_aabb.position + p_aabb.size;
+		vec4f tmin = origin;
+		vec4f tmax = origin;
+		for (int i = 0; i < 3; i++) {
+			const vec4f e = v_mul(columns[i], v_splat(min[i]));
+			const vec4f f = v_mul(columns[i], v_splat(max[i]));
+			tmin = v_add(tmin, v_min(e, f));
+			tmax = v_add(tmax, v_max(e, f));
+		}
+
+		float out_min[4];
+		float out_max[4];
+		v_store(out_min, tmin);
+		v_store(out_max, tmax);
+
+		AABB r_aabb;
+		r_aabb.position = Vector3(out_min[0], out_min[1], out_min[2]);
+		r_aabb.size = Vector3(out_max[0], out_max[1], out_max[2]) - r_aabb.position;
+		return r_aabb;
+	}
+
+	_FORCE_INLINE_ BatchTransform(const Transform3D &p_transform) {
+		const Basis &b = p_transform.basis;
+		columns[0] = v_set(b.rows[0][0], b.rows[1][0], b.rows[2][0], 0.0f);
+		columns[1] = v_set(b.rows[0][1], b.rows[1][1], b.rows[2][1], 0.0f);
+		columns[2] = v_set(b.rows[0][2], b.rows[1][2], b.rows[2][2], 0.0f);
+		origin = v_set(p_transform.origin.x, p_transform.origin.y, p_transform.origin.z, 0.0f);
+	}
+};
+
+// Basis::operator*= computes each row of the result as a combination of the rows of p_b.
+static _FORCE_INLINE_ void _multiply_basis_rows(const Basis &p_a, const Basis &p_b, float r_rows[3][4]) {
+	const vec4f b0 = v_set(p_b.rows[0][0], p_b.rows[0][1], p_b.rows[0][2], 0.0f);
+	const vec4f b1 = v_set(p_b.rows[1][0], p_b.rows[1][1], p_b.rows[1][2], 0.0f);
+	const vec4f b2 = v_set(p_b.rows[2][0], p_b.rows[2][1], p_b.rows[2][2], 0.0f);
+	for (int i = 0; i < 3; i++) {
+		const Vector3 &a = p_a.rows[i];
+		v_store(r_rows[i], v_add(v_add(v_mul(b0, v_splat(a.x)), v_mul(b1, v_splat(a.y))), v_mul(b2, v_splat(a.z))));
+	}
+}
+
+static _FORCE_INLINE_ Transform3D _multiply_transform(const BatchTransform &p_batch_a, const Transform3D &p_a, const Transform3D &p_b) {
+	float rows[3][4];
+	float origin[4];
+	_multiply_basis_rows(p_a.basis, p_b.basis, rows);
+	v_store(origin, p_batch_a.xform(p_b.origin));
+	return Transform3D(rows[0][0], rows[0][1], rows[0][2], rows[1][0], rows[1][1], rows[1][2], rows[2][0], rows[2][1], rows[2][2], origin[0], origin[1], origin[2]);
+}
+
+void MathBatch::xform_vector3(const Transform3D &p_transform, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count) {
+	const BatchTransform transform(p_transform);
+	float out[4];
+	for (uint32_t i = 0; i < p_count; i++) {
+		v_store(out, transform.xform(p_src[i]));
+		r_dst[i] = Vector3(out[0], out[1], out[2]);
+	}
+}
+
+void MathBatch::xform_vector3_soa(const Transform3D &p_transform, const real_t *p_x, const real_t *p_y, const real_t *p_z, real_t *r_x, real_t *r_y, real_t *r_z, uint32_t p_count) {
+	const Basis &b = p_transform.basis;
+	const Vector3 &o = p_transform.origin;
+	vec4f rows[3][3];
+	vec4f origin[3];
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 3; j++) {
+			rows[i][j] = v_splat(b.rows[i][j]);
+		}
+		origin[i] = v_splat(o[i]);
+	}
+
+	uint32_t i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+		const vec4f x = v_load(p_x + i);
+		const vec4f y = v_load(p_y + i);
+		const vec4f z = v_load(p_z + i);
+		v_store(r_x + i, v_add(v_add(v_add(v_mul(rows[0][0], x), v_mul(rows[0][1], y)), v_mul(rows[0][2], z)), origin[0]));
+		v_store(r_y + i, v_add(v_add(v_add(v_mul(rows[1][0], x), v_mul(rows[1][1], y)), v_mul(rows[1][2], z)), origin[1]));
+		v_store(r_z + i, v_add(v_add(v_add(v_mul(rows[2][0], x), v_mul(rows[2][1], y)), v_mul(rows[2][2], z)), origin[2]));
+	}
+	for (; i < p_count; i++) {
+		const Vector3 v = p_transform.xform(Vector3(p_x[i], p_y[i], p_z[i]));
+		r_x[i] = v.x;
+		r_y[i] = v.y;
+		r_z[i] = v.z;
+	}
+}
+
+void MathBatch::xform_aabb(const Transform3D &p_transform, const AABB *p_src, AABB *r_dst, uint32_t p_count) {
+	const BatchTransform transform(p_transform);
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_dst[i] = transform.xform(p_src[i]);
+	}
+}
+
+void MathBatch::xform_aabbs(const Transform3D *p_transforms, const AABB *p_src, AABB *r_dst, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_dst[i] = BatchTransform(p_transforms[i]).xform(p_src[i]);
+	}
+}
+
+AABB MathBatch::merge_aabbs(const AABB *p_src, uint32_t p_count) {
+	if (p_count == 0) {
+		return AABB();
+	}
+
+	const Vector3 &begin = p_src[0].position;
+	const Vector3 end = p_src[0].position + p_src[0].size;
+	vec4f min = v_set(begin.x, begin.y, begin.z, 0.0f);
+	vec4f max = v_set(end.x, end.y, end.z, 0.0f);
+	for (uint32_t i = 1; i < p_count; i++) {
+		const Vector3 &b = p_src[i].position;
+		const Vector3 e = p_src[i].position + p_src[i].size;
+		min = v_min(min, v_set(b.x, b.y, b.z, 0.0f));
+		max = v_max(max, v_set(e.x, e.y, e.z, 0.0f));
+	}
+
+	float out_min[4];
+	float out_max[4];
+	v_store(out_min, min);
+	v_store(out_max, max);
+
+	AABB r_aabb;
+	r_aabb.position = Vector3(out_min[0], out_min[1], out_min[2]);
+	r_aabb.size = Vector3(out_max[0], out_max[1], out_max[2]) - r_aabb.position;
+	return r_aabb;
+}
+
+void MathBatch::multiply_transforms(const Transform3D &p_parent, const Transform3D *p_src, Transform3D *r_dst, uint32_t p_count) {
+	const BatchTransform parent(p_parent);
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_dst[i] = _multiply_transform(parent, p_parent, p_src[i]);
+	}
+}
+
+void MathBatch::multiply_transforms(const Transform3D *p_a, const Transform3D *p_b, Transform3D *r_dst, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_dst[i] = _multiply_transform(BatchTransform(p_a[i]), p_a[i], p_b[i]);
+	}
+}
+
+void MathBatch::multiply_bases(const Basis *p_a, const Basis *p_b, Basis *r_dst, uint32_t p_count) {
+	float rows[3][4];
+	for (uint32_t i = 0; i < p_count; i++) {
+		_multiply_basis_rows(p_a[i], p_b[i], rows);
+		r_dst[i] = Basis(rows[0][0], rows[0][1], rows[0][2], rows[1][0], rows[1][1], rows[1][2], rows[2][0], rows[2][1], rows[2][2]);
+	}
+}
+
+#else
+
+void MathBatch::xform_vector3(const Transform3D &p_transform, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_transform.xform(p_src[i]);
+	}
+}
+
+void MathBatch::xform_vector3_soa(const Transform3D &p_transform, const real_t *p_x, const real_t *p_y, const real_t *p_z, real_t *r_x, real_t *r_y, real_t *r_z, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		const Vector3 v = p_transform.xform(Vector3(p_x[i], p_y[i], p_z[i]));
+		r_x[i] = v.x;
+		r_y[i] = v.y;
+		r_z[i] = v.z;
+	}
+}
+
+void MathBatch::xform_aabb(const Transform3D &p_transform, const AABB *p_src, AABB *r_dst, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_transform.xform(p_src[i]);
+	}
+}
+
+void MathBatch::xform_aabbs(const Transform3D *p_transforms, const AABB *p_src, AABB *r_dst, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_transforms[i].xform(p_src[i]);
+	}
+}
+
+AABB MathBatch::merge_aabbs(const AABB *p_src, uint32_t p_count) {
+	if (p_count == 0) {
+		return AABB();
+	}
+
+	AABB r_aabb = p_src[0];
+	for (uint32_t i = 1; i < p_count; i++) {
+		r_aabb.merge_with(p_src[i]);
+	}
+	return r_aabb;
+}
+
+void MathBatch::multiply_transforms(const Transform3D &p_parent, const Transform3D *p_src, Transform3D *r_dst, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_parent * p_src[i];
+	}
+}
+
+void MathBatch::multiply_transforms(const Transform3D *p_a, const Transform3D *p_b, Transform3D *r_dst, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_a[i] * p_b[i];
+	}
+}
+
+void MathBatch::multiply_bases(const Basis *p_a, const Basis *p_b, Basis *r_dst, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_a[i] * p_b[i];
+	}
+}
+
+#endif
+
+const char *MathBatch::get_simd_name() {
+#if defined(MATH_BATCH_SSE2)
+	return "sse2";
+#elif defined(MATH_BATCH_NEON)
+	return "neon";
+#else
+	return "none";
+#endif
+}
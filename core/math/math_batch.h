@@ -0,0 +1,66 @@
+/**************************************************************************/
+/*  math_batch.h                                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef MATH_BATCH_H
+#define MATH_BATCH_H
+
+#include "core/math/aabb.h"
+#include "core/math/transform_3d.h"
+
+// Batched versions of the hot Transform3D, Basis and AABB operations.
+// Results match the scalar operators up to floating-point rounding. The
+// destination may be the same array as a source, but not a partially
+// overlapping one.
+class MathBatch {
+public:
+	// r_dst[i] = p_transform.xform(p_src[i])
+	static void xform_vector3(const Transform3D &p_transform, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count);
+	// Same as xform_vector3() with the vectors split in separate component arrays, which vectorizes best.
+	static void xform_vector3_soa(const Transform3D &p_transform, const real_t *p_x, const real_t *p_y, const real_t *p_z, real_t *r_x, real_t *r_y, real_t *r_z, uint32_t p_count);
+
+	// r_dst[i] = p_transform.xform(p_src[i])
+	static void xform_aabb(const Transform3D &p_transform, const AABB *p_src, AABB *r_dst, uint32_t p_count);
+	// r_dst[i] = p_transforms[i].xform(p_src[i])
+	static void xform_aabbs(const Transform3D *p_transforms, const AABB *p_src, AABB *r_dst, uint32_t p_count);
+	// Returns the AABB enclosing all of p_src, or an empty AABB if p_count is 0.
+	static AABB merge_aabbs(const AABB *p_src, uint32_t p_count);
+
+	// r_dst[i] = p_parent * p_src[i]
+	static void multiply_transforms(const Transform3D &p_parent, const Transform3D *p_src, Transform3D *r_dst, uint32_t p_count);
+	// r_dst[i] = p_a[i] * p_b[i]
+	static void multiply_transforms(const Transform3D *p_a, const Transform3D *p_b, Transform3D *r_dst, uint32_t p_count);
+	// r_dst[i] = p_a[i] * p_b[i]
+	static void multiply_bases(const Basis *p_a, const Basis *p_b, Basis *r_dst, uint32_t p_count);
+
+	// Name of the instruction set selected at build time ("sse2", "neon" or "none").
+	static const char *get_simd_name();
+};
+
+#endif // MATH_BATCH_H
@@ -88,6 +88,8 @@ public:
 		API_NONE
 	};
 
+	typedef Object *(*CreationFunc)(bool p_notify_postinitialize);
+
 public:
 	struct PropertySetGet {
 		int index;
@@ -306,6 +308,8 @@ public:
 	static Object *instantiate(const StringName &p_class);
 	static Object *instantiate_no_placeholders(const StringName &p_class);
 	static Object *instantiate_without_postinitialization(const StringName &p_class);
+	// Only resolve native classes, for callers caching what `instantiate()` and `set_property()` look up by name.
+	static CreationFunc get_native_creation_func(const StringName &p_class);
 	static void set_object_extension_instance(Object *p_object, const StringName &p_class, GDExtensionClassInstancePtr p_instance);
 
 	static APIType get_api_type(const StringName &p_class);
@@ -439,6 +443,8 @@ public:
 	static Variant::Type get_property_type(const StringName &p_class, const StringName &p_property, bool *r_is_valid = nullptr);
 	static StringName get_property_setter(const StringName &p_class, const StringName &p_property);
 	static StringName get_property_getter(const StringName &p_class, const StringName &p_property);
+	static MethodBind *get_property_setter_method(const StringName &p_class, const StringName &p_property, int *r_index = nullptr);
+	static MethodBind *get_property_getter_method(const StringName &p_class, const StringName &p_property, int *r_index = nullptr);
 
 	static bool has_method(const StringName &p_class, const StringName &p_method, bool p_no_inheritance = false);
 	static void set_method_flags(const StringName &p_class, const StringName &p_method, int p_flags);
@@ -43,21 +43,6 @@
 
 #ifdef DEBUG_ENABLED
 
-struct _ObjectDebugLock {
-	ObjectID obj_id;
-
-	_ObjectDebugLock(Object *p_obj) {
-		obj_id = p_obj->get_instance_id();
-		p_obj->_lock_index.ref();
-	}
-	~_ObjectDebugLock() {
-		Object *obj_ptr = ObjectDB::get_instance(obj_id);
-		if (likely(obj_ptr)) {
-			obj_ptr->_lock_index.unref();
-		}
-	}
-};
-
 #define OBJ_DEBUG_LOCK _ObjectDebugLock _debug_lock(this);
 
 #else
@@ -1127,6 +1112,69 @@ Error Object::_emit_signal(const Variant **p_args, int p_argcount, Callable::Cal
 	return emit_signalp(signal, args, argc);
 }
 
+Object::SignalData::SignalData(const SignalData &p_other) :
+		user(p_other.user),
+		slot_map(p_other.slot_map),
+		removable(p_other.removable) {
+}
+
+Object::SignalData &Object::SignalData::operator=(const SignalData &p_other) {
+	user = p_other.user;
+	slot_map = p_other.slot_map;
+	removable = p_other.removable;
+	invalidate_emit_snapshot();
+	return *this;
+}
+
+Object::SignalData::~SignalData() {
+	invalidate_emit_snapshot();
+}
+
+Object::SignalData::EmitSnapshot *Object::SignalData::acquire_emit_snapshot() {
+	EmitSnapshot *snapshot = emit_snapshot.load(std::memory_order_acquire);
+	if (unlikely(!snapshot)) {
+		snapshot = memnew(EmitSnapshot);
+		snapshot->refcount.init(); // Owned by the signal until the connections change.
+		snapshot->slots.resize(slot_map.size());
+
+		uint32_t i = 0;
+		for (const KeyValue<Callable, Slot> &slot_kv : slot_map) {
+			EmitSlot &slot = snapshot->slots[i++];
+			slot.callable = slot_kv.value.conn.callable;
+			slot.flags = slot_kv.value.conn.flags;
+			if (slot.callable.is_custom()) {
+				slot.custom = slot.callable.get_custom();
+			} else {
+				slot.object = slot.callable.get_object_id();
+				slot.method = slot.callable.get_method();
+			}
+		}
+
+		EmitSnapshot *expected = nullptr;
+		if (!emit_snapshot.compare_exchange_strong(expected, snapshot, std::memory_order_acq_rel)) {
+			// Another thread emitting the same signal built it first.
+			memdelete(snapshot);
+			snapshot = expected;
+		}
+	}
+
+	snapshot->refcount.ref();
+	return snapshot;
+}
+
+void Object::SignalData::release_emit_snapshot(EmitSnapshot *p_snapshot) {
+	if (p_snapshot->refcount.unref()) {
+		memdelete(p_snapshot);
+	}
+}
+
+void Object::SignalData::invalidate_emit_snapshot() {
+	EmitSnapshot *snapshot = emit_snapshot.exchange(nullptr, std::memory_order_acq_rel);
+	if (snapshot) {
+		release_emit_snapshot(snapshot);
+	}
+}
+
 Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int p_argcount) {
 	if (_block_signals) {
 		return ERR_CANT_ACQUIRE_RESOURCE; //no emit, signals blocked
@@ -1149,29 +1197,20 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 
 	// Ensure that disconnecting the signal or even deleting the object
 	// will not affect the signal calling.
-	Callable *slot_callables = (Callable *)alloca(sizeof(Callable) * s->slot_map.size());
-	uint32_t *slot_flags = (uint32_t *)alloca(sizeof(uint32_t) * s->slot_map.size());
-	uint32_t slot_count = 0;
-
-	for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
-		memnew_placement(&slot_callables[slot_count], Callable(slot_kv.value.conn.callable));
-		slot_flags[slot_count] = slot_kv.value.conn.flags;
-		++slot_count;
-	}
-
-	DEV_ASSERT(slot_count == s->slot_map.size());
+	SignalData::EmitSnapshot *snapshot = s->acquire_emit_snapshot();
+	const LocalVector<SignalData::EmitSlot> &slots = snapshot->slots;
 
 	// Disconnect all one-shot connections before emitting to prevent recursion.
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		bool disconnect = slot_flags[i] & CONNECT_ONE_SHOT;
+	for (const SignalData::EmitSlot &slot : slots) {
+		bool disconnect = slot.flags & CONNECT_ONE_SHOT;
 #ifdef TOOLS_ENABLED
-		if (disconnect && (slot_flags[i] & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
+		if (disconnect && (slot.flags & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
 			// This signal was connected from the editor, and is being edited. Just don't disconnect for now.
 			disconnect = false;
 		}
 #endif
 		if (disconnect) {
-			_disconnect(p_name, slot_callables[i]);
+			_disconnect(p_name, slot.callable);
 		}
 	}
 
@@ -1179,26 +1218,46 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 
 	Error err = OK;
 
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		const Callable &callable = slot_callables[i];
-		const uint32_t &flags = slot_flags[i];
-
-		if (!callable.is_valid()) {
-			// Target might have been deleted during signal callback, this is expected and OK.
-			continue;
-		}
+	for (const SignalData::EmitSlot &slot : slots) {
+		const Callable &callable = slot.callable;
+		const uint32_t &flags = slot.flags;
 
 		const Variant **args = p_args;
 		int argc = p_argcount;
 
 		if (flags & CONNECT_DEFERRED) {
+			if (!callable.is_valid()) {
+				// Target might have been deleted during signal callback, this is expected and OK.
+				continue;
+			}
 			MessageQueue::get_singleton()->push_callablep(callable, args, argc, true);
 		} else {
 			Callable::CallError ce;
-			_emitting = true;
 			Variant ret;
-			callable.callp(args, argc, ret, ce);
-			_emitting = false;
+
+			if (slot.custom) {
+				if (!slot.custom->is_valid()) {
+					// Target might have been deleted during signal callback, this is expected and OK.
+					continue;
+				}
+				_emitting = true;
+				slot.custom->call(args, argc, ret, ce);
+				_emitting = false;
+			} else {
+				Object *target = ObjectDB::get_instance(slot.object);
+				if (!target) {
+					// Target might have been deleted during signal callback, this is expected and OK.
+					continue;
+				}
+				_emitting = true;
+				ret = target->callp(slot.method, args, argc, ce);
+				_emitting = false;
+
+				if (ce.error == Callable::CallError::CALL_ERROR_INVALID_METHOD && !target->has_method(slot.method)) {
+					// Only checked on failure, this is the same as skipping callables that are not valid.
+					continue;
+				}
+			}
 
 			if (ce.error != Callable::CallError::CALL_OK) {
 #ifdef DEBUG_ENABLED
@@ -1217,9 +1276,7 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		}
 	}
 
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		slot_callables[i].~Callable();
-	}
+	SignalData::release_emit_snapshot(snapshot);
 
 	return err;
 }
@@ -1434,6 +1491,7 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, ui
 
 	//use callable version as key, so binds can be ignored
 	s->slot_map[*p_callable.get_base_comparator()] = slot;
+	s->invalidate_emit_snapshot();
 
 	return OK;
 }
@@ -1491,6 +1549,7 @@ bool Object::_disconnect(const StringName &p_signal, const Callable &p_callable,
 	}
 
 	s->slot_map.erase(*p_callable.get_base_comparator());
+	s->invalidate_emit_snapshot();
 
 	if (s->slot_map.is_empty() && ClassDB::has_signal(get_class_name(), p_signal)) {
 		//not user signal, delete
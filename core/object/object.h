@@ -39,11 +39,14 @@
 #include "core/templates/hash_map.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/rb_map.h"
 #include "core/templates/safe_refcount.h"
 #include "core/variant/callable_bind.h"
 #include "core/variant/variant.h"
 
+#include <atomic>
+
 template <typename T>
 class TypedArray;
 
@@ -605,9 +608,36 @@ private:
 			List<Connection>::Element *cE = nullptr;
 		};
 
+		struct EmitSlot {
+			Callable callable;
+			// Resolved once, so emitting does not need to go through Callable::callp().
+			CallableCustom *custom = nullptr;
+			ObjectID object;
+			StringName method;
+			uint32_t flags = 0;
+		};
+
+		// Immutable copy of the connections used to emit the signal. It is rebuilt
+		// only after a connection is added or removed, and emissions in progress keep
+		// a reference to it, so callbacks can safely change the connections.
+		struct EmitSnapshot {
+			SafeRefCount refcount;
+			LocalVector<EmitSlot> slots;
+		};
+
 		MethodInfo user;
 		HashMap<Callable, Slot, HashableHasher<Callable>> slot_map;
 		bool removable = false;
+		std::atomic<EmitSnapshot *> emit_snapshot = nullptr;
+
+		EmitSnapshot *acquire_emit_snapshot();
+		static void release_emit_snapshot(EmitSnapshot *p_snapshot);
+		void invalidate_emit_snapshot();
+
+		SignalData() {}
+		SignalData(const SignalData &p_other);
+		SignalData &operator=(const SignalData &p_other);
+		~SignalData();
 	};
 
 	HashMap<StringName, SignalData> signal_map;
@@ -1048,4 +1078,24 @@ public:
 	static int get_object_count();
 };
 
+#ifdef DEBUG_ENABLED
+
+// Marks an object as locked while one of its methods runs, so it can't be freed from inside the call.
+struct _ObjectDebugLock {
+	ObjectID obj_id;
+
+	_ObjectDebugLock(Object *p_obj) {
+		obj_id = p_obj->get_instance_id();
+		p_obj->_lock_index.ref();
+	}
+	~_ObjectDebugLock() {
+		Object *obj_ptr = ObjectDB::get_instance(obj_id);
+		if (likely(obj_ptr)) {
+			obj_ptr->_lock_index.unref();
+		}
+	}
+};
+
+#endif // DEBUG_ENABLED
+
 #endif // OBJECT_H
@@ -118,6 +118,10 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		if (do_post) {
 			p_task->group->done_semaphore.post();
 			p_task->group->completed.set_to(true);
+
+			// Must happen before this task is counted as finished, so the group can't be freed meanwhile.
+			MutexLock task_lock(task_mutex);
+			_post_dependents(p_task->group->dependents);
 		}
 		uint32_t max_users = p_task->group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = p_task->group->finished.increment();
@@ -145,6 +149,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		task_mutex.lock();
 		p_task->completed = true;
 		p_task->pool_thread_index = -1;
+		_post_dependents(p_task->dependents);
 		if (p_task->waiting_user) {
 			p_task->done_semaphore.post(p_task->waiting_user);
 		}
@@ -181,8 +186,9 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 void WorkerThreadPool::_thread_function(void *p_user) {
 	ThreadData *thread_data = (ThreadData *)p_user;
 	while (true) {
-		Task *task_to_process = nullptr;
-		{
+		// Own and stolen tasks don't need the lock.
+		Task *task_to_process = singleton->_try_pop_local_task(thread_data);
+		if (!task_to_process) {
 			MutexLock lock(singleton->task_mutex);
 			if (singleton->exit_threads) {
 				return;
@@ -192,7 +198,8 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 			if (singleton->task_queue.first()) {
 				task_to_process = singleton->task_queue.first()->self();
 				singleton->task_queue.remove(singleton->task_queue.first());
-			} else {
+			} else if (!singleton->_has_local_tasks()) {
+				// Tasks are only pushed to the deques with the lock held, so none can be missed here.
 				thread_data->cond_var.wait(lock);
 				DEV_ASSERT(singleton->exit_threads || thread_data->signaled);
 			}
@@ -217,6 +224,12 @@ void WorkerThreadPool::_post_tasks_and_unlock(Task **p_tasks, uint32_t p_count,
 		return;
 	}
 
+	_post_tasks(p_tasks, p_count, p_high_priority);
+
+	task_mutex.unlock();
+}
+
+void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority) {
 	uint32_t to_process = 0;
 	uint32_t to_promote = 0;
 
@@ -225,7 +238,10 @@ void WorkerThreadPool::_post_tasks_and_unlock(Task **p_tasks, uint32_t p_count,
 	for (uint32_t i = 0; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
 		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
-			task_queue.add_last(&p_tasks[i]->task_elem);
+			// Pool threads keep the tasks they post in their own deque, the shared queue is the fallback.
+			if (!caller_pool_thread || !caller_pool_thread->work_queue.push(p_tasks[i])) {
+				task_queue.add_last(&p_tasks[i]->task_elem);
+			}
 			if (!p_high_priority) {
 				low_priority_threads_used++;
 			}
@@ -238,8 +254,6 @@ void WorkerThreadPool::_post_tasks_and_unlock(Task **p_tasks, uint32_t p_count,
 	}
 
 	_notify_threads(caller_pool_thread, to_process, to_promote);
-
-	task_mutex.unlock();
 }
 
 void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count) {
@@ -318,11 +332,93 @@ bool WorkerThreadPool::_try_promote_low_priority_task() {
 	}
 }
 
+uint32_t WorkerThreadPool::_add_dependencies(const Vector<TaskID> &p_dependencies, const Dependent &p_dependent) {
+	uint32_t pending_dependencies = 0;
+	for (const TaskID &dependency_id : p_dependencies) {
+		Task **taskp = tasks.getptr(dependency_id);
+		if (taskp) {
+			if (!(*taskp)->completed) {
+				(*taskp)->dependents.push_back(p_dependent);
+				pending_dependencies++;
+			}
+			continue;
+		}
+
+		Group **groupp = groups.getptr(dependency_id);
+		if (groupp) {
+			// The completion flag is set before the dependents are posted under the lock, so none can be missed.
+			if (!(*groupp)->completed.is_set()) {
+				(*groupp)->dependents.push_back(p_dependent);
+				pending_dependencies++;
+			}
+			continue;
+		}
+
+		// Not found, so it was already awaited and is completed.
+	}
+	return pending_dependencies;
+}
+
+void WorkerThreadPool::_post_dependents(LocalVector<Dependent> &p_dependents) {
+	for (const Dependent &dependent : p_dependents) {
+		if (dependent.task) {
+			Task *task = dependent.task;
+			DEV_ASSERT(task->pending_dependencies > 0);
+			task->pending_dependencies--;
+			if (task->pending_dependencies == 0) {
+				_post_tasks(&task, 1, !task->low_priority);
+			}
+		} else {
+			Group *group = dependent.group;
+			DEV_ASSERT(group->pending_dependencies > 0);
+			group->pending_dependencies--;
+			if (group->pending_dependencies == 0) {
+				if (group->pending_tasks.is_empty()) {
+					// A group without elements completes as soon as it's released.
+					group->completed.set_to(true);
+					group->done_semaphore.post();
+					_post_dependents(group->dependents);
+				} else {
+					_post_tasks(group->pending_tasks.ptr(), group->pending_tasks.size(), !group->pending_tasks[0]->low_priority);
+					group->pending_tasks.clear();
+				}
+			}
+		}
+	}
+	p_dependents.clear();
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::_try_pop_local_task(ThreadData *p_thread_data) {
+	Task *task = nullptr;
+	if (p_thread_data->work_queue.pop(task)) {
+		return task;
+	}
+
+	// Steal from the other threads, starting with the next one to spread the thieves.
+	const uint32_t thread_count = threads.size();
+	for (uint32_t i = 1; i < thread_count; i++) {
+		ThreadData &victim = threads[(p_thread_data->index + i) % thread_count];
+		if (victim.work_queue.steal(task)) {
+			return task;
+		}
+	}
+	return nullptr;
+}
+
+bool WorkerThreadPool::_has_local_tasks() const {
+	for (const ThreadData &thread_data : threads) {
+		if (!thread_data.work_queue.is_empty()) {
+			return true;
+		}
+	}
+	return false;
+}
+
 WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
 	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description);
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies) {
 	ERR_FAIL_COND_V_MSG(threads.is_empty(), INVALID_TASK_ID, "Can't add a task because the WorkerThreadPool is either not initialized yet or already terminated.");
 
 	task_mutex.lock();
@@ -337,6 +433,18 @@ WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable,
 	task->template_userdata = p_template_userdata;
 	tasks.insert(id, task);
 
+	if (!p_dependencies.is_empty()) {
+		Dependent dependent;
+		dependent.task = task;
+		task->pending_dependencies = _add_dependencies(p_dependencies, dependent);
+		if (task->pending_dependencies > 0) {
+			// Posted by the last dependency to complete.
+			task->low_priority = !p_high_priority;
+			task_mutex.unlock();
+			return id;
+		}
+	}
+
 	_post_tasks_and_unlock(&task, 1, p_high_priority);
 
 	return id;
@@ -346,6 +454,14 @@ WorkerThreadPool::TaskID WorkerThreadPool::add_task(const Callable &p_action, bo
 	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description);
 }
 
+WorkerThreadPool::TaskID WorkerThreadPool::add_native_task_with_dependencies(void (*p_func)(void *), void *p_userdata, const Vector<TaskID> &p_dependencies, bool p_high_priority, const String &p_description) {
+	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description, p_dependencies);
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::add_task_with_dependencies(const Callable &p_action, const Vector<TaskID> &p_dependencies, bool p_high_priority, const String &p_description) {
+	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description, p_dependencies);
+}
+
 bool WorkerThreadPool::is_task_completed(TaskID p_task_id) const {
 	MutexLock task_lock(task_mutex);
 	const Task *const *taskp = tasks.getptr(p_task_id);
@@ -462,7 +578,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				if (!exit_threads && was_signaled) {
 					// This thread was awaken for some additional reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
-					uint32_t to_process = task_queue.first() ? 1 : 0;
+					uint32_t to_process = task_queue.first() || !p_caller_pool_thread->work_queue.is_empty() ? 1 : 0;
 					uint32_t to_promote = p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
 					if (to_process || to_promote) {
 						// This thread must be left alone since it won't loop again.
@@ -481,12 +597,13 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 					}
 				}
 
-				if (singleton->task_queue.first()) {
+				task_to_process = _try_pop_local_task(p_caller_pool_thread);
+				if (!task_to_process && singleton->task_queue.first()) {
 					task_to_process = task_queue.first()->self();
 					task_queue.remove(task_queue.first());
 				}
 
-				if (!task_to_process) {
+				if (!task_to_process && !_has_local_tasks()) {
 					p_caller_pool_thread->awaited_task = p_task;
 
 					_unlock_unlockable_mutexes();
@@ -542,7 +659,7 @@ void WorkerThreadPool::notify_yield_over(TaskID p_task_id) {
 	td.cond_var.notify_one();
 }
 
-WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies) {
 	ERR_FAIL_COND_V_MSG(threads.is_empty(), INVALID_TASK_ID, "Can't add a group task because the WorkerThreadPool is either not initialized yet or already terminated.");
 	ERR_FAIL_COND_V(p_elements < 0, INVALID_TASK_ID);
 	if (p_tasks < 0) {
@@ -555,11 +672,19 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 	group->max = p_elements;
 	group->self = id;
 
+	if (!p_dependencies.is_empty()) {
+		Dependent dependent;
+		dependent.group = group;
+		group->pending_dependencies = _add_dependencies(p_dependencies, dependent);
+	}
+
 	Task **tasks_posted = nullptr;
 	if (p_elements == 0) {
 		// Should really not call it with zero Elements, but at least it should work.
-		group->completed.set_to(true);
-		group->done_semaphore.post();
+		if (group->pending_dependencies == 0) {
+			group->completed.set_to(true);
+			group->done_semaphore.post();
+		}
 		group->tasks_used = 0;
 		p_tasks = 0;
 		if (p_template_userdata) {
@@ -584,6 +709,16 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 
 	groups[id] = group;
 
+	if (group->pending_dependencies > 0) {
+		// Posted by the last dependency to complete.
+		for (int i = 0; i < p_tasks; i++) {
+			tasks_posted[i]->low_priority = !p_high_priority;
+			group->pending_tasks.push_back(tasks_posted[i]);
+		}
+		task_mutex.unlock();
+		return id;
+	}
+
 	_post_tasks_and_unlock(tasks_posted, p_tasks, p_high_priority);
 
 	return id;
@@ -597,6 +732,14 @@ WorkerThreadPool::GroupID WorkerThreadPool::add_group_task(const Callable &p_act
 	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description);
 }
 
+WorkerThreadPool::GroupID WorkerThreadPool::add_native_group_task_with_dependencies(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, const Vector<TaskID> &p_dependencies, int p_tasks, bool p_high_priority, const String &p_description) {
+	return _add_group_task(Callable(), p_func, p_userdata, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
+}
+
+WorkerThreadPool::GroupID WorkerThreadPool::add_group_task_with_dependencies(const Callable &p_action, int p_elements, const Vector<TaskID> &p_dependencies, int p_tasks, bool p_high_priority, const String &p_description) {
+	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
+}
+
 uint32_t WorkerThreadPool::get_group_processed_element_count(GroupID p_group) const {
 	MutexLock task_lock(task_mutex);
 	const Group *const *groupp = groups.getptr(p_group);
@@ -741,10 +884,12 @@ void WorkerThreadPool::finish() {
 
 void WorkerThreadPool::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("add_task", "action", "high_priority", "description"), &WorkerThreadPool::add_task, DEFVAL(false), DEFVAL(String()));
+	ClassDB::bind_method(D_METHOD("add_task_with_dependencies", "action", "dependencies", "high_priority", "description"), &WorkerThreadPool::add_task_with_dependencies, DEFVAL(false), DEFVAL(String()));
 	ClassDB::bind_method(D_METHOD("is_task_completed", "task_id"), &WorkerThreadPool::is_task_completed);
 	ClassDB::bind_method(D_METHOD("wait_for_task_completion", "task_id"), &WorkerThreadPool::wait_for_task_completion);
 
 	ClassDB::bind_method(D_METHOD("add_group_task", "action", "elements", "tasks_needed", "high_priority", "description"), &WorkerThreadPool::add_group_task, DEFVAL(-1), DEFVAL(false), DEFVAL(String()));
+	ClassDB::bind_method(D_METHOD("add_group_task_with_dependencies", "action", "elements", "dependencies", "tasks_needed", "high_priority", "description"), &WorkerThreadPool::add_group_task_with_dependencies, DEFVAL(-1), DEFVAL(false), DEFVAL(String()));
 	ClassDB::bind_method(D_METHOD("is_group_task_completed", "group_id"), &WorkerThreadPool::is_group_task_completed);
 	ClassDB::bind_method(D_METHOD("get_group_processed_element_count", "group_id"), &WorkerThreadPool::get_group_processed_element_count);
 	ClassDB::bind_method(D_METHOD("wait_for_group_task_completion", "group_id"), &WorkerThreadPool::wait_for_group_task_completion);
@@ -31,6 +31,7 @@
 #include "memory.h"
 
 #include "core/error/error_macros.h"
+#include "core/os/small_object_allocator.h"
 #include "core/templates/safe_refcount.h"
 
 #include <stdio.h>
@@ -99,13 +100,18 @@ void Memory::free_aligned_static(void *p_memory) {
 }
 
 void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(SMALL_OBJECT_ALLOCATOR_ENABLED)
+	// The small object allocator needs the size stored in the header to free the block.
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
 #endif
 
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+	void *mem = SmallObjectAllocator::is_small(p_bytes + DATA_OFFSET) ? SmallObjectAllocator::alloc(p_bytes + DATA_OFFSET) : malloc(p_bytes + DATA_OFFSET);
+#else
 	void *mem = malloc(p_bytes + (prepad ? DATA_OFFSET : 0));
+#endif
 
 	ERR_FAIL_NULL_V(mem, nullptr);
 
@@ -134,7 +140,7 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 
 	uint8_t *mem = (uint8_t *)p_memory;
 
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(SMALL_OBJECT_ALLOCATOR_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
@@ -153,6 +159,39 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 		}
 #endif
 
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+		if (SmallObjectAllocator::is_small(*s + DATA_OFFSET)) {
+			if (p_bytes == 0) {
+				SmallObjectAllocator::free(mem, *s + DATA_OFFSET);
+				return nullptr;
+			}
+			if (SmallObjectAllocator::is_same_class(*s + DATA_OFFSET, p_bytes + DATA_OFFSET)) {
+				*s = p_bytes;
+				return mem + DATA_OFFSET;
+			}
+
+			// Move to a block of another size class, or to the system allocator.
+			uint8_t *new_mem = (uint8_t *)(SmallObjectAllocator::is_small(p_bytes + DATA_OFFSET) ? SmallObjectAllocator::alloc(p_bytes + DATA_OFFSET) : malloc(p_bytes + DATA_OFFSET));
+			ERR_FAIL_NULL_V(new_mem, nullptr);
+			memcpy(new_mem, mem, MIN(*s, p_bytes) + DATA_OFFSET);
+			SmallObjectAllocator::free(mem, *s + DATA_OFFSET);
+
+			s = (uint64_t *)(new_mem + SIZE_OFFSET);
+			*s = p_bytes;
+			return new_mem + DATA_OFFSET;
+		} else if (SmallObjectAllocator::is_small(p_bytes + DATA_OFFSET) && p_bytes > 0) {
+			// Shrinking into the small object range, move out of the system allocator.
+			uint8_t *new_mem = (uint8_t *)SmallObjectAllocator::alloc(p_bytes + DATA_OFFSET);
+			ERR_FAIL_NULL_V(new_mem, nullptr);
+			memcpy(new_mem, mem, p_bytes + DATA_OFFSET);
+			free(mem);
+
+			s = (uint64_t *)(new_mem + SIZE_OFFSET);
+			*s = p_bytes;
+			return new_mem + DATA_OFFSET;
+		}
+#endif
+
 		if (p_bytes == 0) {
 			free(mem);
 			return nullptr;
@@ -182,7 +221,7 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 
 	uint8_t *mem = (uint8_t *)p_ptr;
 
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(SMALL_OBJECT_ALLOCATOR_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
@@ -193,11 +232,19 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 	if (prepad) {
 		mem -= DATA_OFFSET;
 
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(SMALL_OBJECT_ALLOCATOR_ENABLED)
 		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
+#endif
+#ifdef DEBUG_ENABLED
 		mem_usage.sub(*s);
 #endif
 
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+		if (SmallObjectAllocator::is_small(*s + DATA_OFFSET)) {
+			SmallObjectAllocator::free(mem, *s + DATA_OFFSET);
+			return;
+		}
+#endif
 		free(mem);
 	} else {
 		free(mem);
@@ -216,6 +263,14 @@ uint64_t Memory::get_mem_usage() {
 #endif
 }
 
+uint64_t Memory::get_small_object_reserved() {
+	return SmallObjectAllocator::get_reserved_bytes();
+}
+
+uint64_t Memory::get_small_object_used() {
+	return SmallObjectAllocator::get_used_bytes();
+}
+
 uint64_t Memory::get_mem_max_usage() {
 #ifdef DEBUG_ENABLED
 	return max_usage.get();
@@ -89,6 +89,9 @@ public:
 	static uint64_t get_mem_available();
 	static uint64_t get_mem_usage();
 	static uint64_t get_mem_max_usage();
+	// Statistics of the small object allocator, zero when it's not built in.
+	static uint64_t get_small_object_reserved();
+	static uint64_t get_small_object_used();
 };
 
 class DefaultAllocator {
@@ -0,0 +1,219 @@
+/**************************************************************************/
+/*  small_object_allocator.cpp                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "small_object_allocator.h"
+
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+
+#include "core/error/error_macros.h"
+#include "core/os/spin_lock.h"
+
+#include <stdlib.h>
+#include <atomic>
+
+// Everything below is constant-initialized, allocations can happen before
+// any static constructor runs.
+
+namespace {
+
+struct CentralList {
+	SpinLock lock;
+	void *head = nullptr;
+	uint32_t count = 0;
+};
+
+CentralList central[SmallObjectAllocator::CLASS_COUNT];
+std::atomic<uint64_t> reserved_bytes = { 0 };
+std::atomic<uint64_t> used_bytes = { 0 };
+
+} // namespace
+
+struct SmallObjectAllocator::ThreadCache {
+	Block *heads[CLASS_COUNT] = {};
+	uint32_t counts[CLASS_COUNT] = {};
+	// Cleared when the thread exits, late frees from other thread-local destructors go to the central lists.
+	bool active = true;
+
+	~ThreadCache() {
+		active = false;
+		for (uint32_t i = 0; i < CLASS_COUNT; i++) {
+			if (!heads[i]) {
+				continue;
+			}
+			Block *last = heads[i];
+			while (last->next) {
+				last = last->next;
+			}
+			_give_to_central(i, heads[i], last, counts[i]);
+			heads[i] = nullptr;
+			counts[i] = 0;
+		}
+	}
+};
+
+thread_local SmallObjectAllocator::ThreadCache SmallObjectAllocator::thread_cache;
+
+uint32_t SmallObjectAllocator::_get_batch_size(uint32_t p_class) {
+	// Move about 4 KiB at once, within reasonable bounds for the smallest and largest classes.
+	size_t batch = 4096 / _get_class_size(p_class);
+	return CLAMP(batch, 8u, 64u);
+}
+
+SmallObjectAllocator::Block *SmallObjectAllocator::_take_from_central(uint32_t p_class, uint32_t p_max, uint32_t &r_count) {
+	CentralList &list = central[p_class];
+	size_t size = _get_class_size(p_class);
+
+	list.lock.lock();
+
+	if (!list.head) {
+		// Carve a new span, aligned to the granularity so every block is aligned for max_align_t.
+		uint8_t *memory = (uint8_t *)malloc(SPAN_SIZE + GRANULARITY);
+		if (!memory) {
+			list.lock.unlock();
+			r_count = 0;
+			return nullptr;
+		}
+		uint8_t *span = (uint8_t *)(((uintptr_t)memory + GRANULARITY - 1) & ~(uintptr_t)(GRANULARITY - 1));
+		uint32_t block_count = SPAN_SIZE / size;
+		for (uint32_t i = 0; i < block_count; i++) {
+			Block *block = (Block *)(span + i * size);
+			block->next = i + 1 < block_count ? (Block *)(span + (i + 1) * size) : nullptr;
+		}
+		list.head = span;
+		list.count = block_count;
+		reserved_bytes.fetch_add(SPAN_SIZE + GRANULARITY, std::memory_order_relaxed);
+	}
+
+	Block *first = (Block *)list.head;
+	Block *last = first;
+	uint32_t count = 1;
+	while (count < p_max && last->next) {
+		last = last->next;
+		count++;
+	}
+	list.head = last->next;
+	list.count -= count;
+	last->next = nullptr;
+
+	list.lock.unlock();
+
+	used_bytes.fetch_add(count * size, std::memory_order_relaxed);
+	r_count = count;
+	return first;
+}
+
+void SmallObjectAllocator::_give_to_central(uint32_t p_class, Block *p_first, Block *p_last, uint32_t p_count) {
+	CentralList &list = central[p_class];
+
+	list.lock.lock();
+	p_last->next = (Block *)list.head;
+	list.head = p_first;
+	list.count += p_count;
+	list.lock.unlock();
+
+	used_bytes.fetch_sub(p_count * _get_class_size(p_class), std::memory_order_relaxed);
+}
+
+void *SmallObjectAllocator::alloc(size_t p_bytes) {
+	DEV_ASSERT(is_small(p_bytes));
+
+	uint32_t c = _get_class(p_bytes);
+	ThreadCache &cache = thread_cache;
+
+	if (unlikely(!cache.active)) {
+		uint32_t count;
+		return _take_from_central(c, 1, count);
+	}
+
+	Block *block = cache.heads[c];
+	if (unlikely(!block)) {
+		uint32_t count;
+		block = _take_from_central(c, _get_batch_size(c), count);
+		if (!block) {
+			return nullptr;
+		}
+		cache.counts[c] = count;
+	}
+
+	cache.heads[c] = block->next;
+	cache.counts[c]--;
+	return block;
+}
+
+void SmallObjectAllocator::free(void *p_ptr, size_t p_bytes) {
+	DEV_ASSERT(is_small(p_bytes));
+
+	uint32_t c = _get_class(p_bytes);
+	ThreadCache &cache = thread_cache;
+	Block *block = (Block *)p_ptr;
+
+	if (unlikely(!cache.active)) {
+		block->next = nullptr;
+		_give_to_central(c, block, block, 1);
+		return;
+	}
+
+	block->next = cache.heads[c];
+	cache.heads[c] = block;
+	cache.counts[c]++;
+
+	uint32_t batch = _get_batch_size(c);
+	if (unlikely(cache.counts[c] > batch * 2)) {
+		// Give a batch back, so memory freed by one thread can be reused by the others.
+		Block *first = cache.heads[c];
+		Block *last = first;
+		for (uint32_t i = 1; i < batch; i++) {
+			last = last->next;
+		}
+		cache.heads[c] = last->next;
+		cache.counts[c] -= batch;
+		_give_to_central(c, first, last, batch);
+	}
+}
+
+uint64_t SmallObjectAllocator::get_reserved_bytes() {
+	return reserved_bytes.load(std::memory_order_relaxed);
+}
+
+uint64_t SmallObjectAllocator::get_used_bytes() {
+	return used_bytes.load(std::memory_order_relaxed);
+}
+
+#else
+
+uint64_t SmallObjectAllocator::get_reserved_bytes() {
+	return 0;
+}
+
+uint64_t SmallObjectAllocator::get_used_bytes() {
+	return 0;
+}
+
+#endif // SMALL_OBJECT_ALLOCATOR_ENABLED
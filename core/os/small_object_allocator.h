@@ -0,0 +1,88 @@
+/**************************************************************************/
+/*  small_object_allocator.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef SMALL_OBJECT_ALLOCATOR_H
+#define SMALL_OBJECT_ALLOCATOR_H
+
+#include "core/typedefs.h"
+
+#include <stddef.h>
+
+// Size-class allocator backing Memory::alloc_static() for small blocks when
+// built with small_object_allocator=yes.
+//
+// Blocks of each size class are carved from spans and kept in per-thread free
+// lists, so most allocations and frees don't take any lock. Threads exchange
+// blocks with a central list per size class in batches. Spans are never given
+// back to the system, since segregating blocks by size keeps them reusable.
+class SmallObjectAllocator {
+public:
+	static constexpr size_t GRANULARITY = 16;
+	static constexpr size_t MAX_SIZE = 512;
+	static constexpr uint32_t CLASS_COUNT = MAX_SIZE / GRANULARITY;
+	static constexpr size_t SPAN_SIZE = 64 * 1024;
+
+private:
+	struct Block {
+		Block *next;
+	};
+
+	struct ThreadCache;
+	static thread_local ThreadCache thread_cache;
+
+	_FORCE_INLINE_ static uint32_t _get_class(size_t p_bytes) {
+		return p_bytes ? uint32_t((p_bytes - 1) / GRANULARITY) : 0;
+	}
+	_FORCE_INLINE_ static size_t _get_class_size(uint32_t p_class) {
+		return (p_class + 1) * GRANULARITY;
+	}
+	static uint32_t _get_batch_size(uint32_t p_class);
+
+	static Block *_take_from_central(uint32_t p_class, uint32_t p_max, uint32_t &r_count);
+	static void _give_to_central(uint32_t p_class, Block *p_first, Block *p_last, uint32_t p_count);
+
+public:
+	_FORCE_INLINE_ static bool is_small(size_t p_bytes) { return p_bytes <= MAX_SIZE; }
+
+	// p_bytes must be at most MAX_SIZE, and the same size must be passed to free().
+	static void *alloc(size_t p_bytes);
+	static void free(void *p_ptr, size_t p_bytes);
+	// True if memory allocated with p_old_bytes can be kept when resized to p_new_bytes.
+	_FORCE_INLINE_ static bool is_same_class(size_t p_old_bytes, size_t p_new_bytes) {
+		return is_small(p_new_bytes) && _get_class(p_old_bytes) == _get_class(p_new_bytes);
+	}
+
+	// Bytes reserved in spans.
+	static uint64_t get_reserved_bytes();
+	// Bytes handed to threads, in use or cached by a thread for reuse.
+	static uint64_t get_used_bytes();
+};
+
+#endif // SMALL_OBJECT_ALLOCATOR_H
@@ -47,6 +47,7 @@
 #include "core/io/dtls_server.h"
 #include "core/io/http_client.h"
 #include "core/io/image_loader.h"
+#include "core/io/io_scheduler.h"
 #include "core/io/json.h"
 #include "core/io/marshalls.h"
 #include "core/io/missing_resource.h"
@@ -115,6 +116,7 @@ extern void register_global_constants();
 extern void unregister_global_constants();
 
 static ResourceUID *resource_uid = nullptr;
+static IOScheduler *io_scheduler = nullptr;
 
 static bool _is_core_extensions_registered = false;
 
@@ -272,6 +274,7 @@ void register_core_types() {
 	GDREGISTER_CLASS(EngineProfiler);
 
 	resource_uid = memnew(ResourceUID);
+	io_scheduler = memnew(IOScheduler);
 
 	gdextension_manager = memnew(GDExtensionManager);
 
@@ -306,6 +309,7 @@ void register_core_settings() {
 
 	GLOBAL_DEF("threading/worker_pool/max_threads", -1);
 	GLOBAL_DEF("threading/worker_pool/low_priority_thread_ratio", 0.3);
+	GLOBAL_DEF("threading/resource_loader/prefetch_files", false);
 }
 
 void register_core_singletons() {
@@ -391,6 +395,7 @@ void unregister_core_types() {
 
 	memdelete(gdextension_manager);
 
+	memdelete(io_scheduler);
 	memdelete(resource_uid);
 
 	if (ip) {
@@ -48,7 +48,10 @@ class StringName {
 	enum {
 		STRING_TABLE_BITS = 16,
 		STRING_TABLE_LEN = 1 << STRING_TABLE_BITS,
-		STRING_TABLE_MASK = STRING_TABLE_LEN - 1
+		STRING_TABLE_MASK = STRING_TABLE_LEN - 1,
+		STRING_TABLE_LOCK_BITS = 7,
+		STRING_TABLE_LOCK_LEN = 1 << STRING_TABLE_LOCK_BITS,
+		STRING_TABLE_LOCK_MASK = STRING_TABLE_LOCK_LEN - 1
 	};
 
 	struct _Data {
@@ -74,6 +77,18 @@ class StringName {
 
 	static inline _Data *_table[STRING_TABLE_LEN];
 
+	// Each lock protects the table slots sharing the same low index bits, so threads
+	// interning or releasing different names rarely contend. Padded to a cache line
+	// to avoid false sharing between neighboring locks.
+	struct alignas(64) _TableLock {
+		BinaryMutex mutex;
+	};
+	static inline _TableLock _table_locks[STRING_TABLE_LOCK_LEN];
+
+	static _FORCE_INLINE_ const BinaryMutex &_get_table_lock(uint32_t p_idx) {
+		return _table_locks[p_idx & STRING_TABLE_LOCK_MASK].mutex;
+	}
+
 	_Data *_data = nullptr;
 
 	void unref();
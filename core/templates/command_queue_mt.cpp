@@ -30,12 +30,176 @@
 
 #include "command_queue_mt.h"
 
-#include "core/config/project_settings.h"
-#include "core/os/os.h"
+thread_local CommandQueueMT::ProducerCacheEntry CommandQueueMT::producer_cache[CommandQueueMT::PRODUCER_CACHE_SIZE];
+thread_local CommandQueueMT::ThreadProducers CommandQueueMT::thread_owned_producers;
+SafeNumeric<uint64_t> CommandQueueMT::last_queue_id;
+
+CommandQueueMT::ThreadProducers::~ThreadProducers() {
+	for (ProducerCacheEntry &entry : producer_cache) {
+		entry = ProducerCacheEntry();
+	}
+	for (Producer *producer : producers) {
+		producer->thread_exited.set();
+		if (producer->refcount.unref()) {
+			// The queue is gone already.
+			memdelete(producer);
+		}
+	}
+}
+
+CommandQueueMT::Producer *CommandQueueMT::_get_producer_slow() {
+	Producer *producer = nullptr;
+	{
+		MutexLock lock(producers_mutex);
+		Thread::ID thread_id = Thread::get_caller_id();
+		HashMap<Thread::ID, Producer *>::Iterator E = thread_producers.find(thread_id);
+		if (E) {
+			producer = E->value;
+		} else {
+			if (!free_producers.is_empty()) {
+				producer = free_producers[free_producers.size() - 1];
+				free_producers.remove_at(free_producers.size() - 1);
+				producer->thread_exited.clear();
+			} else {
+				producer = memnew(Producer);
+				producer->command_mem[0].reserve(DEFAULT_PRODUCER_MEM_SIZE_KB * 1024);
+				producer->command_mem[1].reserve(DEFAULT_PRODUCER_MEM_SIZE_KB * 1024);
+			}
+			producer->thread_id = thread_id;
+			producer->refcount.init(2);
+			producers.push_back(producer);
+			thread_producers.insert(thread_id, producer);
+			thread_owned_producers.producers.push_back(producer);
+		}
+	}
+
+	ProducerCacheEntry &entry = producer_cache[queue_id % PRODUCER_CACHE_SIZE];
+	entry.queue_id = queue_id;
+	entry.producer = producer;
+	return producer;
+}
+
+bool CommandQueueMT::_collect_commands() {
+	pending.clear();
+
+	bool collected = false;
+	flush_producers.clear();
+
+	MutexLock lock(producers_mutex);
+	for (uint32_t i = 0; i < producers.size();) {
+		Producer *producer = producers[i];
+		MutexLock producer_lock(producer->mutex);
+		LocalVector<uint8_t> &write_mem = producer->get_write_mem();
+		LocalVector<uint8_t> &flush_mem = producer->get_flush_mem();
+		if (!write_mem.is_empty()) {
+			collected = true;
+			if (producer->flush_read_ptr == flush_mem.size()) {
+				// Everything was read already, swap the buffers.
+				flush_mem.clear();
+				producer->flush_read_ptr = 0;
+				producer->write_index ^= 1;
+			} else {
+				// Commands are relocated bitwise, just like when the buffer grows.
+				uint64_t size = flush_mem.size();
+				flush_mem.resize(size + write_mem.size());
+				memcpy(&flush_mem[size], write_mem.ptr(), write_mem.size());
+				write_mem.clear();
+			}
+		}
+		if (producer->flush_read_ptr < producer->get_flush_mem().size()) {
+			flush_producers.push_back(producer);
+		} else if (producer->thread_exited.is_set() && producer->get_write_mem().is_empty()) {
+			// The thread exited and all of its commands ran, keep the buffers for another thread.
+			producer->get_flush_mem().clear();
+			producer->flush_read_ptr = 0;
+			thread_producers.erase(producer->thread_id);
+			producers.remove_at_unordered(i);
+			free_producers.push_back(producer);
+			continue;
+		}
+		i++;
+	}
+
+	return collected;
+}
+
+void CommandQueueMT::_flush() {
+	if (unlikely(flushing.is_set())) {
+		// Re-entrant call.
+		return;
+	}
+
+	MutexLock flush_lock(flush_mutex);
+	flushing.set();
+
+	_collect_commands();
+
+	while (true) {
+		// Find the command pushed first among the producers.
+		Producer *next = nullptr;
+		uint64_t next_sequence = UINT64_MAX;
+		for (Producer *producer : flush_producers) {
+			LocalVector<uint8_t> &flush_mem = producer->get_flush_mem();
+			if (producer->flush_read_ptr < flush_mem.size()) {
+				const CommandHeader *header = reinterpret_cast<const CommandHeader *>(&flush_mem[producer->flush_read_ptr]);
+				if (header->sequence < next_sequence) {
+					next_sequence = header->sequence;
+					next = producer;
+				}
+			}
+		}
+
+		if (next == nullptr || next_sequence != flush_sequence) {
+			// Either all collected commands ran, or a command pushed earlier by another thread
+			// was written after its buffer got collected. Collect again to pick it up.
+			if (_collect_commands()) {
+				continue;
+			}
+			if (next == nullptr) {
+				break;
+			}
+			// Should not happen, sequence numbers are taken with the producer lock held.
+			ERR_PRINT(vformat("Command queue sequence mismatch, expected %d, found %d.", flush_sequence, next_sequence));
+			flush_sequence = next_sequence;
+		}
+
+		LocalVector<uint8_t> &flush_mem = next->get_flush_mem();
+		uint64_t size = reinterpret_cast<const CommandHeader *>(&flush_mem[next->flush_read_ptr])->size;
+		next->flush_read_ptr += sizeof(CommandHeader);
+
+		// The flush buffer is only touched by this thread, so it can't move while the command runs.
+		CommandBase *cmd = reinterpret_cast<CommandBase *>(&flush_mem[next->flush_read_ptr]);
+		cmd->call();
+
+		if (unlikely(cmd->sync)) {
+			SyncCommand *sync_cmd = static_cast<SyncCommand *>(cmd);
+			{
+				MutexLock sync_lock(sync_mutex);
+				*sync_cmd->done = true;
+			}
+			sync_cond_var.notify_all();
+		}
+
+		cmd->~CommandBase();
+
+		next->flush_read_ptr += size;
+		flush_sequence++;
+	}
+
+	flushing.clear();
+}
 
 CommandQueueMT::CommandQueueMT() {
-	command_mem.reserve(DEFAULT_COMMAND_MEM_SIZE_KB * 1024);
+	queue_id = last_queue_id.increment();
 }
 
 CommandQueueMT::~CommandQueueMT() {
+	for (Producer *producer : producers) {
+		if (producer->refcount.unref()) {
+			memdelete(producer);
+		}
+	}
+	for (Producer *producer : free_producers) {
+		memdelete(producer);
+	}
 }
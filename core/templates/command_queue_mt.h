@@ -36,7 +36,9 @@
 #include "core/os/memory.h"
 #include "core/os/mutex.h"
 #include "core/string/print_string.h"
+#include "core/templates/hash_map.h"
 #include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/simple_type.h"
 #include "core/typedefs.h"
 
@@ -248,17 +250,18 @@
 #define CMD_TYPE(N) Command##N<T, M COMMA(N) COMMA_SEP_LIST(TYPE_ARG, N)>
 #define CMD_ASSIGN_PARAM(N) cmd->p##N = p##N
 
-#define DECL_PUSH(N)                                                            \
-	template <typename T, typename M COMMA(N) COMMA_SEP_LIST(TYPE_PARAM, N)>    \
-	void push(T *p_instance, M p_method COMMA(N) COMMA_SEP_LIST(PARAM, N)) {    \
-		MutexLock mlock(mutex);                                                 \
-		CMD_TYPE(N) *cmd = allocate<CMD_TYPE(N)>();                             \
-		cmd->instance = p_instance;                                             \
-		cmd->method = p_method;                                                 \
-		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                    \
-		if (pump_task_id != WorkerThreadPool::INVALID_TASK_ID) {                \
-			WorkerThreadPool::get_singleton()->notify_yield_over(pump_task_id); \
-		}                                                                       \
+#define DECL_PUSH(N)                                                         \
+	template <typename T, typename M COMMA(N) COMMA_SEP_LIST(TYPE_PARAM, N)> \
+	void push(T *p_instance, M p_method COMMA(N) COMMA_SEP_LIST(PARAM, N)) { \
+		Producer *producer = _get_producer();                                \
+		{                                                                    \
+			MutexLock mlock(producer->mutex);                                \
+			CMD_TYPE(N) *cmd = _allocate<CMD_TYPE(N)>(producer);             \
+			cmd->instance = p_instance;                                      \
+			cmd->method = p_method;                                          \
+			SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                             \
+		}                                                                    \
+		_notify_pushed();                                                    \
 	}
 
 #define CMD_RET_TYPE(N) CommandRet##N<T, M, COMMA_SEP_LIST(TYPE_ARG, N) COMMA(N) R>
@@ -266,17 +269,19 @@
 #define DECL_PUSH_AND_RET(N)                                                                   \
 	template <typename T, typename M, COMMA_SEP_LIST(TYPE_PARAM, N) COMMA(N) typename R>       \
 	void push_and_ret(T *p_instance, M p_method, COMMA_SEP_LIST(PARAM, N) COMMA(N) R *r_ret) { \
-		MutexLock mlock(mutex);                                                                \
-		CMD_RET_TYPE(N) *cmd = allocate<CMD_RET_TYPE(N)>();                                    \
-		cmd->instance = p_instance;                                                            \
-		cmd->method = p_method;                                                                \
-		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                                   \
-		cmd->ret = r_ret;                                                                      \
-		if (pump_task_id != WorkerThreadPool::INVALID_TASK_ID) {                               \
-			WorkerThreadPool::get_singleton()->notify_yield_over(pump_task_id);                \
+		Producer *producer = _get_producer();                                                  \
+		bool done = false;                                                                     \
+		{                                                                                      \
+			MutexLock mlock(producer->mutex);                                                  \
+			CMD_RET_TYPE(N) *cmd = _allocate<CMD_RET_TYPE(N)>(producer);                       \
+			cmd->instance = p_instance;                                                        \
+			cmd->method = p_method;                                                            \
+			SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                               \
+			cmd->ret = r_ret;                                                                  \
+			cmd->done = &done;                                                                 \
 		}                                                                                      \
-		sync_tail++;                                                                           \
-		_wait_for_sync(mlock);                                                                 \
+		_notify_pushed();                                                                      \
+		_wait_for_sync(done);                                                                  \
 	}
 
 #define CMD_SYNC_TYPE(N) CommandSync##N<T, M COMMA(N) COMMA_SEP_LIST(TYPE_ARG, N)>
@@ -284,20 +289,27 @@
 #define DECL_PUSH_AND_SYNC(N)                                                         \
 	template <typename T, typename M COMMA(N) COMMA_SEP_LIST(TYPE_PARAM, N)>          \
 	void push_and_sync(T *p_instance, M p_method COMMA(N) COMMA_SEP_LIST(PARAM, N)) { \
-		MutexLock mlock(mutex);                                                       \
-		CMD_SYNC_TYPE(N) *cmd = allocate<CMD_SYNC_TYPE(N)>();                         \
-		cmd->instance = p_instance;                                                   \
-		cmd->method = p_method;                                                       \
-		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                          \
-		if (pump_task_id != WorkerThreadPool::INVALID_TASK_ID) {                      \
-			WorkerThreadPool::get_singleton()->notify_yield_over(pump_task_id);       \
+		Producer *producer = _get_producer();                                         \
+		bool done = false;                                                            \
+		{                                                                             \
+			MutexLock mlock(producer->mutex);                                         \
+			CMD_SYNC_TYPE(N) *cmd = _allocate<CMD_SYNC_TYPE(N)>(producer);            \
+			cmd->instance = p_instance;                                               \
+			cmd->method = p_method;                                                   \
+			SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                      \
+			cmd->done = &done;                                                        \
 		}                                                                             \
-		sync_tail++;                                                                  \
-		_wait_for_sync(mlock);                                                        \
+		_notify_pushed();                                                             \
+		_wait_for_sync(done);                                                         \
 	}
 
 #define MAX_CMD_PARAMS 15
 
+// Each producer thread writes its commands to its own buffer, so pushing
+// from several threads only contends on a sequence counter. Every command
+// is stamped with a global sequence number when pushed, and flushing merges
+// the producer buffers back in that order, so commands still run in the
+// order they were pushed, across all threads.
 class CommandQueueMT {
 	struct CommandBase {
 		bool sync = false;
@@ -306,6 +318,8 @@ class CommandQueueMT {
 	};
 
 	struct SyncCommand : public CommandBase {
+		bool *done = nullptr;
+
 		virtual void call() override {}
 		SyncCommand() {
 			sync = true;
@@ -325,86 +339,109 @@ class CommandQueueMT {
 
 	/***** BASE *******/
 
-	static const uint32_t DEFAULT_COMMAND_MEM_SIZE_KB = 64;
+	static const uint32_t DEFAULT_PRODUCER_MEM_SIZE_KB = 16;
 
-	BinaryMutex mutex;
-	LocalVector<uint8_t> command_mem;
-	ConditionVariable sync_cond_var;
-	uint32_t sync_head = 0;
-	uint32_t sync_tail = 0;
-	uint32_t sync_awaiters = 0;
-	WorkerThreadPool::TaskID pump_task_id = WorkerThreadPool::INVALID_TASK_ID;
-	uint64_t flush_read_ptr = 0;
-
-	template <typename T>
-	T *allocate() {
-		// alloc size is size+T+safeguard
-		uint32_t alloc_size = ((sizeof(T) + 8 - 1) & ~(8 - 1));
-		uint64_t size = command_mem.size();
-		command_mem.resize(size + alloc_size + 8);
-		*(uint64_t *)&command_mem[size] = alloc_size;
-		T *cmd = memnew_placement(&command_mem[size + 8], T);
-		return cmd;
-	}
+	struct CommandHeader {
+		uint64_t sequence = 0;
+		uint64_t size = 0;
+	};
 
-	_FORCE_INLINE_ void _prevent_sync_wraparound() {
-		bool safe_to_reset = !sync_awaiters;
-		bool already_sync_to_latest = sync_head == sync_tail;
-		if (safe_to_reset && already_sync_to_latest) {
-			sync_head = 0;
-			sync_tail = 0;
-		}
-	}
+	struct Producer {
+		BinaryMutex mutex;
+		// The producer thread writes to one buffer while the flushing thread reads the other.
+		// Only the flushing thread swaps them, with the mutex held.
+		LocalVector<uint8_t> command_mem[2];
+		uint32_t write_index = 0;
+		uint64_t flush_read_ptr = 0;
+
+		Thread::ID thread_id = Thread::UNASSIGNED_ID;
+		// One reference is held by the queue, the other by the producer thread until it exits.
+		SafeRefCount refcount;
+		SafeFlag thread_exited;
+
+		_FORCE_INLINE_ LocalVector<uint8_t> &get_write_mem() { return command_mem[write_index]; }
+		_FORCE_INLINE_ LocalVector<uint8_t> &get_flush_mem() { return command_mem[write_index ^ 1]; }
+	};
 
-	void _flush() {
-		if (unlikely(flush_read_ptr)) {
-			// Re-entrant call.
-			return;
-		}
+	// Caches the producer of the calling thread for the last few queues it pushed to.
+	struct ProducerCacheEntry {
+		uint64_t queue_id = 0;
+		Producer *producer = nullptr;
+	};
+	static const uint32_t PRODUCER_CACHE_SIZE = 4;
+	static thread_local ProducerCacheEntry producer_cache[PRODUCER_CACHE_SIZE];
+	static SafeNumeric<uint64_t> last_queue_id;
+
+	// The producers of the calling thread for all queues, released when the thread exits.
+	struct ThreadProducers {
+		LocalVector<Producer *> producers;
+		~ThreadProducers();
+	};
+	static thread_local ThreadProducers thread_owned_producers;
 
-		MutexLock lock(mutex);
+	uint64_t queue_id = 0;
 
-		while (flush_read_ptr < command_mem.size()) {
-			uint64_t size = *(uint64_t *)&command_mem[flush_read_ptr];
-			flush_read_ptr += 8;
-			CommandBase *cmd = reinterpret_cast<CommandBase *>(&command_mem[flush_read_ptr]);
-			uint32_t allowance_id = WorkerThreadPool::thread_enter_unlock_allowance_zone(lock);
-			cmd->call();
-			WorkerThreadPool::thread_exit_unlock_allowance_zone(allowance_id);
+	BinaryMutex producers_mutex;
+	LocalVector<Producer *> producers;
+	HashMap<Thread::ID, Producer *> thread_producers;
+	// Producers retired after their thread exited, reused for new threads.
+	LocalVector<Producer *> free_producers;
 
-			// Handle potential realloc due to the command and unlock allowance.
-			cmd = reinterpret_cast<CommandBase *>(&command_mem[flush_read_ptr]);
+	SafeNumeric<uint64_t> push_sequence;
+	SafeFlag pending;
 
-			if (unlikely(cmd->sync)) {
-				sync_head++;
-				lock.~MutexLock(); // Give an opportunity to awaiters right away.
-				sync_cond_var.notify_all();
-				new (&lock) MutexLock(mutex);
-				// Handle potential realloc happened during unlock.
-				cmd = reinterpret_cast<CommandBase *>(&command_mem[flush_read_ptr]);
-			}
+	BinaryMutex flush_mutex;
+	SafeFlag flushing;
+	uint64_t flush_sequence = 0;
+	LocalVector<Producer *> flush_producers;
 
-			cmd->~CommandBase();
+	BinaryMutex sync_mutex;
+	ConditionVariable sync_cond_var;
+	SafeNumeric<WorkerThreadPool::TaskID> pump_task_id{ WorkerThreadPool::INVALID_TASK_ID };
 
-			flush_read_ptr += size;
+	_FORCE_INLINE_ Producer *_get_producer() {
+		const ProducerCacheEntry &entry = producer_cache[queue_id % PRODUCER_CACHE_SIZE];
+		if (likely(entry.queue_id == queue_id)) {
+			return entry.producer;
 		}
+		return _get_producer_slow();
+	}
+	Producer *_get_producer_slow();
 
-		command_mem.clear();
-		flush_read_ptr = 0;
+	template <typename T>
+	T *_allocate(Producer *p_producer) {
+		// alloc size is header+T, kept 8-byte aligned.
+		uint64_t alloc_size = ((sizeof(T) + 8 - 1) & ~(8 - 1));
+		LocalVector<uint8_t> &command_mem = p_producer->get_write_mem();
+		uint64_t size = command_mem.size();
+		command_mem.resize(size + sizeof(CommandHeader) + alloc_size);
+		CommandHeader *header = reinterpret_cast<CommandHeader *>(&command_mem[size]);
+		// Taken with the producer lock held, so that a flush which sees a later sequence number
+		// can always find this command by swapping the producer buffers again.
+		header->sequence = push_sequence.postincrement();
+		header->size = alloc_size;
+		T *cmd = memnew_placement(&command_mem[size + sizeof(CommandHeader)], T);
+		return cmd;
+	}
 
-		_prevent_sync_wraparound();
+	_FORCE_INLINE_ void _notify_pushed() {
+		pending.set();
+		WorkerThreadPool::TaskID pump = pump_task_id.get();
+		if (pump != WorkerThreadPool::INVALID_TASK_ID) {
+			WorkerThreadPool::get_singleton()->notify_yield_over(pump);
+		}
 	}
 
-	_FORCE_INLINE_ void _wait_for_sync(MutexLock<BinaryMutex> &p_lock) {
-		sync_awaiters++;
-		uint32_t sync_head_goal = sync_tail;
-		do {
-			sync_cond_var.wait(p_lock);
-		} while (sync_head < sync_head_goal);
-		sync_awaiters--;
-		_prevent_sync_wraparound();
+	_FORCE_INLINE_ void _wait_for_sync(const bool &p_done) {
+		MutexLock lock(sync_mutex);
+		while (!p_done) {
+			sync_cond_var.wait(lock);
+		}
 	}
 
+	bool _collect_commands();
+	void _flush();
+
 	void _no_op() {}
 
 public:
@@ -421,7 +458,7 @@ public:
 	SPACE_SEP_LIST(DECL_PUSH_AND_SYNC, 15)
 
 	_FORCE_INLINE_ void flush_if_pending() {
-		if (unlikely(command_mem.size() > 0)) {
+		if (unlikely(pending.is_set())) {
 			_flush();
 		}
 	}
@@ -435,14 +472,19 @@ public:
 	}
 
 	void wait_and_flush() {
-		ERR_FAIL_COND(pump_task_id == WorkerThreadPool::INVALID_TASK_ID);
-		WorkerThreadPool::get_singleton()->wait_for_task_completion(pump_task_id);
+		ERR_FAIL_COND(pump_task_id.get() == WorkerThreadPool::INVALID_TASK_ID);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(pump_task_id.get());
 		_flush();
 	}
 
 	void set_pump_task_id(WorkerThreadPool::TaskID p_task_id) {
-		MutexLock lock(mutex);
-		pump_task_id = p_task_id;
+		pump_task_id.set(p_task_id);
+	}
+
+	// Producers of exited threads are retired by the flush that empties them.
+	uint32_t get_producer_count() {
+		MutexLock lock(producers_mutex);
+		return producers.size();
 	}
 
 	CommandQueueMT();
@@ -37,6 +37,7 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -142,6 +143,12 @@ void FileAccessUnix::_close() {
 		return;
 	}
 
+	if (mapped_view) {
+		munmap(mapped_view, mapped_length);
+		mapped_view = nullptr;
+		mapped_length = 0;
+	}
+
 	fclose(f);
 	f = nullptr;
 
@@ -228,6 +235,29 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 }
 
+const uint8_t *FileAccessUnix::get_mapped_view() const {
+	if (mapped_view) {
+		return mapped_view;
+	}
+	if (!f || flags != READ) {
+		return nullptr;
+	}
+
+	uint64_t length = get_length();
+	if (length == 0 || length > (uint64_t)SIZE_MAX) {
+		return nullptr;
+	}
+
+	void *view = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fileno(f), 0);
+	if (view == MAP_FAILED) {
+		return nullptr;
+	}
+
+	mapped_view = (uint8_t *)view;
+	mapped_length = length;
+	return mapped_view;
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
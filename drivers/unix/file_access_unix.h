@@ -43,6 +43,8 @@ typedef void (*CloseNotificationFunc)(const String &p_file, int p_flags);
 class FileAccessUnix : public FileAccess {
 	FILE *f = nullptr;
 	int flags = 0;
+	mutable uint8_t *mapped_view = nullptr;
+	mutable uint64_t mapped_length = 0;
 	void check_errors() const;
 	mutable Error last_error = OK;
 	String save_path;
@@ -68,6 +70,7 @@ public:
 	virtual bool eof_reached() const override; ///< reading passed EOF
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_mapped_view() const override; ///< map the file in READ mode on first use
 
 	virtual Error get_error() const override; ///< get last error
 
@@ -205,7 +205,17 @@ Error EditorExportPlatform::_save_pack_file(void *p_userdata, const String &p_pa
 	}
 
 	// Store file content.
-	ftmp->store_buffer(p_data.ptr(), p_data.size());
+	Vector<uint8_t> compressed_data;
+	if (pd->compress) {
+		compressed_data = PackedData::compress_file(p_data.ptr(), p_data.size());
+	}
+	if (!compressed_data.is_empty()) {
+		sd.compressed = true;
+		sd.size = compressed_data.size();
+		ftmp->store_buffer(compressed_data.ptr(), compressed_data.size());
+	} else {
+		ftmp->store_buffer(p_data.ptr(), p_data.size());
+	}
 
 	if (fae.is_valid()) {
 		ftmp.unref();
@@ -1623,6 +1633,7 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 	pd.ep = &ep;
 	pd.f = ftmp;
 	pd.so_files = p_so_files;
+	pd.compress = GLOBAL_GET("editor/export/compress_pck_files");
 
 	Error err = export_project_files(p_preset, p_debug, _save_pack_file, &pd, _pack_add_shared_object);
 
@@ -1673,8 +1684,13 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 
 	int64_t pck_start_pos = f->get_position();
 
+	bool has_compressed_files = false;
+	for (const SavedData &sd : pd.file_ofs) {
+		has_compressed_files = has_compressed_files || sd.compressed;
+	}
+
 	f->store_32(PACK_HEADER_MAGIC);
-	f->store_32(PACK_FORMAT_VERSION);
+	f->store_32(has_compressed_files ? PACK_FORMAT_VERSION : PACK_FORMAT_VERSION_NO_COMPRESSION);
 	f->store_32(VERSION_MAJOR);
 	f->store_32(VERSION_MINOR);
 	f->store_32(VERSION_PATCH);
@@ -1764,6 +1780,9 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 		if (pd.file_ofs[i].encrypted) {
 			flags |= PACK_FILE_ENCRYPTED;
 		}
+		if (pd.file_ofs[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		fhead->store_32(flags);
 	}
 
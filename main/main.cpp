@@ -43,6 +43,7 @@
 #include "core/io/file_access_pack.h"
 #include "core/io/file_access_zip.h"
 #include "core/io/image_loader.h"
+#include "core/io/io_scheduler.h"
 #include "core/io/ip.h"
 #include "core/io/resource_loader.h"
 #include "core/object/message_queue.h"
@@ -90,6 +91,10 @@
 #include "tests/test_main.h"
 #endif
 
+#ifdef BENCHMARKS_ENABLED
+#include "benchmarks/benchmark_main.h"
+#endif
+
 #ifdef TOOLS_ENABLED
 #include "editor/debugger/debug_adapter/debug_adapter_server.h"
 #include "editor/debugger/editor_debugger_node.h"
@@ -601,6 +606,9 @@ void Main::print_help(const char *p_binary) {
 	print_help_option("-d, --debug", "Debug (local stdout debugger).\n");
 	print_help_option("-b, --breakpoints", "Breakpoint list as source::line comma-separated pairs, no spaces (use %%20 instead).\n");
 	print_help_option("--profiling", "Enable profiling in the script debugger.\n");
+#if defined(DEBUG_ENABLED) && defined(MODULE_GDSCRIPT_ENABLED)
+	print_help_option("--gdscript-sampling-profile <file>", "Sample the GDScript call stacks from a separate thread and write them to <file> in the collapsed stack format used by flame graph tools.\n", CLI_OPTION_AVAILABILITY_TEMPLATE_DEBUG);
+#endif
 	print_help_option("--gpu-profile", "Show a GPU profile of the tasks that took the most time during frame rendering.\n");
 	print_help_option("--gpu-validation", "Enable graphics API validation layers for debugging.\n");
 #ifdef DEBUG_ENABLED
@@ -667,11 +675,14 @@ void Main::print_help(const char *p_binary) {
 #ifdef TESTS_ENABLED
 	print_help_option("--test [--help]", "Run unit tests. Use --test --help for more information.\n", CLI_OPTION_AVAILABILITY_EDITOR);
 #endif
+#ifdef BENCHMARKS_ENABLED
+	print_help_option("--run-benchmarks [--help]", "Run the engine benchmark suite. Use --run-benchmarks --help for more information.\n", CLI_OPTION_AVAILABILITY_EDITOR);
+#endif
 #endif
 	OS::get_singleton()->print("\n");
 }
 
-#ifdef TESTS_ENABLED
+#if defined(TESTS_ENABLED) || defined(BENCHMARKS_ENABLED)
 // The order is the same as in `Main::setup()`, only core and some editor types
 // are initialized here. This also combines `Main::setup2()` initialization.
 Error Main::test_setup() {
@@ -803,6 +814,7 @@ void Main::test_cleanup() {
 	ResourceSaver::remove_custom_savers();
 	PropertyListHelper::clear_base_helpers();
 
+	IOScheduler::get_singleton()->finish();
 	WorkerThreadPool::get_singleton()->finish();
 
 #ifdef TOOLS_ENABLED
@@ -883,6 +895,21 @@ int Main::test_entrypoint(int argc, char *argv[], bool &tests_need_run) {
 					"`--test` was specified on the command line, but this Godot binary was compiled without support for unit tests. Aborting.\n"
 					"To be able to run unit tests, use the `tests=yes` SCons option when compiling Godot.\n");
 			return EXIT_FAILURE;
+#endif
+		}
+		if ((strncmp(argv[x], "--run-benchmarks", 16) == 0) && (strlen(argv[x]) == 16)) {
+			tests_need_run = true;
+#ifdef BENCHMARKS_ENABLED
+			// Benchmarks need the same headless engine context as tests.
+			test_setup();
+			int status = benchmark_main(argc, argv);
+			test_cleanup();
+			return status;
+#else
+			ERR_PRINT(
+					"`--run-benchmarks` was specified on the command line, but this Godot binary was compiled without support for benchmarks. Aborting.\n"
+					"To be able to run benchmarks, use the `benchmarks=yes` SCons option when compiling Godot.\n");
+			return EXIT_FAILURE;
 #endif
 		}
 	}
@@ -1822,6 +1849,10 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 			float low_priority_ratio = GLOBAL_GET("threading/worker_pool/low_priority_thread_ratio");
 			WorkerThreadPool::get_singleton()->init(worker_threads, low_priority_ratio);
 		}
+
+		if (GLOBAL_GET("threading/resource_loader/prefetch_files")) {
+			IOScheduler::get_singleton()->init();
+		}
 #else
 		WorkerThreadPool::get_singleton()->init(0, 0);
 #endif
@@ -3548,6 +3579,10 @@ int Main::start() {
 				script = E->next()->get();
 			} else if (E->get() == "--main-loop") {
 				main_loop_type = E->next()->get();
+#if defined(DEBUG_ENABLED) && defined(MODULE_GDSCRIPT_ENABLED)
+			} else if (E->get() == "--gdscript-sampling-profile") {
+				// Handled by the GDScript module, only skip the path argument here.
+#endif
 #ifdef TOOLS_ENABLED
 			} else if (E->get() == "--doctool") {
 				doc_tool_path = E->next()->get();
@@ -4496,6 +4531,7 @@ void Main::cleanup(bool p_force) {
 	}
 
 	ResourceLoader::clear_thread_load_tasks();
+	IOScheduler::get_singleton()->finish();
 
 	ResourceLoader::remove_custom_loaders();
 	ResourceSaver::remove_custom_savers();
@@ -74,7 +74,7 @@ public:
 	static Error setup2(bool p_show_boot_logo = true); // The thread calling setup2() will effectively become the main thread.
 	static String get_rendering_driver_name();
 	static void setup_boot_logo();
-#ifdef TESTS_ENABLED
+#if defined(TESTS_ENABLED) || defined(BENCHMARKS_ENABLED)
 	static Error test_setup();
 	static void test_cleanup();
 #endif
@@ -92,6 +92,8 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_CONNECTION_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_FREE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_OBSTACLE_COUNT);
+	BIND_ENUM_CONSTANT(MEMORY_SMALL_OBJECT_RESERVED);
+	BIND_ENUM_CONSTANT(MEMORY_SMALL_OBJECT_USED);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
 
@@ -143,6 +145,8 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		PNAME("navigation/edges_connected"),
 		PNAME("navigation/edges_free"),
 		PNAME("navigation/obstacles"),
+		PNAME("memory/small_object_reserved"),
+		PNAME("memory/small_object_used"),
 
 	};
 
@@ -165,6 +169,10 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return Memory::get_mem_max_usage();
 		case MEMORY_MESSAGE_BUFFER_MAX:
 			return MessageQueue::get_singleton()->get_max_buffer_usage();
+		case MEMORY_SMALL_OBJECT_RESERVED:
+			return Memory::get_small_object_reserved();
+		case MEMORY_SMALL_OBJECT_USED:
+			return Memory::get_small_object_used();
 		case OBJECT_COUNT:
 			return ObjectDB::get_object_count();
 		case OBJECT_RESOURCE_COUNT:
@@ -277,6 +285,8 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
 
 	};
 
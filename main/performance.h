@@ -101,6 +101,8 @@ public:
 		NAVIGATION_EDGE_CONNECTION_COUNT,
 		NAVIGATION_EDGE_FREE_COUNT,
 		NAVIGATION_OBSTACLE_COUNT,
+		MEMORY_SMALL_OBJECT_RESERVED,
+		MEMORY_SMALL_OBJECT_USED,
 		MONITOR_MAX
 	};
 
@@ -3,6 +3,12 @@ def can_build(env, platform):
     return True
 
 
+def get_opts(platform):
+    return [
+        ("gdscript_native_path", "Path to a directory with C++ code generated by the GDScript native code export option", ""),
+    ]
+
+
 def configure(env):
     pass
 
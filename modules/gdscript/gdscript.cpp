@@ -31,10 +31,12 @@
 #include "gdscript.h"
 
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 #include "gdscript_rpc_callable.h"
+#include "gdscript_sampling_profiler.h"
 #include "gdscript_tokenizer_buffer.h"
 #include "gdscript_warning.h"
 
@@ -801,8 +803,31 @@ Error GDScript::reload(bool p_keep_state) {
 #endif
 
 	valid = false;
+	GDScriptLanguage::get_singleton()->invalidate_inline_caches(this);
+	Error err = OK;
+
+	if (!has_instances && implicit_initializer == nullptr) {
+		// Never compiled, try to skip compilation altogether.
+		bool has_static_data = false;
+		if (GDScriptBytecodeCache::load_script(this, has_static_data)) {
+			if (has_static_data) {
+				GDScriptCache::add_static_script(this);
+			}
+			err = GDScriptCache::finish_compiling(path);
+			can_run = ScriptServer::is_scripting_enabled() || is_tool();
+			if (err) {
+				reloading = false;
+				return can_run ? ERR_COMPILATION_FAILED : err;
+			}
+			if (can_run) {
+				err = _static_init();
+			}
+			reloading = false;
+			return err;
+		}
+	}
+
 	GDScriptParser parser;
-	Error err;
 	if (!binary_tokens.is_empty()) {
 		err = parser.parse_binary(binary_tokens, path);
 	} else {
@@ -1400,6 +1425,9 @@ void GDScript::_collect_dependencies(RBSet<GDScript *> &p_dependencies, const GD
 
 GDScript::GDScript() :
 		script_list(this) {
+	// The address of a freed script may be reused by this one, which must not match the entries cached for it.
+	inline_cache_epoch.set(GDScriptLanguage::get_singleton()->next_inline_cache_epoch());
+
 	{
 		MutexLock lock(GDScriptLanguage::get_singleton()->mutex);
 
@@ -1527,6 +1555,8 @@ void GDScript::clear(ClearData *p_clear_data) {
 	}
 	clearing = true;
 
+	GDScriptLanguage::get_singleton()->invalidate_inline_caches(this);
+
 	ClearData data;
 	ClearData *clear_data = p_clear_data;
 	bool is_root = false;
@@ -2271,6 +2301,13 @@ void GDScriptLanguage::init() {
 #ifdef TESTS_ENABLED
 	GDScriptTests::GDScriptTestRunner::handle_cmdline();
 #endif
+
+#ifdef DEBUG_ENABLED
+	if (!sampling_profile_path.is_empty()) {
+		sampling_profiler = memnew(GDScriptSamplingProfiler);
+		sampling_profiler->start(sampling_profile_path, GLOBAL_GET("debug/settings/gdscript/sampling_profiler_frequency"));
+	}
+#endif
 }
 
 #ifdef TOOLS_ENABLED
@@ -2303,12 +2340,40 @@ String GDScriptLanguage::get_extension() const {
 	return "gd";
 }
 
+void GDScriptLanguage::invalidate_inline_caches(GDScript *p_script) {
+	MutexLock lock(mutex);
+
+	// Entries of a script depend on the members and functions of its base scripts, inner classes are
+	// recompiled and cleared along with their outer class.
+	for (SelfList<GDScript> *elem = script_list.first(); elem; elem = elem->next()) {
+		GDScript *scr = elem->self();
+		for (const GDScript *sptr = scr; sptr; sptr = sptr->_base) {
+			const GDScript *owner = sptr;
+			while (owner && owner != p_script) {
+				owner = owner->_owner;
+			}
+			if (owner) {
+				scr->inline_cache_epoch.set(next_inline_cache_epoch());
+				break;
+			}
+		}
+	}
+}
+
 void GDScriptLanguage::finish() {
 	if (finishing) {
 		return;
 	}
 	finishing = true;
 
+#ifdef DEBUG_ENABLED
+	if (sampling_profiler) {
+		sampling_profiler->stop();
+		memdelete(sampling_profiler);
+		sampling_profiler = nullptr;
+	}
+#endif
+
 	_call_stack.free();
 
 	// Clear the cache before parsing the script_list
@@ -2344,6 +2409,7 @@ void GDScriptLanguage::finish() {
 	}
 	script_list.clear();
 	function_list.clear();
+	GDScriptFunction::reclaim_retired_inline_caches();
 
 	finishing = false;
 }
@@ -2906,6 +2972,33 @@ String GDScriptLanguage::get_global_class_name(const String &p_path, String *r_b
 
 thread_local GDScriptLanguage::CallStack GDScriptLanguage::_call_stack;
 
+void GDScriptLanguage::CallStack::free() {
+	if (levels) {
+		if (singleton) {
+			MutexLock lock(singleton->mutex);
+			singleton->call_stacks.erase(this);
+		}
+		memdelete_arr(levels);
+		levels = nullptr;
+	}
+}
+
+#ifdef DEBUG_ENABLED
+void GDScriptLanguage::set_call_stack_tracked(bool p_tracked) {
+	call_stack_tracked = p_tracked || EngineDebugger::is_active() || !sampling_profile_path.is_empty();
+	if (call_stack_tracked && _debug_max_call_stack == 0) {
+		_debug_max_call_stack = GLOBAL_GET("debug/settings/gdscript/max_call_stack");
+	}
+}
+#endif
+
+void GDScriptLanguage::_register_call_stack() {
+	_call_stack.thread_id = Thread::get_caller_id();
+
+	MutexLock lock(mutex);
+	call_stacks.push_back(&_call_stack);
+}
+
 GDScriptLanguage::GDScriptLanguage() {
 	calls = 0;
 	ERR_FAIL_COND(singleton);
@@ -2930,6 +3023,9 @@ GDScriptLanguage::GDScriptLanguage() {
 #endif
 
 	int dmcs = GLOBAL_DEF(PropertyInfo(Variant::INT, "debug/settings/gdscript/max_call_stack", PROPERTY_HINT_RANGE, "512," + itos(GDScriptFunction::MAX_CALL_DEPTH - 1) + ",1"), 1024);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "debug/settings/gdscript/sampling_profiler_frequency", PROPERTY_HINT_RANGE, "1,10000,1,suffix:Hz"), 1000);
+
+	GLOBAL_DEF("gdscript/bytecode_cache/enabled", false);
 
 	if (EngineDebugger::is_active()) {
 		//debugging enabled!
@@ -2939,6 +3035,23 @@ GDScriptLanguage::GDScriptLanguage() {
 		_debug_max_call_stack = 0;
 	}
 
+#ifdef DEBUG_ENABLED
+	call_stack_tracked = EngineDebugger::is_active();
+
+	List<String> args = OS::get_singleton()->get_cmdline_args();
+	for (List<String>::Element *E = args.front(); E; E = E->next()) {
+		if (E->get() == "--gdscript-sampling-profile" && E->next()) {
+			sampling_profile_path = E->next()->get();
+			break;
+		}
+	}
+	if (!sampling_profile_path.is_empty()) {
+		// The sampling profiler reads the call stack, so it must be tracked without a debugger too.
+		call_stack_tracked = true;
+		_debug_max_call_stack = dmcs;
+	}
+#endif
+
 #ifdef DEBUG_ENABLED
 	GLOBAL_DEF("debug/gdscript/warnings/enable", true);
 	GLOBAL_DEF("debug/gdscript/warnings/exclude_addons", true);
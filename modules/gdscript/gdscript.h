@@ -41,6 +41,10 @@
 #include "core/object/script_language.h"
 #include "core/templates/rb_set.h"
 
+#include <atomic>
+
+class GDScriptSamplingProfiler;
+
 class GDScriptNativeClass : public RefCounted {
 	GDCLASS(GDScriptNativeClass, RefCounted);
 
@@ -89,6 +93,7 @@ class GDScript : public Script {
 	friend class GDScriptLambdaCallable;
 	friend class GDScriptLambdaSelfCallable;
 	friend class GDScriptLanguage;
+	friend class GDScriptBytecodeCache;
 	friend struct GDScriptUtilityFunctionsDefinitions;
 
 	Ref<GDScriptNativeClass> native;
@@ -96,6 +101,9 @@ class GDScript : public Script {
 	GDScript *_base = nullptr; //fast pointer access
 	GDScript *_owner = nullptr; //for subclasses
 
+	// Inline caches in compiled functions only trust entries resolved for this script during the current epoch.
+	SafeNumeric<uint32_t> inline_cache_epoch;
+
 	// Members are just indices to the instantiated script.
 	HashMap<StringName, MemberInfo> member_indices; // Includes member info of all base GDScript classes.
 	HashSet<StringName> members; // Only members of the current class.
@@ -408,6 +416,7 @@ public:
 
 class GDScriptLanguage : public ScriptLanguage {
 	friend class GDScriptFunctionState;
+	friend class GDScriptSamplingProfiler;
 
 	static GDScriptLanguage *singleton;
 
@@ -425,6 +434,10 @@ class GDScriptLanguage : public ScriptLanguage {
 		GDScriptInstance *instance = nullptr;
 		int *ip = nullptr;
 		int *line = nullptr;
+		// Copies of `function` and `*line` for the sampling profiler thread, `line` points into the
+		// stack of the owning thread and may be gone by the time it is read.
+		std::atomic<GDScriptFunction *> sampled_function = nullptr;
+		std::atomic<int> sampled_line = 0;
 	};
 
 	static thread_local int _debug_parse_err_line;
@@ -432,14 +445,13 @@ class GDScriptLanguage : public ScriptLanguage {
 	static thread_local String _debug_error;
 	struct CallStack {
 		CallLevel *levels = nullptr;
-		int stack_pos = 0;
+		// Written only by the owning thread, read by the sampling profiler thread.
+		std::atomic<int> stack_pos = 0;
+		// Frames past the limit when no debugger is attached to report the overflow.
+		int overflow = 0;
+		Thread::ID thread_id = 0;
 
-		void free() {
-			if (levels) {
-				memdelete(levels);
-				levels = nullptr;
-			}
-		}
+		void free();
 		~CallStack() {
 			free();
 		}
@@ -447,6 +459,9 @@ class GDScriptLanguage : public ScriptLanguage {
 
 	static thread_local CallStack _call_stack;
 	int _debug_max_call_stack = 0;
+	LocalVector<CallStack *> call_stacks; // Protected by mutex.
+
+	void _register_call_stack();
 
 	void _add_global(const StringName &p_name, const Variant &p_value);
 	void _remove_global(const StringName &p_name);
@@ -461,10 +476,15 @@ class GDScriptLanguage : public ScriptLanguage {
 	friend class GDScriptFunction;
 
 	SelfList<GDScriptFunction>::List function_list;
+	SafeNumeric<uint32_t> inline_cache_epoch;
 #ifdef DEBUG_ENABLED
 	bool profiling;
 	bool profile_native_calls;
 	uint64_t script_frame_time;
+
+	bool call_stack_tracked = false;
+	String sampling_profile_path;
+	GDScriptSamplingProfiler *sampling_profiler = nullptr;
 #endif
 
 	HashMap<String, ObjectID> orphan_subclasses;
@@ -480,42 +500,76 @@ public:
 	bool debug_break(const String &p_error, bool p_allow_continue = true);
 	bool debug_break_parse(const String &p_file, int p_line, const String &p_error);
 
+#ifdef DEBUG_ENABLED
+	// True when a debugger or the sampling profiler needs enter_function() and exit_function() to be called.
+	_FORCE_INLINE_ bool is_call_stack_tracked() const { return call_stack_tracked; }
+	// Must not change while GDScript functions run. Used by tests.
+	void set_call_stack_tracked(bool p_tracked);
+
+	// Publishes the line being executed by the innermost function to the sampling profiler.
+	_FORCE_INLINE_ void set_call_stack_line(int p_line) {
+		int pos = _call_stack.stack_pos.load(std::memory_order_relaxed);
+		if (pos > 0 && _call_stack.overflow == 0) {
+			_call_stack.levels[pos - 1].sampled_line.store(p_line, std::memory_order_relaxed);
+		}
+	}
+#endif
+
 	_FORCE_INLINE_ void enter_function(GDScriptInstance *p_instance, GDScriptFunction *p_function, Variant *p_stack, int *p_ip, int *p_line) {
 		if (unlikely(_call_stack.levels == nullptr)) {
 			_call_stack.levels = memnew_arr(CallLevel, _debug_max_call_stack + 1);
+			_register_call_stack();
 		}
 
-		if (EngineDebugger::get_script_debugger()->get_lines_left() > 0 && EngineDebugger::get_script_debugger()->get_depth() >= 0) {
-			EngineDebugger::get_script_debugger()->set_depth(EngineDebugger::get_script_debugger()->get_depth() + 1);
+		ScriptDebugger *script_debugger = EngineDebugger::get_script_debugger();
+		if (script_debugger && script_debugger->get_lines_left() > 0 && script_debugger->get_depth() >= 0) {
+			script_debugger->set_depth(script_debugger->get_depth() + 1);
 		}
 
-		if (_call_stack.stack_pos >= _debug_max_call_stack) {
+		int pos = _call_stack.stack_pos.load(std::memory_order_relaxed);
+		if (pos >= _debug_max_call_stack) {
+			if (!script_debugger) {
+				_call_stack.overflow++;
+				return;
+			}
 			//stack overflow
 			_debug_error = vformat("Stack overflow (stack size: %s). Check for infinite recursion in your script.", _debug_max_call_stack);
-			EngineDebugger::get_script_debugger()->debug(this);
+			script_debugger->debug(this);
 			return;
 		}
 
-		_call_stack.levels[_call_stack.stack_pos].stack = p_stack;
-		_call_stack.levels[_call_stack.stack_pos].instance = p_instance;
-		_call_stack.levels[_call_stack.stack_pos].function = p_function;
-		_call_stack.levels[_call_stack.stack_pos].ip = p_ip;
-		_call_stack.levels[_call_stack.stack_pos].line = p_line;
-		_call_stack.stack_pos++;
+		_call_stack.levels[pos].stack = p_stack;
+		_call_stack.levels[pos].instance = p_instance;
+		_call_stack.levels[pos].function = p_function;
+		_call_stack.levels[pos].ip = p_ip;
+		_call_stack.levels[pos].line = p_line;
+		_call_stack.levels[pos].sampled_function.store(p_function, std::memory_order_relaxed);
+		_call_stack.levels[pos].sampled_line.store(*p_line, std::memory_order_relaxed);
+		// Release so the profiler never sees the new depth before the level is filled.
+		_call_stack.stack_pos.store(pos + 1, std::memory_order_release);
 	}
 
 	_FORCE_INLINE_ void exit_function() {
-		if (EngineDebugger::get_script_debugger()->get_lines_left() > 0 && EngineDebugger::get_script_debugger()->get_depth() >= 0) {
-			EngineDebugger::get_script_debugger()->set_depth(EngineDebugger::get_script_debugger()->get_depth() - 1);
+		ScriptDebugger *script_debugger = EngineDebugger::get_script_debugger();
+		if (script_debugger && script_debugger->get_lines_left() > 0 && script_debugger->get_depth() >= 0) {
+			script_debugger->set_depth(script_debugger->get_depth() - 1);
 		}
 
-		if (_call_stack.stack_pos == 0) {
-			_debug_error = "Stack Underflow (Engine Bug)";
-			EngineDebugger::get_script_debugger()->debug(this);
+		if (unlikely(_call_stack.overflow > 0)) {
+			_call_stack.overflow--;
 			return;
 		}
 
-		_call_stack.stack_pos--;
+		int pos = _call_stack.stack_pos.load(std::memory_order_relaxed);
+		if (pos == 0) {
+			if (script_debugger) {
+				_debug_error = "Stack Underflow (Engine Bug)";
+				script_debugger->debug(this);
+			}
+			return;
+		}
+
+		_call_stack.stack_pos.store(pos - 1, std::memory_order_release);
 	}
 
 	virtual Vector<StackInfo> debug_get_current_stack_info() override {
@@ -555,6 +609,11 @@ public:
 
 	_FORCE_INLINE_ static GDScriptLanguage *get_singleton() { return singleton; }
 
+	// Each script gets a new epoch when created and whenever it, one of its base scripts or its outer class is
+	// recompiled or cleared, so that inline caches drop the entries resolved against its previous layout.
+	_FORCE_INLINE_ uint32_t next_inline_cache_epoch() { return inline_cache_epoch.increment(); }
+	void invalidate_inline_caches(GDScript *p_script);
+
 	virtual String get_name() const override;
 
 	/* LANGUAGE FUNCTIONS */
@@ -98,6 +98,7 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	int max_locals = 0;
 	int current_line = 0;
 	int instr_args_max = 0;
+	int inline_caches_count = 0;
 
 #ifdef DEBUG_ENABLED
 	List<int> temp_stack;
@@ -105,6 +106,7 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 
 	HashMap<Variant, int, VariantHasher, VariantComparator> constant_map;
 	RBMap<StringName, int> name_map;
+	RBMap<int, int> global_indices_map;
 #ifdef TOOLS_ENABLED
 	Vector<StringName> named_globals;
 #endif
@@ -340,6 +342,15 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 		return pos;
 	}
 
+	int get_global_index_pos(int p_global_index) {
+		if (global_indices_map.has(p_global_index)) {
+			return global_indices_map[p_global_index];
+		}
+		int pos = global_indices_map.size();
+		global_indices_map[p_global_index] = pos;
+		return pos;
+	}
+
 	int get_lambda_function_pos(GDScriptFunction *p_lambda_function) {
 		if (lambdas_map.has(p_lambda_function)) {
 			return lambdas_map[p_lambda_function];
@@ -387,6 +398,10 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 		opcodes.push_back(p_code);
 	}
 
+	void append_inline_cache() {
+		opcodes.push_back(inline_caches_count++);
+	}
+
 	void append(const Address &p_address) {
 		opcodes.push_back(address_of(p_address));
 	}
@@ -0,0 +1,2265 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_bytecode_cache.h"
+
+#include "gdscript.h"
+#include "gdscript_cache.h"
+#include "gdscript_function.h"
+#include "gdscript_native.h"
+#include "gdscript_utility_functions.h"
+
+#include "core/config/engine.h"
+#include "core/config/project_settings.h"
+#include "core/crypto/crypto_core.h"
+#include "core/debugger/engine_debugger.h"
+#include "core/io/dir_access.h"
+#include "core/io/resource_loader.h"
+#include "core/os/os.h"
+#include "core/version.h"
+
+#define CACHE_DIR "user://gdscript_bytecode_cache"
+#define FORMAT_VERSION 2
+
+enum {
+	SCRIPT_NONE,
+	SCRIPT_LOCAL, // Class of the script being cached, by fully qualified name.
+	SCRIPT_EXTERNAL, // Class of another GDScript file, by path and fully qualified name.
+	SCRIPT_RESOURCE, // Script of another language, by path.
+};
+
+enum {
+	OBJECT_NULL,
+	OBJECT_SCRIPT,
+	OBJECT_NATIVE_CLASS,
+	OBJECT_SINGLETON,
+	OBJECT_RESOURCE,
+};
+
+enum {
+	VARIANT_VALUE, // Anything `FileAccess::store_var()` handles without objects.
+	VARIANT_OBJECT,
+	VARIANT_ARRAY,
+	VARIANT_DICTIONARY,
+};
+
+// Reverse lookup of the builtin function pointers held by GDScriptFunction.
+class GDScriptBytecodeCache::Names {
+public:
+	struct Operator {
+		Variant::Operator op = Variant::OP_MAX;
+		Variant::Type type_a = Variant::NIL;
+		Variant::Type type_b = Variant::NIL;
+	};
+
+	struct Member {
+		Variant::Type type = Variant::NIL;
+		StringName name;
+	};
+
+	struct Constructor {
+		Variant::Type type = Variant::NIL;
+		int index = 0;
+	};
+
+	RBMap<Variant::ValidatedOperatorEvaluator, Operator> operators;
+	RBMap<Variant::ValidatedSetter, Member> setters;
+	RBMap<Variant::ValidatedGetter, Member> getters;
+	RBMap<Variant::ValidatedKeyedSetter, Variant::Type> keyed_setters;
+	RBMap<Variant::ValidatedKeyedGetter, Variant::Type> keyed_getters;
+	RBMap<Variant::ValidatedIndexedSetter, Variant::Type> indexed_setters;
+	RBMap<Variant::ValidatedIndexedGetter, Variant::Type> indexed_getters;
+	RBMap<Variant::ValidatedBuiltInMethod, Member> builtin_methods;
+	RBMap<Variant::ValidatedConstructor, Constructor> constructors;
+	RBMap<Variant::ValidatedUtilityFunction, StringName> utilities;
+	RBMap<GDScriptUtilityFunctions::FunctionPtr, StringName> gds_utilities;
+
+	template <typename K, typename V>
+	static const V *lookup(const RBMap<K, V> &p_map, K p_key) {
+		const typename RBMap<K, V>::Element *E = p_map.find(p_key);
+		return E ? &E->value() : nullptr;
+	}
+
+	Names() {
+		// Several entries may share a pointer, any of them resolves to it again.
+		for (int op = 0; op < Variant::OP_MAX; op++) {
+			for (int a = 0; a < Variant::VARIANT_MAX; a++) {
+				for (int b = 0; b < Variant::VARIANT_MAX; b++) {
+					Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator((Variant::Operator)op, (Variant::Type)a, (Variant::Type)b);
+					if (evaluator && !operators.has(evaluator)) {
+						operators.insert(evaluator, { (Variant::Operator)op, (Variant::Type)a, (Variant::Type)b });
+					}
+				}
+			}
+		}
+
+		for (int i = 0; i < Variant::VARIANT_MAX; i++) {
+			Variant::Type type = (Variant::Type)i;
+
+			List<StringName> members;
+			Variant::get_member_list(type, &members);
+			for (const StringName &E : members) {
+				Variant::ValidatedSetter setter = Variant::get_member_validated_setter(type, E);
+				if (setter && !setters.has(setter)) {
+					setters.insert(setter, { type, E });
+				}
+				Variant::ValidatedGetter getter = Variant::get_member_validated_getter(type, E);
+				if (getter && !getters.has(getter)) {
+					getters.insert(getter, { type, E });
+				}
+			}
+
+			Variant::ValidatedKeyedSetter keyed_setter = Variant::get_member_validated_keyed_setter(type);
+			if (keyed_setter && !keyed_setters.has(keyed_setter)) {
+				keyed_setters.insert(keyed_setter, type);
+			}
+			Variant::ValidatedKeyedGetter keyed_getter = Variant::get_member_validated_keyed_getter(type);
+			if (keyed_getter && !keyed_getters.has(keyed_getter)) {
+				keyed_getters.insert(keyed_getter, type);
+			}
+			Variant::ValidatedIndexedSetter indexed_setter = Variant::get_member_validated_indexed_setter(type);
+			if (indexed_setter && !indexed_setters.has(indexed_setter)) {
+				indexed_setters.insert(indexed_setter, type);
+			}
+			Variant::ValidatedIndexedGetter indexed_getter = Variant::get_member_validated_indexed_getter(type);
+			if (indexed_getter && !indexed_getters.has(indexed_getter)) {
+				indexed_getters.insert(indexed_getter, type);
+			}
+
+			List<StringName> methods;
+			Variant::get_builtin_method_list(type, &methods);
+			for (const StringName &E : methods) {
+				Variant::ValidatedBuiltInMethod method = Variant::get_validated_builtin_method(type, E);
+				if (method && !builtin_methods.has(method)) {
+					builtin_methods.insert(method, { type, E });
+				}
+			}
+
+			for (int j = 0; j < Variant::get_constructor_count(type); j++) {
+				Variant::ValidatedConstructor constructor = Variant::get_validated_constructor(type, j);
+				if (constructor && !constructors.has(constructor)) {
+					constructors.insert(constructor, { type, j });
+				}
+			}
+		}
+
+		List<StringName> functions;
+		Variant::get_utility_function_list(&functions);
+		for (const StringName &E : functions) {
+			Variant::ValidatedUtilityFunction utility = Variant::get_validated_utility_function(E);
+			if (utility && !utilities.has(utility)) {
+				utilities.insert(utility, E);
+			}
+		}
+
+		functions.clear();
+		GDScriptUtilityFunctions::get_function_list(&functions);
+		for (const StringName &E : functions) {
+			GDScriptUtilityFunctions::FunctionPtr utility = GDScriptUtilityFunctions::get_function(E);
+			if (utility && !gds_utilities.has(utility)) {
+				gds_utilities.insert(utility, E);
+			}
+		}
+	}
+};
+
+class GDScriptBytecodeCache::Writer {
+	bool _fail(const String &p_reason) {
+		print_verbose(vformat(R"(GDScript: Not caching the bytecode of "%s": %s)", root->path, p_reason));
+		return false;
+	}
+
+public:
+	Ref<FileAccess> f;
+	GDScript *root = nullptr;
+	const Names *names = nullptr;
+	HashMap<int, StringName> globals; // Reverse of `GDScriptLanguage::get_global_map()`.
+	HashSet<String> resources; // Files referenced by constants and types.
+
+	void write_string(const String &p_string) {
+		f->store_pascal_string(p_string);
+	}
+
+	void write_string_name(const StringName &p_name) {
+		f->store_pascal_string(p_name);
+	}
+
+	void write_ints(const Vector<int> &p_ints) {
+		f->store_32(p_ints.size());
+		for (int value : p_ints) {
+			f->store_32(value);
+		}
+	}
+
+	bool write_script(Script *p_script) {
+		if (p_script == nullptr) {
+			f->store_8(SCRIPT_NONE);
+			return true;
+		}
+
+		GDScript *gdscript = Object::cast_to<GDScript>(p_script);
+		if (gdscript) {
+			GDScript *gdscript_root = gdscript->get_root_script();
+			if (gdscript_root == root) {
+				f->store_8(SCRIPT_LOCAL);
+				write_string(gdscript->fully_qualified_name);
+				return true;
+			}
+			if (!gdscript_root->path.is_resource_file()) {
+				return _fail("references a built-in script.");
+			}
+			f->store_8(SCRIPT_EXTERNAL);
+			write_string(gdscript_root->path);
+			write_string(gdscript->fully_qualified_name);
+			resources.insert(gdscript_root->path);
+			return true;
+		}
+
+		if (!p_script->get_path().is_resource_file()) {
+			return _fail("references a built-in script.");
+		}
+		f->store_8(SCRIPT_RESOURCE);
+		write_string(p_script->get_path());
+		resources.insert(p_script->get_path());
+		return true;
+	}
+
+	bool write_object(Object *p_object) {
+		if (p_object == nullptr) {
+			f->store_8(OBJECT_NULL);
+			return true;
+		}
+
+		Script *script = Object::cast_to<Script>(p_object);
+		if (script) {
+			f->store_8(OBJECT_SCRIPT);
+			return write_script(script);
+		}
+
+		GDScriptNativeClass *native_class = Object::cast_to<GDScriptNativeClass>(p_object);
+		if (native_class) {
+			f->store_8(OBJECT_NATIVE_CLASS);
+			write_string_name(native_class->get_name());
+			return true;
+		}
+
+		Resource *resource = Object::cast_to<Resource>(p_object);
+		if (resource) {
+			if (!resource->get_path().is_resource_file()) {
+				return _fail("a constant holds a built-in resource.");
+			}
+			f->store_8(OBJECT_RESOURCE);
+			write_string(resource->get_path());
+			resources.insert(resource->get_path());
+			return true;
+		}
+
+		List<Engine::Singleton> singletons;
+		Engine::get_singleton()->get_singletons(&singletons);
+		for (const Engine::Singleton &E : singletons) {
+			if (E.ptr == p_object) {
+				f->store_8(OBJECT_SINGLETON);
+				write_string_name(E.name);
+				return true;
+			}
+		}
+
+		return _fail(vformat(R"(a constant holds an instance of "%s".)", p_object->get_class()));
+	}
+
+	bool write_variant(const Variant &p_value) {
+		switch (p_value.get_type()) {
+			case Variant::OBJECT: {
+				f->store_8(VARIANT_OBJECT);
+				return write_object(p_value.get_validated_object());
+			}
+			case Variant::ARRAY: {
+				const Array array = p_value;
+				f->store_8(VARIANT_ARRAY);
+				f->store_32(array.get_typed_builtin());
+				write_string_name(array.get_typed_class_name());
+				if (!write_script(Object::cast_to<Script>(array.get_typed_script().get_validated_object()))) {
+					return false;
+				}
+				f->store_8(array.is_read_only());
+				f->store_32(array.size());
+				for (int i = 0; i < array.size(); i++) {
+					if (!write_variant(array[i])) {
+						return false;
+					}
+				}
+				return true;
+			}
+			case Variant::DICTIONARY: {
+				const Dictionary dictionary = p_value;
+				f->store_8(VARIANT_DICTIONARY);
+				f->store_32(dictionary.get_typed_key_builtin());
+				write_string_name(dictionary.get_typed_key_class_name());
+				if (!write_script(Object::cast_to<Script>(dictionary.get_typed_key_script().get_validated_object()))) {
+					return false;
+				}
+				f->store_32(dictionary.get_typed_value_builtin());
+				write_string_name(dictionary.get_typed_value_class_name());
+				if (!write_script(Object::cast_to<Script>(dictionary.get_typed_value_script().get_validated_object()))) {
+					return false;
+				}
+				f->store_8(dictionary.is_read_only());
+				List<Variant> keys;
+				dictionary.get_key_list(&keys);
+				f->store_32(keys.size());
+				for (const Variant &E : keys) {
+					if (!write_variant(E) || !write_variant(dictionary[E])) {
+						return false;
+					}
+				}
+				return true;
+			}
+			case Variant::CALLABLE:
+			case Variant::SIGNAL:
+			case Variant::RID: {
+				return _fail(vformat(R"(a constant holds a value of type "%s".)", Variant::get_type_name(p_value.get_type())));
+			}
+			default: {
+				f->store_8(VARIANT_VALUE);
+				f->store_var(p_value);
+				return true;
+			}
+		}
+	}
+
+	bool write_data_type(const GDScriptDataType &p_type) {
+		f->store_8(p_type.has_type);
+		f->store_8(p_type.kind);
+		f->store_32(p_type.builtin_type);
+		write_string_name(p_type.native_type);
+		if (!write_script(p_type.script_type)) {
+			return false;
+		}
+		f->store_8(p_type.script_type_ref.is_valid());
+		f->store_32(p_type.container_element_types.size());
+		for (const GDScriptDataType &E : p_type.container_element_types) {
+			if (!write_data_type(E)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void write_property_info(const PropertyInfo &p_info) {
+		f->store_32(p_info.type);
+		write_string(p_info.name);
+		write_string_name(p_info.class_name);
+		f->store_32(p_info.hint);
+		write_string(p_info.hint_string);
+		f->store_32(p_info.usage);
+	}
+
+	bool write_method_info(const MethodInfo &p_info) {
+		write_string(p_info.name);
+		write_property_info(p_info.return_val);
+		f->store_32(p_info.flags);
+		f->store_32(p_info.id);
+		f->store_32(p_info.arguments.size());
+		for (const PropertyInfo &E : p_info.arguments) {
+			write_property_info(E);
+		}
+		f->store_32(p_info.default_arguments.size());
+		for (const Variant &E : p_info.default_arguments) {
+			if (!write_variant(E)) {
+				return false;
+			}
+		}
+		f->store_32(p_info.return_val_metadata);
+		write_ints(p_info.arguments_metadata);
+		return true;
+	}
+
+	bool write_member_info(const GDScript::MemberInfo &p_info) {
+		f->store_32(p_info.index);
+		write_string_name(p_info.setter);
+		write_string_name(p_info.getter);
+		write_property_info(p_info.property_info);
+		return write_data_type(p_info.data_type);
+	}
+
+	bool write_function(const GDScriptFunction *p_function) {
+		write_string_name(p_function->name);
+		f->store_8(p_function->_static);
+		f->store_32(p_function->argument_types.size());
+		for (const GDScriptDataType &E : p_function->argument_types) {
+			if (!write_data_type(E)) {
+				return false;
+			}
+		}
+		if (!write_data_type(p_function->return_type) || !write_method_info(p_function->method_info) || !write_variant(p_function->rpc_config)) {
+			return false;
+		}
+
+		f->store_32(p_function->_initial_line);
+		f->store_32(p_function->_argument_count);
+		f->store_32(p_function->_stack_size);
+		f->store_32(p_function->_instruction_args_size);
+		f->store_32(p_function->_default_arg_count);
+
+		f->store_32(p_function->temporary_slots.size());
+		for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+			f->store_32(E.key);
+			f->store_32(E.value);
+		}
+
+		write_ints(p_function->code);
+		write_ints(p_function->default_arguments);
+
+		f->store_32(p_function->constants.size());
+		for (const Variant &E : p_function->constants) {
+			if (!write_variant(E)) {
+				return false;
+			}
+		}
+
+		f->store_32(p_function->global_names.size());
+		for (const StringName &E : p_function->global_names) {
+			write_string_name(E);
+		}
+
+		// Indices into the global array depend on registration order, store names instead.
+		f->store_32(p_function->global_indices.size());
+		for (int E : p_function->global_indices) {
+			const StringName *name = globals.getptr(E);
+			if (!name) {
+				return _fail("unknown global.");
+			}
+			write_string_name(*name);
+		}
+
+		f->store_32(p_function->operator_funcs.size());
+		for (Variant::ValidatedOperatorEvaluator E : p_function->operator_funcs) {
+			const Names::Operator *op = Names::lookup(names->operators, E);
+			if (!op) {
+				return _fail("unknown operator evaluator.");
+			}
+			f->store_32(op->op);
+			f->store_32(op->type_a);
+			f->store_32(op->type_b);
+		}
+
+		f->store_32(p_function->setters.size());
+		for (Variant::ValidatedSetter E : p_function->setters) {
+			const Names::Member *member = Names::lookup(names->setters, E);
+			if (!member) {
+				return _fail("unknown builtin setter.");
+			}
+			f->store_32(member->type);
+			write_string_name(member->name);
+		}
+
+		f->store_32(p_function->getters.size());
+		for (Variant::ValidatedGetter E : p_function->getters) {
+			const Names::Member *member = Names::lookup(names->getters, E);
+			if (!member) {
+				return _fail("unknown builtin getter.");
+			}
+			f->store_32(member->type);
+			write_string_name(member->name);
+		}
+
+		f->store_32(p_function->keyed_setters.size());
+		for (Variant::ValidatedKeyedSetter E : p_function->keyed_setters) {
+			const Variant::Type *type = Names::lookup(names->keyed_setters, E);
+			if (!type) {
+				return _fail("unknown keyed setter.");
+			}
+			f->store_32(*type);
+		}
+
+		f->store_32(p_function->keyed_getters.size());
+		for (Variant::ValidatedKeyedGetter E : p_function->keyed_getters) {
+			const Variant::Type *type = Names::lookup(names->keyed_getters, E);
+			if (!type) {
+				return _fail("unknown keyed getter.");
+			}
+			f->store_32(*type);
+		}
+
+		f->store_32(p_function->indexed_setters.size());
+		for (Variant::ValidatedIndexedSetter E : p_function->indexed_setters) {
+			const Variant::Type *type = Names::lookup(names->indexed_setters, E);
+			if (!type) {
+				return _fail("unknown indexed setter.");
+			}
+			f->store_32(*type);
+		}
+
+		f->store_32(p_function->indexed_getters.size());
+		for (Variant::ValidatedIndexedGetter E : p_function->indexed_getters) {
+			const Variant::Type *type = Names::lookup(names->indexed_getters, E);
+			if (!type) {
+				return _fail("unknown indexed getter.");
+			}
+			f->store_32(*type);
+		}
+
+		f->store_32(p_function->builtin_methods.size());
+		for (Variant::ValidatedBuiltInMethod E : p_function->builtin_methods) {
+			const Names::Member *method = Names::lookup(names->builtin_methods, E);
+			if (!method) {
+				return _fail("unknown builtin method.");
+			}
+			f->store_32(method->type);
+			write_string_name(method->name);
+		}
+
+		f->store_32(p_function->constructors.size());
+		for (Variant::ValidatedConstructor E : p_function->constructors) {
+			const Names::Constructor *constructor = Names::lookup(names->constructors, E);
+			if (!constructor) {
+				return _fail("unknown builtin constructor.");
+			}
+			f->store_32(constructor->type);
+			f->store_32(constructor->index);
+		}
+
+		f->store_32(p_function->utilities.size());
+		for (Variant::ValidatedUtilityFunction E : p_function->utilities) {
+			const StringName *name = Names::lookup(names->utilities, E);
+			if (!name) {
+				return _fail("unknown utility function.");
+			}
+			write_string_name(*name);
+		}
+
+		f->store_32(p_function->gds_utilities.size());
+		for (GDScriptUtilityFunctions::FunctionPtr E : p_function->gds_utilities) {
+			const StringName *name = Names::lookup(names->gds_utilities, E);
+			if (!name) {
+				return _fail("unknown GDScript utility function.");
+			}
+			write_string_name(*name);
+		}
+
+		f->store_32(p_function->methods.size());
+		for (const MethodBind *E : p_function->methods) {
+			write_string_name(E->get_instance_class());
+			write_string_name(E->get_name());
+		}
+
+		f->store_32(p_function->lambdas.size());
+		for (const GDScriptFunction *E : p_function->lambdas) {
+			const GDScript::LambdaInfo *info = E->_script->lambda_info.getptr(const_cast<GDScriptFunction *>(E));
+			f->store_8(info != nullptr);
+			if (info) {
+				f->store_32(info->capture_count);
+				f->store_8(info->use_self);
+			}
+			if (!write_function(E)) {
+				return false;
+			}
+		}
+
+		f->store_32(p_function->_inline_caches_count);
+
+		uint64_t native_hash = 0;
+		bool has_native = p_function->native_function && GDScriptNativeFunctions::find_function(p_function->_script->fully_qualified_name, p_function->name, native_hash) == p_function->native_function;
+		f->store_8(has_native);
+		if (has_native) {
+			f->store_64(native_hash);
+		}
+
+#ifdef DEBUG_ENABLED
+		const Vector<String> *debug_names[] = {
+			&p_function->operator_names,
+			&p_function->setter_names,
+			&p_function->getter_names,
+			&p_function->builtin_methods_names,
+			&p_function->constructors_names,
+			&p_function->utilities_names,
+			&p_function->gds_utilities_names,
+		};
+		for (const Vector<String> *E : debug_names) {
+			f->store_32(E->size());
+			for (const String &F : *E) {
+				write_string(F);
+			}
+		}
+#endif
+		return true;
+	}
+
+	bool write_class(const GDScript *p_script) {
+		f->store_8(p_script->tool);
+		write_string_name(p_script->native.is_valid() ? p_script->native->get_name() : StringName());
+		if (!write_script(p_script->base.ptr())) {
+			return false;
+		}
+
+		f->store_32(p_script->member_indices.size());
+		for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_script->member_indices) {
+			write_string_name(E.key);
+			if (!write_member_info(E.value)) {
+				return false;
+			}
+		}
+
+		f->store_32(p_script->members.size());
+		for (const StringName &E : p_script->members) {
+			write_string_name(E);
+		}
+
+		f->store_32(p_script->static_variables_indices.size());
+		for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_script->static_variables_indices) {
+			write_string_name(E.key);
+			if (!write_member_info(E.value)) {
+				return false;
+			}
+		}
+
+		f->store_32(p_script->constants.size());
+		for (const KeyValue<StringName, Variant> &E : p_script->constants) {
+			write_string_name(E.key);
+			if (!write_variant(E.value)) {
+				return false;
+			}
+		}
+
+		f->store_32(p_script->_signals.size());
+		for (const KeyValue<StringName, MethodInfo> &E : p_script->_signals) {
+			write_string_name(E.key);
+			if (!write_method_info(E.value)) {
+				return false;
+			}
+		}
+
+		if (!write_variant(p_script->rpc_config)) {
+			return false;
+		}
+
+		f->store_32(p_script->member_functions.size());
+		for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->member_functions) {
+			write_string_name(E.key);
+			if (!write_function(E.value)) {
+				return false;
+			}
+		}
+		f->store_8(p_script->initializer != nullptr);
+
+		if (!p_script->implicit_initializer) {
+			return _fail("no implicit initializer.");
+		}
+		if (!write_function(p_script->implicit_initializer)) {
+			return false;
+		}
+		f->store_8(p_script->implicit_ready != nullptr);
+		if (p_script->implicit_ready && !write_function(p_script->implicit_ready)) {
+			return false;
+		}
+		f->store_8(p_script->static_initializer != nullptr);
+		if (p_script->static_initializer && !write_function(p_script->static_initializer)) {
+			return false;
+		}
+
+		f->store_32(p_script->subclasses.size());
+		for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+			write_string_name(E.key);
+			if (!write_class(E.value.ptr())) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void write_skeleton(const GDScript *p_script) {
+		write_string_name(p_script->local_name);
+		write_string_name(p_script->global_name);
+		write_string(p_script->fully_qualified_name);
+		write_string(p_script->simplified_icon_path);
+		f->store_32(p_script->subclasses.size());
+		for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+			write_skeleton(E.value.ptr());
+		}
+	}
+};
+
+class GDScriptBytecodeCache::Reader {
+public:
+	struct Skeleton {
+		StringName local_name;
+		StringName global_name;
+		String fully_qualified_name;
+		String simplified_icon_path;
+		int subclass_count = 0;
+	};
+
+	Ref<FileAccess> f;
+	GDScript *root = nullptr;
+
+	bool is_valid() const {
+		return f->get_error() == OK;
+	}
+
+	String read_string() {
+		return f->get_pascal_string();
+	}
+
+	StringName read_string_name() {
+		return f->get_pascal_string();
+	}
+
+	// Counts are bounded by the remaining file size, so a corrupted entry cannot cause huge allocations.
+	bool read_count(int &r_count) {
+		uint32_t count = f->get_32();
+		if (!is_valid() || count > f->get_length() - f->get_position()) {
+			return false;
+		}
+		r_count = count;
+		return true;
+	}
+
+	bool read_type(Variant::Type &r_type) {
+		uint32_t type = f->get_32();
+		if (type >= Variant::VARIANT_MAX) {
+			return false;
+		}
+		r_type = (Variant::Type)type;
+		return true;
+	}
+
+	bool read_ints(Vector<int> &r_ints) {
+		int count = 0;
+		if (!read_count(count)) {
+			return false;
+		}
+		r_ints.resize(count);
+		int *ptr = r_ints.ptrw();
+		for (int i = 0; i < count; i++) {
+			ptr[i] = (int)f->get_32();
+		}
+		return is_valid();
+	}
+
+	bool read_script(Ref<Script> &r_script) {
+		r_script = Ref<Script>();
+		switch (f->get_8()) {
+			case SCRIPT_NONE: {
+				return true;
+			}
+			case SCRIPT_LOCAL: {
+				r_script = Ref<Script>(root->find_class(read_string()));
+			} break;
+			case SCRIPT_EXTERNAL: {
+				String path = read_string();
+				String fully_qualified_name = read_string();
+				Error err = OK;
+				Ref<GDScript> script = GDScriptCache::get_shallow_script(path, err, root->path);
+				if (err == OK && script.is_valid()) {
+					r_script = Ref<Script>(script->find_class(fully_qualified_name));
+				}
+			} break;
+			case SCRIPT_RESOURCE: {
+				r_script = ResourceLoader::load(read_string(), "Script");
+			} break;
+			default: {
+				return false;
+			}
+		}
+		return r_script.is_valid();
+	}
+
+	bool read_object(Variant &r_value) {
+		switch (f->get_8()) {
+			case OBJECT_NULL: {
+				r_value = (Object *)nullptr;
+				return true;
+			}
+			case OBJECT_SCRIPT: {
+				Ref<Script> script;
+				if (!read_script(script)) {
+					return false;
+				}
+				r_value = script;
+				return true;
+			}
+			case OBJECT_NATIVE_CLASS: {
+				const HashMap<StringName, int>::ConstIterator E = GDScriptLanguage::get_singleton()->get_global_map().find(read_string_name());
+				if (!E) {
+					return false;
+				}
+				r_value = GDScriptLanguage::get_singleton()->get_global_array()[E->value];
+				return Object::cast_to<GDScriptNativeClass>(r_value.get_validated_object()) != nullptr;
+			}
+			case OBJECT_SINGLETON: {
+				Object *singleton = Engine::get_singleton()->get_singleton_object(read_string_name());
+				r_value = singleton;
+				return singleton != nullptr;
+			}
+			case OBJECT_RESOURCE: {
+				// Same as preloading, see `GDScriptAnalyzer::reduce_preload()`.
+				String path = read_string();
+				String type = ResourceLoader::get_resource_type(path);
+				Error err = OK;
+				Ref<Resource> resource = ResourceLoader::load(path, type, ResourceFormatLoader::CACHE_MODE_REUSE, &err);
+				if (err == ERR_BUSY) {
+					resource = ResourceLoader::ensure_resource_ref_override_for_outer_load(path, type);
+				}
+				r_value = resource;
+				return resource.is_valid();
+			}
+			default: {
+				return false;
+			}
+		}
+	}
+
+	bool read_variant(Variant &r_value, int p_depth = 0) {
+		if (p_depth > Variant::MAX_RECURSION_DEPTH) {
+			return false;
+		}
+
+		switch (f->get_8()) {
+			case VARIANT_VALUE: {
+				r_value = f->get_var();
+				return is_valid();
+			}
+			case VARIANT_OBJECT: {
+				return read_object(r_value);
+			}
+			case VARIANT_ARRAY: {
+				Variant::Type type = Variant::NIL;
+				Ref<Script> script;
+				if (!read_type(type)) {
+					return false;
+				}
+				StringName class_name = read_string_name();
+				if (!read_script(script)) {
+					return false;
+				}
+				bool read_only = f->get_8();
+				int size = 0;
+				if (!read_count(size)) {
+					return false;
+				}
+
+				Array array;
+				if (type != Variant::NIL) {
+					array.set_typed(type, class_name, script);
+				}
+				for (int i = 0; i < size; i++) {
+					Variant value;
+					if (!read_variant(value, p_depth + 1)) {
+						return false;
+					}
+					array.push_back(value);
+				}
+				if (read_only) {
+					array.make_read_only();
+				}
+				r_value = array;
+				return true;
+			}
+			case VARIANT_DICTIONARY: {
+				Variant::Type key_type = Variant::NIL;
+				Variant::Type value_type = Variant::NIL;
+				Ref<Script> key_script;
+				Ref<Script> value_script;
+				if (!read_type(key_type)) {
+					return false;
+				}
+				StringName key_class_name = read_string_name();
+				if (!read_script(key_script) || !read_type(value_type)) {
+					return false;
+				}
+				StringName value_class_name = read_string_name();
+				if (!read_script(value_script)) {
+					return false;
+				}
+				bool read_only = f->get_8();
+				int size = 0;
+				if (!read_count(size)) {
+					return false;
+				}
+
+				Dictionary dictionary;
+				if (key_type != Variant::NIL || value_type != Variant::NIL) {
+					dictionary.set_typed(key_type, key_class_name, key_script, value_type, value_class_name, value_script);
+				}
+				for (int i = 0; i < size; i++) {
+					Variant key;
+					Variant value;
+					if (!read_variant(key, p_depth + 1) || !read_variant(value, p_depth + 1)) {
+						return false;
+					}
+					dictionary[key] = value;
+				}
+				if (read_only) {
+					dictionary.make_read_only();
+				}
+				r_value = dictionary;
+				return true;
+			}
+			default: {
+				return false;
+			}
+		}
+	}
+
+	bool read_data_type(GDScriptDataType &r_type, int p_depth = 0) {
+		if (p_depth > Variant::MAX_RECURSION_DEPTH) {
+			return false;
+		}
+
+		r_type.has_type = f->get_8();
+		uint8_t kind = f->get_8();
+		if (kind > GDScriptDataType::GDSCRIPT || !read_type(r_type.builtin_type)) {
+			return false;
+		}
+		r_type.kind = (GDScriptDataType::Kind)kind;
+		r_type.native_type = read_string_name();
+
+		Ref<Script> script;
+		if (!read_script(script)) {
+			return false;
+		}
+		r_type.script_type = script.ptr();
+		// Types referring to classes of the same file don't hold a reference, see `GDScriptCompiler::_gdtype_from_datatype()`.
+		if (f->get_8()) {
+			r_type.script_type_ref = script;
+		}
+
+		int count = 0;
+		if (!read_count(count)) {
+			return false;
+		}
+		r_type.container_element_types.resize(count);
+		for (int i = 0; i < count; i++) {
+			if (!read_data_type(r_type.container_element_types.write[i], p_depth + 1)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool read_property_info(PropertyInfo &r_info) {
+		if (!read_type(r_info.type)) {
+			return false;
+		}
+		r_info.name = read_string();
+		r_info.class_name = read_string_name();
+		r_info.hint = (PropertyHint)f->get_32();
+		r_info.hint_string = read_string();
+		r_info.usage = f->get_32();
+		return is_valid();
+	}
+
+	bool read_method_info(MethodInfo &r_info) {
+		r_info.name = read_string();
+		if (!read_property_info(r_info.return_val)) {
+			return false;
+		}
+		r_info.flags = f->get_32();
+		r_info.id = f->get_32();
+
+		int count = 0;
+		if (!read_count(count)) {
+			return false;
+		}
+		for (int i = 0; i < count; i++) {
+			PropertyInfo argument;
+			if (!read_property_info(argument)) {
+				return false;
+			}
+			r_info.arguments.push_back(argument);
+		}
+
+		if (!read_count(count)) {
+			return false;
+		}
+		r_info.default_arguments.resize(count);
+		for (int i = 0; i < count; i++) {
+			if (!read_variant(r_info.default_arguments.write[i])) {
+				return false;
+			}
+		}
+
+		r_info.return_val_metadata = f->get_32();
+		return read_ints(r_info.arguments_metadata);
+	}
+
+	bool read_member_info(GDScript::MemberInfo &r_info) {
+		r_info.index = f->get_32();
+		r_info.setter = read_string_name();
+		r_info.getter = read_string_name();
+		return read_property_info(r_info.property_info) && read_data_type(r_info.data_type);
+	}
+
+	// Cached bytecode doesn't come with the guarantees of the compiler, and release builds don't check
+	// operands at run time. Make sure every instruction only refers to addresses, tables, types and jump
+	// targets that exist, so that a damaged entry is rejected instead of executed.
+	static bool verify_code(GDScriptFunction *p_function, const GDScript *p_script) {
+		const int code_size = p_function->code.size();
+		int *code = p_function->code.ptrw();
+		const int instruction_args_size = p_function->_instruction_args_size;
+
+		if (p_function->_argument_count != p_function->argument_types.size() || p_function->_default_arg_count < 0 || p_function->_default_arg_count > p_function->_argument_count) {
+			return false;
+		}
+		if (p_function->_default_arg_count != MAX(p_function->default_arguments.size() - 1, 0)) {
+			return false;
+		}
+		if (p_function->_stack_size < GDScriptFunction::FIXED_ADDRESSES_MAX + p_function->_argument_count || p_function->_stack_size > GDScriptFunction::ADDR_MASK + 1) {
+			return false;
+		}
+		if (instruction_args_size < 0 || instruction_args_size > GDScriptFunction::ADDR_MASK + 1) {
+			return false;
+		}
+		for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+			if (E.key < GDScriptFunction::FIXED_ADDRESSES_MAX || E.key >= p_function->_stack_size) {
+				return false;
+			}
+		}
+
+		// Same limits as `variant_address_limits` in `GDScriptFunction::call()`.
+		const int address_limits[GDScriptFunction::ADDR_TYPE_MAX] = { p_function->_stack_size, (int)p_function->constants.size(), (int)p_script->member_indices.size() };
+
+		Vector<bool> instruction_starts;
+		instruction_starts.resize(code_size);
+		instruction_starts.fill(false);
+		LocalVector<int> jump_targets;
+		for (int E : p_function->default_arguments) {
+			jump_targets.push_back(E);
+		}
+
+		int ip = 0;
+		int length = 0;
+		int argc_base = 0; // Start of the fixed operands following the instruction arguments.
+		int instr_arg_count = 0;
+
+		auto has_space = [&](int p_length) {
+			length = p_length;
+			return ip + p_length <= code_size;
+		};
+		auto is_address = [&](int p_offset) {
+			const int address = code[ip + p_offset];
+			if (address < 0) {
+				return false;
+			}
+			const int type = (address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS;
+			return type < GDScriptFunction::ADDR_TYPE_MAX && (address & GDScriptFunction::ADDR_MASK) < address_limits[type];
+		};
+		auto are_addresses = [&](int p_offset, int p_count) {
+			for (int i = 0; i < p_count; i++) {
+				if (!is_address(p_offset + i)) {
+					return false;
+				}
+			}
+			return true;
+		};
+		auto is_index = [&](int p_offset, int p_size) {
+			return code[ip + p_offset] >= 0 && code[ip + p_offset] < p_size;
+		};
+		auto is_type = [&](int p_offset) {
+			return is_index(p_offset, Variant::VARIANT_MAX);
+		};
+		auto is_name = [&](int p_offset) {
+			return is_index(p_offset, p_function->global_names.size());
+		};
+		auto is_jump = [&](int p_offset) {
+			jump_targets.push_back(code[ip + p_offset]);
+			return true;
+		};
+		// Instructions with a variable number of addresses store their count first, followed by the
+		// addresses and p_fixed_count operands, see `LOAD_INSTRUCTION_ARGS`.
+		auto has_instruction_args = [&](int p_fixed_count) {
+			if (ip + 1 >= code_size) {
+				return false;
+			}
+			instr_arg_count = code[ip + 1];
+			if (instr_arg_count < 0 || instr_arg_count > instruction_args_size || !has_space(2 + instr_arg_count + p_fixed_count)) {
+				return false;
+			}
+			argc_base = 2 + instr_arg_count;
+			return are_addresses(2, instr_arg_count);
+		};
+		// The instruction uses p_extra_count addresses after its p_argc arguments.
+		auto fits_instruction_args = [&](int p_offset, int p_multiplier, int p_extra_count) {
+			const int argc = code[ip + p_offset];
+			return argc >= 0 && argc <= instr_arg_count && argc * p_multiplier + p_extra_count <= instr_arg_count;
+		};
+
+		while (ip < code_size) {
+			instruction_starts.write[ip] = true;
+			const int opcode = code[ip];
+			if (opcode < 0 || opcode > GDScriptFunction::OPCODE_END) {
+				return false;
+			}
+
+			bool valid = false;
+			switch (opcode) {
+				case GDScriptFunction::OPCODE_OPERATOR: {
+					constexpr int _pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(*code);
+					valid = has_space(7 + _pointer_size) && are_addresses(1, 3) && is_index(4, Variant::OP_MAX);
+					if (valid) {
+						// Signature, return type and evaluator are filled in on the first run, never trust them.
+						for (int i = 5; i < 7 + _pointer_size; i++) {
+							code[ip + i] = 0;
+						}
+					}
+				} break;
+				case GDScriptFunction::OPCODE_OPERATOR_VALIDATED: {
+					valid = has_space(5) && are_addresses(1, 3) && is_index(4, p_function->operator_funcs.size());
+				} break;
+				case GDScriptFunction::OPCODE_TYPE_TEST_BUILTIN:
+				case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN:
+				case GDScriptFunction::OPCODE_CAST_TO_BUILTIN: {
+					valid = has_space(4) && are_addresses(1, 2) && is_type(3);
+				} break;
+				case GDScriptFunction::OPCODE_TYPE_TEST_ARRAY:
+				case GDScriptFunction::OPCODE_ASSIGN_TYPED_ARRAY: {
+					valid = has_space(6) && are_addresses(1, 3) && is_type(4) && is_name(5);
+				} break;
+				case GDScriptFunction::OPCODE_TYPE_TEST_DICTIONARY:
+				case GDScriptFunction::OPCODE_ASSIGN_TYPED_DICTIONARY: {
+					valid = has_space(9) && are_addresses(1, 4) && is_type(5) && is_name(6) && is_type(7) && is_name(8);
+				} break;
+				case GDScriptFunction::OPCODE_TYPE_TEST_NATIVE: {
+					valid = has_space(4) && are_addresses(1, 2) && is_name(3);
+				} break;
+				case GDScriptFunction::OPCODE_TYPE_TEST_SCRIPT:
+				case GDScriptFunction::OPCODE_SET_KEYED:
+				case GDScriptFunction::OPCODE_GET_KEYED:
+				case GDScriptFunction::OPCODE_ASSIGN_TYPED_NATIVE:
+				case GDScriptFunction::OPCODE_ASSIGN_TYPED_SCRIPT:
+				case GDScriptFunction::OPCODE_CAST_TO_NATIVE:
+				case GDScriptFunction::OPCODE_CAST_TO_SCRIPT: {
+					valid = has_space(4) && are_addresses(1, 3);
+				} break;
+				case GDScriptFunction::OPCODE_SET_KEYED_VALIDATED: {
+					valid = has_space(5) && are_addresses(1, 3) && is_index(4, p_function->keyed_setters.size());
+				} break;
+				case GDScriptFunction::OPCODE_SET_INDEXED_VALIDATED: {
+					valid = has_space(5) && are_addresses(1, 3) && is_index(4, p_function->indexed_setters.size());
+				} break;
+				case GDScriptFunction::OPCODE_GET_KEYED_VALIDATED: {
+					valid = has_space(5) && are_addresses(1, 3) && is_index(4, p_function->keyed_getters.size());
+				} break;
+				case GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED: {
+					valid = has_space(5) && are_addresses(1, 3) && is_index(4, p_function->indexed_getters.size());
+				} break;
+				case GDScriptFunction::OPCODE_SET_NAMED:
+				case GDScriptFunction::OPCODE_GET_NAMED: {
+					valid = has_space(5) && are_addresses(1, 2) && is_name(3) && is_index(4, p_function->_inline_caches_count);
+				} break;
+				case GDScriptFunction::OPCODE_SET_NAMED_VALIDATED: {
+					valid = has_space(4) && are_addresses(1, 2) && is_index(3, p_function->setters.size());
+				} break;
+				case GDScriptFunction::OPCODE_GET_NAMED_VALIDATED: {
+					valid = has_space(4) && are_addresses(1, 2) && is_index(3, p_function->getters.size());
+				} break;
+				case GDScriptFunction::OPCODE_SET_MEMBER:
+				case GDScriptFunction::OPCODE_GET_MEMBER:
+				case GDScriptFunction::OPCODE_STORE_NAMED_GLOBAL: {
+					valid = has_space(3) && is_address(1) && is_name(2);
+				} break;
+				case GDScriptFunction::OPCODE_SET_STATIC_VARIABLE:
+				case GDScriptFunction::OPCODE_GET_STATIC_VARIABLE: {
+					// The index is checked against the class at run time.
+					valid = has_space(4) && are_addresses(1, 2) && code[ip + 3] >= 0;
+				} break;
+				case GDScriptFunction::OPCODE_ASSIGN: {
+					valid = has_space(3) && are_addresses(1, 2);
+				} break;
+				case GDScriptFunction::OPCODE_ASSIGN_NULL:
+				case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+				case GDScriptFunction::OPCODE_ASSIGN_FALSE:
+				case GDScriptFunction::OPCODE_AWAIT_RESUME:
+				case GDScriptFunction::OPCODE_RETURN: {
+					valid = has_space(2) && is_address(1);
+				} break;
+				case GDScriptFunction::OPCODE_CONSTRUCT: {
+					valid = has_instruction_args(2) && fits_instruction_args(argc_base, 1, 1) && is_type(argc_base + 1);
+				} break;
+				case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED: {
+					valid = has_instruction_args(2) && fits_instruction_args(argc_base, 1, 1) && is_index(argc_base + 1, p_function->constructors.size());
+				} break;
+				case GDScriptFunction::OPCODE_CONSTRUCT_ARRAY: {
+					valid = has_instruction_args(1) && fits_instruction_args(argc_base, 1, 1);
+				} break;
+				case GDScriptFunction::OPCODE_CONSTRUCT_TYPED_ARRAY: {
+					valid = has_instruction_args(3) && fits_instruction_args(argc_base, 1, 2) && is_type(argc_base + 1) && is_name(argc_base + 2);
+				} break;
+				case GDScriptFunction::OPCODE_CONSTRUCT_DICTIONARY: {
+					valid = has_instruction_args(1) && fits_instruction_args(argc_base, 2, 1);
+				} break;
+				case GDScriptFunction::OPCODE_CONSTRUCT_TYPED_DICTIONARY: {
+					valid = has_instruction_args(5) && fits_instruction_args(argc_base, 2, 3) && is_type(argc_base + 1) && is_name(argc_base + 2) && is_type(argc_base + 3) && is_name(argc_base + 4);
+				} break;
+				case GDScriptFunction::OPCODE_CALL:
+				case GDScriptFunction::OPCODE_CALL_RETURN:
+				case GDScriptFunction::OPCODE_CALL_ASYNC: {
+					const int extra = opcode == GDScriptFunction::OPCODE_CALL ? 1 : 2;
+					valid = has_instruction_args(3) && fits_instruction_args(argc_base, 1, extra) && is_name(argc_base + 1) && is_index(argc_base + 2, p_function->_inline_caches_count);
+				} break;
+				case GDScriptFunction::OPCODE_CALL_METHOD_BIND:
+				case GDScriptFunction::OPCODE_CALL_METHOD_BIND_RET: {
+					const int extra = opcode == GDScriptFunction::OPCODE_CALL_METHOD_BIND ? 1 : 2;
+					valid = has_instruction_args(2) && fits_instruction_args(argc_base, 1, extra) && is_index(argc_base + 1, p_function->methods.size());
+				} break;
+				case GDScriptFunction::OPCODE_CALL_BUILTIN_STATIC: {
+					valid = has_instruction_args(3) && is_type(argc_base) && is_name(argc_base + 1) && fits_instruction_args(argc_base + 2, 1, 1);
+				} break;
+				case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC: {
+					valid = has_instruction_args(2) && is_index(argc_base, p_function->methods.size()) && fits_instruction_args(argc_base + 1, 1, 1);
+				} break;
+				case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_RETURN:
+				case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_NO_RETURN: {
+					valid = has_instruction_args(2) && fits_instruction_args(argc_base, 1, 1) && is_index(argc_base + 1, p_function->methods.size());
+				} break;
+				case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN:
+				case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN: {
+					valid = has_instruction_args(2) && fits_instruction_args(argc_base, 1, 2) && is_index(argc_base + 1, p_function->methods.size());
+				} break;
+				case GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED: {
+					valid = has_instruction_args(2) && fits_instruction_args(argc_base, 1, 2) && is_index(argc_base + 1, p_function->builtin_methods.size());
+				} break;
+				case GDScriptFunction::OPCODE_CALL_UTILITY:
+				case GDScriptFunction::OPCODE_CALL_SELF_BASE: {
+					valid = has_instruction_args(2) && fits_instruction_args(argc_base, 1, 1) && is_name(argc_base + 1);
+				} break;
+				case GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED: {
+					valid = has_instruction_args(2) && fits_instruction_args(argc_base, 1, 1) && is_index(argc_base + 1, p_function->utilities.size());
+				} break;
+				case GDScriptFunction::OPCODE_CALL_GDSCRIPT_UTILITY: {
+					valid = has_instruction_args(2) && fits_instruction_args(argc_base, 1, 1) && is_index(argc_base + 1, p_function->gds_utilities.size());
+				} break;
+				case GDScriptFunction::OPCODE_AWAIT: {
+					// Always followed by OPCODE_AWAIT_RESUME, which it may skip over.
+					valid = has_space(2) && is_address(1) && ip + 2 < code_size && code[ip + 2] == GDScriptFunction::OPCODE_AWAIT_RESUME;
+				} break;
+				case GDScriptFunction::OPCODE_CREATE_LAMBDA:
+				case GDScriptFunction::OPCODE_CREATE_SELF_LAMBDA: {
+					valid = has_instruction_args(2) && fits_instruction_args(argc_base, 1, 1) && is_index(argc_base + 1, p_function->lambdas.size());
+				} break;
+				case GDScriptFunction::OPCODE_JUMP: {
+					valid = has_space(2) && is_jump(1);
+				} break;
+				case GDScriptFunction::OPCODE_JUMP_IF:
+				case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+				case GDScriptFunction::OPCODE_JUMP_IF_SHARED: {
+					valid = has_space(3) && is_address(1) && is_jump(2);
+				} break;
+				case GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT:
+				case GDScriptFunction::OPCODE_BREAKPOINT:
+				case GDScriptFunction::OPCODE_END: {
+					valid = has_space(1);
+				} break;
+				case GDScriptFunction::OPCODE_RETURN_TYPED_BUILTIN: {
+					valid = has_space(3) && is_address(1) && is_type(2);
+				} break;
+				case GDScriptFunction::OPCODE_RETURN_TYPED_ARRAY: {
+					valid = has_space(5) && are_addresses(1, 2) && is_type(3) && is_name(4);
+				} break;
+				case GDScriptFunction::OPCODE_RETURN_TYPED_DICTIONARY: {
+					valid = has_space(8) && are_addresses(1, 3) && is_type(4) && is_name(5) && is_type(6) && is_name(7);
+				} break;
+				case GDScriptFunction::OPCODE_RETURN_TYPED_NATIVE:
+				case GDScriptFunction::OPCODE_RETURN_TYPED_SCRIPT: {
+					valid = has_space(3) && are_addresses(1, 2);
+				} break;
+				case GDScriptFunction::OPCODE_STORE_GLOBAL: {
+					valid = has_space(3) && is_address(1) && is_index(2, p_function->global_indices.size());
+				} break;
+				case GDScriptFunction::OPCODE_ASSERT: {
+					// The message is optional.
+					valid = has_space(3) && is_address(1) && (code[ip + 2] == 0 || is_address(2));
+				} break;
+				case GDScriptFunction::OPCODE_LINE: {
+					valid = has_space(2);
+				} break;
+				default: {
+					if (opcode >= GDScriptFunction::OPCODE_OPERATOR_ADD_INT && opcode <= GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT) {
+						valid = has_space(4) && are_addresses(1, 3);
+					} else if (opcode >= GDScriptFunction::OPCODE_ITERATE_BEGIN && opcode <= GDScriptFunction::OPCODE_ITERATE_OBJECT) {
+						valid = has_space(5) && are_addresses(1, 3) && is_jump(4);
+					} else if (opcode >= GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL && opcode <= GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY) {
+						valid = has_space(2) && is_address(1);
+					}
+				} break;
+			}
+
+			if (!valid) {
+				return false;
+			}
+			if (ip + length == code_size && opcode != GDScriptFunction::OPCODE_END) {
+				// Execution must never run past the end of the code.
+				return false;
+			}
+			ip += length;
+		}
+
+		for (int E : jump_targets) {
+			if (E < 0 || E >= code_size || !instruction_starts[E]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool read_function(GDScriptFunction *p_function, GDScript *p_script) {
+		p_function->name = read_string_name();
+		p_function->source = p_script->get_script_path();
+#ifdef DEBUG_ENABLED
+		p_function->func_cname = (String(p_function->source) + " - " + String(p_function->name)).utf8();
+		p_function->_func_cname = p_function->func_cname.get_data();
+#endif
+		p_function->_static = f->get_8();
+
+		int count = 0;
+		if (!read_count(count)) {
+			return false;
+		}
+		p_function->argument_types.resize(count);
+		for (int i = 0; i < count; i++) {
+			if (!read_data_type(p_function->argument_types.write[i])) {
+				return false;
+			}
+		}
+		if (!read_data_type(p_function->return_type) || !read_method_info(p_function->method_info) || !read_variant(p_function->rpc_config)) {
+			return false;
+		}
+
+		p_function->_initial_line = f->get_32();
+		p_function->_argument_count = f->get_32();
+		p_function->_stack_size = f->get_32();
+		p_function->_instruction_args_size = f->get_32();
+		p_function->_default_arg_count = f->get_32();
+
+		if (!read_count(count)) {
+			return false;
+		}
+		for (int i = 0; i < count; i++) {
+			int slot = f->get_32();
+			Variant::Type type = Variant::NIL;
+			if (!read_type(type)) {
+				return false;
+			}
+			p_function->temporary_slots[slot] = type;
+		}
+
+		if (!read_ints(p_function->code) || !read_ints(p_function->default_arguments)) {
+			return false;
+		}
+
+		if (!read_count(count)) {
+			return false;
+		}
+		p_function->constants.resize(count);
+		for (int i = 0; i < count; i++) {
+			if (!read_variant(p_function->constants.write[i])) {
+				return false;
+			}
+		}
+
+		if (!read_count(count)) {
+			return false;
+		}
+		p_function->global_names.resize(count);
+		for (int i = 0; i < count; i++) {
+			p_function->global_names.write[i] = read_string_name();
+		}
+
+		if (!read_count(count)) {
+			return false;
+		}
+		p_function->global_indices.resize(count);
+		for (int i = 0; i < count; i++) {
+			const HashMap<StringName, int>::ConstIterator E = GDScriptLanguage::get_singleton()->get_global_map().find(read_string_name());
+			if (!E) {
+				return false;
+			}
+			p_function->global_indices.write[i] = E->value;
+		}
+
+		if (!read_count(count)) {
+			return false;
+		}
+		p_function->operator_funcs.resize(count);
+		for (int i = 0; i < count; i++) {
+			uint32_t op = f->get_32();
+			Variant::Type type_a = Variant::NIL;
+			Variant::Type type_b = Variant::NIL;
+			if (op >= Variant::OP_MAX || !read_type(type_a) || !read_type(type_b)) {
+				return false;
+			}
+			Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator((Variant::Operator)op, type_a, type_b);
+			if (!evaluator) {
+				return false;
+			}
+			p_function->operator_funcs.write[i] = evaluator;
+		}
+
+		if (!read_count(count)) {
+			return false;
+		}
+		p_function->setters.resize(count);
+		for (int i = 0; i < count; i++) {
+			Variant::Type type = Variant::NIL;
+			if (!read_type(type)) {
+				return false;
+			}
+			Variant::ValidatedSetter setter = Variant::get_member_validated_setter(type, read_string_name());
+			if (!setter) {
+				return false;
+			}
+			p_function->setters.write[i] = setter;
+		}
+
+		if (!read_count(count)) {
+			return false;
+		}
+		p_function->getters.resize(count);
+		for (int i = 0; i < count; i++) {
+			Variant::Type type = Variant::NIL;
+			if (!read_type(type)) {
+				return false;
+			}
+			Variant::ValidatedGetter getter = Variant::get_member_validated_getter(type, read_string_name());
+			if (!getter) {
+				return false;
+			}
+			p_function->getters.write[i] = getter;
+		}
+
+		if (!read_count(count)) {
+			return false;
+		}
+		p_function->keyed_setters.resize(count);
+		for (int i = 0; i < count; i++) {
+			Variant::Type type = Variant::NIL;
+			if (!read_type(type)) {
+				return false;
+			}
+			p_function->keyed_setters.write[i] = Variant::get_member_validated_keyed_setter(type);
+			if (!p_function->keyed_setters[i]) {
+				return false;
+			}
+		}
+
+		if (!read_count(count)) {
+			return false;
+		}
+		p_function->keyed_getters.resize(count);
+		for (int i = 0; i < count; i++) {
+			Variant::Type type = Variant::NIL;
+			if (!read_type(type)) {
+				return false;
+			}
+			p_function->keyed_getters.write[i] = Variant::get_member_validated_keyed_getter(type);
+			if (!p_function->keyed_getters[i]) {
+				return false;
+			}
+		}
+
+		if (!read_count(count)) {
+			return false;
+		}
+		p_function->indexed_setters.resize(count);
+		for (int i = 0; i < count; i++) {
+			Variant::Type type = Variant::NIL;
+			if (!read_type(type)) {
+				return false;
+			}
+			p_function->indexed_setters.write[i] = Variant::get_member_validated_indexed_setter(type);
+			if (!p_function->indexed_setters[i]) {
+				return false;
+			}
+		}
+
+		if (!read_count(count)) {
+			return false;
+		}
+		p_function->indexed_getters.resize(count);
+		for (int i = 0; i < count; i++) {
+			Variant::Type type = Variant::NIL;
+			if (!read_type(type)) {
+				return false;
+			}
+			p_function->indexed_getters.write[i] = Variant::get_member_validated_indexed_getter(type);
+			if (!p_function->indexed_getters[i]) {
+				return false;
+			}
+		}
+
+		if (!read_count(count)) {
+			return false;
+		}
+		p_function->builtin_methods.resize(count);
+		for (int i = 0; i < count; i++) {
+			Variant::Type type = Variant::NIL;
+			if (!read_type(type)) {
+				return false;
+			}
+			Variant::ValidatedBuiltInMethod method = Variant::get_validated_builtin_method(type, read_string_name());
+			if (!method) {
+				return false;
+			}
+			p_function->builtin_methods.write[i] = method;
+		}
+
+		if (!read_count(count)) {
+			return false;
+		}
+		p_function->constructors.resize(count);
+		for (int i = 0; i < count; i++) {
+			Variant::Type type = Variant::NIL;
+			if (!read_type(type)) {
+				return false;
+			}
+			int index = f->get_32();
+			if (index < 0 || index >= Variant::get_constructor_count(type)) {
+				return false;
+			}
+			p_function->constructors.write[i] = Variant::get_validated_constructor(type, index);
+		}
+
+		if (!read_count(count)) {
+			return false;
+		}
+		p_function->utilities.resize(count);
+		for (int i = 0; i < count; i++) {
+			Variant::ValidatedUtilityFunction utility = Variant::get_validated_utility_function(read_string_name());
+			if (!utility) {
+				return false;
+			}
+			p_function->utilities.write[i] = utility;
+		}
+
+		if (!read_count(count)) {
+			return false;
+		}
+		p_function->gds_utilities.resize(count);
+		for (int i = 0; i < count; i++) {
+			GDScriptUtilityFunctions::FunctionPtr utility = GDScriptUtilityFunctions::get_function(read_string_name());
+			if (!utility) {
+				return false;
+			}
+			p_function->gds_utilities.write[i] = utility;
+		}
+
+		if (!read_count(count)) {
+			return false;
+		}
+		p_function->methods.resize(count);
+		for (int i = 0; i < count; i++) {
+			StringName class_name = read_string_name();
+			MethodBind *method = ClassDB::get_method(class_name, read_string_name());
+			if (!method) {
+				return false;
+			}
+			p_function->methods.write[i] = method;
+		}
+
+		if (!read_count(count)) {
+			return false;
+		}
+		for (int i = 0; i < count; i++) {
+			bool has_info = f->get_8();
+			GDScript::LambdaInfo info = { 0, false };
+			if (has_info) {
+				info.capture_count = f->get_32();
+				info.use_self = f->get_8();
+			}
+			GDScriptFunction *lambda = read_function(p_script);
+			if (!lambda) {
+				return false;
+			}
+			// Owned by the function from now on.
+			p_function->lambdas.push_back(lambda);
+			if (has_info) {
+				p_script->lambda_info.insert(lambda, info);
+			}
+		}
+
+		int inline_caches_count = f->get_32();
+		if (inline_caches_count < 0 || inline_caches_count > p_function->code.size()) {
+			return false;
+		}
+		if (inline_caches_count) {
+			p_function->_inline_caches_ptr = memnew_arr(GDScriptFunction::InlineCache, inline_caches_count);
+		}
+		p_function->_inline_caches_count = inline_caches_count;
+
+		if (f->get_8()) {
+			uint64_t hash = f->get_64();
+			uint64_t native_hash = 0;
+			GDScriptNativeFunctions::Function native_function = GDScriptNativeFunctions::find_function(p_script->fully_qualified_name, p_function->name, native_hash);
+			if (native_function && native_hash == hash) {
+				p_function->native_function = native_function;
+			}
+		}
+
+#ifdef DEBUG_ENABLED
+		Vector<String> *debug_names[] = {
+			&p_function->operator_names,
+			&p_function->setter_names,
+			&p_function->getter_names,
+			&p_function->builtin_methods_names,
+			&p_function->constructors_names,
+			&p_function->utilities_names,
+			&p_function->gds_utilities_names,
+		};
+		for (Vector<String> *E : debug_names) {
+			if (!read_count(count)) {
+				return false;
+			}
+			E->resize(count);
+			for (int i = 0; i < count; i++) {
+				E->write[i] = read_string();
+			}
+		}
+#endif
+
+		if (!is_valid() || !verify_code(p_function, p_script)) {
+			return false;
+		}
+
+		// Same as `GDScriptByteCodeGenerator::write_end()`.
+		p_function->_code_size = p_function->code.size();
+		p_function->_code_ptr = p_function->code.is_empty() ? nullptr : p_function->code.ptrw();
+		p_function->_default_arg_ptr = p_function->default_arguments.is_empty() ? nullptr : p_function->default_arguments.ptr();
+		p_function->_constant_count = p_function->constants.size();
+		p_function->_constants_ptr = p_function->constants.is_empty() ? nullptr : p_function->constants.ptrw();
+		p_function->_global_names_count = p_function->global_names.size();
+		p_function->_global_names_ptr = p_function->global_names.is_empty() ? nullptr : p_function->global_names.ptr();
+		p_function->_global_indices_count = p_function->global_indices.size();
+		p_function->_global_indices_ptr = p_function->global_indices.is_empty() ? nullptr : p_function->global_indices.ptr();
+		p_function->_operator_funcs_count = p_function->operator_funcs.size();
+		p_function->_operator_funcs_ptr = p_function->operator_funcs.is_empty() ? nullptr : p_function->operator_funcs.ptr();
+		p_function->_setters_count = p_function->setters.size();
+		p_function->_setters_ptr = p_function->setters.is_empty() ? nullptr : p_function->setters.ptr();
+		p_function->_getters_count = p_function->getters.size();
+		p_function->_getters_ptr = p_function->getters.is_empty() ? nullptr : p_function->getters.ptr();
+		p_function->_keyed_setters_count = p_function->keyed_setters.size();
+		p_function->_keyed_setters_ptr = p_function->keyed_setters.is_empty() ? nullptr : p_function->keyed_setters.ptr();
+		p_function->_keyed_getters_count = p_function->keyed_getters.size();
+		p_function->_keyed_getters_ptr = p_function->keyed_getters.is_empty() ? nullptr : p_function->keyed_getters.ptr();
+		p_function->_indexed_setters_count = p_function->indexed_setters.size();
+		p_function->_indexed_setters_ptr = p_function->indexed_setters.is_empty() ? nullptr : p_function->indexed_setters.ptr();
+		p_function->_indexed_getters_count = p_function->indexed_getters.size();
+		p_function->_indexed_getters_ptr = p_function->indexed_getters.is_empty() ? nullptr : p_function->indexed_getters.ptr();
+		p_function->_builtin_methods_count = p_function->builtin_methods.size();
+		p_function->_builtin_methods_ptr = p_function->builtin_methods.is_empty() ? nullptr : p_function->builtin_methods.ptr();
+		p_function->_constructors_count = p_function->constructors.size();
+		p_function->_constructors_ptr = p_function->constructors.is_empty() ? nullptr : p_function->constructors.ptr();
+		p_function->_utilities_count = p_function->utilities.size();
+		p_function->_utilities_ptr = p_function->utilities.is_empty() ? nullptr : p_function->utilities.ptr();
+		p_function->_gds_utilities_count = p_function->gds_utilities.size();
+		p_function->_gds_utilities_ptr = p_function->gds_utilities.is_empty() ? nullptr : p_function->gds_utilities.ptr();
+		p_function->_methods_count = p_function->methods.size();
+		p_function->_methods_ptr = p_function->methods.is_empty() ? nullptr : p_function->methods.ptrw();
+		p_function->_lambdas_count = p_function->lambdas.size();
+		p_function->_lambdas_ptr = p_function->lambdas.is_empty() ? nullptr : p_function->lambdas.ptrw();
+		return true;
+	}
+
+	GDScriptFunction *read_function(GDScript *p_script) {
+		GDScriptFunction *function = memnew(GDScriptFunction);
+		function->_script = p_script;
+		if (!read_function(function, p_script)) {
+			// The destructor removes the function from the script by name, it was never added.
+			function->name = StringName();
+			memdelete(function);
+			return nullptr;
+		}
+		return function;
+	}
+
+	bool read_class(GDScript *p_script) {
+		p_script->tool = f->get_8();
+
+		const HashMap<StringName, int>::ConstIterator native_index = GDScriptLanguage::get_singleton()->get_global_map().find(read_string_name());
+		if (!native_index) {
+			return false;
+		}
+		p_script->native = GDScriptLanguage::get_singleton()->get_global_array()[native_index->value];
+		if (p_script->native.is_null()) {
+			return false;
+		}
+
+		Ref<Script> base;
+		if (!read_script(base)) {
+			return false;
+		}
+		if (base.is_valid()) {
+			Ref<GDScript> base_gdscript = base;
+			if (base_gdscript.is_null()) {
+				return false;
+			}
+			p_script->base = base_gdscript;
+			p_script->_base = base_gdscript.ptr();
+		}
+
+		int count = 0;
+		if (!read_count(count)) {
+			return false;
+		}
+		for (int i = 0; i < count; i++) {
+			StringName name = read_string_name();
+			if (!read_member_info(p_script->member_indices[name])) {
+				return false;
+			}
+		}
+
+		if (!read_count(count)) {
+			return false;
+		}
+		for (int i = 0; i < count; i++) {
+			p_script->members.insert(read_string_name());
+		}
+
+		if (!read_count(count)) {
+			return false;
+		}
+		for (int i = 0; i < count; i++) {
+			StringName name = read_string_name();
+			if (!read_member_info(p_script->static_variables_indices[name])) {
+				return false;
+			}
+		}
+		p_script->static_variables.resize(p_script->static_variables_indices.size());
+
+		if (!read_count(count)) {
+			return false;
+		}
+		for (int i = 0; i < count; i++) {
+			StringName name = read_string_name();
+			if (!read_variant(p_script->constants[name])) {
+				return false;
+			}
+		}
+
+		if (!read_count(count)) {
+			return false;
+		}
+		for (int i = 0; i < count; i++) {
+			StringName name = read_string_name();
+			if (!read_method_info(p_script->_signals[name])) {
+				return false;
+			}
+		}
+
+		Variant rpc_config;
+		if (!read_variant(rpc_config) || rpc_config.get_type() != Variant::DICTIONARY) {
+			return false;
+		}
+		p_script->rpc_config = rpc_config;
+
+		if (!read_count(count)) {
+			return false;
+		}
+		for (int i = 0; i < count; i++) {
+			StringName name = read_string_name();
+			GDScriptFunction *function = read_function(p_script);
+			if (!function) {
+				return false;
+			}
+			p_script->member_functions[name] = function;
+		}
+		if (f->get_8()) {
+			GDScriptFunction **initializer = p_script->member_functions.getptr(GDScriptLanguage::get_singleton()->strings._init);
+			if (!initializer) {
+				return false;
+			}
+			p_script->initializer = *initializer;
+		}
+
+		p_script->implicit_initializer = read_function(p_script);
+		if (!p_script->implicit_initializer) {
+			return false;
+		}
+		if (f->get_8()) {
+			p_script->implicit_ready = read_function(p_script);
+			if (!p_script->implicit_ready) {
+				return false;
+			}
+		}
+		if (f->get_8()) {
+			p_script->static_initializer = read_function(p_script);
+			if (!p_script->static_initializer) {
+				return false;
+			}
+		}
+
+		if (!read_count(count) || count != (int)p_script->subclasses.size()) {
+			return false;
+		}
+		for (int i = 0; i < count; i++) {
+			Ref<GDScript> *subclass = p_script->subclasses.getptr(read_string_name());
+			if (!subclass || !read_class(subclass->ptr())) {
+				return false;
+			}
+		}
+		return is_valid();
+	}
+
+	bool read_skeleton(Vector<Skeleton> &r_skeleton, int p_depth = 0) {
+		if (p_depth > Variant::MAX_RECURSION_DEPTH) {
+			return false;
+		}
+
+		Skeleton skeleton;
+		skeleton.local_name = read_string_name();
+		skeleton.global_name = read_string_name();
+		skeleton.fully_qualified_name = read_string();
+		skeleton.simplified_icon_path = read_string();
+		if (!read_count(skeleton.subclass_count)) {
+			return false;
+		}
+		r_skeleton.push_back(skeleton);
+		for (int i = 0; i < skeleton.subclass_count; i++) {
+			if (!read_skeleton(r_skeleton, p_depth + 1)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static bool is_compiled(const GDScript *p_script) {
+		if (p_script->implicit_initializer || !p_script->member_functions.is_empty() || !p_script->constants.is_empty()) {
+			return true;
+		}
+		for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+			if (is_compiled(E.value.ptr())) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Same as the end of `GDScriptCompiler::_compile_class()`.
+	static void set_valid(GDScript *p_script) {
+		for (KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+			set_valid(E.value.ptr());
+		}
+		p_script->_static_default_init();
+		p_script->valid = true;
+	}
+
+	// Same as `GDScriptCompiler::make_scripts()`, from the pre-order list read by `read_skeleton()`.
+	static void apply_skeleton(GDScript *p_script, const Vector<Skeleton> &p_skeleton, int &r_index) {
+		const Skeleton &skeleton = p_skeleton[r_index++];
+		p_script->fully_qualified_name = skeleton.fully_qualified_name;
+		p_script->local_name = skeleton.local_name;
+		p_script->global_name = skeleton.global_name;
+		p_script->simplified_icon_path = skeleton.simplified_icon_path;
+
+		HashMap<StringName, Ref<GDScript>> old_subclasses = p_script->subclasses;
+		p_script->subclasses.clear();
+
+		for (int i = 0; i < skeleton.subclass_count; i++) {
+			const Skeleton &inner_skeleton = p_skeleton[r_index];
+
+			Ref<GDScript> subclass;
+			if (old_subclasses.has(inner_skeleton.local_name)) {
+				subclass = old_subclasses[inner_skeleton.local_name];
+			} else {
+				subclass = GDScriptLanguage::get_singleton()->get_orphan_subclass(inner_skeleton.fully_qualified_name);
+			}
+
+			if (subclass.is_null()) {
+				subclass.instantiate();
+			}
+
+			subclass->_owner = p_script;
+			subclass->path = p_script->path;
+			p_script->subclasses.insert(inner_skeleton.local_name, subclass);
+
+			apply_skeleton(subclass.ptr(), p_skeleton, r_index);
+		}
+	}
+};
+
+Mutex GDScriptBytecodeCache::mutex;
+GDScriptBytecodeCache::Names *GDScriptBytecodeCache::names = nullptr;
+String GDScriptBytecodeCache::cache_path;
+String GDScriptBytecodeCache::engine_key;
+HashMap<String, String> GDScriptBytecodeCache::file_hashes;
+HashMap<String, HashMap<String, String>> GDScriptBytecodeCache::session_dependencies;
+
+const GDScriptBytecodeCache::Names *GDScriptBytecodeCache::_get_names() {
+	MutexLock lock(mutex);
+	if (!names) {
+		names = memnew(Names);
+	}
+	return names;
+}
+
+String GDScriptBytecodeCache::_get_file_hash(const String &p_path) {
+	{
+		MutexLock lock(mutex);
+		const String *hash = file_hashes.getptr(p_path);
+		if (hash) {
+			return *hash;
+		}
+	}
+
+	String hash = FileAccess::get_md5(ResourceLoader::path_remap(p_path));
+
+	MutexLock lock(mutex);
+	file_hashes[p_path] = hash;
+	return hash;
+}
+
+String GDScriptBytecodeCache::_get_source_hash(const GDScript *p_script) {
+	if (p_script->binary_tokens.is_empty()) {
+		return p_script->source.md5_text();
+	}
+	unsigned char hash[16];
+	CryptoCore::md5(p_script->binary_tokens.ptr(), p_script->binary_tokens.size(), hash);
+	return String::hex_encode_buffer(hash, 16);
+}
+
+String GDScriptBytecodeCache::_get_engine_key() {
+	MutexLock lock(mutex);
+	if (!engine_key.is_empty()) {
+		return engine_key;
+	}
+
+	// Bytecode depends on the opcode set and on which code paths the build compiled in. Custom builds
+	// may have no commit hash, so the modification time of the executable tells builds apart too.
+	String key = vformat("%s.%s.%d.%d.%d.%d.%d.%d", VERSION_FULL_BUILD, VERSION_HASH, FORMAT_VERSION, GDScriptFunction::OPCODE_END, Variant::VARIANT_MAX, Variant::OP_MAX, GDScriptFunction::ADDR_BITS, (int)sizeof(void *));
+	key += "." + itos(FileAccess::get_modified_time(OS::get_singleton()->get_executable_path()));
+#ifdef DEBUG_ENABLED
+	key += ".debug";
+#endif
+#ifdef TOOLS_ENABLED
+	key += ".tools";
+#endif
+#ifdef REAL_T_IS_DOUBLE
+	key += ".double";
+#endif
+	engine_key = key;
+	return key;
+}
+
+bool GDScriptBytecodeCache::_get_body_checksum(const Ref<FileAccess> &p_file, uint64_t p_from, uint8_t r_checksum[16]) {
+	p_file->seek(p_from);
+
+	CryptoCore::MD5Context ctx;
+	ctx.start();
+	uint8_t buffer[4096];
+	while (true) {
+		uint64_t read = p_file->get_buffer(buffer, sizeof(buffer));
+		if (read == 0) {
+			break;
+		}
+		ctx.update(buffer, read);
+	}
+	ctx.finish(r_checksum);
+	return p_file->get_error() == OK || p_file->get_error() == ERR_FILE_EOF;
+}
+
+String GDScriptBytecodeCache::_get_entry_path(const String &p_path) {
+	return get_cache_path().path_join(p_path.md5_text() + ".gdbc");
+}
+
+bool GDScriptBytecodeCache::_is_cacheable(const GDScript *p_script) {
+	return p_script->is_root_script() && p_script->path.is_resource_file();
+}
+
+Ref<FileAccess> GDScriptBytecodeCache::_open_entry(const GDScript *p_script) {
+	Error err = OK;
+	Ref<FileAccess> f = FileAccess::open(_get_entry_path(p_script->path), FileAccess::READ, &err);
+	if (f.is_null()) {
+		return Ref<FileAccess>();
+	}
+
+	uint8_t magic[4] = {};
+	f->get_buffer(magic, 4);
+	if (magic[0] != 'G' || magic[1] != 'D' || magic[2] != 'B' || magic[3] != 'C') {
+		return Ref<FileAccess>();
+	}
+	if (f->get_pascal_string() != _get_engine_key() || f->get_pascal_string() != _get_source_hash(p_script)) {
+		return Ref<FileAccess>();
+	}
+
+	uint8_t checksum[16] = {};
+	f->get_buffer(checksum, 16);
+	const uint64_t body_start = f->get_position();
+	uint8_t body_checksum[16] = {};
+	if (!_get_body_checksum(f, body_start, body_checksum) || memcmp(checksum, body_checksum, 16) != 0) {
+		return Ref<FileAccess>();
+	}
+	f->seek(body_start);
+	return f;
+}
+
+void GDScriptBytecodeCache::set_cache_path(const String &p_path) {
+	MutexLock lock(mutex);
+	cache_path = p_path;
+}
+
+String GDScriptBytecodeCache::get_cache_path() {
+	MutexLock lock(mutex);
+	return cache_path.is_empty() ? String(CACHE_DIR) : cache_path;
+}
+
+bool GDScriptBytecodeCache::is_enabled() {
+	if (Engine::get_singleton()->is_editor_hint() || EngineDebugger::is_active()) {
+		// The editor reloads scripts as they are edited, and the debugger needs line information.
+		return false;
+	}
+	return GLOBAL_GET("gdscript/bytecode_cache/enabled");
+}
+
+bool GDScriptBytecodeCache::make_scripts(GDScript *p_script) {
+	if (!is_enabled() || !_is_cacheable(p_script)) {
+		return false;
+	}
+
+	Ref<FileAccess> f = _open_entry(p_script);
+	if (f.is_null()) {
+		return false;
+	}
+
+	Reader reader;
+	reader.f = f;
+	reader.root = p_script;
+
+	f->get_64(); // Dependencies offset.
+	Vector<Reader::Skeleton> skeleton;
+	if (!reader.read_skeleton(skeleton) || !reader.is_valid()) {
+		return false;
+	}
+
+	int index = 0;
+	Reader::apply_skeleton(p_script, skeleton, index);
+	return true;
+}
+
+bool GDScriptBytecodeCache::load_script(GDScript *p_script, bool &r_has_static_data) {
+	if (!is_enabled() || !_is_cacheable(p_script)) {
+		return false;
+	}
+
+	Ref<FileAccess> f = _open_entry(p_script);
+	if (f.is_null()) {
+		return false;
+	}
+
+	Reader reader;
+	reader.f = f;
+	reader.root = p_script;
+
+	uint64_t dependencies_offset = f->get_64();
+	Vector<Reader::Skeleton> skeleton;
+	if (!reader.read_skeleton(skeleton) || !reader.is_valid()) {
+		return false;
+	}
+	uint64_t body_offset = f->get_position();
+
+	// The analyzer may have inferred types from any of these, they must be unchanged.
+	if (dependencies_offset < body_offset || dependencies_offset >= f->get_length()) {
+		return false;
+	}
+	f->seek(dependencies_offset);
+	int count = 0;
+	if (!reader.read_count(count)) {
+		return false;
+	}
+	HashMap<String, String> dependencies;
+	Vector<String> direct_dependencies;
+	for (int i = 0; i < count; i++) {
+		String path = reader.read_string();
+		String hash = reader.read_string();
+		bool direct = f->get_8();
+		if (!reader.is_valid()) {
+			return false;
+		}
+		if (_get_file_hash(path) != hash) {
+			print_verbose(vformat(R"(GDScript: Cached bytecode of "%s" is outdated, "%s" changed.)", p_script->path, path));
+			return false;
+		}
+		dependencies[path] = hash;
+		if (direct) {
+			direct_dependencies.push_back(path);
+		}
+	}
+	f->seek(body_offset);
+
+	int index = 0;
+	Reader::apply_skeleton(p_script, skeleton, index);
+	if (Reader::is_compiled(p_script)) {
+		return false;
+	}
+
+	r_has_static_data = f->get_8();
+	if (!reader.read_class(p_script)) {
+		print_verbose(vformat(R"(GDScript: Could not restore the cached bytecode of "%s".)", p_script->path));
+		return false;
+	}
+
+	// Record the same dependencies as the compiler would, so that `GDScriptCache::finish_compiling()` compiles them.
+	for (const String &E : direct_dependencies) {
+		Error err = OK;
+		GDScriptCache::get_shallow_script(E, err, p_script->path);
+	}
+
+	Reader::set_valid(p_script);
+	GDScriptLanguage::get_singleton()->invalidate_inline_caches(p_script);
+
+	MutexLock lock(mutex);
+	session_dependencies[p_script->path] = dependencies;
+	return true;
+}
+
+void GDScriptBytecodeCache::save_script(GDScript *p_script, bool p_has_static_data) {
+	if (!is_enabled() || !_is_cacheable(p_script)) {
+		return;
+	}
+
+	Writer writer;
+	writer.root = p_script;
+	writer.names = _get_names();
+	for (const KeyValue<StringName, int> &E : GDScriptLanguage::get_singleton()->get_global_map()) {
+		writer.globals[E.value] = E.key;
+	}
+
+	const String entry_path = _get_entry_path(p_script->path);
+	const String temp_path = entry_path + ".tmp";
+
+	DirAccess::make_dir_recursive_absolute(get_cache_path());
+	Error err = OK;
+	// Read back to compute the checksum.
+	writer.f = FileAccess::open(temp_path, FileAccess::WRITE_READ, &err);
+	ERR_FAIL_COND_MSG(writer.f.is_null(), vformat(R"(Cannot write the GDScript bytecode cache file "%s".)", temp_path));
+	Ref<FileAccess> f = writer.f;
+
+	f->store_buffer((const uint8_t *)"GDBC", 4);
+	writer.write_string(_get_engine_key());
+	writer.write_string(_get_source_hash(p_script));
+	const uint64_t checksum_position = f->get_position();
+	uint8_t checksum[16] = {};
+	f->store_buffer(checksum, 16); // Checksum of everything that follows, filled in once written.
+	const uint64_t body_start = f->get_position();
+	uint64_t dependencies_offset_position = f->get_position();
+	f->store_64(0); // Dependencies offset, filled in once known.
+	writer.write_skeleton(p_script);
+	f->store_8(p_has_static_data);
+
+	bool saved = writer.write_class(p_script);
+	if (saved) {
+		// Scripts this one was analyzed against, and everything those were analyzed against.
+		HashSet<String> direct_dependencies;
+		GDScriptCache::get_dependencies(p_script->path, direct_dependencies);
+
+		List<String> pending;
+		for (const String &E : direct_dependencies) {
+			pending.push_back(E);
+		}
+		for (const String &E : writer.resources) {
+			pending.push_back(E);
+		}
+
+		HashMap<String, String> dependencies;
+		while (!pending.is_empty()) {
+			const String path = pending.front()->get();
+			pending.pop_front();
+			if (path == p_script->path || dependencies.has(path)) {
+				continue;
+			}
+			dependencies[path] = _get_file_hash(path);
+
+			HashMap<String, String> recorded;
+			bool has_recorded = false;
+			{
+				MutexLock lock(mutex);
+				const HashMap<String, String> *E = session_dependencies.getptr(path);
+				if (E) {
+					recorded = *E;
+					has_recorded = true;
+				}
+			}
+
+			if (has_recorded) {
+				for (const KeyValue<String, String> &E : recorded) {
+					if (E.key != p_script->path && !dependencies.has(E.key)) {
+						dependencies[E.key] = E.value;
+					}
+				}
+			} else {
+				HashSet<String> next;
+				GDScriptCache::get_dependencies(path, next);
+				for (const String &E : next) {
+					pending.push_back(E);
+				}
+			}
+		}
+
+		uint64_t dependencies_offset = f->get_position();
+		f->store_32(dependencies.size());
+		for (const KeyValue<String, String> &E : dependencies) {
+			writer.write_string(E.key);
+			writer.write_string(E.value);
+			f->store_8(direct_dependencies.has(E.key));
+		}
+		f->seek(dependencies_offset_position);
+		f->store_64(dependencies_offset);
+		saved = f->get_error() == OK;
+
+		if (saved) {
+			f->flush();
+			saved = _get_body_checksum(f, body_start, checksum);
+			f->seek(checksum_position);
+			f->store_buffer(checksum, 16);
+			saved = saved && f->get_error() == OK;
+		}
+
+		MutexLock lock(mutex);
+		session_dependencies[p_script->path] = dependencies;
+	}
+
+	writer.f.unref();
+	f.unref();
+
+	if (saved) {
+		saved = DirAccess::rename_absolute(temp_path, entry_path) == OK;
+	}
+	if (!saved) {
+		DirAccess::remove_absolute(temp_path);
+	}
+}
+
+void GDScriptBytecodeCache::clear() {
+	MutexLock lock(mutex);
+	if (names) {
+		memdelete(names);
+		names = nullptr;
+	}
+	file_hashes.clear();
+	session_dependencies.clear();
+}
@@ -0,0 +1,99 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_BYTECODE_CACHE_H
+#define GDSCRIPT_BYTECODE_CACHE_H
+
+#include "core/io/file_access.h"
+#include "core/os/mutex.h"
+#include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+
+class GDScript;
+
+// Persistent cache of compiled GDScript classes.
+//
+// When `gdscript/bytecode_cache/enabled` is set, every script compiled outside of the editor and
+// without a debugger attached is serialized to `user://gdscript_bytecode_cache`, and the next run
+// restores it without going through the parser, analyzer and compiler. An entry is only used if
+// it was written by the same engine build, its checksum matches, and neither the script nor any
+// script it depended on at compile time changed, otherwise the script is compiled normally and its
+// entry is rewritten. Restored bytecode is verified before use, since it is executed without the
+// guarantees of the compiler.
+//
+// Bytecode holds no pointers: builtin operators, accessors, utilities and method binds are stored
+// by name and resolved again on load, and scripts and resources referenced by constants are
+// stored by path.
+
+class GDScriptBytecodeCache {
+	class Names;
+	class Writer;
+	class Reader;
+
+	static Mutex mutex;
+	static Names *names;
+	static String cache_path;
+	static String engine_key;
+	// MD5 hashes of files, they don't change while the project runs.
+	static HashMap<String, String> file_hashes;
+	// Dependencies (paths and MD5 hashes) of the scripts saved or loaded in this session, so that
+	// dependents record their whole closure even after GDScriptCache dropped its own records.
+	static HashMap<String, HashMap<String, String>> session_dependencies;
+
+	static const Names *_get_names();
+	static String _get_file_hash(const String &p_path);
+	static String _get_source_hash(const GDScript *p_script);
+	static String _get_engine_key();
+	static bool _get_body_checksum(const Ref<FileAccess> &p_file, uint64_t p_from, uint8_t r_checksum[16]);
+	static String _get_entry_path(const String &p_path);
+	static bool _is_cacheable(const GDScript *p_script);
+	static Ref<FileAccess> _open_entry(const GDScript *p_script);
+
+public:
+	static bool is_enabled();
+
+	// Directory the entries are stored in, `user://gdscript_bytecode_cache` unless set. Used by tests.
+	static void set_cache_path(const String &p_path);
+	static String get_cache_path();
+
+	// Rebuilds the inner class tree of the root script p_script, like GDScriptCompiler::make_scripts().
+	// Only needs the source of p_script to be unchanged.
+	static bool make_scripts(GDScript *p_script);
+
+	// Restores the compiled state of the root script p_script, which must not have been compiled yet.
+	// On failure, p_script is left in a state that a regular compilation can start from.
+	static bool load_script(GDScript *p_script, bool &r_has_static_data);
+	static void save_script(GDScript *p_script, bool p_has_static_data);
+
+	static void clear();
+};
+
+#endif // GDSCRIPT_BYTECODE_CACHE_H
@@ -32,6 +32,7 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 
@@ -326,9 +327,11 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 		return Ref<GDScript>(); // Returns null and does not cache when the script fails to load.
 	}
 
-	Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
-	if (r_error == OK) {
-		GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+	if (!GDScriptBytecodeCache::make_scripts(script.ptr())) {
+		Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
+		if (r_error == OK) {
+			GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+		}
 	}
 
 	singleton->shallow_gdscript_cache[p_path] = script;
@@ -404,6 +407,17 @@ Ref<GDScript> GDScriptCache::get_cached_script(const String &p_path) {
 	return Ref<GDScript>();
 }
 
+void GDScriptCache::get_dependencies(const String &p_path, HashSet<String> &r_dependencies) {
+	MutexLock lock(singleton->mutex);
+
+	HashMap<String, HashSet<String>>::ConstIterator E = singleton->dependencies.find(p_path);
+	if (E) {
+		for (const String &F : E->value) {
+			r_dependencies.insert(F);
+		}
+	}
+}
+
 Error GDScriptCache::finish_compiling(const String &p_owner) {
 	MutexLock lock(singleton->mutex);
 
@@ -32,7 +32,9 @@
 
 #include "gdscript.h"
 #include "gdscript_byte_codegen.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
+#include "gdscript_native.h"
 #include "gdscript_utility_functions.h"
 
 #include "core/config/engine.h"
@@ -2469,6 +2471,10 @@ GDScriptFunction *GDScriptCompiler::_parse_function(Error &r_error, GDScript *p_
 
 	gd_function->method_info = method_info;
 
+	if (p_func && !p_for_lambda && GDScriptNativeFunctions::has_class(p_class->fqcn)) {
+		gd_function->native_function = GDScriptNativeFunctions::get_function(p_class, p_func);
+	}
+
 	if (!is_implicit_initializer && !is_implicit_ready && !p_for_lambda) {
 		p_script->member_functions[func_name] = gd_function;
 	}
@@ -2647,6 +2653,9 @@ Error GDScriptCompiler::_prepare_compilation(GDScript *p_script, const GDScriptP
 
 	p_script->clearing = true;
 
+	// Members and functions are about to move, drop whatever inline caches resolved against them.
+	GDScriptLanguage::get_singleton()->invalidate_inline_caches(p_script);
+
 	p_script->native = Ref<GDScriptNativeClass>();
 	p_script->base = Ref<GDScript>();
 	p_script->_base = nullptr;
@@ -3048,6 +3057,7 @@ Error GDScriptCompiler::_compile_class(GDScript *p_script, const GDScriptParser:
 	p_script->_static_default_init();
 
 	p_script->valid = true;
+	GDScriptLanguage::get_singleton()->invalidate_inline_caches(p_script);
 	return OK;
 }
 
@@ -3265,6 +3275,8 @@ Error GDScriptCompiler::compile(const GDScriptParser *p_parser, GDScript *p_scri
 	_get_function_ptr_replacements(func_ptr_replacements, old_lambda_info, &new_lambda_info);
 	main_script->_recurse_replace_function_ptrs(func_ptr_replacements);
 
+	GDScriptBytecodeCache::save_script(main_script, has_static_data && !root->annotated_static_unload);
+
 	if (has_static_data && !root->annotated_static_unload) {
 		GDScriptCache::add_static_script(p_script);
 	}
@@ -32,6 +32,9 @@
 
 #include "gdscript.h"
 
+#include "core/object/class_db.h"
+#include "scene/scene_string_names.h"
+
 Variant GDScriptFunction::get_constant(int p_idx) const {
 	ERR_FAIL_INDEX_V(p_idx, constants.size(), "<errconst>");
 	return constants[p_idx];
@@ -104,6 +107,427 @@ void GDScriptFunction::debug_get_stack_member_state(int p_line, List<Pair<String
 	}
 }
 
+BinaryMutex GDScriptFunction::inline_cache_mutex;
+LocalVector<GDScriptFunction::InlineCacheEntry *> GDScriptFunction::inline_cache_retired;
+SafeFlag GDScriptFunction::inline_cache_has_retired;
+SafeNumeric<uint32_t> GDScriptFunction::inline_cache_active_threads;
+
+// Only compiled GDScript instances and plain native objects can be cached,
+// placeholders and instances of other languages always take the generic path.
+static _FORCE_INLINE_ bool _get_cacheable_instance(Object *p_object, GDScriptInstance *&r_instance) {
+	ScriptInstance *si = p_object->get_script_instance();
+	if (!si) {
+		r_instance = nullptr;
+		return true;
+	}
+	if (si->get_language() != GDScriptLanguage::get_singleton() || si->is_placeholder()) {
+		return false;
+	}
+	r_instance = static_cast<GDScriptInstance *>(si);
+	return true;
+}
+
+GDScriptFunction *GDScriptFunction::_inline_cache_find_function(const GDScript *p_script, const StringName &p_name) {
+	// Same lookup as GDScriptInstance::callp().
+	for (const GDScript *sptr = p_script; sptr; sptr = sptr->_base) {
+		if (likely(sptr->valid)) {
+			HashMap<StringName, GDScriptFunction *>::ConstIterator E = sptr->member_functions.find(p_name);
+			if (E) {
+				return E->value;
+			}
+		}
+	}
+	return nullptr;
+}
+
+static bool _is_cacheable_native_class(const StringName &p_class) {
+	// Extension classes may handle properties in their own callbacks and can be unloaded.
+	ClassDB::APIType api = ClassDB::get_api_type(p_class);
+	return api == ClassDB::API_CORE || api == ClassDB::API_EDITOR;
+}
+
+const GDScriptFunction::InlineCacheEntry *GDScriptFunction::_inline_cache_find(const InlineCache &p_cache, Object *p_object, const GDScript *p_script) const {
+	const StringName *native_class = nullptr;
+
+	for (const InlineCacheEntry *E = p_cache.entries.load(std::memory_order_acquire); E; E = E->next) {
+		if (E->kind == InlineCacheEntry::KIND_MEGAMORPHIC) {
+			return E;
+		}
+		if (E->script != p_script) {
+			continue;
+		}
+		// The receiver keeps its script alive, entries of a freed script never match a new one at the same address.
+		if (p_script && E->epoch != p_script->inline_cache_epoch.get()) {
+			continue;
+		}
+		if (!E->native_class.is_empty()) {
+			if (!native_class) {
+				native_class = &p_object->get_class_name();
+			}
+			if (*native_class != E->native_class) {
+				continue;
+			}
+		}
+		return E;
+	}
+
+	return nullptr;
+}
+
+// Only entries resolved for the script of the new entry or for a freed script can be told stale here,
+// entries of other scripts are dropped when a later miss on their own script replaces them.
+bool GDScriptFunction::_inline_cache_is_stale(const InlineCacheEntry *p_entry, const InlineCacheEntry *p_new_entry) {
+	if (!p_entry->script) {
+		return false;
+	}
+	if (p_entry->script_id != p_new_entry->script_id) {
+		return ObjectDB::get_instance(p_entry->script_id) == nullptr;
+	}
+	return p_entry->epoch != p_new_entry->epoch;
+}
+
+const GDScriptFunction::InlineCacheEntry *GDScriptFunction::_inline_cache_add(InlineCache &p_cache, InlineCacheEntry *p_entry) {
+	MutexLock lock(inline_cache_mutex);
+
+	InlineCacheEntry *head = p_cache.entries.load(std::memory_order_relaxed);
+	int live = 0;
+	bool stale = false;
+	for (InlineCacheEntry *E = head; E; E = E->next) {
+		if (_inline_cache_is_stale(E, p_entry)) {
+			stale = true;
+		} else {
+			live++;
+		}
+	}
+
+	if (live >= INLINE_CACHE_MAX_ENTRIES) {
+		p_entry->kind = InlineCacheEntry::KIND_MEGAMORPHIC;
+	}
+
+	if (stale) {
+		// Other threads may still be walking the old chain, so retire it until no GDScript function is running
+		// and publish a copy of the entries that are still valid.
+		InlineCacheEntry **tail = &p_entry->next;
+		for (InlineCacheEntry *E = head; E; E = E->next) {
+			inline_cache_retired.push_back(E);
+			if (!_inline_cache_is_stale(E, p_entry)) {
+				InlineCacheEntry *copy = memnew(InlineCacheEntry(*E));
+				copy->next = nullptr;
+				*tail = copy;
+				tail = &copy->next;
+			}
+		}
+		inline_cache_has_retired.set();
+	} else {
+		p_entry->next = head;
+	}
+
+	p_cache.entries.store(p_entry, std::memory_order_release);
+	return p_entry;
+}
+
+void GDScriptFunction::_inline_cache_thread_exit() {
+	// Called when the outermost GDScript function of a thread returns. Once no thread runs a GDScript function,
+	// nothing can hold a pointer into a retired chain anymore, and threads entering later only see the new chains.
+	if (inline_cache_active_threads.decrement() == 0 && unlikely(inline_cache_has_retired.is_set())) {
+		reclaim_retired_inline_caches();
+	}
+}
+
+void GDScriptFunction::reclaim_retired_inline_caches() {
+	MutexLock lock(inline_cache_mutex);
+	if (inline_cache_active_threads.get() != 0) {
+		// Another thread entered a GDScript function in the meantime, it will reclaim them when it leaves.
+		return;
+	}
+	for (InlineCacheEntry *E : inline_cache_retired) {
+		memdelete(E);
+	}
+	inline_cache_retired.clear();
+	inline_cache_has_retired.clear();
+}
+
+GDScriptFunction::InlineCacheEntry *GDScriptFunction::_inline_cache_resolve_call(Object *p_object, GDScriptInstance *p_instance, const StringName &p_method) const {
+	InlineCacheEntry *entry = memnew(InlineCacheEntry);
+	entry->script = p_instance ? p_instance->script.ptr() : nullptr;
+	if (entry->script) {
+		// Read before resolving, so that an invalidation racing with the lookup leaves the entry stale.
+		entry->epoch = entry->script->inline_cache_epoch.get();
+		entry->script_id = entry->script->get_instance_id();
+	}
+
+	if (p_method == CoreStringName(free_) || p_method == SceneStringName(_ready)) {
+		// Both rely on special handling in Object::callp() and GDScriptInstance::callp().
+		return entry;
+	}
+
+	if (p_instance) {
+		GDScriptFunction *function = _inline_cache_find_function(entry->script, p_method);
+		if (function) {
+			entry->kind = InlineCacheEntry::KIND_SCRIPT_FUNCTION;
+			entry->function = function;
+			return entry;
+		}
+	}
+
+	entry->native_class = p_object->get_class_name();
+	if (!_is_cacheable_native_class(entry->native_class)) {
+		return entry;
+	}
+
+	MethodBind *method = ClassDB::get_method(entry->native_class, p_method);
+	if (method) {
+		entry->kind = InlineCacheEntry::KIND_METHOD_BIND;
+		entry->method = method;
+	}
+	return entry;
+}
+
+GDScriptFunction::InlineCacheEntry *GDScriptFunction::_inline_cache_resolve_get(Object *p_object, GDScriptInstance *p_instance, const StringName &p_name) const {
+	InlineCacheEntry *entry = memnew(InlineCacheEntry);
+	entry->script = p_instance ? p_instance->script.ptr() : nullptr;
+	if (entry->script) {
+		// Read before resolving, so that an invalidation racing with the lookup leaves the entry stale.
+		entry->epoch = entry->script->inline_cache_epoch.get();
+		entry->script_id = entry->script->get_instance_id();
+	}
+
+	if (p_instance) {
+		// Mirrors the lookup order of GDScriptInstance::get().
+		const GDScript *script = entry->script;
+		if (unlikely(!script->valid)) {
+			return entry;
+		}
+
+		HashMap<StringName, GDScript::MemberInfo>::ConstIterator M = script->member_indices.find(p_name);
+		if (M) {
+			if (M->value.getter) {
+				GDScriptFunction *getter = _inline_cache_find_function(script, M->value.getter);
+				if (getter) {
+					entry->kind = InlineCacheEntry::KIND_SCRIPT_FUNCTION;
+					entry->function = getter;
+				}
+			} else {
+				entry->kind = InlineCacheEntry::KIND_SCRIPT_MEMBER;
+				entry->index = M->value.index;
+			}
+			return entry;
+		}
+
+		for (const GDScript *sptr = script; sptr; sptr = sptr->_base) {
+			if (sptr->constants.has(p_name) || sptr->static_variables_indices.has(p_name) || sptr->_signals.has(p_name) || sptr->subclasses.has(p_name)) {
+				return entry;
+			}
+			if (likely(sptr->valid) && (sptr->member_functions.has(p_name) || sptr->member_functions.has(GDScriptLanguage::get_singleton()->strings._get))) {
+				return entry;
+			}
+		}
+	}
+
+	entry->native_class = p_object->get_class_name();
+	if (!_is_cacheable_native_class(entry->native_class)) {
+		return entry;
+	}
+
+	// ClassDB::get_property() checks constants, methods and signals of each class before its parent's properties.
+	if (ClassDB::has_integer_constant(entry->native_class, p_name) || ClassDB::has_method(entry->native_class, p_name) || ClassDB::has_signal(entry->native_class, p_name)) {
+		return entry;
+	}
+
+	int index = -1;
+	MethodBind *getter = ClassDB::get_property_getter_method(entry->native_class, p_name, &index);
+	if (getter && index < 0) {
+		entry->kind = InlineCacheEntry::KIND_METHOD_BIND;
+		entry->method = getter;
+	}
+	return entry;
+}
+
+GDScriptFunction::InlineCacheEntry *GDScriptFunction::_inline_cache_resolve_set(Object *p_object, GDScriptInstance *p_instance, const StringName &p_name) const {
+	InlineCacheEntry *entry = memnew(InlineCacheEntry);
+	entry->script = p_instance ? p_instance->script.ptr() : nullptr;
+	if (entry->script) {
+		// Read before resolving, so that an invalidation racing with the lookup leaves the entry stale.
+		entry->epoch = entry->script->inline_cache_epoch.get();
+		entry->script_id = entry->script->get_instance_id();
+	}
+
+	if (p_instance) {
+		// Mirrors the lookup order of GDScriptInstance::set().
+		const GDScript *script = entry->script;
+		if (unlikely(!script->valid)) {
+			return entry;
+		}
+
+		HashMap<StringName, GDScript::MemberInfo>::ConstIterator M = script->member_indices.find(p_name);
+		if (M) {
+			entry->member_type = &M->value.data_type;
+			if (M->value.setter) {
+				GDScriptFunction *setter = _inline_cache_find_function(script, M->value.setter);
+				if (setter) {
+					entry->kind = InlineCacheEntry::KIND_SCRIPT_FUNCTION;
+					entry->function = setter;
+				}
+			} else {
+				entry->kind = InlineCacheEntry::KIND_SCRIPT_MEMBER;
+				entry->index = M->value.index;
+			}
+			return entry;
+		}
+
+		for (const GDScript *sptr = script; sptr; sptr = sptr->_base) {
+			if (sptr->static_variables_indices.has(p_name)) {
+				return entry;
+			}
+			if (likely(sptr->valid) && sptr->member_functions.has(GDScriptLanguage::get_singleton()->strings._set)) {
+				return entry;
+			}
+		}
+	}
+
+	entry->native_class = p_object->get_class_name();
+	if (!_is_cacheable_native_class(entry->native_class)) {
+		return entry;
+	}
+
+	int index = -1;
+	MethodBind *setter = ClassDB::get_property_setter_method(entry->native_class, p_name, &index);
+	if (setter) {
+		entry->kind = InlineCacheEntry::KIND_METHOD_BIND;
+		entry->method = setter;
+		entry->index = index;
+	}
+	return entry;
+}
+
+bool GDScriptFunction::_inline_cache_call(InlineCache &p_cache, Object *p_object, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err) {
+	GDScriptInstance *instance;
+	if (!_get_cacheable_instance(p_object, instance)) {
+		return false;
+	}
+
+	const InlineCacheEntry *entry = _inline_cache_find(p_cache, p_object, instance ? instance->script.ptr() : nullptr);
+	if (unlikely(!entry)) {
+		entry = _inline_cache_add(p_cache, _inline_cache_resolve_call(p_object, instance, p_method));
+	}
+
+	switch (entry->kind) {
+		case InlineCacheEntry::KIND_SCRIPT_FUNCTION: {
+#ifdef DEBUG_ENABLED
+			_ObjectDebugLock debug_lock(p_object);
+#endif
+			r_err.error = Callable::CallError::CALL_OK;
+			r_ret = entry->function->call(instance, p_args, p_argcount, r_err);
+			return true;
+		}
+		case InlineCacheEntry::KIND_METHOD_BIND: {
+#ifdef DEBUG_ENABLED
+			_ObjectDebugLock debug_lock(p_object);
+#endif
+			r_err.error = Callable::CallError::CALL_OK;
+			r_ret = entry->method->call(p_object, p_args, p_argcount, r_err);
+			return true;
+		}
+		default: {
+			return false;
+		}
+	}
+}
+
+bool GDScriptFunction::_inline_cache_get(InlineCache &p_cache, const Variant *p_base, const StringName &p_name, Variant &r_ret) {
+	Object *object = p_base->get_validated_object();
+	GDScriptInstance *instance;
+	if (!object || !_get_cacheable_instance(object, instance)) {
+		return false;
+	}
+
+	const InlineCacheEntry *entry = _inline_cache_find(p_cache, object, instance ? instance->script.ptr() : nullptr);
+	if (unlikely(!entry)) {
+		entry = _inline_cache_add(p_cache, _inline_cache_resolve_get(object, instance, p_name));
+	}
+
+	switch (entry->kind) {
+		case InlineCacheEntry::KIND_SCRIPT_MEMBER: {
+			if (unlikely(entry->index >= instance->members.size())) {
+				return false;
+			}
+			r_ret = instance->members[entry->index];
+			return true;
+		}
+		case InlineCacheEntry::KIND_SCRIPT_FUNCTION: {
+			Callable::CallError ce;
+			const Variant ret = entry->function->call(instance, nullptr, 0, ce);
+			r_ret = (ce.error == Callable::CallError::CALL_OK) ? ret : Variant();
+			return true;
+		}
+		case InlineCacheEntry::KIND_METHOD_BIND: {
+			Callable::CallError ce;
+			r_ret = entry->method->call(object, nullptr, 0, ce);
+			return true;
+		}
+		default: {
+			return false;
+		}
+	}
+}
+
+bool GDScriptFunction::_inline_cache_set(InlineCache &p_cache, Variant *p_base, const StringName &p_name, const Variant &p_value, bool &r_valid) {
+	Object *object = p_base->get_validated_object();
+	GDScriptInstance *instance;
+	if (!object || !_get_cacheable_instance(object, instance)) {
+		return false;
+	}
+
+	const InlineCacheEntry *entry = _inline_cache_find(p_cache, object, instance ? instance->script.ptr() : nullptr);
+	if (unlikely(!entry)) {
+		entry = _inline_cache_add(p_cache, _inline_cache_resolve_set(object, instance, p_name));
+	}
+
+	if (entry->member_type && entry->member_type->has_type && !entry->member_type->is_type(p_value)) {
+		// Let GDScriptInstance::set() try to convert the value.
+		return false;
+	}
+
+	switch (entry->kind) {
+		case InlineCacheEntry::KIND_SCRIPT_MEMBER: {
+			if (unlikely(entry->index >= instance->members.size())) {
+				return false;
+			}
+			instance->members.write[entry->index] = p_value;
+			r_valid = true;
+		} break;
+		case InlineCacheEntry::KIND_SCRIPT_FUNCTION: {
+			const Variant *args = &p_value;
+			Callable::CallError ce;
+			entry->function->call(instance, &args, 1, ce);
+			r_valid = ce.error == Callable::CallError::CALL_OK;
+		} break;
+		case InlineCacheEntry::KIND_METHOD_BIND: {
+			Callable::CallError ce;
+			if (entry->index >= 0) {
+				Variant index = entry->index;
+				const Variant *args[2] = { &index, &p_value };
+				entry->method->call(object, args, 2, ce);
+			} else {
+				const Variant *args[1] = { &p_value };
+				entry->method->call(object, args, 1, ce);
+			}
+			r_valid = ce.error == Callable::CallError::CALL_OK;
+		} break;
+		default: {
+			return false;
+		}
+	}
+
+#ifdef TOOLS_ENABLED
+	// Object::set() flags every assignment.
+	if (!object->is_edited()) {
+		object->set_edited(true);
+	}
+#endif
+	return true;
+}
+
 GDScriptFunction::GDScriptFunction() {
 	name = "<anonymous>";
 #ifdef DEBUG_ENABLED
@@ -126,6 +550,18 @@ GDScriptFunction::~GDScriptFunction() {
 	}
 	return_type.script_type_ref = Ref<Script>();
 
+	for (int i = 0; i < _inline_caches_count; i++) {
+		InlineCacheEntry *E = _inline_caches_ptr[i].entries.load(std::memory_order_relaxed);
+		while (E) {
+			InlineCacheEntry *next = E->next;
+			memdelete(E);
+			E = next;
+		}
+	}
+	if (_inline_caches_ptr) {
+		memdelete_arr(_inline_caches_ptr);
+	}
+
 #ifdef DEBUG_ENABLED
 	MutexLock lock(GDScriptLanguage::get_singleton()->mutex);
 	GDScriptLanguage::get_singleton()->function_list.remove(&function_list);
@@ -238,7 +674,7 @@ Variant GDScriptFunctionState::resume(const Variant &p_arg) {
 		}
 
 #ifdef DEBUG_ENABLED
-		if (EngineDebugger::is_active()) {
+		if (GDScriptLanguage::get_singleton()->is_call_stack_tracked()) {
 			GDScriptLanguage::get_singleton()->exit_function();
 		}
 
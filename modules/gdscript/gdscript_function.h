@@ -35,12 +35,16 @@
 
 #include "core/object/ref_counted.h"
 #include "core/object/script_language.h"
+#include "core/os/mutex.h"
 #include "core/os/thread.h"
 #include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/pair.h"
 #include "core/templates/self_list.h"
 #include "core/variant/variant.h"
 
+#include <atomic>
+
 class GDScriptInstance;
 class GDScript;
 
@@ -257,6 +261,29 @@ public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		OPCODE_OPERATOR_ADD_INT,
+		OPCODE_OPERATOR_SUBTRACT_INT,
+		OPCODE_OPERATOR_MULTIPLY_INT,
+		OPCODE_OPERATOR_EQUAL_INT,
+		OPCODE_OPERATOR_NOT_EQUAL_INT,
+		OPCODE_OPERATOR_LESS_INT,
+		OPCODE_OPERATOR_LESS_EQUAL_INT,
+		OPCODE_OPERATOR_GREATER_INT,
+		OPCODE_OPERATOR_GREATER_EQUAL_INT,
+		OPCODE_OPERATOR_ADD_FLOAT,
+		OPCODE_OPERATOR_SUBTRACT_FLOAT,
+		OPCODE_OPERATOR_MULTIPLY_FLOAT,
+		OPCODE_OPERATOR_DIVIDE_FLOAT,
+		OPCODE_OPERATOR_LESS_FLOAT,
+		OPCODE_OPERATOR_LESS_EQUAL_FLOAT,
+		OPCODE_OPERATOR_GREATER_FLOAT,
+		OPCODE_OPERATOR_GREATER_EQUAL_FLOAT,
+		OPCODE_OPERATOR_ADD_VECTOR2,
+		OPCODE_OPERATOR_SUBTRACT_VECTOR2,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT,
+		OPCODE_OPERATOR_ADD_VECTOR3,
+		OPCODE_OPERATOR_SUBTRACT_VECTOR3,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT,
 		OPCODE_TYPE_TEST_BUILTIN,
 		OPCODE_TYPE_TEST_ARRAY,
 		OPCODE_TYPE_TEST_DICTIONARY,
@@ -445,6 +472,7 @@ private:
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
 	friend class GDScriptLanguage;
+	friend class GDScriptBytecodeCache;
 
 	StringName name;
 	StringName source;
@@ -469,6 +497,7 @@ private:
 	Vector<int> default_arguments;
 	Vector<Variant> constants;
 	Vector<StringName> global_names;
+	Vector<int> global_indices; // Into `GDScriptLanguage::get_global_array()`.
 	Vector<Variant::ValidatedOperatorEvaluator> operator_funcs;
 	Vector<Variant::ValidatedSetter> setters;
 	Vector<Variant::ValidatedGetter> getters;
@@ -483,10 +512,14 @@ private:
 	Vector<MethodBind *> methods;
 	Vector<GDScriptFunction *> lambdas;
 
+	// Ahead-of-time compiled implementation, see `GDScriptNativeFunctions`.
+	void (*native_function)(const Variant **p_args, Variant &r_ret) = nullptr;
+
 	int _code_size = 0;
 	int _default_arg_count = 0;
 	int _constant_count = 0;
 	int _global_names_count = 0;
+	int _global_indices_count = 0;
 	int _operator_funcs_count = 0;
 	int _setters_count = 0;
 	int _getters_count = 0;
@@ -505,6 +538,7 @@ private:
 	const int *_default_arg_ptr = nullptr;
 	mutable Variant *_constants_ptr = nullptr;
 	const StringName *_global_names_ptr = nullptr;
+	const int *_global_indices_ptr = nullptr;
 	const Variant::ValidatedOperatorEvaluator *_operator_funcs_ptr = nullptr;
 	const Variant::ValidatedSetter *_setters_ptr = nullptr;
 	const Variant::ValidatedGetter *_getters_ptr = nullptr;
@@ -519,6 +553,58 @@ private:
 	MethodBind **_methods_ptr = nullptr;
 	GDScriptFunction **_lambdas_ptr = nullptr;
 
+	// Inline caches of OPCODE_GET_NAMED, OPCODE_SET_NAMED and OPCODE_CALL, which operate on untyped receivers.
+	// Each site holds a short chain of immutable entries keyed by the receiver script and native class,
+	// remembering how the generic Object path resolved the name for that receiver.
+	struct InlineCacheEntry {
+		enum Kind {
+			KIND_GENERIC, // Receiver known to need the generic path.
+			KIND_MEGAMORPHIC, // Too many receivers seen, the site always takes the generic path.
+			KIND_SCRIPT_FUNCTION, // Script method, getter or setter.
+			KIND_SCRIPT_MEMBER, // Script member variable slot.
+			KIND_METHOD_BIND, // Native method, getter or setter.
+		};
+
+		Kind kind = KIND_GENERIC;
+		uint32_t epoch = 0; // Inline cache epoch of the script when the entry was resolved.
+		const GDScript *script = nullptr;
+		ObjectID script_id;
+		StringName native_class; // Empty if the entry does not depend on the native class.
+		GDScriptFunction *function = nullptr;
+		MethodBind *method = nullptr;
+		const GDScriptDataType *member_type = nullptr;
+		int index = -1; // Member slot, or index argument of a native setter.
+		InlineCacheEntry *next = nullptr;
+	};
+
+	struct InlineCache {
+		std::atomic<InlineCacheEntry *> entries = { nullptr };
+	};
+
+	static constexpr int INLINE_CACHE_MAX_ENTRIES = 4;
+	static BinaryMutex inline_cache_mutex;
+
+	// Replaced chains may still be walked by other threads, they are freed once no thread runs a GDScript function.
+	static LocalVector<InlineCacheEntry *> inline_cache_retired;
+	static SafeFlag inline_cache_has_retired;
+	static SafeNumeric<uint32_t> inline_cache_active_threads;
+
+	int _inline_caches_count = 0;
+	InlineCache *_inline_caches_ptr = nullptr;
+
+	static GDScriptFunction *_inline_cache_find_function(const GDScript *p_script, const StringName &p_name);
+	const InlineCacheEntry *_inline_cache_find(const InlineCache &p_cache, Object *p_object, const GDScript *p_script) const;
+	static bool _inline_cache_is_stale(const InlineCacheEntry *p_entry, const InlineCacheEntry *p_new_entry);
+	const InlineCacheEntry *_inline_cache_add(InlineCache &p_cache, InlineCacheEntry *p_entry);
+	static void _inline_cache_thread_exit();
+	InlineCacheEntry *_inline_cache_resolve_call(Object *p_object, GDScriptInstance *p_instance, const StringName &p_method) const;
+	InlineCacheEntry *_inline_cache_resolve_get(Object *p_object, GDScriptInstance *p_instance, const StringName &p_name) const;
+	InlineCacheEntry *_inline_cache_resolve_set(Object *p_object, GDScriptInstance *p_instance, const StringName &p_name) const;
+
+	bool _inline_cache_call(InlineCache &p_cache, Object *p_object, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err);
+	bool _inline_cache_get(InlineCache &p_cache, const Variant *p_base, const StringName &p_name, Variant &r_ret);
+	bool _inline_cache_set(InlineCache &p_cache, Variant *p_base, const StringName &p_name, const Variant &p_value, bool &r_valid);
+
 #ifdef DEBUG_ENABLED
 	CharString func_cname;
 	const char *_func_cname = nullptr;
@@ -589,6 +675,8 @@ public:
 	Variant call(GDScriptInstance *p_instance, const Variant **p_args, int p_argcount, Callable::CallError &r_err, CallState *p_state = nullptr);
 	void debug_get_stack_member_state(int p_line, List<Pair<StringName, int>> *r_stackvars) const;
 
+	static void reclaim_retired_inline_caches();
+
 #ifdef DEBUG_ENABLED
 	void _profile_native_call(uint64_t p_t_taken, const String &p_function_name, const String &p_instance_class_name = String());
 	void disassemble(const Vector<String> &p_code_lines) const;
@@ -0,0 +1,939 @@
+/**************************************************************************/
+/*  gdscript_native.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_native.h"
+
+#include "core/math/math_funcs.h"
+
+HashMap<String, HashMap<StringName, GDScriptNativeFunctions::Entry>> GDScriptNativeFunctions::functions;
+
+void GDScriptNativeFunctions::register_function(const String &p_class, const StringName &p_function, uint64_t p_hash, Function p_ptr) {
+	ERR_FAIL_NULL(p_ptr);
+	Entry &entry = functions[p_class][p_function];
+	entry.hash = p_hash;
+	entry.function = p_ptr;
+}
+
+void GDScriptNativeFunctions::clear() {
+	functions.clear();
+}
+
+GDScriptNativeFunctions::Function GDScriptNativeFunctions::get_function(const GDScriptParser::ClassNode *p_class, const GDScriptParser::FunctionNode *p_function) {
+	if (p_function->identifier == nullptr) {
+		return nullptr;
+	}
+
+	HashMap<String, HashMap<StringName, Entry>>::ConstIterator C = functions.find(p_class->fqcn);
+	if (!C) {
+		return nullptr;
+	}
+	HashMap<StringName, Entry>::ConstIterator E = C->value.find(p_function->identifier->name);
+	if (!E) {
+		return nullptr;
+	}
+
+	// The script may have changed since the native code was generated.
+	const String body = GDScriptNativeCodeGenerator::generate_function(p_function);
+	if (body.is_empty() || body.hash64() != E->value.hash) {
+		print_verbose(vformat(R"(GDScript: Native code for "%s" in "%s" is outdated, running it in the VM instead.)", p_function->identifier->name, p_class->fqcn));
+		return nullptr;
+	}
+	return E->value.function;
+}
+
+GDScriptNativeFunctions::Function GDScriptNativeFunctions::find_function(const String &p_class, const StringName &p_function, uint64_t &r_hash) {
+	HashMap<String, HashMap<StringName, Entry>>::ConstIterator C = functions.find(p_class);
+	if (!C) {
+		return nullptr;
+	}
+	HashMap<StringName, Entry>::ConstIterator E = C->value.find(p_function);
+	if (!E) {
+		return nullptr;
+	}
+	r_hash = E->value.hash;
+	return E->value.function;
+}
+
+// Math utility functions that map directly to `VariantUtilityFunctions`.
+// Signatures use 'f' for float, 'i' for int and 'b' for bool, return type first.
+struct GDScriptNativeUtility {
+	const char *name;
+	const char *signature;
+};
+
+static const GDScriptNativeUtility native_utilities[] = {
+	{ "sin", "ff" },
+	{ "cos", "ff" },
+	{ "tan", "ff" },
+	{ "sinh", "ff" },
+	{ "cosh", "ff" },
+	{ "tanh", "ff" },
+	{ "asin", "ff" },
+	{ "acos", "ff" },
+	{ "atan", "ff" },
+	{ "asinh", "ff" },
+	{ "acosh", "ff" },
+	{ "atanh", "ff" },
+	{ "sqrt", "ff" },
+	{ "log", "ff" },
+	{ "exp", "ff" },
+	{ "floorf", "ff" },
+	{ "ceilf", "ff" },
+	{ "roundf", "ff" },
+	{ "absf", "ff" },
+	{ "signf", "ff" },
+	{ "deg_to_rad", "ff" },
+	{ "rad_to_deg", "ff" },
+	{ "atan2", "fff" },
+	{ "fmod", "fff" },
+	{ "fposmod", "fff" },
+	{ "pow", "fff" },
+	{ "minf", "fff" },
+	{ "maxf", "fff" },
+	{ "snappedf", "fff" },
+	{ "move_toward", "ffff" },
+	{ "angle_difference", "fff" },
+	{ "lerpf", "ffff" },
+	{ "clampf", "ffff" },
+	{ "wrapf", "ffff" },
+	{ "smoothstep", "ffff" },
+	{ "inverse_lerp", "ffff" },
+	{ "lerp_angle", "ffff" },
+	{ "remap", "ffffff" },
+	{ "floori", "if" },
+	{ "ceili", "if" },
+	{ "roundi", "if" },
+	{ "absi", "ii" },
+	{ "signi", "ii" },
+	{ "mini", "iii" },
+	{ "maxi", "iii" },
+	{ "clampi", "iiii" },
+	{ "wrapi", "iiii" },
+	{ "is_nan", "bf" },
+	{ "is_inf", "bf" },
+	{ "is_finite", "bf" },
+	{ "is_zero_approx", "bf" },
+	{ "is_equal_approx", "bff" },
+	{ nullptr, nullptr },
+};
+
+static Variant::Type _get_utility_type(char p_signature) {
+	switch (p_signature) {
+		case 'f':
+			return Variant::FLOAT;
+		case 'i':
+			return Variant::INT;
+		default:
+			return Variant::BOOL;
+	}
+}
+
+bool GDScriptNativeCodeGenerator::_is_supported_type(Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::BOOL:
+		case Variant::INT:
+		case Variant::FLOAT:
+		case Variant::VECTOR2:
+		case Variant::VECTOR3:
+			return true;
+		default:
+			return false;
+	}
+}
+
+bool GDScriptNativeCodeGenerator::_get_hard_type(const GDScriptParser::DataType &p_type, Variant::Type &r_type) {
+	if (!p_type.is_hard_type() || p_type.kind != GDScriptParser::DataType::BUILTIN || !_is_supported_type(p_type.builtin_type)) {
+		return false;
+	}
+	r_type = p_type.builtin_type;
+	return true;
+}
+
+String GDScriptNativeCodeGenerator::_get_cpp_type(Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::BOOL:
+			return "bool";
+		case Variant::INT:
+			return "int64_t";
+		case Variant::FLOAT:
+			return "double";
+		case Variant::VECTOR2:
+			return "Vector2";
+		case Variant::VECTOR3:
+			return "Vector3";
+		default:
+			ERR_FAIL_V("void");
+	}
+}
+
+String GDScriptNativeCodeGenerator::_get_local_name(const StringName &p_name) {
+	// GDScript doesn't allow shadowing locals in nested blocks, so names are unique within a function.
+	const String name = p_name;
+	String result = "l_";
+	for (int i = 0; i < name.length(); i++) {
+		const char32_t c = name[i];
+		if (is_ascii_alphanumeric_char(c) || c == '_') {
+			result += c;
+		} else {
+			result += "_u" + String::num_int64(c, 16) + "_";
+		}
+	}
+	return result;
+}
+
+static String _get_float_literal(double p_value) {
+	if (Math::is_nan(p_value)) {
+		return "Math_NAN";
+	}
+	if (Math::is_inf(p_value)) {
+		return p_value > 0 ? "Math_INF" : "-Math_INF";
+	}
+	char buffer[64];
+	snprintf(buffer, sizeof(buffer), "%.17g", p_value);
+	String result = buffer;
+	if (!result.contains(".") && !result.contains("e")) {
+		result += ".0";
+	}
+	return result;
+}
+
+String GDScriptNativeCodeGenerator::_get_literal(const Variant &p_value) {
+	switch (p_value.get_type()) {
+		case Variant::BOOL:
+			return bool(p_value) ? "true" : "false";
+		case Variant::INT: {
+			const int64_t value = p_value;
+			if (value == INT64_MIN) {
+				return "INT64_MIN";
+			}
+			return "INT64_C(" + itos(value) + ")";
+		}
+		case Variant::FLOAT:
+			return _get_float_literal(p_value);
+		case Variant::VECTOR2: {
+			const Vector2 value = p_value;
+			return "Vector2((real_t)" + _get_float_literal(value.x) + ", (real_t)" + _get_float_literal(value.y) + ")";
+		}
+		case Variant::VECTOR3: {
+			const Vector3 value = p_value;
+			return "Vector3((real_t)" + _get_float_literal(value.x) + ", (real_t)" + _get_float_literal(value.y) + ", (real_t)" + _get_float_literal(value.z) + ")";
+		}
+		default:
+			ERR_FAIL_V(String());
+	}
+}
+
+bool GDScriptNativeCodeGenerator::_convert(const Expression &p_expression, Variant::Type p_type, String &r_code) {
+	if (p_expression.type == p_type) {
+		r_code = p_expression.code;
+		return true;
+	}
+	if (p_expression.type == Variant::INT && p_type == Variant::FLOAT) {
+		r_code = "(double)(" + p_expression.code + ")";
+		return true;
+	}
+	if (p_expression.type == Variant::FLOAT && p_type == Variant::INT) {
+		r_code = "(int64_t)(" + p_expression.code + ")";
+		return true;
+	}
+	return false;
+}
+
+String GDScriptNativeCodeGenerator::_get_condition(const Expression &p_expression) {
+	// Same truthiness as `Variant::booleanize()`.
+	switch (p_expression.type) {
+		case Variant::BOOL:
+			return p_expression.code;
+		case Variant::INT:
+			return "(" + p_expression.code + " != 0)";
+		case Variant::FLOAT:
+			return "(" + p_expression.code + " != 0.0)";
+		case Variant::VECTOR2:
+			return "(" + p_expression.code + " != Vector2())";
+		case Variant::VECTOR3:
+			return "(" + p_expression.code + " != Vector3())";
+		default:
+			ERR_FAIL_V("false");
+	}
+}
+
+bool GDScriptNativeCodeGenerator::_make_binary(Variant::Operator p_op, const Expression &p_left, const Expression &p_right, Expression &r_result) {
+	const bool left_number = p_left.type == Variant::INT || p_left.type == Variant::FLOAT;
+	const bool right_number = p_right.type == Variant::INT || p_right.type == Variant::FLOAT;
+	const bool both_int = p_left.type == Variant::INT && p_right.type == Variant::INT;
+	const bool left_vector = p_left.type == Variant::VECTOR2 || p_left.type == Variant::VECTOR3;
+	const bool right_vector = p_right.type == Variant::VECTOR2 || p_right.type == Variant::VECTOR3;
+
+	const char *symbol = nullptr;
+	switch (p_op) {
+		case Variant::OP_ADD:
+			symbol = " + ";
+			break;
+		case Variant::OP_SUBTRACT:
+			symbol = " - ";
+			break;
+		case Variant::OP_MULTIPLY:
+			symbol = " * ";
+			break;
+		case Variant::OP_DIVIDE:
+			symbol = " / ";
+			break;
+		case Variant::OP_EQUAL:
+			symbol = " == ";
+			break;
+		case Variant::OP_NOT_EQUAL:
+			symbol = " != ";
+			break;
+		case Variant::OP_LESS:
+			symbol = " < ";
+			break;
+		case Variant::OP_LESS_EQUAL:
+			symbol = " <= ";
+			break;
+		case Variant::OP_GREATER:
+			symbol = " > ";
+			break;
+		case Variant::OP_GREATER_EQUAL:
+			symbol = " >= ";
+			break;
+		case Variant::OP_BIT_AND:
+			symbol = " & ";
+			break;
+		case Variant::OP_BIT_OR:
+			symbol = " | ";
+			break;
+		case Variant::OP_BIT_XOR:
+			symbol = " ^ ";
+			break;
+		case Variant::OP_POWER:
+			break;
+		default:
+			return false;
+	}
+
+	String left;
+	String right;
+	switch (p_op) {
+		case Variant::OP_ADD:
+		case Variant::OP_SUBTRACT:
+		case Variant::OP_MULTIPLY:
+		case Variant::OP_DIVIDE: {
+			if (left_number && right_number) {
+				// Integer division has error checks in the VM, leave it there.
+				if (both_int && p_op == Variant::OP_DIVIDE) {
+					return false;
+				}
+				r_result.type = both_int ? Variant::INT : Variant::FLOAT;
+				_convert(p_left, r_result.type, left);
+				_convert(p_right, r_result.type, right);
+				r_result.code = "(" + left + symbol + right + ")";
+				return true;
+			}
+			if (left_vector && p_left.type == p_right.type) {
+				r_result.type = p_left.type;
+				r_result.code = "(" + p_left.code + symbol + p_right.code + ")";
+				return true;
+			}
+			if (left_vector && right_number && (p_op == Variant::OP_MULTIPLY || p_op == Variant::OP_DIVIDE)) {
+				r_result.type = p_left.type;
+				r_result.code = "(" + p_left.code + symbol + "(real_t)(" + p_right.code + "))";
+				return true;
+			}
+			if (left_number && right_vector && p_op == Variant::OP_MULTIPLY) {
+				r_result.type = p_right.type;
+				r_result.code = "(" + p_right.code + " * (real_t)(" + p_left.code + "))";
+				return true;
+			}
+			return false;
+		}
+		case Variant::OP_POWER: {
+			if (!left_number || !right_number || both_int) {
+				return false;
+			}
+			_convert(p_left, Variant::FLOAT, left);
+			_convert(p_right, Variant::FLOAT, right);
+			r_result.type = Variant::FLOAT;
+			r_result.code = "Math::pow(" + left + ", " + right + ")";
+			return true;
+		}
+		case Variant::OP_EQUAL:
+		case Variant::OP_NOT_EQUAL:
+		case Variant::OP_LESS:
+		case Variant::OP_LESS_EQUAL:
+		case Variant::OP_GREATER:
+		case Variant::OP_GREATER_EQUAL: {
+			r_result.type = Variant::BOOL;
+			if (left_number && right_number) {
+				const Variant::Type type = both_int ? Variant::INT : Variant::FLOAT;
+				_convert(p_left, type, left);
+				_convert(p_right, type, right);
+				r_result.code = "(" + left + symbol + right + ")";
+				return true;
+			}
+			if ((p_op == Variant::OP_EQUAL || p_op == Variant::OP_NOT_EQUAL) && p_left.type == p_right.type && (left_vector || p_left.type == Variant::BOOL)) {
+				r_result.code = "(" + p_left.code + symbol + p_right.code + ")";
+				return true;
+			}
+			return false;
+		}
+		case Variant::OP_BIT_AND:
+		case Variant::OP_BIT_OR:
+		case Variant::OP_BIT_XOR: {
+			if (!both_int) {
+				return false;
+			}
+			r_result.type = Variant::INT;
+			r_result.code = "(" + p_left.code + symbol + p_right.code + ")";
+			return true;
+		}
+		default:
+			return false;
+	}
+}
+
+void GDScriptNativeCodeGenerator::_append_line(const String &p_line) {
+	code += String("\t").repeat(indent) + p_line + "\n";
+}
+
+bool GDScriptNativeCodeGenerator::_parse_call(const GDScriptParser::CallNode *p_call, Expression &r_result) {
+	if (p_call->is_super || p_call->callee == nullptr) {
+		return false;
+	}
+
+	Vector<Expression> arguments;
+	arguments.resize(p_call->arguments.size());
+	for (int i = 0; i < p_call->arguments.size(); i++) {
+		if (!_parse_expression(p_call->arguments[i], arguments.write[i])) {
+			return false;
+		}
+	}
+
+	if (p_call->callee->type == GDScriptParser::Node::IDENTIFIER) {
+		// Resolved in the same order as in `GDScriptCompiler::_parse_expression()`.
+		const Variant::Type constructed = GDScriptParser::get_builtin_type(p_call->function_name);
+		if (constructed < Variant::VARIANT_MAX) {
+			String x, y, z;
+			switch (constructed) {
+				case Variant::INT:
+				case Variant::FLOAT: {
+					if (arguments.size() != 1 || !_convert(arguments[0], constructed, r_result.code)) {
+						return false;
+					}
+				} break;
+				case Variant::VECTOR2: {
+					if (arguments.is_empty()) {
+						r_result.code = "Vector2()";
+					} else if (arguments.size() == 1 && arguments[0].type == Variant::VECTOR2) {
+						r_result.code = arguments[0].code;
+					} else if (arguments.size() == 2 && _convert(arguments[0], Variant::FLOAT, x) && _convert(arguments[1], Variant::FLOAT, y)) {
+						r_result.code = "Vector2((real_t)" + x + ", (real_t)" + y + ")";
+					} else {
+						return false;
+					}
+				} break;
+				case Variant::VECTOR3: {
+					if (arguments.is_empty()) {
+						r_result.code = "Vector3()";
+					} else if (arguments.size() == 1 && arguments[0].type == Variant::VECTOR3) {
+						r_result.code = arguments[0].code;
+					} else if (arguments.size() == 3 && _convert(arguments[0], Variant::FLOAT, x) && _convert(arguments[1], Variant::FLOAT, y) && _convert(arguments[2], Variant::FLOAT, z)) {
+						r_result.code = "Vector3((real_t)" + x + ", (real_t)" + y + ", (real_t)" + z + ")";
+					} else {
+						return false;
+					}
+				} break;
+				default:
+					return false;
+			}
+			r_result.type = constructed;
+			return true;
+		}
+
+		if (!Variant::has_utility_function(p_call->function_name)) {
+			return false;
+		}
+		for (const GDScriptNativeUtility *utility = native_utilities; utility->name; utility++) {
+			if (p_call->function_name != utility->name) {
+				continue;
+			}
+			const int argument_count = strlen(utility->signature) - 1;
+			if (arguments.size() != argument_count) {
+				return false;
+			}
+			String call = String("VariantUtilityFunctions::") + utility->name + "(";
+			for (int i = 0; i < argument_count; i++) {
+				const Variant::Type type = _get_utility_type(utility->signature[i + 1]);
+				// Only allow conversions the VM would do implicitly.
+				if (arguments[i].type != type && !(arguments[i].type == Variant::INT && type == Variant::FLOAT)) {
+					return false;
+				}
+				String argument;
+				_convert(arguments[i], type, argument);
+				call += (i > 0 ? ", " : "") + argument;
+			}
+			r_result.code = call + ")";
+			r_result.type = _get_utility_type(utility->signature[0]);
+			return true;
+		}
+		return false;
+	}
+
+	if (p_call->callee->type != GDScriptParser::Node::SUBSCRIPT) {
+		return false;
+	}
+	const GDScriptParser::SubscriptNode *subscript = static_cast<const GDScriptParser::SubscriptNode *>(p_call->callee);
+	if (!subscript->is_attribute) {
+		return false;
+	}
+	Expression base;
+	if (!_parse_expression(subscript->base, base) || (base.type != Variant::VECTOR2 && base.type != Variant::VECTOR3)) {
+		return false;
+	}
+
+	const StringName &method = p_call->function_name;
+	if (arguments.is_empty()) {
+		if (method == SNAME("length") || method == SNAME("length_squared")) {
+			r_result.type = Variant::FLOAT;
+			r_result.code = "(double)" + base.code + "." + String(method) + "()";
+			return true;
+		}
+		if (method == SNAME("normalized")) {
+			r_result.type = base.type;
+			r_result.code = base.code + ".normalized()";
+			return true;
+		}
+		return false;
+	}
+	if (arguments.size() != 1 || arguments[0].type != base.type) {
+		return false;
+	}
+	if (method == SNAME("dot") || method == SNAME("distance_to") || method == SNAME("distance_squared_to") || (method == SNAME("cross") && base.type == Variant::VECTOR2)) {
+		r_result.type = Variant::FLOAT;
+		r_result.code = "(double)" + base.code + "." + String(method) + "(" + arguments[0].code + ")";
+		return true;
+	}
+	if (method == SNAME("cross")) {
+		r_result.type = Variant::VECTOR3;
+		r_result.code = base.code + ".cross(" + arguments[0].code + ")";
+		return true;
+	}
+	return false;
+}
+
+bool GDScriptNativeCodeGenerator::_parse_expression(const GDScriptParser::ExpressionNode *p_expression, Expression &r_result) {
+	if (p_expression->is_constant) {
+		// Folded by the analyzer.
+		if (!_is_supported_type(p_expression->reduced_value.get_type())) {
+			return false;
+		}
+		r_result.type = p_expression->reduced_value.get_type();
+		r_result.code = _get_literal(p_expression->reduced_value);
+		return true;
+	}
+
+	switch (p_expression->type) {
+		case GDScriptParser::Node::IDENTIFIER: {
+			const GDScriptParser::IdentifierNode *identifier = static_cast<const GDScriptParser::IdentifierNode *>(p_expression);
+			switch (identifier->source) {
+				case GDScriptParser::IdentifierNode::FUNCTION_PARAMETER:
+				case GDScriptParser::IdentifierNode::LOCAL_VARIABLE:
+				case GDScriptParser::IdentifierNode::LOCAL_ITERATOR:
+					break;
+				default:
+					return false;
+			}
+			if (!_get_hard_type(identifier->get_datatype(), r_result.type)) {
+				return false;
+			}
+			r_result.code = _get_local_name(identifier->name);
+			return true;
+		}
+		case GDScriptParser::Node::BINARY_OPERATOR: {
+			const GDScriptParser::BinaryOpNode *binary = static_cast<const GDScriptParser::BinaryOpNode *>(p_expression);
+			Expression left;
+			Expression right;
+			if (!_parse_expression(binary->left_operand, left) || !_parse_expression(binary->right_operand, right)) {
+				return false;
+			}
+			if (binary->operation == GDScriptParser::BinaryOpNode::OP_LOGIC_AND || binary->operation == GDScriptParser::BinaryOpNode::OP_LOGIC_OR) {
+				const char *symbol = binary->operation == GDScriptParser::BinaryOpNode::OP_LOGIC_AND ? " && " : " || ";
+				r_result.type = Variant::BOOL;
+				r_result.code = "(" + _get_condition(left) + symbol + _get_condition(right) + ")";
+				return true;
+			}
+			return _make_binary(binary->variant_op, left, right, r_result);
+		}
+		case GDScriptParser::Node::UNARY_OPERATOR: {
+			const GDScriptParser::UnaryOpNode *unary = static_cast<const GDScriptParser::UnaryOpNode *>(p_expression);
+			Expression operand;
+			if (!_parse_expression(unary->operand, operand)) {
+				return false;
+			}
+			switch (unary->operation) {
+				case GDScriptParser::UnaryOpNode::OP_POSITIVE:
+				case GDScriptParser::UnaryOpNode::OP_NEGATIVE: {
+					if (operand.type == Variant::BOOL) {
+						return false;
+					}
+					r_result.type = operand.type;
+					r_result.code = unary->operation == GDScriptParser::UnaryOpNode::OP_NEGATIVE ? "(-" + operand.code + ")" : operand.code;
+					return true;
+				}
+				case GDScriptParser::UnaryOpNode::OP_COMPLEMENT: {
+					if (operand.type != Variant::INT) {
+						return false;
+					}
+					r_result.type = Variant::INT;
+					r_result.code = "(~" + operand.code + ")";
+					return true;
+				}
+				case GDScriptParser::UnaryOpNode::OP_LOGIC_NOT: {
+					r_result.type = Variant::BOOL;
+					r_result.code = "(!" + _get_condition(operand) + ")";
+					return true;
+				}
+			}
+			return false;
+		}
+		case GDScriptParser::Node::TERNARY_OPERATOR: {
+			const GDScriptParser::TernaryOpNode *ternary = static_cast<const GDScriptParser::TernaryOpNode *>(p_expression);
+			Expression condition;
+			Expression true_expr;
+			Expression false_expr;
+			if (!_parse_expression(ternary->condition, condition) || !_parse_expression(ternary->true_expr, true_expr) || !_parse_expression(ternary->false_expr, false_expr)) {
+				return false;
+			}
+			if (true_expr.type != false_expr.type) {
+				return false;
+			}
+			r_result.type = true_expr.type;
+			r_result.code = "(" + _get_condition(condition) + " ? " + true_expr.code + " : " + false_expr.code + ")";
+			return true;
+		}
+		case GDScriptParser::Node::SUBSCRIPT: {
+			const GDScriptParser::SubscriptNode *subscript = static_cast<const GDScriptParser::SubscriptNode *>(p_expression);
+			if (!subscript->is_attribute) {
+				return false;
+			}
+			Expression base;
+			if (!_parse_expression(subscript->base, base)) {
+				return false;
+			}
+			const StringName &name = subscript->attribute->name;
+			const bool is_component = (base.type == Variant::VECTOR2 && (name == SNAME("x") || name == SNAME("y"))) ||
+					(base.type == Variant::VECTOR3 && (name == SNAME("x") || name == SNAME("y") || name == SNAME("z")));
+			if (!is_component) {
+				return false;
+			}
+			r_result.type = Variant::FLOAT;
+			r_result.code = "(double)" + base.code + "." + String(name);
+			return true;
+		}
+		case GDScriptParser::Node::CALL:
+			return _parse_call(static_cast<const GDScriptParser::CallNode *>(p_expression), r_result);
+		default:
+			return false;
+	}
+}
+
+bool GDScriptNativeCodeGenerator::_parse_assignment(const GDScriptParser::AssignmentNode *p_assignment) {
+	Expression value;
+	if (!_parse_expression(p_assignment->assigned_value, value)) {
+		return false;
+	}
+	if (p_assignment->operation != GDScriptParser::AssignmentNode::OP_NONE) {
+		Expression current;
+		if (!_parse_expression(p_assignment->assignee, current) || !_make_binary(p_assignment->variant_op, current, value, value)) {
+			return false;
+		}
+	}
+
+	String converted;
+	if (p_assignment->assignee->type == GDScriptParser::Node::IDENTIFIER) {
+		Expression target;
+		if (!_parse_expression(p_assignment->assignee, target) || !_convert(value, target.type, converted)) {
+			return false;
+		}
+		_append_line(target.code + " = " + converted + ";");
+		return true;
+	}
+
+	if (p_assignment->assignee->type != GDScriptParser::Node::SUBSCRIPT) {
+		return false;
+	}
+	// Vector component of a local.
+	const GDScriptParser::SubscriptNode *subscript = static_cast<const GDScriptParser::SubscriptNode *>(p_assignment->assignee);
+	Expression component;
+	if (!subscript->is_attribute || subscript->base->type != GDScriptParser::Node::IDENTIFIER || !_parse_expression(subscript, component)) {
+		return false;
+	}
+	Expression base;
+	if (!_parse_expression(subscript->base, base) || !_convert(value, Variant::FLOAT, converted)) {
+		return false;
+	}
+	_append_line(base.code + "." + String(subscript->attribute->name) + " = (real_t)" + converted + ";");
+	return true;
+}
+
+bool GDScriptNativeCodeGenerator::_parse_for(const GDScriptParser::ForNode *p_for) {
+	Variant::Type variable_type;
+	if (!_get_hard_type(p_for->variable->get_datatype(), variable_type) || variable_type != Variant::INT) {
+		return false;
+	}
+
+	String from = "INT64_C(0)";
+	String to;
+	String step = "INT64_C(1)";
+	bool descending = false;
+
+	const GDScriptParser::CallNode *call = p_for->list->type == GDScriptParser::Node::CALL ? static_cast<const GDScriptParser::CallNode *>(p_for->list) : nullptr;
+	if (call && !call->is_super && call->get_callee_type() == GDScriptParser::Node::IDENTIFIER && call->function_name == SNAME("range")) {
+		const int argument_count = call->arguments.size();
+		if (argument_count < 1 || argument_count > 3) {
+			return false;
+		}
+		Vector<Expression> arguments;
+		arguments.resize(argument_count);
+		for (int i = 0; i < argument_count; i++) {
+			if (!_parse_expression(call->arguments[i], arguments.write[i]) || arguments[i].type != Variant::INT) {
+				return false;
+			}
+		}
+		if (argument_count == 1) {
+			to = arguments[0].code;
+		} else {
+			from = arguments[0].code;
+			to = arguments[1].code;
+		}
+		if (argument_count == 3) {
+			// The direction has to be known to pick the loop condition.
+			const GDScriptParser::ExpressionNode *step_node = call->arguments[2];
+			if (!step_node->is_constant || int64_t(step_node->reduced_value) == 0) {
+				return false;
+			}
+			step = arguments[2].code;
+			descending = int64_t(step_node->reduced_value) < 0;
+		}
+	} else {
+		Expression count;
+		if (!_parse_expression(p_for->list, count) || count.type != Variant::INT) {
+			return false;
+		}
+		to = count.code;
+	}
+
+	const String counter = "it" + itos(iterators++);
+	_append_line("{");
+	indent++;
+	_append_line("const int64_t " + counter + "_to = " + to + ";");
+	_append_line("for (int64_t " + counter + " = " + from + "; " + counter + (descending ? " > " : " < ") + counter + "_to; " + counter + " += " + step + ") {");
+	indent++;
+	_append_line("int64_t " + _get_local_name(p_for->variable->name) + " = " + counter + ";");
+	if (!_parse_block(p_for->loop)) {
+		return false;
+	}
+	indent--;
+	_append_line("}");
+	indent--;
+	_append_line("}");
+	return true;
+}
+
+bool GDScriptNativeCodeGenerator::_parse_block(const GDScriptParser::SuiteNode *p_block) {
+	for (const GDScriptParser::Node *statement : p_block->statements) {
+		switch (statement->type) {
+			case GDScriptParser::Node::PASS:
+			case GDScriptParser::Node::CONSTANT: // Local constants are folded into their uses.
+				break;
+			case GDScriptParser::Node::VARIABLE: {
+				const GDScriptParser::VariableNode *variable = static_cast<const GDScriptParser::VariableNode *>(statement);
+				Variant::Type type;
+				if (!_get_hard_type(variable->get_datatype(), type)) {
+					return false;
+				}
+				String initializer;
+				if (variable->initializer) {
+					Expression value;
+					if (!_parse_expression(variable->initializer, value) || !_convert(value, type, initializer)) {
+						return false;
+					}
+				} else {
+					Callable::CallError ce;
+					Variant default_value;
+					Variant::construct(type, default_value, nullptr, 0, ce);
+					initializer = _get_literal(default_value);
+				}
+				_append_line(_get_cpp_type(type) + " " + _get_local_name(variable->identifier->name) + " = " + initializer + ";");
+			} break;
+			case GDScriptParser::Node::ASSIGNMENT: {
+				if (!_parse_assignment(static_cast<const GDScriptParser::AssignmentNode *>(statement))) {
+					return false;
+				}
+			} break;
+			case GDScriptParser::Node::IF: {
+				const GDScriptParser::IfNode *if_node = static_cast<const GDScriptParser::IfNode *>(statement);
+				Expression condition;
+				if (!_parse_expression(if_node->condition, condition)) {
+					return false;
+				}
+				_append_line("if (" + _get_condition(condition) + ") {");
+				indent++;
+				if (!_parse_block(if_node->true_block)) {
+					return false;
+				}
+				indent--;
+				if (if_node->false_block) {
+					_append_line("} else {");
+					indent++;
+					if (!_parse_block(if_node->false_block)) {
+						return false;
+					}
+					indent--;
+				}
+				_append_line("}");
+			} break;
+			case GDScriptParser::Node::WHILE: {
+				const GDScriptParser::WhileNode *while_node = static_cast<const GDScriptParser::WhileNode *>(statement);
+				Expression condition;
+				if (!_parse_expression(while_node->condition, condition)) {
+					return false;
+				}
+				_append_line("while (" + _get_condition(condition) + ") {");
+				indent++;
+				if (!_parse_block(while_node->loop)) {
+					return false;
+				}
+				indent--;
+				_append_line("}");
+			} break;
+			case GDScriptParser::Node::FOR: {
+				if (!_parse_for(static_cast<const GDScriptParser::ForNode *>(statement))) {
+					return false;
+				}
+			} break;
+			case GDScriptParser::Node::BREAK:
+				_append_line("break;");
+				break;
+			case GDScriptParser::Node::CONTINUE:
+				_append_line("continue;");
+				break;
+			case GDScriptParser::Node::RETURN: {
+				const GDScriptParser::ReturnNode *return_node = static_cast<const GDScriptParser::ReturnNode *>(statement);
+				if (return_node->return_value) {
+					Variant::Type return_type;
+					Expression value;
+					String converted;
+					if (!_get_hard_type(function->get_datatype(), return_type) || !_parse_expression(return_node->return_value, value) || !_convert(value, return_type, converted)) {
+						return false;
+					}
+					_append_line("r_ret = " + converted + ";");
+				}
+				_append_line("return;");
+			} break;
+			case GDScriptParser::Node::CALL: {
+				// Only pure functions are supported, but the statement is still valid.
+				Expression value;
+				if (!_parse_expression(static_cast<const GDScriptParser::ExpressionNode *>(statement), value)) {
+					return false;
+				}
+				_append_line("(void)" + value.code + ";");
+			} break;
+			default:
+				return false;
+		}
+	}
+	return true;
+}
+
+String GDScriptNativeCodeGenerator::generate_function(const GDScriptParser::FunctionNode *p_function) {
+	if (p_function == nullptr || p_function->identifier == nullptr || p_function->source_lambda || p_function->is_coroutine || p_function->body == nullptr) {
+		return String();
+	}
+
+	// Untyped functions may return anything, `void` is the only other accepted return type.
+	const GDScriptParser::DataType return_type = p_function->get_datatype();
+	Variant::Type type;
+	if (!_get_hard_type(return_type, type) && !(return_type.is_hard_type() && return_type.kind == GDScriptParser::DataType::BUILTIN && return_type.builtin_type == Variant::NIL)) {
+		return String();
+	}
+
+	GDScriptNativeCodeGenerator generator;
+	generator.function = p_function;
+	generator.indent = 1;
+
+	for (int i = 0; i < p_function->parameters.size(); i++) {
+		const GDScriptParser::ParameterNode *parameter = p_function->parameters[i];
+		// Default arguments are evaluated by the VM.
+		if (parameter->initializer || !_get_hard_type(parameter->get_datatype(), type)) {
+			return String();
+		}
+		generator._append_line(_get_cpp_type(type) + " " + _get_local_name(parameter->identifier->name) + " = *VariantInternal::get_" + Variant::get_type_name(type).to_lower() + "(p_args[" + itos(i) + "]);");
+	}
+
+	if (!generator._parse_block(p_function->body)) {
+		return String();
+	}
+	return "{\n" + generator.code + "}\n";
+}
+
+void GDScriptNativeCodeGenerator::add_class(const GDScriptParser::ClassNode *p_class) {
+	for (const GDScriptParser::ClassNode::Member &member : p_class->members) {
+		if (member.type == GDScriptParser::ClassNode::Member::CLASS) {
+			add_class(member.m_class);
+			continue;
+		}
+		if (member.type != GDScriptParser::ClassNode::Member::FUNCTION) {
+			continue;
+		}
+
+		const String body = generate_function(member.function);
+		if (body.is_empty()) {
+			continue;
+		}
+		const String name = member.function->identifier->name;
+		const String symbol = "_gdscript_native_" + itos(function_count++);
+		source_functions += "// " + p_class->fqcn + "::" + name + "\n";
+		source_functions += "static void " + symbol + "(const Variant **p_args, Variant &r_ret) " + body + "\n";
+		source_registrations += "\tGDScriptNativeFunctions::register_function(String::utf8(\"" + p_class->fqcn.c_escape() + "\"), StringName(String::utf8(\"" + name.c_escape() + "\")), UINT64_C(" + String::num_uint64(body.hash64()) + "), " + symbol + ");\n";
+	}
+}
+
+String GDScriptNativeCodeGenerator::get_source() const {
+	String source = "/* THIS FILE IS GENERATED DO NOT EDIT */\n\n";
+	source += "#include \"modules/gdscript/gdscript_native.h\"\n\n";
+	source += "#include \"core/math/math_funcs.h\"\n";
+	source += "#include \"core/variant/variant_internal.h\"\n";
+	source += "#include \"core/variant/variant_utility.h\"\n\n";
+	source += source_functions;
+	source += "void register_gdscript_native_functions() {\n";
+	source += source_registrations;
+	source += "}\n";
+	return source;
+}
@@ -0,0 +1,125 @@
+/**************************************************************************/
+/*  gdscript_native.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_NATIVE_H
+#define GDSCRIPT_NATIVE_H
+
+#include "gdscript_parser.h"
+
+#include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
+#include "core/variant/variant.h"
+
+// Ahead-of-time compilation of GDScript functions to C++.
+//
+// At export time, functions that only use a statically typed numeric subset of the language
+// (bool, int, float, Vector2 and Vector3 locals, arithmetic, comparisons, control flow and
+// math utility functions) are translated to C++ by GDScriptNativeCodeGenerator. Building the
+// engine with `gdscript_native_path` pointing to the generated sources links them in, and
+// the compiler then attaches each native function to its bytecode counterpart. Anything the
+// subset does not cover keeps running in the VM.
+//
+// Functions are matched by class, name and a hash of their generated code, so a script that
+// changed since export silently falls back to the VM for the affected functions.
+
+class GDScriptNativeFunctions {
+public:
+	// Arguments are guaranteed to have the exact declared types.
+	typedef void (*Function)(const Variant **p_args, Variant &r_ret);
+
+private:
+	struct Entry {
+		uint64_t hash = 0;
+		Function function = nullptr;
+	};
+
+	static HashMap<String, HashMap<StringName, Entry>> functions;
+
+public:
+	static void register_function(const String &p_class, const StringName &p_function, uint64_t p_hash, Function p_ptr);
+	static void clear();
+
+	_FORCE_INLINE_ static bool has_class(const String &p_class) { return !functions.is_empty() && functions.has(p_class); }
+	static Function get_function(const GDScriptParser::ClassNode *p_class, const GDScriptParser::FunctionNode *p_function);
+	// Registered function and its hash, without checking it against the script.
+	static Function find_function(const String &p_class, const StringName &p_function, uint64_t &r_hash);
+};
+
+class GDScriptNativeCodeGenerator {
+	struct Expression {
+		String code;
+		Variant::Type type = Variant::NIL;
+	};
+
+	// Function being generated.
+	const GDScriptParser::FunctionNode *function = nullptr;
+	String code;
+	int indent = 0;
+	int iterators = 0;
+
+	// Translation unit.
+	String source_functions;
+	String source_registrations;
+	int function_count = 0;
+
+	static bool _is_supported_type(Variant::Type p_type);
+	static bool _get_hard_type(const GDScriptParser::DataType &p_type, Variant::Type &r_type);
+	static String _get_cpp_type(Variant::Type p_type);
+	static String _get_local_name(const StringName &p_name);
+	static String _get_literal(const Variant &p_value);
+	static bool _convert(const Expression &p_expression, Variant::Type p_type, String &r_code);
+	static String _get_condition(const Expression &p_expression);
+	static bool _make_binary(Variant::Operator p_op, const Expression &p_left, const Expression &p_right, Expression &r_result);
+
+	void _append_line(const String &p_line);
+
+	bool _parse_call(const GDScriptParser::CallNode *p_call, Expression &r_result);
+	bool _parse_expression(const GDScriptParser::ExpressionNode *p_expression, Expression &r_result);
+	bool _parse_assignment(const GDScriptParser::AssignmentNode *p_assignment);
+	bool _parse_for(const GDScriptParser::ForNode *p_for);
+	bool _parse_block(const GDScriptParser::SuiteNode *p_block);
+
+public:
+	// Returns the body of the C++ function implementing p_function, or an empty string
+	// if the function uses anything outside of the supported subset.
+	static String generate_function(const GDScriptParser::FunctionNode *p_function);
+
+	// Builds the translation unit written at export time.
+	void add_class(const GDScriptParser::ClassNode *p_class);
+	_FORCE_INLINE_ bool is_empty() const { return function_count == 0; }
+	String get_source() const;
+};
+
+#ifdef GDSCRIPT_NATIVE_FUNCTIONS_ENABLED
+// Defined in the generated sources.
+void register_gdscript_native_functions();
+#endif
+
+#endif // GDSCRIPT_NATIVE_H
@@ -0,0 +1,166 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_sampling_profiler.h"
+
+#include "gdscript.h"
+
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+
+void GDScriptSamplingProfiler::_thread_func(void *p_userdata) {
+	GDScriptSamplingProfiler *profiler = static_cast<GDScriptSamplingProfiler *>(p_userdata);
+	Thread::set_name("GDScript sampling profiler");
+
+	uint64_t last_save = OS::get_singleton()->get_ticks_usec();
+	while (!profiler->exit_thread.is_set()) {
+		OS::get_singleton()->delay_usec(profiler->interval_usec);
+		profiler->_take_sample();
+
+		uint64_t now = OS::get_singleton()->get_ticks_usec();
+		if (now - last_save >= SAVE_INTERVAL_USEC) {
+			profiler->_save();
+			last_save = now;
+		}
+	}
+}
+
+void GDScriptSamplingProfiler::_take_sample() {
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	uint32_t sample_index = 0;
+
+	{
+		// Functions are removed from the language under this lock when freed, so the
+		// ones still on a call stack stay valid while their names are copied. Only copy
+		// here, the sampled threads block on this lock when they start or finish.
+		MutexLock lock(language->mutex);
+
+		for (const GDScriptLanguage::CallStack *call_stack : language->call_stacks) {
+			int depth = call_stack->stack_pos.load(std::memory_order_acquire);
+			if (depth == 0) {
+				continue;
+			}
+
+			if (sample_index == samples.size()) {
+				samples.push_back(Sample());
+			}
+			Sample &sample = samples[sample_index++];
+			sample.thread_id = call_stack->thread_id;
+
+			for (int i = 0; i < depth; i++) {
+				const GDScriptLanguage::CallLevel &level = call_stack->levels[i];
+				const GDScriptFunction *function = level.sampled_function.load(std::memory_order_relaxed);
+				if (!function) {
+					continue;
+				}
+				Frame frame;
+				frame.function = function->get_name();
+				frame.source = function->get_source();
+				frame.line = level.sampled_line.load(std::memory_order_relaxed);
+				sample.frames.push_back(frame);
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < sample_index; i++) {
+		Sample &sample = samples[i];
+		String stack = sample.thread_id == Thread::get_main_id() ? String("Main Thread") : "Thread " + itos(sample.thread_id);
+		for (const Frame &frame : sample.frames) {
+			stack += ";" + String(frame.function) + " (" + String(frame.source) + ":" + itos(frame.line) + ")";
+		}
+		// Outside of the lock, releasing names may need the StringName lock.
+		sample.frames.clear();
+
+		HashMap<String, uint64_t>::Iterator E = stacks.find(stack);
+		if (E) {
+			E->value++;
+		} else {
+			stacks.insert(stack, 1);
+		}
+	}
+	sample_count++;
+}
+
+String GDScriptSamplingProfiler::get_collapsed_stacks() const {
+	Vector<String> lines;
+	lines.resize(stacks.size());
+	int i = 0;
+	for (const KeyValue<String, uint64_t> &E : stacks) {
+		lines.write[i++] = E.key + " " + itos(E.value);
+	}
+	lines.sort();
+
+	String result;
+	for (const String &line : lines) {
+		result += line + "\n";
+	}
+	return result;
+}
+
+Error GDScriptSamplingProfiler::_save() const {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(output_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat(R"(Cannot write the GDScript sampling profile to "%s".)", output_path));
+
+	f->store_string(get_collapsed_stacks());
+	return OK;
+}
+
+Error GDScriptSamplingProfiler::start(const String &p_output_path, int p_frequency) {
+	ERR_FAIL_COND_V_MSG(thread.is_started(), ERR_ALREADY_IN_USE, "The GDScript sampling profiler is already running.");
+	ERR_FAIL_COND_V(p_output_path.is_empty(), ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(p_frequency <= 0, ERR_INVALID_PARAMETER);
+
+	output_path = p_output_path;
+	interval_usec = 1000000 / p_frequency;
+	stacks.clear();
+	sample_count = 0;
+
+	exit_thread.clear();
+	thread.start(_thread_func, this);
+	return OK;
+}
+
+void GDScriptSamplingProfiler::stop() {
+	if (!thread.is_started()) {
+		return;
+	}
+
+	exit_thread.set();
+	thread.wait_to_finish();
+
+	if (_save() == OK) {
+		print_line(vformat(R"(GDScript sampling profile with %d samples written to "%s".)", sample_count, output_path));
+	}
+}
+
+GDScriptSamplingProfiler::~GDScriptSamplingProfiler() {
+	stop();
+}
@@ -0,0 +1,85 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_SAMPLING_PROFILER_H
+#define GDSCRIPT_SAMPLING_PROFILER_H
+
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+// Periodically captures the GDScript call stack of every thread from a
+// separate thread, without instrumenting function calls, and writes the
+// aggregated samples in the collapsed stack format used by flame graph tools.
+class GDScriptSamplingProfiler {
+	// Rewrite the output while running, so long-lived processes that are killed still leave a profile behind.
+	static constexpr uint64_t SAVE_INTERVAL_USEC = 10000000;
+
+	String output_path;
+	uint64_t interval_usec = 1000;
+
+	Thread thread;
+	SafeFlag exit_thread;
+
+	struct Frame {
+		StringName function;
+		StringName source;
+		int line = 0;
+	};
+
+	struct Sample {
+		Thread::ID thread_id = 0;
+		LocalVector<Frame> frames;
+	};
+
+	// Reused between samples, only the profiler thread touches it.
+	LocalVector<Sample> samples;
+
+	HashMap<String, uint64_t> stacks;
+	uint64_t sample_count = 0;
+
+	static void _thread_func(void *p_userdata);
+
+	void _take_sample();
+	Error _save() const;
+
+public:
+	Error start(const String &p_output_path, int p_frequency);
+	void stop();
+	bool is_running() const { return thread.is_started(); }
+
+	String get_collapsed_stacks() const;
+
+	~GDScriptSamplingProfiler();
+};
+
+#endif // GDSCRIPT_SAMPLING_PROFILER_H
@@ -232,6 +232,29 @@ void (*type_init_function_table[])(Variant *) = {
 	static const void *switch_table_ops[] = {            \
 		&&OPCODE_OPERATOR,                               \
 		&&OPCODE_OPERATOR_VALIDATED,                     \
+		&&OPCODE_OPERATOR_ADD_INT,                       \
+		&&OPCODE_OPERATOR_SUBTRACT_INT,                  \
+		&&OPCODE_OPERATOR_MULTIPLY_INT,                  \
+		&&OPCODE_OPERATOR_EQUAL_INT,                     \
+		&&OPCODE_OPERATOR_NOT_EQUAL_INT,                 \
+		&&OPCODE_OPERATOR_LESS_INT,                      \
+		&&OPCODE_OPERATOR_LESS_EQUAL_INT,                \
+		&&OPCODE_OPERATOR_GREATER_INT,                   \
+		&&OPCODE_OPERATOR_GREATER_EQUAL_INT,             \
+		&&OPCODE_OPERATOR_ADD_FLOAT,                     \
+		&&OPCODE_OPERATOR_SUBTRACT_FLOAT,                \
+		&&OPCODE_OPERATOR_MULTIPLY_FLOAT,                \
+		&&OPCODE_OPERATOR_DIVIDE_FLOAT,                  \
+		&&OPCODE_OPERATOR_LESS_FLOAT,                    \
+		&&OPCODE_OPERATOR_LESS_EQUAL_FLOAT,              \
+		&&OPCODE_OPERATOR_GREATER_FLOAT,                 \
+		&&OPCODE_OPERATOR_GREATER_EQUAL_FLOAT,           \
+		&&OPCODE_OPERATOR_ADD_VECTOR2,                   \
+		&&OPCODE_OPERATOR_SUBTRACT_VECTOR2,              \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT,        \
+		&&OPCODE_OPERATOR_ADD_VECTOR3,                   \
+		&&OPCODE_OPERATOR_SUBTRACT_VECTOR3,              \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT,        \
 		&&OPCODE_TYPE_TEST_BUILTIN,                      \
 		&&OPCODE_TYPE_TEST_ARRAY,                        \
 		&&OPCODE_TYPE_TEST_DICTIONARY,                   \
@@ -475,6 +498,22 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 	r_err.error = Callable::CallError::CALL_OK;
 
+	if (native_function && !p_state && p_argcount == _argument_count && !EngineDebugger::is_active()) {
+		// Native code skips the implicit conversions, so argument types must match exactly.
+		bool exact_types = true;
+		for (int i = 0; i < p_argcount; i++) {
+			if (p_args[i]->get_type() != argument_types[i].builtin_type) {
+				exact_types = false;
+				break;
+			}
+		}
+		if (exact_types) {
+			Variant ret;
+			native_function(p_args, ret);
+			return ret;
+		}
+	}
+
 	static thread_local int call_depth = 0;
 	if (unlikely(++call_depth > MAX_CALL_DEPTH)) {
 		call_depth--;
@@ -611,6 +650,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		}
 	}
 
+	if (call_depth == 1) {
+		// Retired inline cache chains are only freed while no thread runs a GDScript function.
+		inline_cache_active_threads.increment();
+	}
+
 	if (p_instance) {
 		memnew_placement(&stack[ADDR_STACK_SELF], Variant(p_instance->owner));
 		script = p_instance->script.ptr();
@@ -625,7 +669,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 #ifdef DEBUG_ENABLED
 
-	if (EngineDebugger::is_active()) {
+	if (GDScriptLanguage::get_singleton()->is_call_stack_tracked()) {
 		GDScriptLanguage::get_singleton()->enter_function(p_instance, this, stack, &ip, &line);
 	}
 
@@ -818,6 +862,46 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+#define OPCODE_OPERATOR_TYPED(m_op, m_left_type, m_right_type, m_ret_type, m_operator) \
+	OPCODE(OPCODE_OPERATOR_##m_op) {                                                   \
+		CHECK_SPACE(4);                                                                \
+		GET_VARIANT_PTR(a, 0);                                                         \
+		GET_VARIANT_PTR(b, 1);                                                         \
+		GET_VARIANT_PTR(dst, 2);                                                       \
+		const auto &left = *VariantInternal::OP_GET_##m_left_type(a);                  \
+		const auto &right = *VariantInternal::OP_GET_##m_right_type(b);                \
+		*VariantInternal::OP_GET_##m_ret_type(dst) = left m_operator right;            \
+		ip += 4;                                                                       \
+	}                                                                                  \
+	DISPATCH_OPCODE
+
+			// Same as the validated operators, without the indirect call.
+			OPCODE_OPERATOR_TYPED(ADD_INT, INT, INT, INT, +);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_INT, INT, INT, INT, -);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_INT, INT, INT, INT, *);
+			OPCODE_OPERATOR_TYPED(EQUAL_INT, INT, INT, BOOL, ==);
+			OPCODE_OPERATOR_TYPED(NOT_EQUAL_INT, INT, INT, BOOL, !=);
+			OPCODE_OPERATOR_TYPED(LESS_INT, INT, INT, BOOL, <);
+			OPCODE_OPERATOR_TYPED(LESS_EQUAL_INT, INT, INT, BOOL, <=);
+			OPCODE_OPERATOR_TYPED(GREATER_INT, INT, INT, BOOL, >);
+			OPCODE_OPERATOR_TYPED(GREATER_EQUAL_INT, INT, INT, BOOL, >=);
+			OPCODE_OPERATOR_TYPED(ADD_FLOAT, FLOAT, FLOAT, FLOAT, +);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_FLOAT, FLOAT, FLOAT, FLOAT, -);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_FLOAT, FLOAT, FLOAT, FLOAT, *);
+			OPCODE_OPERATOR_TYPED(DIVIDE_FLOAT, FLOAT, FLOAT, FLOAT, /);
+			OPCODE_OPERATOR_TYPED(LESS_FLOAT, FLOAT, FLOAT, BOOL, <);
+			OPCODE_OPERATOR_TYPED(LESS_EQUAL_FLOAT, FLOAT, FLOAT, BOOL, <=);
+			OPCODE_OPERATOR_TYPED(GREATER_FLOAT, FLOAT, FLOAT, BOOL, >);
+			OPCODE_OPERATOR_TYPED(GREATER_EQUAL_FLOAT, FLOAT, FLOAT, BOOL, >=);
+			OPCODE_OPERATOR_TYPED(ADD_VECTOR2, VECTOR2, VECTOR2, VECTOR2, +);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_VECTOR2, VECTOR2, VECTOR2, VECTOR2, -);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_VECTOR2_FLOAT, VECTOR2, FLOAT, VECTOR2, *);
+			OPCODE_OPERATOR_TYPED(ADD_VECTOR3, VECTOR3, VECTOR3, VECTOR3, +);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_VECTOR3, VECTOR3, VECTOR3, VECTOR3, -);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_VECTOR3_FLOAT, VECTOR3, FLOAT, VECTOR3, *);
+
+#undef OPCODE_OPERATOR_TYPED
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
@@ -1162,7 +1246,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_SET_NAMED) {
-				CHECK_SPACE(3);
+				CHECK_SPACE(4);
 
 				GET_VARIANT_PTR(dst, 0);
 				GET_VARIANT_PTR(value, 1);
@@ -1172,8 +1256,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				int cache_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_caches_count);
+
 				bool valid;
-				dst->set_named(*index, *value, valid);
+				if (dst->get_type() != Variant::OBJECT || !_inline_cache_set(_inline_caches_ptr[cache_idx], dst, *index, *value, valid)) {
+					dst->set_named(*index, *value, valid);
+				}
 
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1194,7 +1283,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					OPCODE_BREAK;
 				}
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1214,7 +1303,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_GET_NAMED) {
-				CHECK_SPACE(4);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(src, 0);
 				GET_VARIANT_PTR(dst, 1);
@@ -1224,22 +1313,31 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
-				bool valid;
+				int cache_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_caches_count);
+
+				// Read into a temporary, assigning to dst may free the object src points to.
+				Variant cached_ret;
+				if (src->get_type() == Variant::OBJECT && _inline_cache_get(_inline_caches_ptr[cache_idx], src, *index, cached_ret)) {
+					*dst = cached_ret;
+				} else {
+					bool valid;
 #ifdef DEBUG_ENABLED
-				//allow better error message in cases where src and dst are the same stack position
-				Variant ret = src->get_named(*index, valid);
+					//allow better error message in cases where src and dst are the same stack position
+					Variant ret = src->get_named(*index, valid);
 
 #else
-				*dst = src->get_named(*index, valid);
+					*dst = src->get_named(*index, valid);
 #endif
 #ifdef DEBUG_ENABLED
-				if (!valid) {
-					err_text = "Invalid access to property or key '" + index->operator String() + "' on a base object of type '" + _get_var_type(src) + "'.";
-					OPCODE_BREAK;
-				}
-				*dst = ret;
+					if (!valid) {
+						err_text = "Invalid access to property or key '" + index->operator String() + "' on a base object of type '" + _get_var_type(src) + "'.";
+						OPCODE_BREAK;
+					}
+					*dst = ret;
 #endif
-				ip += 4;
+				}
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1858,7 +1956,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				bool call_async = (_code_ptr[ip]) == OPCODE_CALL_ASYNC;
 #endif
 				LOAD_INSTRUCTION_ARGS
-				CHECK_SPACE(3 + instr_arg_count);
+				CHECK_SPACE(4 + instr_arg_count);
 
 				ip += instr_arg_count;
 
@@ -1869,6 +1967,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(methodname_idx < 0 || methodname_idx >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[methodname_idx];
 
+				int cache_idx = _code_ptr[ip + 3];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_caches_count);
+
 				GET_INSTRUCTION_ARG(base, argc);
 				Variant **argptrs = instruction_args;
 
@@ -1881,13 +1982,18 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				Variant::Type base_type = base->get_type();
 				Object *base_obj = base->get_validated_object();
 				StringName base_class = base_obj ? base_obj->get_class_name() : StringName();
+				Object *call_obj = base_obj;
+#else
+				Object *call_obj = base->operator Object *();
 #endif
 
 				Variant temp_ret;
 				Callable::CallError err;
 				if (call_ret) {
 					GET_INSTRUCTION_ARG(ret, argc + 1);
-					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					if (!call_obj || !_inline_cache_call(_inline_caches_ptr[cache_idx], call_obj, *methodname, (const Variant **)argptrs, argc, temp_ret, err)) {
+						base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					}
 					*ret = temp_ret;
 #ifdef DEBUG_ENABLED
 					if (ret->get_type() == Variant::NIL) {
@@ -1917,7 +2023,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					}
 #endif
 				} else {
-					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					if (!call_obj || !_inline_cache_call(_inline_caches_ptr[cache_idx], call_obj, *methodname, (const Variant **)argptrs, argc, temp_ret, err)) {
+						base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					}
 				}
 #ifdef DEBUG_ENABLED
 
@@ -1967,7 +2075,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif
 
-				ip += 3;
+				ip += 4;
 			}
 			DISPATCH_OPCODE;
 
@@ -3661,7 +3769,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 			OPCODE(OPCODE_STORE_GLOBAL) {
 				CHECK_SPACE(3);
-				int global_idx = _code_ptr[ip + 2];
+				int global_pos = _code_ptr[ip + 2];
+				GD_ERR_BREAK(global_pos < 0 || global_pos >= _global_indices_count);
+				int global_idx = _global_indices_ptr[global_pos];
 				GD_ERR_BREAK(global_idx < 0 || global_idx >= GDScriptLanguage::get_singleton()->get_global_array_size());
 
 				GET_VARIANT_PTR(dst, 0);
@@ -3778,6 +3888,12 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				line = _code_ptr[ip + 1];
 				ip += 2;
 
+#ifdef DEBUG_ENABLED
+				if (GDScriptLanguage::get_singleton()->is_call_stack_tracked()) {
+					GDScriptLanguage::get_singleton()->set_call_stack_line(line);
+				}
+#endif
+
 				if (EngineDebugger::is_active()) {
 					// line
 					bool do_break = false;
@@ -3875,7 +3991,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	// If that is the case then we exit the function as normal. Otherwise we postpone it until the last `await` is completed.
 	// This ensures the call stack can be properly shown when using `await`, showing what resumed the function.
 	if (!p_state || awaited) {
-		if (EngineDebugger::is_active()) {
+		if (GDScriptLanguage::get_singleton()->is_call_stack_tracked()) {
 			GDScriptLanguage::get_singleton()->exit_function();
 		}
 #endif
@@ -3893,6 +4009,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		stack[i].~Variant();
 	}
 
+	if (call_depth == 1) {
+		_inline_cache_thread_exit();
+	}
 	call_depth--;
 
 	return retvalue;
@@ -32,7 +32,9 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
+#include "gdscript_native.h"
 #include "gdscript_tokenizer.h"
 #include "gdscript_tokenizer_buffer.h"
 #include "gdscript_utility_functions.h"
@@ -85,7 +87,14 @@ class EditorExportGDScript : public EditorExportPlugin {
 	static constexpr int DEFAULT_SCRIPT_MODE = EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED;
 	int script_mode = DEFAULT_SCRIPT_MODE;
 
+	String native_code_path;
+	GDScriptNativeCodeGenerator native_code_generator;
+
 protected:
+	virtual void _get_export_options(const Ref<EditorExportPlatform> &p_export_platform, List<EditorExportPlatform::ExportOption> *r_options) const override {
+		r_options->push_back(EditorExportPlatform::ExportOption(PropertyInfo(Variant::STRING, "gdscript/native_code_path", PROPERTY_HINT_GLOBAL_DIR), ""));
+	}
+
 	virtual void _export_begin(const HashSet<String> &p_features, bool p_debug, const String &p_path, int p_flags) override {
 		script_mode = DEFAULT_SCRIPT_MODE;
 
@@ -93,10 +102,16 @@ protected:
 		if (preset.is_valid()) {
 			script_mode = preset->get_script_export_mode();
 		}
+
+		native_code_path = get_option("gdscript/native_code_path");
+		native_code_generator = GDScriptNativeCodeGenerator();
 	}
 
 	virtual void _export_file(const String &p_path, const String &p_type, const HashSet<String> &p_features) override {
-		if (p_path.get_extension() != "gd" || script_mode == EditorExportPreset::MODE_SCRIPT_TEXT) {
+		if (p_path.get_extension() != "gd") {
+			return;
+		}
+		if (script_mode == EditorExportPreset::MODE_SCRIPT_TEXT && native_code_path.is_empty()) {
 			return;
 		}
 
@@ -107,6 +122,19 @@ protected:
 
 		String source;
 		source.parse_utf8(reinterpret_cast<const char *>(file.ptr()), file.size());
+
+		if (!native_code_path.is_empty()) {
+			GDScriptParser parser;
+			GDScriptAnalyzer analyzer(&parser);
+			if (parser.parse(source, p_path, false) == OK && analyzer.analyze() == OK) {
+				native_code_generator.add_class(parser.get_tree());
+			}
+		}
+
+		if (script_mode == EditorExportPreset::MODE_SCRIPT_TEXT) {
+			return;
+		}
+
 		GDScriptTokenizerBuffer::CompressMode compress_mode = script_mode == EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED ? GDScriptTokenizerBuffer::COMPRESS_ZSTD : GDScriptTokenizerBuffer::COMPRESS_NONE;
 		file = GDScriptTokenizerBuffer::parse_code_string(source, compress_mode);
 		if (file.is_empty()) {
@@ -116,6 +144,18 @@ protected:
 		add_file(p_path.get_basename() + ".gdc", file, true);
 	}
 
+	virtual void _export_end() override {
+		if (native_code_path.is_empty()) {
+			return;
+		}
+
+		// Written even when empty so the engine build always finds the registration function.
+		const String path = native_code_path.path_join("gdscript_native_functions.gen.cpp");
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		ERR_FAIL_COND_MSG(f.is_null(), vformat(R"(Cannot write GDScript native code to "%s".)", path));
+		f->store_string(native_code_generator.get_source());
+	}
+
 public:
 	virtual String get_name() const override { return "GDScript"; }
 };
@@ -157,6 +197,10 @@ void initialize_gdscript_module(ModuleInitializationLevel p_level) {
 		gdscript_cache = memnew(GDScriptCache);
 
 		GDScriptUtilityFunctions::register_functions();
+
+#ifdef GDSCRIPT_NATIVE_FUNCTIONS_ENABLED
+		register_gdscript_native_functions();
+#endif
 	}
 
 #ifdef TOOLS_ENABLED
@@ -196,6 +240,8 @@ void uninitialize_gdscript_module(ModuleInitializationLevel p_level) {
 
 		GDScriptParser::cleanup();
 		GDScriptUtilityFunctions::unregister_functions();
+		GDScriptNativeFunctions::clear();
+		GDScriptBytecodeCache::clear();
 	}
 
 #ifdef TOOLS_ENABLED
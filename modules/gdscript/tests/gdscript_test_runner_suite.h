@@ -33,7 +33,18 @@
 
 #include "gdscript_test_runner.h"
 
+#include "../gdscript_analyzer.h"
+#include "../gdscript_bytecode_cache.h"
+#include "../gdscript_cache.h"
+#include "../gdscript_native.h"
+#include "../gdscript_parser.h"
+#include "../gdscript_sampling_profiler.h"
+
+#include "core/config/project_settings.h"
+#include "core/io/dir_access.h"
+
 #include "tests/test_macros.h"
+#include "tests/test_utils.h"
 
 namespace GDScriptTests {
 
@@ -70,8 +81,161 @@ func _init():
 	ref_counted->set_script(gdscript);
 	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 42, "The script should assign object metadata successfully.");
 }
+
+TEST_CASE("[Modules][GDScript] Restore compiled bytecode from the cache") {
+	const String path = "res://bytecode_cache_test.gd";
+	const String source = R"(
+extends RefCounted
+
+const FACTORS = [2, 3]
+
+class Inner:
+	static func scale(value: int) -> int:
+		return value * FACTORS[1]
+
+static func compute(count: int) -> int:
+	var total := 0
+	for i in range(count):
+		total += i * FACTORS[0]
+	var add := func(value: int) -> int: return value + 1
+	return add.call(Inner.scale(total))
+)";
+
+	const String cache_path = TestUtils::get_temp_path("gdscript_bytecode_cache");
+	const String entry_path = cache_path.path_join(path.md5_text() + ".gdbc");
+	GDScriptBytecodeCache::set_cache_path(cache_path);
+	ProjectSettings::get_singleton()->set_setting("gdscript/bytecode_cache/enabled", true);
+	REQUIRE_MESSAGE(GDScriptBytecodeCache::is_enabled(), "The bytecode cache should be enabled by the project setting.");
+
+	Ref<GDScript> compiled = memnew(GDScript);
+	compiled->set_source_code(source);
+	compiled->set_path(path, true);
+	ERR_PRINT_OFF;
+	REQUIRE(compiled->reload() == OK);
+	ERR_PRINT_ON;
+	CHECK(int(compiled->call("compute", 4)) == 37);
+	GDScriptCache::remove_script(path);
+	REQUIRE_MESSAGE(FileAccess::exists(entry_path), "Compiled scripts should be saved to the cache.");
+
+	Ref<GDScript> cached = memnew(GDScript);
+	cached->set_source_code(source);
+	cached->set_path(path, true);
+	bool has_static_data = false;
+	CHECK_MESSAGE(GDScriptBytecodeCache::load_script(cached.ptr(), has_static_data), "Unchanged scripts should be restored from the cache.");
+	CHECK(cached->is_valid());
+	CHECK(int(cached->call("compute", 4)) == 37);
+	GDScriptCache::remove_script(path);
+
+	{
+		Ref<FileAccess> f = FileAccess::open(entry_path, FileAccess::READ_WRITE);
+		REQUIRE(f.is_valid());
+		const uint64_t last = f->get_length() - 1;
+		f->seek(last);
+		const uint8_t byte = f->get_8();
+		f->seek(last);
+		f->store_8(byte ^ 0xFF);
+	}
+	Ref<GDScript> corrupted = memnew(GDScript);
+	corrupted->set_source_code(source);
+	corrupted->set_path(path, true);
+	CHECK_MESSAGE(!GDScriptBytecodeCache::load_script(corrupted.ptr(), has_static_data), "Damaged entries should fail their checksum.");
+	GDScriptCache::remove_script(path);
+
+	Ref<GDScript> changed = memnew(GDScript);
+	changed->set_source_code(source.replace("[2, 3]", "[3, 2]"));
+	changed->set_path(path, true);
+	CHECK_MESSAGE(!GDScriptBytecodeCache::load_script(changed.ptr(), has_static_data), "Changed scripts should be compiled again.");
+	GDScriptCache::remove_script(path);
+
+	ProjectSettings::get_singleton()->set_setting("gdscript/bytecode_cache/enabled", false);
+	GDScriptBytecodeCache::clear();
+	GDScriptBytecodeCache::set_cache_path(String());
+	DirAccess::remove_absolute(entry_path);
+	DirAccess::remove_absolute(cache_path);
+}
 #endif // TOOLS_ENABLED
 
+#ifdef DEBUG_ENABLED
+TEST_CASE("[Modules][GDScript] Sample call stacks with the sampling profiler") {
+	const String path = "res://sampling_profiler_test.gd";
+	const String source = R"(extends RefCounted
+
+static func outer() -> int:
+	return inner()
+
+static func inner() -> int:
+	var total := 0
+	for i in range(1000):
+		total += i
+	return total
+)";
+
+	Ref<GDScript> script = memnew(GDScript);
+	script->set_source_code(source);
+	script->set_path(path, true);
+	ERR_PRINT_OFF;
+	REQUIRE(script->reload() == OK);
+	ERR_PRINT_ON;
+
+	const String output_path = TestUtils::get_temp_path("gdscript_sampling_profile.txt");
+	GDScriptLanguage::get_singleton()->set_call_stack_tracked(true);
+	GDScriptSamplingProfiler profiler;
+	REQUIRE(profiler.start(output_path, 2000) == OK);
+	const uint64_t end = OS::get_singleton()->get_ticks_msec() + 300;
+	while (OS::get_singleton()->get_ticks_msec() < end) {
+		script->call("outer");
+	}
+	profiler.stop();
+	GDScriptLanguage::get_singleton()->set_call_stack_tracked(false);
+
+	const String stacks = profiler.get_collapsed_stacks();
+	CHECK_MESSAGE(stacks.contains("Main Thread;outer (" + path + ":4);inner (" + path + ":"), "The call from `outer()` to `inner()` should be sampled, with the line of the call.");
+	CHECK_MESSAGE(FileAccess::get_file_as_string(output_path) == stacks, "The collapsed stacks should be written to the output file.");
+
+	GDScriptCache::remove_script(path);
+	DirAccess::remove_absolute(output_path);
+}
+#endif // DEBUG_ENABLED
+
+static void _native_test_function(const Variant **p_args, Variant &r_ret) {}
+
+TEST_CASE("[Modules][GDScript] Generate native code for statically typed functions") {
+	GDScriptParser parser;
+	GDScriptAnalyzer analyzer(&parser);
+	const Error parse_error = parser.parse(R"(
+extends RefCounted
+
+func typed_sum(count: int, scale: float) -> float:
+	var total := 0.0
+	for i in range(count):
+		total += sqrt(float(i)) * scale
+	return total
+
+func untyped_add(value):
+	return value + 1
+
+func member_call(value: int) -> int:
+	return value + get_reference_count()
+)",
+			"res://native_test.gd", false);
+	REQUIRE(parse_error == OK);
+	REQUIRE(analyzer.analyze() == OK);
+
+	const GDScriptParser::ClassNode *tree = parser.get_tree();
+	const GDScriptParser::FunctionNode *typed_sum = tree->get_member("typed_sum").function;
+	const String body = GDScriptNativeCodeGenerator::generate_function(typed_sum);
+	CHECK_MESSAGE(!body.is_empty(), "Statically typed numeric functions should be translated.");
+	CHECK(body.contains("VariantUtilityFunctions::sqrt"));
+	CHECK_MESSAGE(GDScriptNativeCodeGenerator::generate_function(tree->get_member("untyped_add").function).is_empty(), "Untyped functions should stay in the VM.");
+	CHECK_MESSAGE(GDScriptNativeCodeGenerator::generate_function(tree->get_member("member_call").function).is_empty(), "Functions calling methods should stay in the VM.");
+
+	GDScriptNativeFunctions::register_function(tree->fqcn, "typed_sum", body.hash64(), _native_test_function);
+	CHECK(GDScriptNativeFunctions::get_function(tree, typed_sum) == _native_test_function);
+	GDScriptNativeFunctions::register_function(tree->fqcn, "typed_sum", body.hash64() + 1, _native_test_function);
+	CHECK_MESSAGE(GDScriptNativeFunctions::get_function(tree, typed_sum) == nullptr, "Outdated native code should not be used.");
+	GDScriptNativeFunctions::clear();
+}
+
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
 	GDScriptLanguage *lang = GDScriptLanguage::get_singleton();
 
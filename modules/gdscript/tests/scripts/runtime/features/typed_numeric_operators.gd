@@ -0,0 +1,38 @@
+# Statically typed operands use specialized operator opcodes.
+
+func test():
+	var a: int = 7
+	var b: int = -3
+	print(a + b)
+	print(a - b)
+	print(a * b)
+	print(a == b, a != b)
+	print(a < b, a <= b, a > b, a >= b)
+
+	var f: float = 1.5
+	var g: float = 0.25
+	print(f + g)
+	print(f - g)
+	print(f * g)
+	print(f / g)
+	print(f < g, f <= g, f > g, f >= g)
+
+	var v2 := Vector2(1, 2)
+	print(v2 + Vector2(3, 4))
+	print(v2 - Vector2(3, 4))
+	print(v2 * f)
+
+	var v3 := Vector3(1, 2, 3)
+	print(v3 + Vector3(1, 1, 1))
+	print(v3 - Vector3(1, 1, 1))
+	print(v3 * g)
+
+	var sum: int = 0
+	for i: int in 10:
+		sum = sum + i * i
+	print(sum)
+
+	var acc: float = 0.0
+	while acc < 2.0:
+		acc = acc + g
+	print(acc)
@@ -0,0 +1,55 @@
+# Calls and property accesses on untyped receivers are resolved through per-site inline caches.
+
+class A:
+	var value = 1
+	var typed: float = 0.0
+	var with_setter = 0:
+		set(v):
+			with_setter = v * 2
+
+	func describe():
+		return "A %s" % value
+
+class B extends A:
+	func describe():
+		return "B %s" % value
+
+class Dynamic:
+	func _get(property):
+		if property == &"value":
+			return 42
+		return null
+
+	func describe():
+		return "Dynamic"
+
+func read_value(obj):
+	return obj.value
+
+func describe(obj):
+	return obj.describe()
+
+func test():
+	var receivers = [A.new(), B.new(), Dynamic.new(), A.new()]
+	for _i in 2:
+		for obj in receivers:
+			print(describe(obj), " ", read_value(obj))
+
+	var a = A.new()
+	for i in 2:
+		a.typed = 3 # Converted to float every time.
+		a.with_setter = i + 1
+		a.value = a.value + 1
+		print(a.typed, " ", a.with_setter, " ", a.value)
+
+	var node = Node.new()
+	for i in 2:
+		node.name = "Node%d" % i
+		print(node.name, " ", node.get_child_count())
+	node.free()
+
+	# More receiver types than a single site remembers.
+	var many = [A.new(), B.new(), Dynamic.new(), RefCounted.new(), Resource.new(), Image.new(), Curve.new()]
+	for _i in 2:
+		for obj in many:
+			print(obj.get_class())
@@ -1172,6 +1172,7 @@ bool GodotNavigationServer3D::is_baking_navigation_mesh(Ref<NavigationMesh> p_na
 COMMAND_1(free, RID, p_object) {
 	if (map_owner.owns(p_object)) {
 		NavMap *map = map_owner.get_or_null(p_object);
+		_wait_for_path_query_pins(map);
 
 		// Removes any assigned region
 		for (NavRegion *region : map->get_regions()) {
@@ -1207,6 +1208,9 @@ COMMAND_1(free, RID, p_object) {
 	} else if (region_owner.owns(p_object)) {
 		NavRegion *region = region_owner.get_or_null(p_object);
 
+		// The map polygons point to the region until the next sync.
+		_wait_for_path_query_pins(region->get_map());
+
 		// Removes this region from the map if assigned
 		if (region->get_map() != nullptr) {
 			region->get_map()->remove_region(region);
@@ -1218,6 +1222,9 @@ COMMAND_1(free, RID, p_object) {
 	} else if (link_owner.owns(p_object)) {
 		NavLink *link = link_owner.get_or_null(p_object);
 
+		// The map polygons point to the link until the next sync.
+		_wait_for_path_query_pins(link->get_map());
+
 		// Removes this link from the map if assigned
 		if (link->get_map() != nullptr) {
 			link->get_map()->remove_link(link);
@@ -1374,6 +1381,7 @@ void GodotNavigationServer3D::init() {
 }
 
 void GodotNavigationServer3D::finish() {
+	_finish_path_query_batches();
 	flush_queries();
 #ifndef _3D_DISABLED
 	if (navmesh_generator_3d) {
@@ -1385,33 +1393,99 @@ void GodotNavigationServer3D::finish() {
 }
 
 PathQueryResult GodotNavigationServer3D::_query_path(const PathQueryParameters &p_parameters) const {
-	PathQueryResult r_query_result;
-
 	const NavMap *map = map_owner.get_or_null(p_parameters.map);
-	ERR_FAIL_NULL_V(map, r_query_result);
+	ERR_FAIL_NULL_V(map, PathQueryResult());
+
+	return _query_map_path(map, p_parameters, false);
+}
+
+void GodotNavigationServer3D::_pin_path_query_maps(const LocalVector<PathQueryParameters> &p_parameters, LocalVector<void *> &r_maps) const {
+	r_maps.resize(p_parameters.size());
+	for (uint32_t i = 0; i < p_parameters.size(); i++) {
+		NavMap *map = map_owner.get_or_null(p_parameters[i].map);
+		if (map) {
+			map->pin_path_query();
+		}
+		r_maps[i] = map;
+	}
+}
+
+void GodotNavigationServer3D::_unpin_path_query_maps(const LocalVector<void *> &p_maps) const {
+	bool unpinned = false;
+	for (void *map_ptr : p_maps) {
+		NavMap *map = static_cast<NavMap *>(map_ptr);
+		if (map && map->unpin_path_query() == 0) {
+			unpinned = true;
+		}
+	}
+
+	if (unpinned) {
+		// Notify under the lock so a waiter can't miss it between its check and its wait.
+		MutexLock lock(path_query_pins_mutex);
+		path_query_pins_condition.notify_all();
+	}
+}
+
+void GodotNavigationServer3D::_query_pinned_paths(void *const *p_maps, const PathQueryParameters *p_parameters, PathQueryResult *r_results, uint32_t p_count) const {
+	ERR_FAIL_NULL(p_maps);
+
+	uint32_t query_index = 0;
+	while (query_index < p_count) {
+		const NavMap *map = static_cast<const NavMap *>(p_maps[query_index]);
+
+		// Consecutive queries on the same map share the read lock.
+		uint32_t end = query_index + 1;
+		while (end < p_count && p_maps[end] == map) {
+			end++;
+		}
+
+		if (map) {
+			map->read_lock();
+			for (; query_index < end; query_index++) {
+				r_results[query_index] = _query_map_path(map, p_parameters[query_index], true);
+			}
+			map->read_unlock();
+		} else {
+			ERR_PRINT(vformat("Path query map %d is not a valid navigation map.", p_parameters[query_index].map.get_id()));
+			query_index = end;
+		}
+	}
+}
+
+void GodotNavigationServer3D::_wait_for_path_query_pins(const NavMap *p_map) {
+	if (p_map == nullptr || p_map->get_path_query_pins() == 0) {
+		return;
+	}
+
+	// Asynchronous batches are waited for collaboratively first, the remaining pins belong to batches running on other threads.
+	_wait_for_path_query_batches();
+
+	MutexLock lock(path_query_pins_mutex);
+	while (p_map->get_path_query_pins() > 0) {
+		path_query_pins_condition.wait(lock);
+	}
+}
+
+PathQueryResult GodotNavigationServer3D::_query_map_path(const NavMap *p_map, const PathQueryParameters &p_parameters, bool p_map_read_locked) const {
+	PathQueryResult r_query_result;
 
 	// run the pathfinding
 
-	if (p_parameters.pathfinding_algorithm == PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR) {
+	if (p_parameters.pathfinding_algorithm == PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR || p_parameters.pathfinding_algorithm == PathfindingAlgorithm::PATHFINDING_ALGORITHM_HIERARCHICAL_ASTAR) {
+		const bool hierarchical = p_parameters.pathfinding_algorithm == PathfindingAlgorithm::PATHFINDING_ALGORITHM_HIERARCHICAL_ASTAR;
+
 		// while postprocessing is still part of map.get_path() need to check and route it here for the correct "optimize" post-processing
-		if (p_parameters.path_postprocessing == PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL) {
-			r_query_result.path = map->get_path(
-					p_parameters.start_position,
-					p_parameters.target_position,
-					true,
-					p_parameters.navigation_layers,
-					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_TYPES) ? &r_query_result.path_types : nullptr,
-					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_RIDS) ? &r_query_result.path_rids : nullptr,
-					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_OWNERS) ? &r_query_result.path_owner_ids : nullptr);
-		} else if (p_parameters.path_postprocessing == PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED) {
-			r_query_result.path = map->get_path(
-					p_parameters.start_position,
-					p_parameters.target_position,
-					false,
-					p_parameters.navigation_layers,
-					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_TYPES) ? &r_query_result.path_types : nullptr,
-					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_RIDS) ? &r_query_result.path_rids : nullptr,
-					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_OWNERS) ? &r_query_result.path_owner_ids : nullptr);
+		if (p_parameters.path_postprocessing == PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL || p_parameters.path_postprocessing == PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED) {
+			const bool optimize = p_parameters.path_postprocessing == PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
+			Vector<int32_t> *path_types = p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_TYPES) ? &r_query_result.path_types : nullptr;
+			TypedArray<RID> *path_rids = p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_RIDS) ? &r_query_result.path_rids : nullptr;
+			Vector<int64_t> *path_owner_ids = p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_OWNERS) ? &r_query_result.path_owner_ids : nullptr;
+
+			if (p_map_read_locked) {
+				r_query_result.path = p_map->get_path_read_locked(p_parameters.start_position, p_parameters.target_position, optimize, p_parameters.navigation_layers, path_types, path_rids, path_owner_ids, hierarchical);
+			} else {
+				r_query_result.path = p_map->get_path(p_parameters.start_position, p_parameters.target_position, optimize, p_parameters.navigation_layers, path_types, path_rids, path_owner_ids, hierarchical);
+			}
 		}
 	} else {
 		return r_query_result;
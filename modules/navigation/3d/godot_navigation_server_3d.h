@@ -37,6 +37,8 @@
 #include "../nav_obstacle.h"
 #include "../nav_region.h"
 
+#include "core/os/condition_variable.h"
+#include "core/os/mutex.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/rid.h"
 #include "core/templates/rid_owner.h"
@@ -78,6 +80,10 @@ class GodotNavigationServer3D : public NavigationServer3D {
 	mutable RID_Owner<NavAgent> agent_owner;
 	mutable RID_Owner<NavObstacle> obstacle_owner;
 
+	/// Signaled when the last path query pin of a map is released, see _wait_for_path_query_pins().
+	mutable BinaryMutex path_query_pins_mutex;
+	mutable ConditionVariable path_query_pins_condition;
+
 	bool active = true;
 	LocalVector<NavMap *> active_maps;
 	LocalVector<uint32_t> active_maps_iteration_id;
@@ -292,9 +298,18 @@ public:
 
 	int get_process_info(ProcessInfo p_info) const override;
 
+protected:
+	virtual void _pin_path_query_maps(const LocalVector<NavigationUtilities::PathQueryParameters> &p_parameters, LocalVector<void *> &r_maps) const override;
+	virtual void _unpin_path_query_maps(const LocalVector<void *> &p_maps) const override;
+	virtual void _query_pinned_paths(void *const *p_maps, const NavigationUtilities::PathQueryParameters *p_parameters, NavigationUtilities::PathQueryResult *r_results, uint32_t p_count) const override;
+
 private:
 	void internal_free_agent(RID p_object);
 	void internal_free_obstacle(RID p_object);
+
+	NavigationUtilities::PathQueryResult _query_map_path(const NavMap *p_map, const NavigationUtilities::PathQueryParameters &p_parameters, bool p_map_read_locked) const;
+	/// Blocks until no path query batch uses the map, before the map or one of its regions or links is freed.
+	void _wait_for_path_query_pins(const NavMap *p_map);
 };
 
 #undef COMMAND_1
@@ -127,7 +127,80 @@ Vector3 NavMeshQueries3D::polygons_get_random_point(const LocalVector<gd::Polygo
 	}
 }
 
-Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygon> &p_polygons, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, const Vector3 &p_map_up, uint32_t p_link_polygons_size) {
+bool NavMeshQueries3D::clusters_get_route(const gd::ClusterGraph &p_cluster_graph, uint32_t p_begin_cluster, uint32_t p_end_cluster, const Vector3 &p_destination, uint32_t p_navigation_layers, LocalVector<uint8_t> &r_route_clusters) {
+	const LocalVector<gd::Cluster> &clusters = p_cluster_graph.clusters;
+	ERR_FAIL_UNSIGNED_INDEX_V(p_begin_cluster, clusters.size(), false);
+	ERR_FAIL_UNSIGNED_INDEX_V(p_end_cluster, clusters.size(), false);
+
+	LocalVector<gd::NavigationCluster> navigation_clusters;
+	navigation_clusters.resize(clusters.size());
+
+	gd::Heap<gd::NavigationCluster *, gd::NavClusterTravelCostGreaterThan, gd::NavClusterHeapIndexer> traversable_clusters;
+
+	navigation_clusters[p_begin_cluster].visited = true;
+	traversable_clusters.push(&navigation_clusters[p_begin_cluster]);
+
+	// A* over the clusters, the costs are estimated between the cluster positions.
+	bool found_route = false;
+	while (!traversable_clusters.is_empty()) {
+		const gd::NavigationCluster *least_cost_navigation_cluster = traversable_clusters.pop();
+		const uint32_t least_cost_id = least_cost_navigation_cluster - navigation_clusters.ptr();
+		if (least_cost_id == p_end_cluster) {
+			found_route = true;
+			break;
+		}
+
+		const gd::Cluster &least_cost_cluster = clusters[least_cost_id];
+		for (uint32_t neighbor_id : least_cost_cluster.neighbors) {
+			const gd::Cluster &neighbor_cluster = clusters[neighbor_id];
+
+			// Only consider the clusters of regions or links with compatible layers.
+			if ((p_navigation_layers & neighbor_cluster.owner->get_navigation_layers()) == 0) {
+				continue;
+			}
+
+			real_t neighbor_enter_cost = 0.0;
+			if (neighbor_cluster.owner != least_cost_cluster.owner) {
+				neighbor_enter_cost = neighbor_cluster.owner->get_enter_cost();
+			}
+			const real_t new_traveled_distance = least_cost_navigation_cluster->traveled_distance + neighbor_enter_cost +
+					least_cost_cluster.position.distance_to(neighbor_cluster.position) * neighbor_cluster.owner->get_travel_cost();
+
+			gd::NavigationCluster &neighbor_navigation_cluster = navigation_clusters[neighbor_id];
+			if (neighbor_navigation_cluster.visited) {
+				// Only shorten routes to clusters that are still waiting in the heap.
+				if (neighbor_navigation_cluster.traversable_cluster_index < traversable_clusters.size() &&
+						new_traveled_distance < neighbor_navigation_cluster.traveled_distance) {
+					neighbor_navigation_cluster.back_navigation_cluster_id = least_cost_id;
+					neighbor_navigation_cluster.traveled_distance = new_traveled_distance;
+					traversable_clusters.shift(neighbor_navigation_cluster.traversable_cluster_index);
+				}
+			} else {
+				neighbor_navigation_cluster.visited = true;
+				neighbor_navigation_cluster.back_navigation_cluster_id = least_cost_id;
+				neighbor_navigation_cluster.traveled_distance = new_traveled_distance;
+				neighbor_navigation_cluster.distance_to_destination =
+						neighbor_cluster.position.distance_to(p_destination) *
+						neighbor_cluster.owner->get_travel_cost();
+				traversable_clusters.push(&neighbor_navigation_cluster);
+			}
+		}
+	}
+
+	if (!found_route) {
+		return false;
+	}
+
+	r_route_clusters.resize(clusters.size());
+	memset(r_route_clusters.ptr(), 0, clusters.size() * sizeof(uint8_t));
+	for (int cluster_id = p_end_cluster; cluster_id != -1; cluster_id = navigation_clusters[cluster_id].back_navigation_cluster_id) {
+		r_route_clusters[cluster_id] = 1;
+	}
+
+	return true;
+}
+
+Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygon> &p_polygons, const gd::PolygonsBVH &p_polygons_bvh, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, const Vector3 &p_map_up, uint32_t p_link_polygons_size, const gd::ClusterGraph *p_cluster_graph) {
 	// Clear metadata outputs.
 	if (r_path_types) {
 		r_path_types->clear();
@@ -147,30 +220,38 @@ Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygo
 	real_t begin_d = FLT_MAX;
 	real_t end_d = FLT_MAX;
 	// Find the initial poly and the end poly on this map.
-	for (const gd::Polygon &p : p_polygons) {
-		// Only consider the polygon if it in a region with compatible layers.
-		if ((p_navigation_layers & p.owner->get_navigation_layers()) == 0) {
-			continue;
-		}
+	if (!p_polygons_bvh.is_empty()) {
+		Vector3 normal;
+		const uint32_t begin_poly_index = polygons_get_closest_polygon(p_polygons, p_polygons_bvh, p_origin, FLT_MAX, p_navigation_layers, true, begin_point, normal);
+		const uint32_t end_poly_index = polygons_get_closest_polygon(p_polygons, p_polygons_bvh, p_destination, FLT_MAX, p_navigation_layers, true, end_point, normal);
+		begin_poly = begin_poly_index != UINT32_MAX ? &p_polygons[begin_poly_index] : nullptr;
+		end_poly = end_poly_index != UINT32_MAX ? &p_polygons[end_poly_index] : nullptr;
+	} else {
+		for (const gd::Polygon &p : p_polygons) {
+			// Only consider the polygon if it in a region with compatible layers.
+			if ((p_navigation_layers & p.owner->get_navigation_layers()) == 0) {
+				continue;
+			}
 
-		// For each face check the distance between the origin/destination
-		for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
-			const Face3 face(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+			// For each face check the distance between the origin/destination
+			for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
+				const Face3 face(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
 
-			Vector3 point = face.get_closest_point_to(p_origin);
-			real_t distance_to_point = point.distance_to(p_origin);
-			if (distance_to_point < begin_d) {
-				begin_d = distance_to_point;
-				begin_poly = &p;
-				begin_point = point;
-			}
+				Vector3 point = face.get_closest_point_to(p_origin);
+				real_t distance_to_point = point.distance_to(p_origin);
+				if (distance_to_point < begin_d) {
+					begin_d = distance_to_point;
+					begin_poly = &p;
+					begin_point = point;
+				}
 
-			point = face.get_closest_point_to(p_destination);
-			distance_to_point = point.distance_to(p_destination);
-			if (distance_to_point < end_d) {
-				end_d = distance_to_point;
-				end_poly = &p;
-				end_point = point;
+				point = face.get_closest_point_to(p_destination);
+				distance_to_point = point.distance_to(p_destination);
+				if (distance_to_point < end_d) {
+					end_d = distance_to_point;
+					end_poly = &p;
+					end_point = point;
+				}
 			}
 		}
 	}
@@ -205,6 +286,14 @@ Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygo
 		return path;
 	}
 
+	// With a cluster graph plan a coarse route first, then only search the polygons of the clusters along it.
+	LocalVector<uint8_t> route_clusters;
+	const uint32_t *polygon_clusters = nullptr;
+	if (p_cluster_graph && !p_cluster_graph->is_empty() &&
+			clusters_get_route(*p_cluster_graph, p_cluster_graph->polygon_clusters[begin_poly->id], p_cluster_graph->polygon_clusters[end_poly->id], end_point, p_navigation_layers, route_clusters)) {
+		polygon_clusters = p_cluster_graph->polygon_clusters.ptr();
+	}
+
 	// List of all reachable navigation polys.
 	LocalVector<gd::NavigationPoly> navigation_polys;
 	navigation_polys.resize(p_polygons.size() + p_link_polygons_size);
@@ -242,6 +331,11 @@ Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygo
 					continue;
 				}
 
+				// Stay inside the coarse route when refining a hierarchical path.
+				if (polygon_clusters && route_clusters[polygon_clusters[connection.polygon->id]] == 0) {
+					continue;
+				}
+
 				const gd::NavigationPoly &least_cost_poly = navigation_polys[least_cost_id];
 				real_t poly_enter_cost = 0.0;
 				real_t poly_travel_cost = least_cost_poly.poly->owner->get_travel_cost();
@@ -297,6 +391,25 @@ Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygo
 		// When the heap of traversable polygons is empty at this point it means the end polygon is
 		// unreachable.
 		if (traversable_polys.is_empty()) {
+			if (polygon_clusters) {
+				// The coarse route could not be refined, e.g. because a cluster is split in disconnected parts.
+				// Search all the polygons instead.
+				polygon_clusters = nullptr;
+
+				for (gd::NavigationPoly &nav_poly : navigation_polys) {
+					nav_poly.poly = nullptr;
+				}
+				navigation_polys[begin_poly->id].poly = begin_poly;
+
+				least_cost_id = begin_poly->id;
+				prev_least_cost_id = -1;
+
+				reachable_end = nullptr;
+				distance_to_reachable_end = FLT_MAX;
+
+				continue;
+			}
+
 			// Thus use the further reachable polygon
 			ERR_BREAK_MSG(is_reachable == false, "It's not expect to not find the most reachable polygons");
 			is_reachable = false;
@@ -678,6 +791,188 @@ RID NavMeshQueries3D::polygons_get_closest_point_owner(const LocalVector<gd::Pol
 	return cp.owner;
 }
 
+Vector3 NavMeshQueries3D::polygons_get_closest_point_to_segment(const LocalVector<gd::Polygon> &p_polygons, const gd::PolygonsBVH &p_polygons_bvh, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) {
+	if (p_polygons_bvh.is_empty()) {
+		return polygons_get_closest_point_to_segment(p_polygons, p_from, p_to, p_use_collision);
+	}
+
+	AABB segment_aabb(p_from, Vector3());
+	segment_aabb.expand_to(p_to);
+
+	LocalVector<uint32_t> candidates;
+	p_polygons_bvh.query(segment_aabb, candidates);
+
+	// The closest point is the intersection closest to the segment start if there is any.
+	// Only polygons overlapping the segment bounds can intersect it.
+	const gd::Polygon *closest_polygon = nullptr;
+	Vector3 closest_point;
+	real_t closest_point_distance = FLT_MAX;
+
+	for (uint32_t polygon_index : candidates) {
+		const gd::Polygon *polygon = &p_polygons[polygon_index];
+		for (size_t point_id = 2; point_id < polygon->points.size(); point_id += 1) {
+			const Face3 face(polygon->points[0].pos, polygon->points[point_id - 1].pos, polygon->points[point_id].pos);
+			Vector3 intersection_point;
+			if (face.intersects_segment(p_from, p_to, &intersection_point)) {
+				const real_t d = p_from.distance_to(intersection_point);
+				// Break ties on the polygon id to return the same point as the linear search.
+				if (d < closest_point_distance || (closest_polygon && d == closest_point_distance && polygon->id < closest_polygon->id)) {
+					closest_polygon = polygon;
+					closest_point = intersection_point;
+					closest_point_distance = d;
+				}
+			}
+		}
+	}
+
+	if (closest_polygon || p_use_collision) {
+		return closest_point;
+	}
+
+	// Grow the search bounds until they contain a polygon closer than the growth distance, or all the polygons.
+	const real_t bounds_distance = MIN(p_from.distance_to(p_from.clamp(p_polygons_bvh.bounds.position, p_polygons_bvh.bounds.get_end())), p_to.distance_to(p_to.clamp(p_polygons_bvh.bounds.position, p_polygons_bvh.bounds.get_end())));
+	real_t radius = bounds_distance + p_polygons_bvh.average_polygon_size;
+
+	while (true) {
+		const AABB query_aabb = segment_aabb.grow(radius);
+		candidates.clear();
+		p_polygons_bvh.query(query_aabb, candidates);
+
+		for (uint32_t polygon_index : candidates) {
+			const gd::Polygon *polygon = &p_polygons[polygon_index];
+			Vector3 polygon_closest_point;
+			real_t polygon_closest_point_distance = FLT_MAX;
+
+			// For each face check the distance from segment's endpoints.
+			for (size_t point_id = 2; point_id < polygon->points.size(); point_id += 1) {
+				const Face3 face(polygon->points[0].pos, polygon->points[point_id - 1].pos, polygon->points[point_id].pos);
+
+				const Vector3 p_from_closest = face.get_closest_point_to(p_from);
+				const real_t d_p_from = p_from.distance_to(p_from_closest);
+				if (polygon_closest_point_distance > d_p_from) {
+					polygon_closest_point = p_from_closest;
+					polygon_closest_point_distance = d_p_from;
+				}
+
+				const Vector3 p_to_closest = face.get_closest_point_to(p_to);
+				const real_t d_p_to = p_to.distance_to(p_to_closest);
+				if (polygon_closest_point_distance > d_p_to) {
+					polygon_closest_point = p_to_closest;
+					polygon_closest_point_distance = d_p_to;
+				}
+			}
+
+			// Check for a case when shortest distance is between some point located on a face's edge and some point located on a line segment.
+			for (size_t point_id = 0; point_id < polygon->points.size(); point_id += 1) {
+				Vector3 a, b;
+
+				Geometry3D::get_closest_points_between_segments(
+						p_from,
+						p_to,
+						polygon->points[point_id].pos,
+						polygon->points[(point_id + 1) % polygon->points.size()].pos,
+						a,
+						b);
+
+				const real_t d = a.distance_to(b);
+				if (d < polygon_closest_point_distance) {
+					polygon_closest_point_distance = d;
+					polygon_closest_point = b;
+				}
+			}
+
+			if (polygon_closest_point_distance < closest_point_distance || (closest_polygon && polygon_closest_point_distance == closest_point_distance && polygon->id < closest_polygon->id)) {
+				closest_polygon = polygon;
+				closest_point = polygon_closest_point;
+				closest_point_distance = polygon_closest_point_distance;
+			}
+		}
+
+		if (closest_polygon) {
+			if (closest_point_distance <= radius) {
+				break;
+			}
+			// No polygon outside of the closest distance can be closer.
+			radius = closest_point_distance;
+		} else if (query_aabb.encloses(p_polygons_bvh.bounds)) {
+			break;
+		} else {
+			radius = MAX(radius * 2.0, (real_t)CMP_EPSILON);
+		}
+	}
+
+	return closest_point;
+}
+
+gd::ClosestPointQueryResult NavMeshQueries3D::polygons_get_closest_point_info(const LocalVector<gd::Polygon> &p_polygons, const gd::PolygonsBVH &p_polygons_bvh, const Vector3 &p_point) {
+	if (p_polygons_bvh.is_empty()) {
+		return polygons_get_closest_point_info(p_polygons, p_point);
+	}
+
+	gd::ClosestPointQueryResult result;
+	const uint32_t closest_polygon = polygons_get_closest_polygon(p_polygons, p_polygons_bvh, p_point, FLT_MAX, 0, false, result.point, result.normal);
+	if (closest_polygon != UINT32_MAX) {
+		result.owner = p_polygons[closest_polygon].owner->get_self();
+	}
+	return result;
+}
+
+uint32_t NavMeshQueries3D::polygons_get_closest_polygon(const LocalVector<gd::Polygon> &p_polygons, const gd::PolygonsBVH &p_polygons_bvh, const Vector3 &p_point, real_t p_max_distance, uint32_t p_navigation_layers, bool p_use_navigation_layers, Vector3 &r_closest_point, Vector3 &r_closest_normal) {
+	if (p_polygons_bvh.is_empty()) {
+		return UINT32_MAX;
+	}
+
+	uint32_t closest_polygon = UINT32_MAX;
+	real_t closest_distance = p_max_distance;
+
+	// Grow the search bounds until they contain a polygon closer than the growth distance, or all the polygons.
+	const real_t bounds_distance = p_point.distance_to(p_point.clamp(p_polygons_bvh.bounds.position, p_polygons_bvh.bounds.get_end()));
+	real_t radius = MIN(bounds_distance + p_polygons_bvh.average_polygon_size, p_max_distance);
+
+	LocalVector<uint32_t> candidates;
+	while (true) {
+		const AABB query_aabb(p_point - Vector3(radius, radius, radius), Vector3(radius, radius, radius) * 2.0);
+		candidates.clear();
+		p_polygons_bvh.query(query_aabb, candidates);
+
+		for (uint32_t polygon_index : candidates) {
+			const gd::Polygon *polygon = &p_polygons[polygon_index];
+			// Only consider the polygon if it in a region with compatible layers.
+			if (p_use_navigation_layers && (p_navigation_layers & polygon->owner->get_navigation_layers()) == 0) {
+				continue;
+			}
+
+			for (size_t point_id = 2; point_id < polygon->points.size(); point_id++) {
+				const Face3 face(polygon->points[0].pos, polygon->points[point_id - 1].pos, polygon->points[point_id].pos);
+				const Vector3 point = face.get_closest_point_to(p_point);
+				const real_t distance_to_point = point.distance_to(p_point);
+
+				// Break ties on the polygon id to return the same polygon as the linear search.
+				if (distance_to_point < closest_distance || (closest_polygon != UINT32_MAX && distance_to_point == closest_distance && polygon->id < p_polygons[closest_polygon].id)) {
+					closest_polygon = polygon_index;
+					closest_distance = distance_to_point;
+					r_closest_point = point;
+					r_closest_normal = face.get_plane().normal;
+				}
+			}
+		}
+
+		if (closest_polygon != UINT32_MAX) {
+			if (closest_distance <= radius) {
+				break;
+			}
+			// No polygon outside of the closest distance can be closer.
+			radius = closest_distance;
+		} else if (radius >= p_max_distance || query_aabb.encloses(p_polygons_bvh.bounds)) {
+			break;
+		} else {
+			radius = MIN(MAX(radius * 2.0, (real_t)CMP_EPSILON), p_max_distance);
+		}
+	}
+
+	return closest_polygon;
+}
+
 void NavMeshQueries3D::clip_path(const LocalVector<gd::NavigationPoly> &p_navigation_polys, Vector<Vector3> &path, const gd::NavigationPoly *from_poly, const Vector3 &p_to_point, const gd::NavigationPoly *p_to_poly, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, const Vector3 &p_map_up) {
 	Vector3 from = path[path.size() - 1];
 
@@ -39,13 +39,18 @@ class NavMeshQueries3D {
 public:
 	static Vector3 polygons_get_random_point(const LocalVector<gd::Polygon> &p_polygons, uint32_t p_navigation_layers, bool p_uniformly);
 
-	static Vector<Vector3> polygons_get_path(const LocalVector<gd::Polygon> &p_polygons, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, const Vector3 &p_map_up, uint32_t p_link_polygons_size);
+	static Vector<Vector3> polygons_get_path(const LocalVector<gd::Polygon> &p_polygons, const gd::PolygonsBVH &p_polygons_bvh, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, const Vector3 &p_map_up, uint32_t p_link_polygons_size, const gd::ClusterGraph *p_cluster_graph = nullptr);
+	static bool clusters_get_route(const gd::ClusterGraph &p_cluster_graph, uint32_t p_begin_cluster, uint32_t p_end_cluster, const Vector3 &p_destination, uint32_t p_navigation_layers, LocalVector<uint8_t> &r_route_clusters);
 	static Vector3 polygons_get_closest_point_to_segment(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision);
 	static Vector3 polygons_get_closest_point(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point);
 	static Vector3 polygons_get_closest_point_normal(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point);
 	static gd::ClosestPointQueryResult polygons_get_closest_point_info(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point);
 	static RID polygons_get_closest_point_owner(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point);
 
+	static Vector3 polygons_get_closest_point_to_segment(const LocalVector<gd::Polygon> &p_polygons, const gd::PolygonsBVH &p_polygons_bvh, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision);
+	static gd::ClosestPointQueryResult polygons_get_closest_point_info(const LocalVector<gd::Polygon> &p_polygons, const gd::PolygonsBVH &p_polygons_bvh, const Vector3 &p_point);
+	static uint32_t polygons_get_closest_polygon(const LocalVector<gd::Polygon> &p_polygons, const gd::PolygonsBVH &p_polygons_bvh, const Vector3 &p_point, real_t p_max_distance, uint32_t p_navigation_layers, bool p_use_navigation_layers, Vector3 &r_closest_point, Vector3 &r_closest_normal);
+
 	static void clip_path(const LocalVector<gd::NavigationPoly> &p_navigation_polys, Vector<Vector3> &path, const gd::NavigationPoly *from_poly, const Vector3 &p_to_point, const gd::NavigationPoly *p_to_poly, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, const Vector3 &p_map_up);
 };
 
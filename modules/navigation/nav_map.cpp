@@ -51,6 +51,48 @@
 #define NAVMAP_ITERATION_ZERO_ERROR_MSG()
 #endif // DEBUG_ENABLED
 
+static void _print_edge_merge_error() {
+	ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.");
+}
+
+// Checks if two free edges are close enough to be connected, and computes the pathway between them.
+static bool _get_edge_connection_pathway(const Vector3 &p_edge_p1, const Vector3 &p_edge_p2, const Vector3 &p_other_edge_p1, const Vector3 &p_other_edge_p2, real_t p_edge_connection_margin, Vector3 &r_pathway_start, Vector3 &r_pathway_end) {
+	// Compute the projection of the opposite edge on the current one
+	Vector3 edge_vector = p_edge_p2 - p_edge_p1;
+	real_t projected_p1_ratio = edge_vector.dot(p_other_edge_p1 - p_edge_p1) / (edge_vector.length_squared());
+	real_t projected_p2_ratio = edge_vector.dot(p_other_edge_p2 - p_edge_p1) / (edge_vector.length_squared());
+	if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
+		return false;
+	}
+
+	// Check if the two edges are close to each other enough and compute a pathway between the two regions.
+	Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + p_edge_p1;
+	Vector3 other1;
+	if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
+		other1 = p_other_edge_p1;
+	} else {
+		other1 = p_other_edge_p1.lerp(p_other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+	}
+	if (other1.distance_to(self1) > p_edge_connection_margin) {
+		return false;
+	}
+
+	Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + p_edge_p1;
+	Vector3 other2;
+	if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
+		other2 = p_other_edge_p2;
+	} else {
+		other2 = p_other_edge_p1.lerp(p_other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+	}
+	if (other2.distance_to(self2) > p_edge_connection_margin) {
+		return false;
+	}
+
+	r_pathway_start = (self1 + other1) / 2.0;
+	r_pathway_end = (self2 + other2) / 2.0;
+	return true;
+}
+
 void NavMap::set_up(Vector3 p_up) {
 	if (up == p_up) {
 		return;
@@ -92,6 +134,7 @@ void NavMap::set_use_edge_connections(bool p_enabled) {
 	}
 	use_edge_connections = p_enabled;
 	regenerate_links = true;
+	regenerate_region_connections = true;
 }
 
 void NavMap::set_edge_connection_margin(real_t p_edge_connection_margin) {
@@ -100,6 +143,7 @@ void NavMap::set_edge_connection_margin(real_t p_edge_connection_margin) {
 	}
 	edge_connection_margin = p_edge_connection_margin;
 	regenerate_links = true;
+	regenerate_region_connections = true;
 }
 
 void NavMap::set_link_connection_radius(real_t p_link_connection_radius) {
@@ -123,16 +167,21 @@ gd::PointKey NavMap::get_point_key(const Vector3 &p_pos) const {
 	return p;
 }
 
-Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const {
+Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, bool p_hierarchical) const {
 	RWLockRead read_lock(map_rwlock);
+	return get_path_read_locked(p_origin, p_destination, p_optimize, p_navigation_layers, r_path_types, r_path_rids, r_path_owners, p_hierarchical);
+}
+
+Vector<Vector3> NavMap::get_path_read_locked(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, bool p_hierarchical) const {
 	if (iteration_id == 0) {
 		NAVMAP_ITERATION_ZERO_ERROR_MSG();
 		return Vector<Vector3>();
 	}
 
 	return NavMeshQueries3D::polygons_get_path(
-			polygons, p_origin, p_destination, p_optimize, p_navigation_layers,
-			r_path_types, r_path_rids, r_path_owners, up, link_polygons.size());
+			polygons, polygons_bvh, p_origin, p_destination, p_optimize, p_navigation_layers,
+			r_path_types, r_path_rids, r_path_owners, up, link_polygons.size(),
+			p_hierarchical ? &cluster_graph : nullptr);
 }
 
 Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
@@ -142,7 +191,7 @@ Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector
 		return Vector3();
 	}
 
-	return NavMeshQueries3D::polygons_get_closest_point_to_segment(polygons, p_from, p_to, p_use_collision);
+	return NavMeshQueries3D::polygons_get_closest_point_to_segment(polygons, polygons_bvh, p_from, p_to, p_use_collision);
 }
 
 Vector3 NavMap::get_closest_point(const Vector3 &p_point) const {
@@ -152,7 +201,7 @@ Vector3 NavMap::get_closest_point(const Vector3 &p_point) const {
 		return Vector3();
 	}
 
-	return NavMeshQueries3D::polygons_get_closest_point(polygons, p_point);
+	return NavMeshQueries3D::polygons_get_closest_point_info(polygons, polygons_bvh, p_point).point;
 }
 
 Vector3 NavMap::get_closest_point_normal(const Vector3 &p_point) const {
@@ -162,7 +211,7 @@ Vector3 NavMap::get_closest_point_normal(const Vector3 &p_point) const {
 		return Vector3();
 	}
 
-	return NavMeshQueries3D::polygons_get_closest_point_normal(polygons, p_point);
+	return NavMeshQueries3D::polygons_get_closest_point_info(polygons, polygons_bvh, p_point).normal;
 }
 
 RID NavMap::get_closest_point_owner(const Vector3 &p_point) const {
@@ -172,13 +221,13 @@ RID NavMap::get_closest_point_owner(const Vector3 &p_point) const {
 		return RID();
 	}
 
-	return NavMeshQueries3D::polygons_get_closest_point_owner(polygons, p_point);
+	return NavMeshQueries3D::polygons_get_closest_point_info(polygons, polygons_bvh, p_point).owner;
 }
 
 gd::ClosestPointQueryResult NavMap::get_closest_point_info(const Vector3 &p_point) const {
 	RWLockRead read_lock(map_rwlock);
 
-	return NavMeshQueries3D::polygons_get_closest_point_info(polygons, p_point);
+	return NavMeshQueries3D::polygons_get_closest_point_info(polygons, polygons_bvh, p_point);
 }
 
 void NavMap::add_region(NavRegion *p_region) {
@@ -375,9 +424,13 @@ void NavMap::sync() {
 		regenerate_links = true;
 	}
 
+	LocalVector<NavRegion *> changed_regions;
 	for (NavRegion *region : regions) {
 		if (region->sync()) {
 			regenerate_links = true;
+			if (use_incremental_sync) {
+				changed_regions.push_back(region);
+			}
 		}
 	}
 
@@ -394,149 +447,131 @@ void NavMap::sync() {
 		_new_pm_edge_connection_count = 0;
 		_new_pm_edge_free_count = 0;
 
-		// Remove regions connections.
-		region_external_connections.clear();
-		for (NavRegion *region : regions) {
-			region_external_connections[region] = LocalVector<gd::Edge::Connection>();
-		}
-
-		// Resize the polygon count.
 		int polygon_count = 0;
-		for (const NavRegion *region : regions) {
-			if (!region->get_enabled()) {
-				continue;
+		if (use_incremental_sync) {
+			_sync_regions_incremental(changed_regions, _new_pm_edge_count, _new_pm_edge_merge_count, _new_pm_edge_connection_count, _new_pm_edge_free_count);
+			polygon_count = polygons.size();
+		} else {
+			// Remove regions connections.
+			region_external_connections.clear();
+			for (NavRegion *region : regions) {
+				region_external_connections[region] = LocalVector<gd::Edge::Connection>();
 			}
-			polygon_count += region->get_polygons().size();
-		}
-		polygons.resize(polygon_count);
 
-		// Copy all region polygons in the map.
-		polygon_count = 0;
-		for (const NavRegion *region : regions) {
-			if (!region->get_enabled()) {
-				continue;
-			}
-			const LocalVector<gd::Polygon> &polygons_source = region->get_polygons();
-			for (uint32_t n = 0; n < polygons_source.size(); n++) {
-				polygons[polygon_count] = polygons_source[n];
-				polygons[polygon_count].id = polygon_count;
-				polygon_count++;
+			// Resize the polygon count.
+			for (const NavRegion *region : regions) {
+				if (!region->get_enabled()) {
+					continue;
+				}
+				polygon_count += region->get_polygons().size();
 			}
-		}
-
-		_new_pm_polygon_count = polygon_count;
+			polygons.resize(polygon_count);
 
-		// Group all edges per key.
-		HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey> connections;
-		for (gd::Polygon &poly : polygons) {
-			for (uint32_t p = 0; p < poly.points.size(); p++) {
-				int next_point = (p + 1) % poly.points.size();
-				gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
-
-				HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey>::Iterator connection = connections.find(ek);
-				if (!connection) {
-					connections[ek] = Vector<gd::Edge::Connection>();
-					_new_pm_edge_count += 1;
+			// Copy all region polygons in the map.
+			polygon_count = 0;
+			for (const NavRegion *region : regions) {
+				if (!region->get_enabled()) {
+					continue;
 				}
-				if (connections[ek].size() <= 1) {
-					// Add the polygon/edge tuple to this key.
-					gd::Edge::Connection new_connection;
-					new_connection.polygon = &poly;
-					new_connection.edge = p;
-					new_connection.pathway_start = poly.points[p].pos;
-					new_connection.pathway_end = poly.points[next_point].pos;
-					connections[ek].push_back(new_connection);
-				} else {
-					// The edge is already connected with another edge, skip.
-					ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.");
+				const LocalVector<gd::Polygon> &polygons_source = region->get_polygons();
+				for (uint32_t n = 0; n < polygons_source.size(); n++) {
+					polygons[polygon_count] = polygons_source[n];
+					polygons[polygon_count].id = polygon_count;
+					polygon_count++;
 				}
 			}
-		}
 
-		Vector<gd::Edge::Connection> free_edges;
-		for (KeyValue<gd::EdgeKey, Vector<gd::Edge::Connection>> &E : connections) {
-			if (E.value.size() == 2) {
-				// Connect edge that are shared in different polygons.
-				gd::Edge::Connection &c1 = E.value.write[0];
-				gd::Edge::Connection &c2 = E.value.write[1];
-				c1.polygon->edges[c1.edge].connections.push_back(c2);
-				c2.polygon->edges[c2.edge].connections.push_back(c1);
-				// Note: The pathway_start/end are full for those connection and do not need to be modified.
-				_new_pm_edge_merge_count += 1;
-			} else {
-				CRASH_COND_MSG(E.value.size() != 1, vformat("Number of connection != 1. Found: %d", E.value.size()));
-				if (use_edge_connections && E.value[0].polygon->owner->get_use_edge_connections()) {
-					free_edges.push_back(E.value[0]);
+			// Group all edges per key.
+			HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey> connections;
+			for (gd::Polygon &poly : polygons) {
+				for (uint32_t p = 0; p < poly.points.size(); p++) {
+					int next_point = (p + 1) % poly.points.size();
+					gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
+
+					HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey>::Iterator connection = connections.find(ek);
+					if (!connection) {
+						connections[ek] = Vector<gd::Edge::Connection>();
+						_new_pm_edge_count += 1;
+					}
+					if (connections[ek].size() <= 1) {
+						// Add the polygon/edge tuple to this key.
+						gd::Edge::Connection new_connection;
+						new_connection.polygon = &poly;
+						new_connection.edge = p;
+						new_connection.pathway_start = poly.points[p].pos;
+						new_connection.pathway_end = poly.points[next_point].pos;
+						connections[ek].push_back(new_connection);
+					} else {
+						// The edge is already connected with another edge, skip.
+						_print_edge_merge_error();
+					}
 				}
 			}
-		}
-
-		// Find the compatible near edges.
-		//
-		// Note:
-		// Considering that the edges must be compatible (for obvious reasons)
-		// to be connected, create new polygons to remove that small gap is
-		// not really useful and would result in wasteful computation during
-		// connection, integration and path finding.
-		_new_pm_edge_free_count = free_edges.size();
-
-		for (int i = 0; i < free_edges.size(); i++) {
-			const gd::Edge::Connection &free_edge = free_edges[i];
-			Vector3 edge_p1 = free_edge.polygon->points[free_edge.edge].pos;
-			Vector3 edge_p2 = free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos;
 
-			for (int j = 0; j < free_edges.size(); j++) {
-				const gd::Edge::Connection &other_edge = free_edges[j];
-				if (i == j || free_edge.polygon->owner == other_edge.polygon->owner) {
-					continue;
+			Vector<gd::Edge::Connection> free_edges;
+			for (KeyValue<gd::EdgeKey, Vector<gd::Edge::Connection>> &E : connections) {
+				if (E.value.size() == 2) {
+					// Connect edge that are shared in different polygons.
+					gd::Edge::Connection &c1 = E.value.write[0];
+					gd::Edge::Connection &c2 = E.value.write[1];
+					c1.polygon->edges[c1.edge].connections.push_back(c2);
+					c2.polygon->edges[c2.edge].connections.push_back(c1);
+					// Note: The pathway_start/end are full for those connection and do not need to be modified.
+					_new_pm_edge_merge_count += 1;
+				} else {
+					CRASH_COND_MSG(E.value.size() != 1, vformat("Number of connection != 1. Found: %d", E.value.size()));
+					if (use_edge_connections && E.value[0].polygon->owner->get_use_edge_connections()) {
+						free_edges.push_back(E.value[0]);
+					}
 				}
+			}
 
-				Vector3 other_edge_p1 = other_edge.polygon->points[other_edge.edge].pos;
-				Vector3 other_edge_p2 = other_edge.polygon->points[(other_edge.edge + 1) % other_edge.polygon->points.size()].pos;
-
-				// Compute the projection of the opposite edge on the current one
-				Vector3 edge_vector = edge_p2 - edge_p1;
-				real_t projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
-				real_t projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
-				if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
-					continue;
-				}
+			// Find the compatible near edges.
+			//
+			// Note:
+			// Considering that the edges must be compatible (for obvious reasons)
+			// to be connected, create new polygons to remove that small gap is
+			// not really useful and would result in wasteful computation during
+			// connection, integration and path finding.
+			_new_pm_edge_free_count = free_edges.size();
+
+			for (int i = 0; i < free_edges.size(); i++) {
+				const gd::Edge::Connection &free_edge = free_edges[i];
+				Vector3 edge_p1 = free_edge.polygon->points[free_edge.edge].pos;
+				Vector3 edge_p2 = free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos;
+
+				for (int j = 0; j < free_edges.size(); j++) {
+					const gd::Edge::Connection &other_edge = free_edges[j];
+					if (i == j || free_edge.polygon->owner == other_edge.polygon->owner) {
+						continue;
+					}
 
-				// Check if the two edges are close to each other enough and compute a pathway between the two regions.
-				Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other1;
-				if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
-					other1 = other_edge_p1;
-				} else {
-					other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
-				}
-				if (other1.distance_to(self1) > edge_connection_margin) {
-					continue;
-				}
+					Vector3 other_edge_p1 = other_edge.polygon->points[other_edge.edge].pos;
+					Vector3 other_edge_p2 = other_edge.polygon->points[(other_edge.edge + 1) % other_edge.polygon->points.size()].pos;
 
-				Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other2;
-				if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
-					other2 = other_edge_p2;
-				} else {
-					other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
-				}
-				if (other2.distance_to(self2) > edge_connection_margin) {
-					continue;
-				}
+					Vector3 pathway_start;
+					Vector3 pathway_end;
+					if (!_get_edge_connection_pathway(edge_p1, edge_p2, other_edge_p1, other_edge_p2, edge_connection_margin, pathway_start, pathway_end)) {
+						continue;
+					}
 
-				// The edges can now be connected.
-				gd::Edge::Connection new_connection = other_edge;
-				new_connection.pathway_start = (self1 + other1) / 2.0;
-				new_connection.pathway_end = (self2 + other2) / 2.0;
-				free_edge.polygon->edges[free_edge.edge].connections.push_back(new_connection);
+					// The edges can now be connected.
+					gd::Edge::Connection new_connection = other_edge;
+					new_connection.pathway_start = pathway_start;
+					new_connection.pathway_end = pathway_end;
+					free_edge.polygon->edges[free_edge.edge].connections.push_back(new_connection);
 
-				// Add the connection to the region_connection map.
-				region_external_connections[(NavRegion *)free_edge.polygon->owner].push_back(new_connection);
-				_new_pm_edge_connection_count += 1;
+					// Add the connection to the region_connection map.
+					region_external_connections[(NavRegion *)free_edge.polygon->owner].push_back(new_connection);
+					_new_pm_edge_connection_count += 1;
+				}
 			}
+
+			polygons_bvh.build(polygons);
 		}
 
+		_new_pm_polygon_count = polygon_count;
+
 		uint32_t link_poly_idx = 0;
 		link_polygons.resize(links.size());
 
@@ -548,52 +583,17 @@ void NavMap::sync() {
 			const Vector3 start = link->get_start_position();
 			const Vector3 end = link->get_end_position();
 
-			gd::Polygon *closest_start_polygon = nullptr;
-			real_t closest_start_distance = link_connection_radius;
+			// Find the closest polygons within the search radius of the start and end points.
 			Vector3 closest_start_point;
-
-			gd::Polygon *closest_end_polygon = nullptr;
-			real_t closest_end_distance = link_connection_radius;
 			Vector3 closest_end_point;
-
-			// Create link to any polygons within the search radius of the start point.
-			for (uint32_t start_index = 0; start_index < polygons.size(); start_index++) {
-				gd::Polygon &start_poly = polygons[start_index];
-
-				// For each face check the distance to the start
-				for (uint32_t start_point_id = 2; start_point_id < start_poly.points.size(); start_point_id += 1) {
-					const Face3 start_face(start_poly.points[0].pos, start_poly.points[start_point_id - 1].pos, start_poly.points[start_point_id].pos);
-					const Vector3 start_point = start_face.get_closest_point_to(start);
-					const real_t start_distance = start_point.distance_to(start);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (start_distance <= link_connection_radius && start_distance < closest_start_distance) {
-						closest_start_distance = start_distance;
-						closest_start_point = start_point;
-						closest_start_polygon = &start_poly;
-					}
-				}
-			}
-
-			// Find any polygons within the search radius of the end point.
-			for (gd::Polygon &end_poly : polygons) {
-				// For each face check the distance to the end
-				for (uint32_t end_point_id = 2; end_point_id < end_poly.points.size(); end_point_id += 1) {
-					const Face3 end_face(end_poly.points[0].pos, end_poly.points[end_point_id - 1].pos, end_poly.points[end_point_id].pos);
-					const Vector3 end_point = end_face.get_closest_point_to(end);
-					const real_t end_distance = end_point.distance_to(end);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (end_distance <= link_connection_radius && end_distance < closest_end_distance) {
-						closest_end_distance = end_distance;
-						closest_end_point = end_point;
-						closest_end_polygon = &end_poly;
-					}
-				}
-			}
+			Vector3 closest_normal;
+			const uint32_t closest_start_polygon_index = NavMeshQueries3D::polygons_get_closest_polygon(polygons, polygons_bvh, start, link_connection_radius, 0, false, closest_start_point, closest_normal);
+			const uint32_t closest_end_polygon_index = NavMeshQueries3D::polygons_get_closest_polygon(polygons, polygons_bvh, end, link_connection_radius, 0, false, closest_end_point, closest_normal);
 
 			// If we have both a start and end point, then create a synthetic polygon to route through.
-			if (closest_start_polygon && closest_end_polygon) {
+			if (closest_start_polygon_index != UINT32_MAX && closest_end_polygon_index != UINT32_MAX) {
+				gd::Polygon *closest_start_polygon = &polygons[closest_start_polygon_index];
+				gd::Polygon *closest_end_polygon = &polygons[closest_end_polygon_index];
 				gd::Polygon &new_polygon = link_polygons[link_poly_idx++];
 				new_polygon.id = polygon_count++;
 				new_polygon.owner = link;
@@ -645,6 +645,10 @@ void NavMap::sync() {
 			}
 		}
 
+		if (use_cluster_graph) {
+			_build_cluster_graph(link_poly_idx);
+		}
+
 		// Some code treats 0 as a failure case, so we avoid returning 0 and modulo wrap UINT32_MAX manually.
 		iteration_id = iteration_id % UINT32_MAX + 1;
 	}
@@ -669,6 +673,7 @@ void NavMap::sync() {
 
 	regenerate_polygons = false;
 	regenerate_links = false;
+	regenerate_region_connections = false;
 	obstacles_dirty = false;
 	agents_dirty = false;
 
@@ -684,6 +689,506 @@ void NavMap::sync() {
 	pm_obstacle_count = _new_pm_obstacle_count;
 }
 
+void NavMap::_build_cluster_graph(uint32_t p_link_polygon_count) {
+	cluster_graph.clear();
+	cluster_graph.polygon_clusters.resize(polygons.size() + link_polygons.size());
+
+	LocalVector<gd::Cluster> &clusters = cluster_graph.clusters;
+	LocalVector<uint32_t> &polygon_clusters = cluster_graph.polygon_clusters;
+	LocalVector<uint32_t> cluster_polygon_counts;
+
+	// Group the region polygons by their owner and by the cell their center falls in,
+	// so that a cluster never crosses a region boundary.
+	HashMap<const NavBase *, HashMap<Vector3i, uint32_t>> owner_cell_clusters;
+	for (const gd::Polygon &polygon : polygons) {
+		ERR_CONTINUE(polygon.id >= polygon_clusters.size());
+
+		Vector3 center;
+		for (const gd::Point &point : polygon.points) {
+			center += point.pos;
+		}
+		if (!polygon.points.is_empty()) {
+			center /= polygon.points.size();
+		}
+
+		const Vector3 cell_position = (center / cluster_size).floor();
+		const Vector3i cell(cell_position.x, cell_position.y, cell_position.z);
+
+		HashMap<Vector3i, uint32_t> &cell_clusters = owner_cell_clusters[polygon.owner];
+		HashMap<Vector3i, uint32_t>::Iterator E = cell_clusters.find(cell);
+		if (!E) {
+			E = cell_clusters.insert(cell, clusters.size());
+
+			gd::Cluster new_cluster;
+			new_cluster.owner = polygon.owner;
+			clusters.push_back(new_cluster);
+			cluster_polygon_counts.push_back(0);
+		}
+
+		const uint32_t cluster_index = E->value;
+		clusters[cluster_index].position += center;
+		cluster_polygon_counts[cluster_index]++;
+		polygon_clusters[polygon.id] = cluster_index;
+	}
+
+	for (uint32_t i = 0; i < clusters.size(); i++) {
+		clusters[i].position /= cluster_polygon_counts[i];
+	}
+
+	// Every link is a cluster of its own.
+	for (uint32_t i = 0; i < p_link_polygon_count; i++) {
+		const gd::Polygon &link_polygon = link_polygons[i];
+		ERR_CONTINUE(link_polygon.id >= polygon_clusters.size());
+
+		gd::Cluster new_cluster;
+		new_cluster.owner = link_polygon.owner;
+		new_cluster.position = (link_polygon.points[0].pos + link_polygon.points[2].pos) * 0.5;
+
+		polygon_clusters[link_polygon.id] = clusters.size();
+		clusters.push_back(new_cluster);
+	}
+
+	// Connect the clusters following the polygon connections, links included.
+	HashSet<uint64_t> cluster_connections;
+	const gd::Polygon *polygon_lists[2] = { polygons.ptr(), link_polygons.ptr() };
+	const uint32_t polygon_list_sizes[2] = { polygons.size(), p_link_polygon_count };
+	for (uint32_t list = 0; list < 2; list++) {
+		for (uint32_t i = 0; i < polygon_list_sizes[list]; i++) {
+			const gd::Polygon &polygon = polygon_lists[list][i];
+			const uint32_t from_cluster = polygon_clusters[polygon.id];
+
+			for (const gd::Edge &edge : polygon.edges) {
+				for (const gd::Edge::Connection &connection : edge.connections) {
+					const uint32_t to_cluster = polygon_clusters[connection.polygon->id];
+					if (to_cluster == from_cluster) {
+						continue;
+					}
+
+					const uint64_t connection_key = (uint64_t(from_cluster) << 32) | to_cluster;
+					if (!cluster_connections.has(connection_key)) {
+						cluster_connections.insert(connection_key);
+						clusters[from_cluster].neighbors.push_back(to_cluster);
+					}
+				}
+			}
+		}
+	}
+}
+
+void NavMap::_update_region_sync_data(NavRegion *p_region, RegionSyncData &r_data) {
+	r_data.self = p_region->get_self();
+	r_data.bounds = AABB();
+	r_data.has_bounds = false;
+	r_data.polygon_count = 0;
+	r_data.edge_count = 0;
+	r_data.edge_merge_count = 0;
+	r_data.edge_free_count = 0;
+	r_data.internal_connections.clear();
+	r_data.boundary_edges.clear();
+	r_data.boundary_edge_map.clear();
+	r_data.merged_connections.clear();
+	r_data.margin_connections.clear();
+
+	if (!p_region->get_enabled()) {
+		return;
+	}
+
+	const LocalVector<gd::Polygon> &region_polygons = p_region->get_polygons();
+	r_data.polygon_count = region_polygons.size();
+
+	// Group all edges of the region per key, edges shared by two polygons are merged right away.
+	HashMap<gd::EdgeKey, LocalVector<RegionBoundaryEdge>, gd::EdgeKey> connections;
+	for (uint32_t poly_index = 0; poly_index < region_polygons.size(); poly_index++) {
+		const gd::Polygon &poly = region_polygons[poly_index];
+		for (uint32_t p = 0; p < poly.points.size(); p++) {
+			if (r_data.has_bounds) {
+				r_data.bounds.expand_to(poly.points[p].pos);
+			} else {
+				r_data.bounds.position = poly.points[p].pos;
+				r_data.has_bounds = true;
+			}
+
+			int next_point = (p + 1) % poly.points.size();
+			gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
+
+			LocalVector<RegionBoundaryEdge> &edges = connections[ek];
+			if (edges.size() <= 1) {
+				RegionBoundaryEdge boundary_edge;
+				boundary_edge.polygon = poly_index;
+				boundary_edge.edge = p;
+				boundary_edge.key = ek;
+				edges.push_back(boundary_edge);
+			} else {
+				// The edge is already connected with another edge, skip.
+				_print_edge_merge_error();
+			}
+		}
+	}
+
+	r_data.edge_count = connections.size();
+
+	for (KeyValue<gd::EdgeKey, LocalVector<RegionBoundaryEdge>> &E : connections) {
+		if (E.value.size() == 2) {
+			// Connect edge that are shared in different polygons.
+			const RegionBoundaryEdge &e1 = E.value[0];
+			const RegionBoundaryEdge &e2 = E.value[1];
+			const gd::Polygon &poly1 = region_polygons[e1.polygon];
+			const gd::Polygon &poly2 = region_polygons[e2.polygon];
+
+			RegionConnection c1;
+			c1.polygon = e1.polygon;
+			c1.edge = e1.edge;
+			c1.target_region = p_region;
+			c1.target_polygon = e2.polygon;
+			c1.target_edge = e2.edge;
+			c1.pathway_start = poly2.points[e2.edge].pos;
+			c1.pathway_end = poly2.points[(e2.edge + 1) % poly2.points.size()].pos;
+			r_data.internal_connections.push_back(c1);
+
+			RegionConnection c2;
+			c2.polygon = e2.polygon;
+			c2.edge = e2.edge;
+			c2.target_region = p_region;
+			c2.target_polygon = e1.polygon;
+			c2.target_edge = e1.edge;
+			c2.pathway_start = poly1.points[e1.edge].pos;
+			c2.pathway_end = poly1.points[(e1.edge + 1) % poly1.points.size()].pos;
+			r_data.internal_connections.push_back(c2);
+
+			r_data.edge_merge_count += 1;
+		} else {
+			CRASH_COND_MSG(E.value.size() != 1, vformat("Number of connection != 1. Found: %d", E.value.size()));
+			r_data.boundary_edge_map[E.key] = r_data.boundary_edges.size();
+			r_data.boundary_edges.push_back(E.value[0]);
+		}
+	}
+}
+
+void NavMap::_sync_regions_incremental(const LocalVector<NavRegion *> &p_changed_regions, int &r_edge_count, int &r_edge_merge_count, int &r_edge_connection_count, int &r_edge_free_count) {
+	// Two regions can only be connected when they are within the edge connection margin of each other.
+	// The rasterizer cell size is added as points that share a key are not necessarily at the exact same position.
+	const real_t neighbor_margin = MAX(edge_connection_margin, real_t(0.0)) + MAX(merge_rasterizer_cell_size, merge_rasterizer_cell_height);
+
+	// The old and new bounds of every changed region, regions overlapping them need to be relinked.
+	LocalVector<AABB> changed_bounds;
+
+	HashSet<NavRegion *> map_regions;
+	for (NavRegion *region : regions) {
+		map_regions.insert(region);
+	}
+
+	// Forget the regions that left the map. A new region may reuse the address of a freed one, so check the RID as well.
+	LocalVector<NavRegion *> removed_regions;
+	for (const KeyValue<NavRegion *, RegionSyncData> &E : region_sync_data) {
+		if (!map_regions.has(E.key) || E.key->get_self() != E.value.self) {
+			if (E.value.has_bounds) {
+				changed_bounds.push_back(E.value.bounds);
+			}
+			removed_regions.push_back(E.key);
+		}
+	}
+	for (NavRegion *region : removed_regions) {
+		RegionSyncData &data = region_sync_data[region];
+		polygons_bvh.remove_polygons(data.bvh_ids, data.bvh_polygon_size_sum);
+		region_sync_data.erase(region);
+	}
+
+	HashSet<NavRegion *> changed_region_set;
+	for (NavRegion *region : p_changed_regions) {
+		changed_region_set.insert(region);
+	}
+	for (NavRegion *region : regions) {
+		if (!region_sync_data.has(region)) {
+			changed_region_set.insert(region);
+		}
+	}
+
+	// Rebuild the local data of the changed regions.
+	for (NavRegion *region : changed_region_set) {
+		RegionSyncData &data = region_sync_data[region];
+		if (data.has_bounds) {
+			changed_bounds.push_back(data.bounds);
+		}
+		_update_region_sync_data(region, data);
+		if (data.has_bounds) {
+			changed_bounds.push_back(data.bounds);
+		}
+	}
+
+	// Find the regions that need to be relinked with their neighbors.
+	LocalVector<NavRegion *> affected_regions;
+	HashSet<NavRegion *> affected_region_set;
+	for (NavRegion *region : regions) {
+		const RegionSyncData &data = region_sync_data[region];
+		bool affected = regenerate_region_connections || changed_region_set.has(region);
+		if (!affected && data.has_bounds) {
+			const AABB grown_bounds = data.bounds.grow(neighbor_margin);
+			for (const AABB &bounds : changed_bounds) {
+				if (grown_bounds.intersects_inclusive(bounds)) {
+					affected = true;
+					break;
+				}
+			}
+		}
+		if (affected) {
+			affected_regions.push_back(region);
+			affected_region_set.insert(region);
+		}
+	}
+
+	// Gather the neighbors of the affected regions.
+	LocalVector<LocalVector<NavRegion *>> affected_region_neighbors;
+	affected_region_neighbors.resize(affected_regions.size());
+	for (uint32_t i = 0; i < affected_regions.size(); i++) {
+		const RegionSyncData &data = region_sync_data[affected_regions[i]];
+		if (!data.has_bounds) {
+			continue;
+		}
+		const AABB grown_bounds = data.bounds.grow(neighbor_margin);
+		for (NavRegion *other_region : regions) {
+			if (other_region == affected_regions[i]) {
+				continue;
+			}
+			const RegionSyncData &other_data = region_sync_data[other_region];
+			if (other_data.has_bounds && grown_bounds.intersects_inclusive(other_data.bounds)) {
+				affected_region_neighbors[i].push_back(other_region);
+			}
+		}
+	}
+
+	// Merge the edges shared with the neighbor regions, the remaining boundary edges become free edges.
+	for (uint32_t i = 0; i < affected_regions.size(); i++) {
+		NavRegion *region = affected_regions[i];
+		RegionSyncData &data = region_sync_data[region];
+		data.merged_connections.clear();
+		data.margin_connections.clear();
+		data.edge_free_count = 0;
+
+		const bool region_use_edge_connections = use_edge_connections && region->get_use_edge_connections();
+
+		for (RegionBoundaryEdge &boundary_edge : data.boundary_edges) {
+			bool merged = false;
+			for (NavRegion *other_region : affected_region_neighbors[i]) {
+				const RegionSyncData &other_data = region_sync_data[other_region];
+				HashMap<gd::EdgeKey, uint32_t, gd::EdgeKey>::ConstIterator other_edge_index = other_data.boundary_edge_map.find(boundary_edge.key);
+				if (!other_edge_index) {
+					continue;
+				}
+				if (merged) {
+					// The edge is already connected with another edge, skip.
+					_print_edge_merge_error();
+					break;
+				}
+
+				const RegionBoundaryEdge &other_edge = other_data.boundary_edges[other_edge_index->value];
+				const gd::Polygon &other_poly = other_region->get_polygons()[other_edge.polygon];
+
+				RegionConnection connection;
+				connection.polygon = boundary_edge.polygon;
+				connection.edge = boundary_edge.edge;
+				connection.target_region = other_region;
+				connection.target_polygon = other_edge.polygon;
+				connection.target_edge = other_edge.edge;
+				connection.pathway_start = other_poly.points[other_edge.edge].pos;
+				connection.pathway_end = other_poly.points[(other_edge.edge + 1) % other_poly.points.size()].pos;
+				data.merged_connections.push_back(connection);
+				merged = true;
+			}
+
+			boundary_edge.free = !merged && region_use_edge_connections;
+			if (boundary_edge.free) {
+				data.edge_free_count += 1;
+			}
+		}
+	}
+
+	// Find the compatible near edges of the affected regions.
+	for (uint32_t i = 0; i < affected_regions.size(); i++) {
+		NavRegion *region = affected_regions[i];
+		RegionSyncData &data = region_sync_data[region];
+		if (data.edge_free_count == 0) {
+			continue;
+		}
+		const LocalVector<gd::Polygon> &region_polygons = region->get_polygons();
+
+		for (const RegionBoundaryEdge &free_edge : data.boundary_edges) {
+			if (!free_edge.free) {
+				continue;
+			}
+			const gd::Polygon &free_poly = region_polygons[free_edge.polygon];
+			const Vector3 edge_p1 = free_poly.points[free_edge.edge].pos;
+			const Vector3 edge_p2 = free_poly.points[(free_edge.edge + 1) % free_poly.points.size()].pos;
+
+			for (NavRegion *other_region : affected_region_neighbors[i]) {
+				const RegionSyncData &other_data = region_sync_data[other_region];
+				if (other_data.edge_free_count == 0) {
+					continue;
+				}
+				const LocalVector<gd::Polygon> &other_region_polygons = other_region->get_polygons();
+
+				for (const RegionBoundaryEdge &other_edge : other_data.boundary_edges) {
+					if (!other_edge.free) {
+						continue;
+					}
+					const gd::Polygon &other_poly = other_region_polygons[other_edge.polygon];
+					const Vector3 other_edge_p1 = other_poly.points[other_edge.edge].pos;
+					const Vector3 other_edge_p2 = other_poly.points[(other_edge.edge + 1) % other_poly.points.size()].pos;
+
+					RegionConnection connection;
+					if (!_get_edge_connection_pathway(edge_p1, edge_p2, other_edge_p1, other_edge_p2, edge_connection_margin, connection.pathway_start, connection.pathway_end)) {
+						continue;
+					}
+					connection.polygon = free_edge.polygon;
+					connection.edge = free_edge.edge;
+					connection.target_region = other_region;
+					connection.target_polygon = other_edge.polygon;
+					connection.target_edge = other_edge.edge;
+					data.margin_connections.push_back(connection);
+				}
+			}
+		}
+	}
+
+	// Lay out the region polygons in the map. Regions that were not relinked and kept
+	// their polygon range only need their connections to be pointed at the new polygons.
+	const uintptr_t old_polygons_address = uintptr_t(polygons.ptr());
+	LocalVector<uint32_t> old_to_new_polygon_id;
+	old_to_new_polygon_id.resize(polygons.size());
+	for (uint32_t &polygon_id : old_to_new_polygon_id) {
+		polygon_id = UINT32_MAX;
+	}
+
+	LocalVector<bool> keep_region_polygons;
+	keep_region_polygons.resize(regions.size());
+
+	// The BVH leaves of the regions that changed or moved in the map polygons are replaced once the polygons are laid out.
+	LocalVector<bool> insert_region_bvh;
+	insert_region_bvh.resize(regions.size());
+
+	uint32_t polygon_count = 0;
+	for (uint32_t i = 0; i < regions.size(); i++) {
+		RegionSyncData &data = region_sync_data[regions[i]];
+		const bool changed = changed_region_set.has(regions[i]);
+		if (data.materialized && !changed) {
+			for (uint32_t n = 0; n < data.polygon_count; n++) {
+				old_to_new_polygon_id[data.polygon_offset + n] = polygon_count + n;
+			}
+		}
+		keep_region_polygons[i] = data.materialized && !changed && !affected_region_set.has(regions[i]) && data.polygon_offset == polygon_count;
+		insert_region_bvh[i] = !data.materialized || changed || data.polygon_offset != polygon_count;
+		if (insert_region_bvh[i]) {
+			polygons_bvh.remove_polygons(data.bvh_ids, data.bvh_polygon_size_sum);
+		}
+		data.polygon_offset = polygon_count;
+		data.materialized = true;
+		polygon_count += data.polygon_count;
+	}
+
+	polygons.resize(polygon_count);
+
+	region_external_connections.clear();
+	AABB polygons_bounds;
+	bool has_polygons_bounds = false;
+	for (uint32_t i = 0; i < regions.size(); i++) {
+		NavRegion *region = regions[i];
+		RegionSyncData &data = region_sync_data[region];
+		LocalVector<gd::Edge::Connection> &external_connections = region_external_connections[region];
+
+		if (keep_region_polygons[i]) {
+			for (uint32_t n = 0; n < data.polygon_count; n++) {
+				for (gd::Edge &edge : polygons[data.polygon_offset + n].edges) {
+					for (int c = edge.connections.size() - 1; c >= 0; c--) {
+						gd::Edge::Connection &connection = edge.connections.write[c];
+						if (connection.edge == -1) {
+							// Navigation link connections are rebuilt after this.
+							edge.connections.remove_at(c);
+							continue;
+						}
+						const uint32_t old_polygon_id = (uintptr_t(connection.polygon) - old_polygons_address) / sizeof(gd::Polygon);
+						if (old_polygon_id >= old_to_new_polygon_id.size() || old_to_new_polygon_id[old_polygon_id] == UINT32_MAX) {
+							// Should not happen, regions connected to a changed region are always relinked.
+							edge.connections.remove_at(c);
+							continue;
+						}
+						connection.polygon = &polygons[old_to_new_polygon_id[old_polygon_id]];
+					}
+				}
+			}
+		} else {
+			const LocalVector<gd::Polygon> &polygons_source = region->get_polygons();
+			for (uint32_t n = 0; n < data.polygon_count; n++) {
+				polygons[data.polygon_offset + n] = polygons_source[n];
+				polygons[data.polygon_offset + n].id = data.polygon_offset + n;
+			}
+
+			for (const RegionConnection &region_connection : data.internal_connections) {
+				gd::Edge::Connection new_connection;
+				new_connection.polygon = &polygons[data.polygon_offset + region_connection.target_polygon];
+				new_connection.edge = region_connection.target_edge;
+				new_connection.pathway_start = region_connection.pathway_start;
+				new_connection.pathway_end = region_connection.pathway_end;
+				polygons[data.polygon_offset + region_connection.polygon].edges[region_connection.edge].connections.push_back(new_connection);
+			}
+
+			for (const RegionConnection &region_connection : data.merged_connections) {
+				gd::Edge::Connection new_connection;
+				new_connection.polygon = &polygons[region_sync_data[region_connection.target_region].polygon_offset + region_connection.target_polygon];
+				new_connection.edge = region_connection.target_edge;
+				new_connection.pathway_start = region_connection.pathway_start;
+				new_connection.pathway_end = region_connection.pathway_end;
+				polygons[data.polygon_offset + region_connection.polygon].edges[region_connection.edge].connections.push_back(new_connection);
+			}
+
+			for (const RegionConnection &region_connection : data.margin_connections) {
+				gd::Edge::Connection new_connection;
+				new_connection.polygon = &polygons[region_sync_data[region_connection.target_region].polygon_offset + region_connection.target_polygon];
+				new_connection.edge = region_connection.target_edge;
+				new_connection.pathway_start = region_connection.pathway_start;
+				new_connection.pathway_end = region_connection.pathway_end;
+				polygons[data.polygon_offset + region_connection.polygon].edges[region_connection.edge].connections.push_back(new_connection);
+			}
+		}
+
+		// Add the edge connections to the region_connection map.
+		for (const RegionConnection &region_connection : data.margin_connections) {
+			gd::Edge::Connection new_connection;
+			new_connection.polygon = &polygons[region_sync_data[region_connection.target_region].polygon_offset + region_connection.target_polygon];
+			new_connection.edge = region_connection.target_edge;
+			new_connection.pathway_start = region_connection.pathway_start;
+			new_connection.pathway_end = region_connection.pathway_end;
+			external_connections.push_back(new_connection);
+		}
+
+		if (insert_region_bvh[i]) {
+			data.bvh_polygon_size_sum = polygons_bvh.insert_polygons(polygons, data.polygon_offset, data.polygon_count, &data.bvh_ids);
+		}
+		if (data.has_bounds) {
+			polygons_bounds = has_polygons_bounds ? polygons_bounds.merge(data.bounds) : data.bounds;
+			has_polygons_bounds = true;
+		}
+	}
+
+	// Leaves removal does not shrink the BVH bounds, the regions bounds contain all of their polygons.
+	polygons_bvh.bounds = polygons_bounds;
+
+	// Performance Monitor.
+	int merged_connection_count = 0;
+	r_edge_count = 0;
+	r_edge_merge_count = 0;
+	r_edge_connection_count = 0;
+	r_edge_free_count = 0;
+	for (const KeyValue<NavRegion *, RegionSyncData> &E : region_sync_data) {
+		r_edge_count += E.value.edge_count;
+		r_edge_merge_count += E.value.edge_merge_count;
+		r_edge_connection_count += E.value.margin_connections.size();
+		r_edge_free_count += E.value.edge_free_count;
+		merged_connection_count += E.value.merged_connections.size();
+	}
+	// Edges shared between two regions are counted once from each side.
+	r_edge_count -= merged_connection_count / 2;
+	r_edge_merge_count += merged_connection_count / 2;
+}
+
 void NavMap::_update_rvo_obstacles_tree_2d() {
 	int obstacle_vertex_count = 0;
 	for (NavObstacle *obstacle : obstacles) {
@@ -893,6 +1398,9 @@ Vector3 NavMap::get_region_connection_pathway_end(NavRegion *p_region, int p_con
 NavMap::NavMap() {
 	avoidance_use_multiple_threads = GLOBAL_GET("navigation/avoidance/thread_model/avoidance_use_multiple_threads");
 	avoidance_use_high_priority_threads = GLOBAL_GET("navigation/avoidance/thread_model/avoidance_use_high_priority_threads");
+	use_incremental_sync = GLOBAL_GET("navigation/world/map_use_incremental_sync");
+	use_cluster_graph = GLOBAL_GET("navigation/world/map_use_cluster_graph");
+	cluster_size = MAX(real_t(GLOBAL_GET("navigation/world/map_cluster_size")), real_t(0.01));
 }
 
 NavMap::~NavMap() {
@@ -34,8 +34,10 @@
 #include "nav_rid.h"
 #include "nav_utils.h"
 
+#include "core/math/aabb.h"
 #include "core/math/math_defs.h"
 #include "core/object/worker_thread_pool.h"
+#include "core/templates/safe_refcount.h"
 #include "servers/navigation/navigation_globals.h"
 
 #include <KdTree2d.h>
@@ -51,6 +53,9 @@ class NavObstacle;
 class NavMap : public NavRid {
 	RWLock map_rwlock;
 
+	/// Queries of path query batches that use this map from other threads, the map must not be freed while they are pinned.
+	SafeNumeric<uint32_t> path_query_pins;
+
 	/// Map Up
 	Vector3 up = Vector3(0, 1, 0);
 
@@ -74,6 +79,15 @@ class NavMap : public NavRid {
 
 	bool regenerate_polygons = true;
 	bool regenerate_links = true;
+	bool regenerate_region_connections = true;
+
+	/// Only relink the regions affected by a change instead of rebuilding all the map connections on sync.
+	bool use_incremental_sync = false;
+
+	/// Build a graph of polygon clusters on sync to plan hierarchical paths.
+	bool use_cluster_graph = false;
+	/// Size of the cells used to group the polygons of a region in clusters.
+	real_t cluster_size = 32.0;
 
 	/// Map regions
 	LocalVector<NavRegion *> regions;
@@ -84,6 +98,8 @@ class NavMap : public NavRid {
 
 	/// Map polygons
 	LocalVector<gd::Polygon> polygons;
+	gd::PolygonsBVH polygons_bvh;
+	gd::ClusterGraph cluster_graph;
 
 	/// RVO avoidance worlds
 	RVO2D::RVOSimulator2D rvo_simulation_2d;
@@ -128,6 +144,57 @@ class NavMap : public NavRid {
 
 	HashMap<NavRegion *, LocalVector<gd::Edge::Connection>> region_external_connections;
 
+	/// Connection between two region polygons, stored with region local polygon indices
+	/// so it stays valid while the map polygons are relocated.
+	struct RegionConnection {
+		uint32_t polygon = 0;
+		int edge = -1;
+		NavRegion *target_region = nullptr;
+		uint32_t target_polygon = 0;
+		int target_edge = -1;
+		Vector3 pathway_start;
+		Vector3 pathway_end;
+	};
+
+	/// Region polygon edge that is not shared with another polygon of the same region.
+	struct RegionBoundaryEdge {
+		uint32_t polygon = 0;
+		int edge = -1;
+		gd::EdgeKey key;
+		bool free = false;
+	};
+
+	/// Per region data cached between syncs by the incremental synchronization.
+	struct RegionSyncData {
+		RID self;
+		AABB bounds;
+		bool has_bounds = false;
+		bool materialized = false;
+
+		/// Range of the region polygons in the map polygons.
+		uint32_t polygon_offset = 0;
+		uint32_t polygon_count = 0;
+
+		/// Leaves of the region polygons in the map polygons BVH, they store the polygon indices so they are only valid for this range.
+		LocalVector<DynamicBVH::ID> bvh_ids;
+		real_t bvh_polygon_size_sum = 0.0;
+
+		uint32_t edge_count = 0;
+		uint32_t edge_merge_count = 0;
+		uint32_t edge_free_count = 0;
+
+		LocalVector<RegionConnection> internal_connections;
+		LocalVector<RegionBoundaryEdge> boundary_edges;
+		HashMap<gd::EdgeKey, uint32_t, gd::EdgeKey> boundary_edge_map;
+
+		/// Edges shared with polygons of other regions.
+		LocalVector<RegionConnection> merged_connections;
+		/// Edge connections with other regions within the edge connection margin.
+		LocalVector<RegionConnection> margin_connections;
+	};
+
+	HashMap<NavRegion *, RegionSyncData> region_sync_data;
+
 public:
 	NavMap();
 	~NavMap();
@@ -169,7 +236,17 @@ public:
 
 	gd::PointKey get_point_key(const Vector3 &p_pos) const;
 
-	Vector<Vector3> get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const;
+	/// Locks the map for reading to run several queries in a row, it must be unlocked by the same thread.
+	void read_lock() const { map_rwlock.read_lock(); }
+	void read_unlock() const { map_rwlock.read_unlock(); }
+
+	void pin_path_query() { path_query_pins.increment(); }
+	uint32_t unpin_path_query() { return path_query_pins.decrement(); }
+	uint32_t get_path_query_pins() const { return path_query_pins.get(); }
+
+	Vector<Vector3> get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, bool p_hierarchical = false) const;
+	/// Same as get_path() for a caller that already holds the read lock, see read_lock().
+	Vector<Vector3> get_path_read_locked(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, bool p_hierarchical = false) const;
 	Vector3 get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const;
 	Vector3 get_closest_point(const Vector3 &p_point) const;
 	Vector3 get_closest_point_normal(const Vector3 &p_point) const;
@@ -238,6 +315,10 @@ private:
 	void _update_rvo_agents_tree_3d();
 
 	void _update_merge_rasterizer_cell_dimensions();
+
+	void _update_region_sync_data(NavRegion *p_region, RegionSyncData &r_data);
+	void _sync_regions_incremental(const LocalVector<NavRegion *> &p_changed_regions, int &r_edge_count, int &r_edge_merge_count, int &r_edge_connection_count, int &r_edge_free_count);
+	void _build_cluster_graph(uint32_t p_link_polygon_count);
 };
 
 #endif // NAV_MAP_H
@@ -31,6 +31,7 @@
 #ifndef NAV_UTILS_H
 #define NAV_UTILS_H
 
+#include "core/math/dynamic_bvh.h"
 #include "core/math/vector3.h"
 #include "core/templates/hash_map.h"
 #include "core/templates/hashfuncs.h"
@@ -113,6 +114,100 @@ struct Polygon {
 	real_t surface_area = 0.0;
 };
 
+/// Bounding volume hierarchy of the polygons of a map, used to accelerate the spatial queries.
+/// The leaves store the index of their polygon in the map polygons.
+struct PolygonsBVH {
+	DynamicBVH bvh;
+
+	/// Bounds of all the polygons.
+	AABB bounds;
+
+	/// Average size of the polygons, used as starting radius for closest searches.
+	real_t average_polygon_size = 0.0;
+
+	/// Sum of the sizes of the polygons in the hierarchy and their count, used to keep the average up to date.
+	real_t polygon_size_sum = 0.0;
+	uint32_t polygon_count = 0;
+
+	struct QueryResult {
+		LocalVector<uint32_t> *polygons = nullptr;
+
+		bool operator()(void *p_data) {
+			polygons->push_back(uint32_t(uintptr_t(p_data)));
+			return false;
+		}
+	};
+
+	bool is_empty() const {
+		return bvh.is_empty();
+	}
+
+	void clear() {
+		bvh.clear();
+		bounds = AABB();
+		average_polygon_size = 0.0;
+		polygon_size_sum = 0.0;
+		polygon_count = 0;
+	}
+
+	/// Inserts the polygons of the range, returns the sum of their sizes.
+	/// The ids of the new leaves are added to `r_ids` when it is not null, to remove them later.
+	real_t insert_polygons(const LocalVector<Polygon> &p_polygons, uint32_t p_offset, uint32_t p_count, LocalVector<DynamicBVH::ID> *r_ids) {
+		real_t size_sum = 0.0;
+		for (uint32_t polygon_index = p_offset; polygon_index < p_offset + p_count; polygon_index++) {
+			const Polygon &polygon = p_polygons[polygon_index];
+			// Polygons without faces are never returned by the queries.
+			if (polygon.points.size() < 3) {
+				continue;
+			}
+
+			AABB polygon_aabb(polygon.points[0].pos, Vector3());
+			for (uint32_t i = 1; i < polygon.points.size(); i++) {
+				polygon_aabb.expand_to(polygon.points[i].pos);
+			}
+			const DynamicBVH::ID id = bvh.insert(polygon_aabb, (void *)uintptr_t(polygon_index));
+			if (r_ids) {
+				r_ids->push_back(id);
+			}
+
+			bounds = polygon_count == 0 ? polygon_aabb : bounds.merge(polygon_aabb);
+			size_sum += polygon_aabb.get_longest_axis_size();
+			polygon_count++;
+		}
+		polygon_size_sum += size_sum;
+		_update_average_polygon_size();
+		return size_sum;
+	}
+
+	/// Removes leaves added by `insert_polygons()`.
+	/// The bounds are not shrunk, they need to be set by the caller when it knows them.
+	void remove_polygons(LocalVector<DynamicBVH::ID> &r_ids, real_t p_size_sum) {
+		for (const DynamicBVH::ID &id : r_ids) {
+			bvh.remove(id);
+		}
+		polygon_count -= r_ids.size();
+		polygon_size_sum = polygon_count > 0 ? MAX(polygon_size_sum - p_size_sum, real_t(0.0)) : real_t(0.0);
+		r_ids.clear();
+		_update_average_polygon_size();
+	}
+
+	void build(const LocalVector<Polygon> &p_polygons) {
+		clear();
+		insert_polygons(p_polygons, 0, p_polygons.size(), nullptr);
+	}
+
+	void query(const AABB &p_aabb, LocalVector<uint32_t> &r_polygons) const {
+		QueryResult result;
+		result.polygons = &r_polygons;
+		bvh.aabb_query(p_aabb, result);
+	}
+
+private:
+	void _update_average_polygon_size() {
+		average_polygon_size = polygon_count > 0 ? polygon_size_sum / polygon_count : real_t(0.0);
+	}
+};
+
 struct NavigationPoly {
 	/// This poly.
 	const Polygon *poly = nullptr;
@@ -169,6 +264,74 @@ struct NavPolyHeapIndexer {
 	}
 };
 
+/// Group of close polygons that belong to the same region or link.
+struct Cluster {
+	const NavBase *owner = nullptr;
+
+	/// Average center of the cluster polygons, used as waypoint of the coarse routes.
+	Vector3 position;
+
+	/// Clusters that can be entered from this cluster.
+	LocalVector<uint32_t> neighbors;
+};
+
+/// Abstract graph of polygon clusters, used to plan a coarse route before searching the polygons.
+struct ClusterGraph {
+	LocalVector<Cluster> clusters;
+
+	/// Cluster index of each polygon, indexed by the polygon id.
+	LocalVector<uint32_t> polygon_clusters;
+
+	bool is_empty() const {
+		return clusters.is_empty();
+	}
+
+	void clear() {
+		clusters.clear();
+		polygon_clusters.clear();
+	}
+};
+
+struct NavigationCluster {
+	/// Index in the heap of traversable clusters.
+	uint32_t traversable_cluster_index = UINT32_MAX;
+
+	bool visited = false;
+
+	/// Used to travel the route backwards.
+	int back_navigation_cluster_id = -1;
+
+	/// The distance traveled until now (g cost).
+	real_t traveled_distance = 0.0;
+	/// The distance to the destination (h cost).
+	real_t distance_to_destination = 0.0;
+
+	/// The total travel cost (f cost).
+	real_t total_travel_cost() const {
+		return traveled_distance + distance_to_destination;
+	}
+};
+
+struct NavClusterTravelCostGreaterThan {
+	// Returns `true` if the travel cost of `a` is higher than that of `b`.
+	bool operator()(const NavigationCluster *p_cluster_a, const NavigationCluster *p_cluster_b) const {
+		real_t f_cost_a = p_cluster_a->total_travel_cost();
+		real_t f_cost_b = p_cluster_b->total_travel_cost();
+
+		if (f_cost_a != f_cost_b) {
+			return f_cost_a > f_cost_b;
+		} else {
+			return p_cluster_a->distance_to_destination > p_cluster_b->distance_to_destination;
+		}
+	}
+};
+
+struct NavClusterHeapIndexer {
+	void operator()(NavigationCluster *p_cluster, uint32_t p_heap_index) const {
+		p_cluster->traversable_cluster_index = p_heap_index;
+	}
+};
+
 struct ClosestPointQueryResult {
 	Vector3 point;
 	Vector3 normal;
@@ -30,6 +30,9 @@
 
 #include "tween.h"
 
+#include "core/config/engine.h"
+#include "core/object/script_language.h"
+#include "core/variant/variant_internal.h"
 #include "scene/animation/easing_equations.h"
 #include "scene/main/node.h"
 #include "scene/resources/animation.h"
@@ -502,6 +505,43 @@ Tween::Tween(bool p_valid) {
 	valid = p_valid;
 }
 
+// Same as Tween::interpolate_variant() for the most commonly tweened types,
+// without the Variant arithmetic. Returns false for the other types.
+static bool _interpolate_typed(const Variant &p_initial_val, const Variant &p_delta_val, double p_time, double p_duration, Tween::TransitionType p_trans, Tween::EaseType p_ease, Variant &r_value) {
+	if (p_initial_val.get_type() != p_delta_val.get_type() || (uint32_t)p_trans >= Tween::TRANS_MAX || (uint32_t)p_ease >= Tween::EASE_MAX) {
+		return false;
+	}
+
+	const float weight = Tween::run_equation(p_trans, p_ease, p_time, 0.0, 1.0, p_duration);
+
+	switch (p_initial_val.get_type()) {
+		case Variant::FLOAT: {
+			const double initial = *VariantInternal::get_float(&p_initial_val);
+			r_value = Math::lerp(initial, initial + *VariantInternal::get_float(&p_delta_val), (double)weight);
+		} break;
+		case Variant::VECTOR2: {
+			const Vector2 &initial = *VariantInternal::get_vector2(&p_initial_val);
+			r_value = initial.lerp(initial + *VariantInternal::get_vector2(&p_delta_val), weight);
+		} break;
+		case Variant::VECTOR3: {
+			const Vector3 &initial = *VariantInternal::get_vector3(&p_initial_val);
+			r_value = initial.lerp(initial + *VariantInternal::get_vector3(&p_delta_val), weight);
+		} break;
+		case Variant::VECTOR4: {
+			const Vector4 &initial = *VariantInternal::get_vector4(&p_initial_val);
+			r_value = initial.lerp(initial + *VariantInternal::get_vector4(&p_delta_val), weight);
+		} break;
+		case Variant::COLOR: {
+			const Color &initial = *VariantInternal::get_color(&p_initial_val);
+			r_value = initial.lerp(initial + *VariantInternal::get_color(&p_delta_val), weight);
+		} break;
+		default: {
+			return false;
+		}
+	}
+	return true;
+}
+
 Ref<PropertyTweener> PropertyTweener::from(const Variant &p_value) {
 	Ref<Tween> tween = _get_tween();
 	ERR_FAIL_COND_V(tween.is_null(), nullptr);
@@ -569,6 +609,8 @@ void PropertyTweener::start() {
 	}
 
 	delta_val = Animation::subtract_variant(final_val, initial_val);
+
+	_resolve_setter(target_instance);
 }
 
 bool PropertyTweener::step(double &r_delta) {
@@ -593,12 +635,10 @@ bool PropertyTweener::step(double &r_delta) {
 		do_continue_delayed = false;
 	}
 
-	Ref<Tween> tween = _get_tween();
-
 	double time = MIN(elapsed_time - delay, duration);
 	if (time < duration) {
 		if (custom_method.is_valid()) {
-			const Variant t = tween->interpolate_variant(0.0, 1.0, time, duration, trans_type, ease_type);
+			const Variant t = Tween::interpolate_variant(0.0, 1.0, time, duration, trans_type, ease_type);
 			const Variant *argptr = &t;
 
 			Variant result;
@@ -610,20 +650,107 @@ bool PropertyTweener::step(double &r_delta) {
 				ERR_FAIL_V_MSG(false, vformat("Wrong return type in PropertyTweener custom method. Expected float, got %s.", Variant::get_type_name(result.get_type())));
 			}
 
-			target_instance->set_indexed(property, Animation::interpolate_variant(initial_val, final_val, result));
+			_set_value(target_instance, Animation::interpolate_variant(initial_val, final_val, result));
 		} else {
-			target_instance->set_indexed(property, tween->interpolate_variant(initial_val, delta_val, time, duration, trans_type, ease_type));
+			Variant value;
+			if (!_interpolate_typed(initial_val, delta_val, time, duration, trans_type, ease_type, value)) {
+				value = Tween::interpolate_variant(initial_val, delta_val, time, duration, trans_type, ease_type);
+			}
+			_set_value(target_instance, value);
 		}
 		r_delta = 0;
 		return true;
 	} else {
-		target_instance->set_indexed(property, final_val);
+		_set_value(target_instance, final_val);
 		r_delta = elapsed_time - delay - duration;
 		_finish();
 		return false;
 	}
 }
 
+void PropertyTweener::_resolve_setter(Object *p_target) {
+	setter = nullptr;
+	setter_args.clear();
+
+	if (property.size() != 1) {
+		return;
+	}
+	// Extension instances can intercept the property in their own set().
+	const ClassDB::APIType api = ClassDB::get_api_type(p_target->get_class_name());
+	if (api == ClassDB::API_EXTENSION || api == ClassDB::API_EDITOR_EXTENSION) {
+		return;
+	}
+#ifdef TOOLS_ENABLED
+	if (Engine::get_singleton()->is_editor_hint()) {
+		// Object::set() also flags the object as edited.
+		return;
+	}
+#endif
+
+	// Scripts can intercept the property, either with a member or _set().
+	ScriptInstance *script_instance = p_target->get_script_instance();
+	if (script_instance) {
+		bool is_script_property = false;
+		script_instance->get_property_type(property[0], &is_script_property);
+		if (is_script_property || script_instance->has_method(SNAME("_set"))) {
+			return;
+		}
+	}
+
+	int index = -1;
+	MethodBind *method = ClassDB::get_property_setter_method(p_target->get_class_name(), property[0], &index);
+	if (!method || method->is_vararg() || method->has_return()) {
+		return;
+	}
+
+	const uint32_t value_arg = index >= 0 ? 1 : 0;
+	const int argument_count = method->get_argument_count();
+	if (argument_count <= (int)value_arg || (index >= 0 && method->get_argument_type(0) != Variant::INT)) {
+		return;
+	}
+
+	const Variant::Type value_type = method->get_argument_type(value_arg);
+	if (value_type != Variant::NIL && value_type != final_val.get_type()) {
+		return;
+	}
+
+	setter_args.resize(argument_count);
+	if (index >= 0) {
+		setter_args[0] = index;
+	}
+	// Validated calls don't fill in default arguments.
+	for (int i = value_arg + 1; i < argument_count; i++) {
+		if (!bool(method->has_default_argument(i))) {
+			setter_args.clear();
+			return;
+		}
+		const Variant default_value = method->get_default_argument(i);
+		const Variant::Type type = method->get_argument_type(i);
+		if (type != Variant::NIL && type != default_value.get_type()) {
+			setter_args.clear();
+			return;
+		}
+		setter_args[i] = default_value;
+	}
+
+	setter = method;
+	setter_script_instance = script_instance;
+	setter_type = value_type;
+	setter_value_arg = value_arg;
+}
+
+void PropertyTweener::_set_value(Object *p_target, const Variant &p_value) {
+	if (setter && p_target->get_script_instance() == setter_script_instance && (setter_type == Variant::NIL || setter_type == p_value.get_type())) {
+		const Variant **args = (const Variant **)alloca(sizeof(Variant *) * setter_args.size());
+		for (uint32_t i = 0; i < setter_args.size(); i++) {
+			args[i] = i == setter_value_arg ? &p_value : &setter_args[i];
+		}
+		setter->validated_call(p_target, args, nullptr);
+	} else {
+		p_target->set_indexed(property, p_value);
+	}
+}
+
 void PropertyTweener::set_tween(const Ref<Tween> &p_tween) {
 	Tweener::set_tween(p_tween);
 	if (trans_type == Tween::TRANS_MAX) {
@@ -32,9 +32,12 @@
 #define TWEEN_H
 
 #include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
 
-class Tween;
+class MethodBind;
 class Node;
+class ScriptInstance;
+class Tween;
 
 class Tweener : public RefCounted {
 	GDCLASS(Tweener, RefCounted);
@@ -232,6 +235,16 @@ private:
 	bool do_continue = true;
 	bool do_continue_delayed = false;
 	bool relative = false;
+
+	// Setter resolved in start(), called directly instead of going through Object::set_indexed().
+	MethodBind *setter = nullptr;
+	ScriptInstance *setter_script_instance = nullptr;
+	Variant::Type setter_type = Variant::NIL;
+	uint32_t setter_value_arg = 0;
+	LocalVector<Variant> setter_args;
+
+	void _resolve_setter(Object *p_target);
+	void _set_value(Object *p_target, const Variant &p_value);
 };
 
 class IntervalTweener : public Tweener {
@@ -78,14 +78,21 @@ void SceneTreeTimer::_bind_methods() {
 
 void SceneTreeTimer::set_time_left(double p_time) {
 	time_left = p_time;
+	if (queue_entry.is_active()) {
+		queue_entry.get_queue()->start(&queue_entry, queue_entry.get_clock(), p_time);
+	}
 }
 
 double SceneTreeTimer::get_time_left() const {
+	if (queue_entry.is_active()) {
+		return MAX(queue_entry.get_queue()->get_time_left(&queue_entry), 0.0);
+	}
 	return MAX(time_left, 0.0);
 }
 
 void SceneTreeTimer::set_process_always(bool p_process_always) {
 	process_always = p_process_always;
+	_update_clock();
 }
 
 bool SceneTreeTimer::is_process_always() {
@@ -94,6 +101,7 @@ bool SceneTreeTimer::is_process_always() {
 
 void SceneTreeTimer::set_process_in_physics(bool p_process_in_physics) {
 	process_in_physics = p_process_in_physics;
+	_update_clock();
 }
 
 bool SceneTreeTimer::is_process_in_physics() {
@@ -102,6 +110,7 @@ bool SceneTreeTimer::is_process_in_physics() {
 
 void SceneTreeTimer::set_ignore_time_scale(bool p_ignore) {
 	ignore_time_scale = p_ignore;
+	_update_clock();
 }
 
 bool SceneTreeTimer::is_ignore_time_scale() {
@@ -117,7 +126,32 @@ void SceneTreeTimer::release_connections() {
 	}
 }
 
-SceneTreeTimer::SceneTreeTimer() {}
+uint32_t SceneTreeTimer::_get_clock() const {
+	return TimerQueue::get_clock(process_in_physics, ignore_time_scale, !process_always);
+}
+
+void SceneTreeTimer::_update_clock() {
+	if (queue_entry.is_active() && queue_entry.get_clock() != _get_clock()) {
+		TimerQueue *queue = queue_entry.get_queue();
+		queue->start(&queue_entry, _get_clock(), queue->get_time_left(&queue_entry));
+	}
+}
+
+void SceneTreeTimer::_timeout(Object *p_timer, double p_time_left) {
+	SceneTreeTimer *timer = static_cast<SceneTreeTimer *>(p_timer);
+	timer->time_left = p_time_left;
+	timer->emit_signal(SNAME("timeout"));
+
+	// Release the reference taken by SceneTree::create_timer().
+	if (timer->unreference()) {
+		memdelete(timer);
+	}
+}
+
+SceneTreeTimer::SceneTreeTimer() {
+	queue_entry.owner = this;
+	queue_entry.callback = &SceneTreeTimer::_timeout;
+}
 
 #ifndef _3D_DISABLED
 // This should be called once per physics tick, to make sure the transform previous and current
@@ -632,62 +666,55 @@ bool SceneTree::process(double p_time) {
 }
 
 void SceneTree::process_timers(double p_delta, bool p_physics_frame) {
-	_THREAD_SAFE_METHOD_
-	List<Ref<SceneTreeTimer>>::Element *L = timers.back(); //last element
+	const double unscaled_delta = Engine::get_singleton()->get_process_step();
 
-	for (List<Ref<SceneTreeTimer>>::Element *E = timers.front(); E;) {
-		List<Ref<SceneTreeTimer>>::Element *N = E->next();
-		if ((paused && !E->get()->is_process_always()) || (E->get()->is_process_in_physics() != p_physics_frame)) {
-			if (E == L) {
-				break; //break on last, so if new timers were added during list traversal, ignore them.
-			}
-			E = N;
+	for (uint32_t clock = 0; clock < TimerQueue::CLOCK_MAX; clock++) {
+		if (bool(clock & TimerQueue::CLOCK_PHYSICS) != p_physics_frame) {
 			continue;
 		}
-
-		double time_left = E->get()->get_time_left();
-		if (E->get()->is_ignore_time_scale()) {
-			time_left -= Engine::get_singleton()->get_process_step();
-		} else {
-			time_left -= p_delta;
-		}
-		E->get()->set_time_left(time_left);
-
-		if (time_left <= 0) {
-			E->get()->emit_signal(SNAME("timeout"));
-			timers.erase(E);
-		}
-		if (E == L) {
-			break; //break on last, so if new timers were added during list traversal, ignore them.
+		if (paused && (clock & TimerQueue::CLOCK_PAUSABLE)) {
+			continue;
 		}
-		E = N;
+		timer_queue.advance(clock, (clock & TimerQueue::CLOCK_IGNORE_TIME_SCALE) ? unscaled_delta : p_delta);
 	}
+
+	timer_queue.dispatch_expired();
 }
 
 void SceneTree::process_tweens(double p_delta, bool p_physics) {
 	_THREAD_SAFE_METHOD_
-	// This methods works similarly to how SceneTreeTimers are handled.
-	List<Ref<Tween>>::Element *L = tweens.back();
+	// Tweens created during the traversal are only processed from the next frame.
+	const uint32_t count = tweens.size();
+	bool removed = false;
 
-	for (List<Ref<Tween>>::Element *E = tweens.front(); E;) {
-		List<Ref<Tween>>::Element *N = E->next();
+	for (uint32_t i = 0; i < count; i++) {
+		// The vector can grow while stepping, don't hold references into it.
+		Tween *tween = tweens[i].ptr();
 		// Don't process if paused or process mode doesn't match.
-		if (!E->get()->can_process(paused) || (p_physics == (E->get()->get_process_mode() == Tween::TWEEN_PROCESS_IDLE))) {
-			if (E == L) {
-				break;
-			}
-			E = N;
+		if (!tween->can_process(paused) || (p_physics == (tween->get_process_mode() == Tween::TWEEN_PROCESS_IDLE))) {
 			continue;
 		}
 
-		if (!E->get()->step(p_delta)) {
-			E->get()->clear();
-			tweens.erase(E);
+		if (!tween->step(p_delta)) {
+			tween->clear();
+			tweens[i].unref();
+			removed = true;
 		}
-		if (E == L) {
-			break;
+	}
+
+	if (removed) {
+		// Compact while keeping the creation order.
+		uint32_t to = 0;
+		for (uint32_t from = 0; from < tweens.size(); from++) {
+			if (tweens[from].is_null()) {
+				continue;
+			}
+			if (to != from) {
+				tweens[to] = tweens[from];
+			}
+			to++;
 		}
-		E = N;
+		tweens.resize(to);
 	}
 }
 
@@ -710,10 +737,17 @@ void SceneTree::finalize() {
 	MainLoop::finalize();
 
 	// Cleanup timers.
-	for (Ref<SceneTreeTimer> &timer : timers) {
+	LocalVector<Object *> active_timers;
+	timer_queue.stop_all(active_timers);
+	for (Object *owner : active_timers) {
+		// Timer nodes stop when they exit the tree, only SceneTreeTimers can remain.
+		SceneTreeTimer *timer = Object::cast_to<SceneTreeTimer>(owner);
+		ERR_CONTINUE(!timer);
 		timer->release_connections();
+		if (timer->unreference()) {
+			memdelete(timer);
+		}
 	}
-	timers.clear();
 
 	// Cleanup tweens.
 	for (Ref<Tween> &tween : tweens) {
@@ -1538,7 +1572,9 @@ Ref<SceneTreeTimer> SceneTree::create_timer(double p_delay_sec, bool p_process_a
 	stt->set_time_left(p_delay_sec);
 	stt->set_process_in_physics(p_process_in_physics);
 	stt->set_ignore_time_scale(p_ignore_time_scale);
-	timers.push_back(stt);
+	// Kept alive by the queue until it times out.
+	stt->reference();
+	timer_queue.start(&stt->queue_entry, stt->_get_clock(), p_delay_sec);
 	return stt;
 }
 
@@ -1556,9 +1592,13 @@ TypedArray<Tween> SceneTree::get_processed_tweens() {
 
 	int i = 0;
 	for (const Ref<Tween> &tween : tweens) {
-		ret[i] = tween;
-		i++;
+		// Null while a finished Tween waits to be compacted in process_tweens().
+		if (tween.is_valid()) {
+			ret[i] = tween;
+			i++;
+		}
 	}
+	ret.resize(i);
 
 	return ret;
 }
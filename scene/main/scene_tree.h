@@ -35,6 +35,7 @@
 #include "core/os/thread_safe.h"
 #include "core/templates/paged_allocator.h"
 #include "core/templates/self_list.h"
+#include "scene/main/timer_queue.h"
 #include "scene/resources/mesh.h"
 
 #undef Window
@@ -60,6 +61,14 @@ class SceneTreeTimer : public RefCounted {
 	bool process_in_physics = false;
 	bool ignore_time_scale = false;
 
+	TimerQueue::Entry queue_entry;
+
+	uint32_t _get_clock() const;
+	void _update_clock();
+	static void _timeout(Object *p_timer, double p_time_left);
+
+	friend class SceneTree;
+
 protected:
 	static void _bind_methods();
 
@@ -201,8 +210,8 @@ private:
 
 	void _flush_scene_change();
 
-	List<Ref<SceneTreeTimer>> timers;
-	List<Ref<Tween>> tweens;
+	TimerQueue timer_queue;
+	LocalVector<Ref<Tween>> tweens;
 
 	///network///
 
@@ -341,6 +350,8 @@ public:
 	_FORCE_INLINE_ double get_physics_process_time() const { return physics_process_time; }
 	_FORCE_INLINE_ double get_process_time() const { return process_time; }
 
+	_FORCE_INLINE_ TimerQueue *get_timer_queue() { return &timer_queue; }
+
 	void set_pause(bool p_enabled);
 	bool is_paused() const;
 
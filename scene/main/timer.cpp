@@ -30,6 +30,8 @@
 
 #include "timer.h"
 
+#include "scene/main/scene_tree.h"
+
 void Timer::_notification(int p_what) {
 	switch (p_what) {
 		case NOTIFICATION_READY: {
@@ -44,39 +46,32 @@ void Timer::_notification(int p_what) {
 			}
 		} break;
 
-		case NOTIFICATION_INTERNAL_PROCESS: {
-			if (!processing || timer_process_callback == TIMER_PROCESS_PHYSICS || !is_processing_internal()) {
-				return;
-			}
-			time_left -= get_process_delta_time();
-
-			if (time_left < 0) {
-				if (!one_shot) {
-					time_left += wait_time;
-				} else {
-					stop();
-				}
+		case NOTIFICATION_ENTER_TREE:
+		case NOTIFICATION_PAUSED:
+		case NOTIFICATION_UNPAUSED: {
+			_update_queue();
+		} break;
 
-				emit_signal(SNAME("timeout"));
+		case NOTIFICATION_EXIT_TREE: {
+			if (queue_entry.is_active()) {
+				time_left = queue_entry.get_queue()->stop(&queue_entry);
 			}
 		} break;
+	}
+}
 
-		case NOTIFICATION_INTERNAL_PHYSICS_PROCESS: {
-			if (!processing || timer_process_callback == TIMER_PROCESS_IDLE || !is_physics_processing_internal()) {
-				return;
-			}
-			time_left -= get_physics_process_delta_time();
+void Timer::_timeout(Object *p_timer, double p_time_left) {
+	Timer *timer = static_cast<Timer *>(p_timer);
+	timer->time_left = p_time_left;
 
-			if (time_left < 0) {
-				if (!one_shot) {
-					time_left += wait_time;
-				} else {
-					stop();
-				}
-				emit_signal(SNAME("timeout"));
-			}
-		} break;
+	if (!timer->one_shot) {
+		timer->time_left += timer->wait_time;
+		timer->_update_queue();
+	} else {
+		timer->stop();
 	}
+
+	timer->emit_signal(SNAME("timeout"));
 }
 
 void Timer::set_wait_time(double p_time) {
@@ -112,10 +107,17 @@ void Timer::start(double p_time) {
 		set_wait_time(p_time);
 	}
 	time_left = wait_time;
+	if (queue_entry.is_active()) {
+		// Restart with the full wait time.
+		queue_entry.get_queue()->stop(&queue_entry);
+	}
 	_set_process(true);
 }
 
 void Timer::stop() {
+	if (queue_entry.is_active()) {
+		queue_entry.get_queue()->stop(&queue_entry);
+	}
 	time_left = -1;
 	_set_process(false);
 	autostart = false;
@@ -139,7 +141,8 @@ bool Timer::is_stopped() const {
 }
 
 double Timer::get_time_left() const {
-	return time_left > 0 ? time_left : 0;
+	double left = queue_entry.is_active() ? queue_entry.get_queue()->get_time_left(&queue_entry) : time_left;
+	return left > 0 ? left : 0;
 }
 
 void Timer::set_timer_process_callback(TimerProcessCallback p_callback) {
@@ -147,37 +150,35 @@ void Timer::set_timer_process_callback(TimerProcessCallback p_callback) {
 		return;
 	}
 
-	switch (timer_process_callback) {
-		case TIMER_PROCESS_PHYSICS:
-			if (is_physics_processing_internal()) {
-				set_physics_process_internal(false);
-				set_process_internal(true);
-			}
-			break;
-		case TIMER_PROCESS_IDLE:
-			if (is_processing_internal()) {
-				set_process_internal(false);
-				set_physics_process_internal(true);
-			}
-			break;
-	}
 	timer_process_callback = p_callback;
+	_update_queue();
 }
 
 Timer::TimerProcessCallback Timer::get_timer_process_callback() const {
 	return timer_process_callback;
 }
 
-void Timer::_set_process(bool p_process, bool p_force) {
-	switch (timer_process_callback) {
-		case TIMER_PROCESS_PHYSICS:
-			set_physics_process_internal(p_process && !paused);
-			break;
-		case TIMER_PROCESS_IDLE:
-			set_process_internal(p_process && !paused);
-			break;
-	}
+void Timer::_set_process(bool p_process) {
 	processing = p_process;
+	_update_queue();
+}
+
+// Timers don't use internal processing, they wait in the SceneTree timer
+// queue while they run, are not paused and their node can process.
+void Timer::_update_queue() {
+	bool run = processing && !paused && is_inside_tree() && can_process();
+	uint32_t clock = TimerQueue::get_clock(timer_process_callback == TIMER_PROCESS_PHYSICS, false, false);
+
+	if (queue_entry.is_active()) {
+		if (run && queue_entry.get_clock() == clock) {
+			return;
+		}
+		time_left = queue_entry.get_queue()->stop(&queue_entry);
+	}
+
+	if (run) {
+		get_tree()->get_timer_queue()->start(&queue_entry, clock, time_left);
+	}
 }
 
 PackedStringArray Timer::get_configuration_warnings() const {
@@ -226,4 +227,7 @@ void Timer::_bind_methods() {
 	BIND_ENUM_CONSTANT(TIMER_PROCESS_IDLE);
 }
 
-Timer::Timer() {}
+Timer::Timer() {
+	queue_entry.owner = this;
+	queue_entry.callback = &Timer::_timeout;
+}
@@ -32,6 +32,7 @@
 #define TIMER_H
 
 #include "scene/main/node.h"
+#include "scene/main/timer_queue.h"
 
 class Timer : public Node {
 	GDCLASS(Timer, Node);
@@ -44,6 +45,10 @@ class Timer : public Node {
 
 	double time_left = -1.0;
 
+	TimerQueue::Entry queue_entry;
+
+	static void _timeout(Object *p_timer, double p_time_left);
+
 protected:
 	void _notification(int p_what);
 	static void _bind_methods();
@@ -81,7 +86,8 @@ public:
 
 private:
 	TimerProcessCallback timer_process_callback = TIMER_PROCESS_IDLE;
-	void _set_process(bool p_process, bool p_force = false);
+	void _set_process(bool p_process);
+	void _update_queue();
 };
 
 VARIANT_ENUM_CAST(Timer::TimerProcessCallback);
@@ -0,0 +1,229 @@
+/**************************************************************************/
+/*  timer_queue.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "timer_queue.h"
+
+#include "core/error/error_macros.h"
+
+void TimerQueue::_sift_up(LocalVector<Entry *> &p_heap, uint32_t p_index) {
+	Entry *entry = p_heap[p_index];
+	while (p_index > 0) {
+		uint32_t parent = (p_index - 1) / 2;
+		if (!_is_before(entry, p_heap[parent])) {
+			break;
+		}
+		p_heap[p_index] = p_heap[parent];
+		p_heap[p_index]->index = p_index;
+		p_index = parent;
+	}
+	p_heap[p_index] = entry;
+	entry->index = p_index;
+}
+
+void TimerQueue::_sift_down(LocalVector<Entry *> &p_heap, uint32_t p_index) {
+	Entry *entry = p_heap[p_index];
+	const uint32_t size = p_heap.size();
+	while (true) {
+		uint32_t child = p_index * 2 + 1;
+		if (child >= size) {
+			break;
+		}
+		if (child + 1 < size && _is_before(p_heap[child + 1], p_heap[child])) {
+			child++;
+		}
+		if (!_is_before(p_heap[child], entry)) {
+			break;
+		}
+		p_heap[p_index] = p_heap[child];
+		p_heap[p_index]->index = p_index;
+		p_index = child;
+	}
+	p_heap[p_index] = entry;
+	entry->index = p_index;
+}
+
+void TimerQueue::_heap_remove(Entry *p_entry) {
+	LocalVector<Entry *> &heap = heaps[p_entry->clock];
+	uint32_t index = p_entry->index;
+	Entry *last = heap[heap.size() - 1];
+	heap.resize(heap.size() - 1);
+	if (last != p_entry) {
+		heap[index] = last;
+		last->index = index;
+		if (index > 0 && _is_before(last, heap[(index - 1) / 2])) {
+			_sift_up(heap, index);
+		} else {
+			_sift_down(heap, index);
+		}
+	}
+}
+
+double TimerQueue::_stop(Entry *p_entry) {
+	if (p_entry->index >= 0) {
+		_heap_remove(p_entry);
+	} else if (p_entry->index <= EXPIRED) {
+		// Expired but not dispatched yet, make sure it is skipped.
+		expired[EXPIRED - p_entry->index] = nullptr;
+	}
+	p_entry->index = INACTIVE;
+	p_entry->queue = nullptr;
+	return p_entry->deadline - clock_time[p_entry->clock];
+}
+
+void TimerQueue::start(Entry *p_entry, uint32_t p_clock, double p_time_left) {
+	ERR_FAIL_NULL(p_entry);
+	ERR_FAIL_UNSIGNED_INDEX(p_clock, (uint32_t)CLOCK_MAX);
+	ERR_FAIL_COND_MSG(p_entry->queue != nullptr && p_entry->queue != this, "Timer is already active in another TimerQueue.");
+
+	MutexLock lock(mutex);
+
+	if (p_entry->queue == this) {
+		_stop(p_entry);
+	} else {
+		p_entry->order = ++last_order;
+	}
+
+	p_entry->queue = this;
+	p_entry->clock = p_clock;
+	p_entry->deadline = clock_time[p_clock] + p_time_left;
+
+	LocalVector<Entry *> &heap = heaps[p_clock];
+	heap.push_back(p_entry);
+	_sift_up(heap, heap.size() - 1);
+}
+
+double TimerQueue::stop(Entry *p_entry) {
+	ERR_FAIL_NULL_V(p_entry, 0.0);
+	ERR_FAIL_COND_V(p_entry->queue != this, 0.0);
+
+	MutexLock lock(mutex);
+	return _stop(p_entry);
+}
+
+double TimerQueue::get_time_left(const Entry *p_entry) const {
+	ERR_FAIL_NULL_V(p_entry, 0.0);
+	ERR_FAIL_COND_V(p_entry->queue != this, 0.0);
+
+	MutexLock lock(mutex);
+	return p_entry->deadline - clock_time[p_entry->clock];
+}
+
+void TimerQueue::advance(uint32_t p_clock, double p_delta) {
+	ERR_FAIL_UNSIGNED_INDEX(p_clock, (uint32_t)CLOCK_MAX);
+
+	MutexLock lock(mutex);
+
+	double now = clock_time[p_clock] + p_delta;
+	clock_time[p_clock] = now;
+
+	LocalVector<Entry *> &heap = heaps[p_clock];
+	while (!heap.is_empty() && heap[0]->deadline <= now) {
+		Entry *entry = heap[0];
+		_heap_remove(entry);
+		entry->index = EXPIRED - (int32_t)expired.size();
+		expired.push_back(entry);
+	}
+}
+
+void TimerQueue::dispatch_expired() {
+	MutexLock lock(mutex);
+
+	if (expired.is_empty()) {
+		return;
+	}
+	ERR_FAIL_COND_MSG(dispatching, "Timers can't be dispatched from a timeout callback.");
+	dispatching = true;
+
+	// Clocks are advanced one after another, restore the order in which
+	// timers were started so that timeouts fire in a predictable sequence.
+	if (expired.size() > 1) {
+		expired.sort_custom<OrderComparator>();
+		for (uint32_t i = 0; i < expired.size(); i++) {
+			expired[i]->index = EXPIRED - (int32_t)i;
+		}
+	}
+
+	for (uint32_t i = 0; i < expired.size(); i++) {
+		Entry *entry = expired[i];
+		if (!entry) {
+			// Stopped by an earlier callback.
+			continue;
+		}
+		double time_left = _stop(entry);
+
+		lock.temp_unlock();
+		entry->callback(entry->owner, time_left);
+		lock.temp_relock();
+	}
+
+	expired.clear();
+	dispatching = false;
+}
+
+void TimerQueue::stop_all(LocalVector<Object *> &r_owners) {
+	MutexLock lock(mutex);
+
+	for (Entry *entry : expired) {
+		if (entry) {
+			r_owners.push_back(entry->owner);
+			entry->index = INACTIVE;
+			entry->queue = nullptr;
+		}
+	}
+	expired.clear();
+
+	for (uint32_t i = 0; i < CLOCK_MAX; i++) {
+		for (Entry *entry : heaps[i]) {
+			r_owners.push_back(entry->owner);
+			entry->index = INACTIVE;
+			entry->queue = nullptr;
+		}
+		heaps[i].clear();
+	}
+}
+
+uint32_t TimerQueue::get_active_count() const {
+	MutexLock lock(mutex);
+
+	uint32_t count = 0;
+	for (const Entry *entry : expired) {
+		if (entry) {
+			count++;
+		}
+	}
+	for (uint32_t i = 0; i < CLOCK_MAX; i++) {
+		count += heaps[i].size();
+	}
+	return count;
+}
+
+TimerQueue::~TimerQueue() {
+	ERR_FAIL_COND_MSG(get_active_count() > 0, "TimerQueue destroyed with timers still active.");
+}
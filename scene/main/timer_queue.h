@@ -0,0 +1,129 @@
+/**************************************************************************/
+/*  timer_queue.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TIMER_QUEUE_H
+#define TIMER_QUEUE_H
+
+#include "core/os/mutex.h"
+#include "core/templates/local_vector.h"
+
+class Object;
+
+// Schedules timeouts for SceneTreeTimer and Timer.
+// Every clock keeps its own elapsed time and a binary min-heap of deadlines,
+// so advancing a clock is O(1) and the per-frame cost only grows with the
+// number of timers that actually expire, instead of with every live timer.
+class TimerQueue {
+public:
+	enum ClockFlags {
+		CLOCK_PHYSICS = 1, // Advanced on physics frames instead of process frames.
+		CLOCK_IGNORE_TIME_SCALE = 2, // Advanced by the unscaled process step.
+		CLOCK_PAUSABLE = 4, // Not advanced while the SceneTree is paused.
+		CLOCK_MAX = 8,
+	};
+
+	// Called with the owner of the entry once its deadline is reached.
+	// The entry is already inactive, so the callback may start it again.
+	// `p_time_left` is zero or negative, how much the deadline was overshot.
+	typedef void (*TimeoutCallback)(Object *p_owner, double p_time_left);
+
+	struct Entry {
+		Object *owner = nullptr;
+		TimeoutCallback callback = nullptr;
+
+	private:
+		friend class TimerQueue;
+
+		TimerQueue *queue = nullptr;
+		double deadline = 0.0;
+		uint64_t order = 0;
+		int32_t index = INACTIVE;
+		uint32_t clock = 0;
+
+	public:
+		_FORCE_INLINE_ bool is_active() const { return queue != nullptr; }
+		_FORCE_INLINE_ TimerQueue *get_queue() const { return queue; }
+		_FORCE_INLINE_ uint32_t get_clock() const { return clock; }
+	};
+
+private:
+	// Entry::index is the position in the heap of its clock when >= 0, and
+	// encodes the position in `expired` when <= EXPIRED.
+	static constexpr int32_t INACTIVE = -1;
+	static constexpr int32_t EXPIRED = -2;
+
+	struct OrderComparator {
+		_FORCE_INLINE_ bool operator()(const Entry *p_a, const Entry *p_b) const { return p_a->order < p_b->order; }
+	};
+
+	mutable BinaryMutex mutex;
+	double clock_time[CLOCK_MAX] = {};
+	LocalVector<Entry *> heaps[CLOCK_MAX];
+	LocalVector<Entry *> expired;
+	uint64_t last_order = 0;
+	bool dispatching = false;
+
+	_FORCE_INLINE_ bool _is_before(const Entry *p_a, const Entry *p_b) const {
+		return p_a->deadline < p_b->deadline || (p_a->deadline == p_b->deadline && p_a->order < p_b->order);
+	}
+	void _sift_up(LocalVector<Entry *> &p_heap, uint32_t p_index);
+	void _sift_down(LocalVector<Entry *> &p_heap, uint32_t p_index);
+	void _heap_remove(Entry *p_entry);
+	double _stop(Entry *p_entry);
+
+public:
+	static _FORCE_INLINE_ uint32_t get_clock(bool p_physics, bool p_ignore_time_scale, bool p_pausable) {
+		return (p_physics ? CLOCK_PHYSICS : 0) | (p_ignore_time_scale ? CLOCK_IGNORE_TIME_SCALE : 0) | (p_pausable ? CLOCK_PAUSABLE : 0);
+	}
+
+	// Starts the entry so it times out after `p_time_left` on `p_clock`.
+	// If the entry is already active it is moved, keeping its original order
+	// relative to timers that expire on the same frame.
+	void start(Entry *p_entry, uint32_t p_clock, double p_time_left);
+	// Stops an active entry and returns the time it had left.
+	double stop(Entry *p_entry);
+	double get_time_left(const Entry *p_entry) const;
+
+	// Advances a clock, collecting the entries whose deadline is reached.
+	void advance(uint32_t p_clock, double p_delta);
+	// Runs the callbacks of the entries collected by advance(), in the order
+	// they were started. Entries started by those callbacks wait for the next
+	// advance() even if they are already due.
+	void dispatch_expired();
+
+	// Stops every entry and returns their owners.
+	void stop_all(LocalVector<Object *> &r_owners);
+
+	uint32_t get_active_count() const;
+
+	~TimerQueue();
+};
+
+#endif // TIMER_QUEUE_H
@@ -124,7 +124,93 @@ Ref<Resource> SceneState::get_remap_resource(const Ref<Resource> &p_resource, Ha
 	return remap_resource;
 }
 
+const SceneState::InstantiationPlan *SceneState::_get_instantiation_plan() const {
+	MutexLock lock(instantiation_plan_mutex);
+	if (instantiation_plan_built) {
+		return &instantiation_plan;
+	}
+
+	instantiation_plan.nodes.resize(nodes.size());
+	for (int i = 0; i < nodes.size(); i++) {
+		const NodeData &n = nodes[i];
+		// Only nodes this scene creates itself have a known class.
+		if (n.type == TYPE_INSTANTIATED || n.instance >= 0 || (i == 0 && base_scene_idx >= 0)) {
+			continue;
+		}
+		ERR_CONTINUE(n.type < 0 || n.type >= names.size());
+
+		const StringName &type = names[n.type];
+		if (!ClassDB::is_parent_class(type, Node::get_class_static())) {
+			continue;
+		}
+
+		InstantiationPlan::NodePlan &node_plan = instantiation_plan.nodes[i];
+		node_plan.creation_func = ClassDB::get_native_creation_func(type);
+		if (!node_plan.creation_func) {
+			// Extension classes handle their own properties, so they go through the regular path.
+			continue;
+		}
+
+		node_plan.properties.resize(n.properties.size());
+		for (int j = 0; j < n.properties.size(); j++) {
+			int name = n.properties[j].name;
+			if ((name & FLAG_PATH_PROPERTY_IS_NODE) || name < 0 || name >= names.size()) {
+				continue;
+			}
+
+			InstantiationPlan::PropertyPlan &property_plan = node_plan.properties[j];
+			property_plan.setter = ClassDB::get_property_setter_method(type, names[name], &property_plan.index);
+		}
+	}
+
+	instantiation_plan.connection_binds.resize(connections.size());
+	for (int i = 0; i < connections.size(); i++) {
+		const ConnectionData &c = connections[i];
+		if (c.unbinds > 0) {
+			continue;
+		}
+
+		Vector<Variant> &binds = instantiation_plan.connection_binds[i];
+		binds.resize(c.binds.size());
+		for (int j = 0; j < c.binds.size(); j++) {
+			ERR_CONTINUE(c.binds[j] < 0 || c.binds[j] >= variants.size());
+			binds.write[j] = variants[c.binds[j]];
+		}
+	}
+
+	instantiation_plan_built = true;
+	return &instantiation_plan;
+}
+
+void SceneState::_clear_instantiation_plan() {
+	MutexLock lock(instantiation_plan_mutex);
+	instantiation_plan.nodes.clear();
+	instantiation_plan.connection_binds.clear();
+	instantiation_plan_built = false;
+}
+
 Node *SceneState::instantiate(GenEditState p_edit_state) const {
+	// The editor needs every property to go through Object::set(), so it never uses the plan.
+	bool use_plan = p_edit_state == GEN_EDIT_STATE_DISABLED && !Engine::get_singleton()->is_editor_hint();
+	return _instantiate(p_edit_state, use_plan ? _get_instantiation_plan() : nullptr);
+}
+
+void SceneState::instantiate_multiple(int p_count, GenEditState p_edit_state, LocalVector<Node *> &r_nodes) const {
+	ERR_FAIL_COND(p_count < 0);
+
+	bool use_plan = p_edit_state == GEN_EDIT_STATE_DISABLED && !Engine::get_singleton()->is_editor_hint();
+	const InstantiationPlan *plan = use_plan ? _get_instantiation_plan() : nullptr;
+
+	r_nodes.reserve(r_nodes.size() + p_count);
+	for (int i = 0; i < p_count; i++) {
+		Node *node = _instantiate(p_edit_state, plan);
+		// The instances created so far stay valid, the caller owns them.
+		ERR_FAIL_NULL_MSG(node, vformat("Failed to instantiate scene state of \"%s\", only %d of %d instances were created.", path, i, p_count));
+		r_nodes.push_back(node);
+	}
+}
+
+Node *SceneState::_instantiate(GenEditState p_edit_state, const InstantiationPlan *p_plan) const {
 	// Nodes where instantiation failed (because something is missing.)
 	List<Node *> stray_instances;
 
@@ -191,6 +277,7 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 		Node *node = nullptr;
 		MissingNode *missing_node = nullptr;
 		bool is_inherited_scene = false;
+		const InstantiationPlan::NodePlan *node_plan = nullptr;
 
 		if (i == 0 && base_scene_idx >= 0) {
 			// Scene inheritance on root node.
@@ -257,7 +344,13 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 			}
 		} else {
 			// Node belongs to this scene and must be created.
-			Object *obj = ClassDB::instantiate(snames[n.type]);
+			Object *obj = nullptr;
+			if (p_plan && p_plan->nodes[i].creation_func) {
+				node_plan = &p_plan->nodes[i];
+				obj = node_plan->creation_func(true);
+			} else {
+				obj = ClassDB::instantiate(snames[n.type]);
+			}
 
 			node = Object::cast_to<Node>(obj);
 
@@ -411,7 +504,22 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 						}
 
 						if (set_valid) {
-							node->set(snames[nprops[j].name], value, &valid);
+							const InstantiationPlan::PropertyPlan *property_plan = node_plan ? &node_plan->properties[j] : nullptr;
+							if (property_plan && property_plan->setter && !node->get_script_instance()) {
+								// Same as what ClassDB::set_property() would end up calling, minus the lookup.
+								Callable::CallError ce;
+								if (property_plan->index >= 0) {
+									Variant index = property_plan->index;
+									const Variant *args[2] = { &index, &value };
+									property_plan->setter->call(node, args, 2, ce);
+								} else {
+									const Variant *args[1] = { &value };
+									property_plan->setter->call(node, args, 1, ce);
+								}
+								valid = ce.error == Callable::CallError::CALL_OK;
+							} else {
+								node->set(snames[nprops[j].name], value, &valid);
+							}
 						}
 						if (p_edit_state == GEN_EDIT_STATE_INSTANCE && value.get_type() != Variant::OBJECT) {
 							value = value.duplicate(true); // Duplicate arrays and dictionaries for the editor.
@@ -592,7 +700,9 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 			callable = callable.unbind(c.unbinds);
 		} else if (!c.binds.is_empty()) {
 			Vector<Variant> binds;
-			if (c.binds.size()) {
+			if (p_plan) {
+				binds = p_plan->connection_binds[i];
+			} else {
 				binds.resize(c.binds.size());
 				for (int j = 0; j < c.binds.size(); j++) {
 					binds.write[j] = props[c.binds[j]];
@@ -1302,6 +1412,7 @@ String SceneState::get_path() const {
 }
 
 void SceneState::clear() {
+	_clear_instantiation_plan();
 	names.clear();
 	variants.clear();
 	nodes.clear();
@@ -1500,6 +1611,8 @@ void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
 
 	ERR_FAIL_COND_MSG(version > PACKED_SCENE_VERSION, "Save format version too new.");
 
+	_clear_instantiation_plan();
+
 	const int node_count = p_dictionary["node_count"];
 	const Vector<int> snodes = p_dictionary["nodes"];
 	ERR_FAIL_COND(snodes.size() < node_count);
@@ -1984,6 +2097,7 @@ int SceneState::add_node(int p_parent, int p_owner, int p_type, int p_name, int
 	nd.instance = p_instance;
 	nd.index = p_index;
 
+	_clear_instantiation_plan();
 	nodes.push_back(nd);
 
 	return nodes.size() - 1;
@@ -2000,6 +2114,7 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value, bool p_d
 		prop.name |= FLAG_PATH_PROPERTY_IS_NODE;
 	}
 	prop.value = p_value;
+	_clear_instantiation_plan();
 	nodes.write[p_node].properties.push_back(prop);
 }
 
@@ -2011,6 +2126,7 @@ void SceneState::add_node_group(int p_node, int p_group) {
 
 void SceneState::set_base_scene(int p_idx) {
 	ERR_FAIL_INDEX(p_idx, variants.size());
+	_clear_instantiation_plan();
 	base_scene_idx = p_idx;
 }
 
@@ -2029,6 +2145,7 @@ void SceneState::add_connection(int p_from, int p_to, int p_signal, int p_method
 	c.flags = p_flags;
 	c.unbinds = p_unbinds;
 	c.binds = p_binds;
+	_clear_instantiation_plan();
 	connections.push_back(c);
 }
 
@@ -2055,6 +2172,7 @@ bool SceneState::rename_group_references(const StringName &p_old_name, const Str
 	for (const NodeData &node : nodes) {
 		for (const int &group : node.groups) {
 			if (names[group] == p_old_name) {
+				_clear_instantiation_plan();
 				names.write[group] = p_new_name;
 				edited = true;
 				break;
@@ -2173,17 +2291,40 @@ Node *PackedScene::instantiate(GenEditState p_edit_state) const {
 		return nullptr;
 	}
 
-	if (p_edit_state != GEN_EDIT_STATE_DISABLED) {
-		s->set_scene_instance_state(state);
+	_post_instantiate(s, p_edit_state != GEN_EDIT_STATE_DISABLED);
+
+	return s;
+}
+
+TypedArray<Node> PackedScene::instantiate_multiple(int p_count, GenEditState p_edit_state) const {
+#ifndef TOOLS_ENABLED
+	ERR_FAIL_COND_V_MSG(p_edit_state != GEN_EDIT_STATE_DISABLED, TypedArray<Node>(), "Edit state is only for editors, does not work without tools compiled.");
+#endif
+	ERR_FAIL_COND_V(p_count < 0, TypedArray<Node>());
+
+	LocalVector<Node *> nodes;
+	state->instantiate_multiple(p_count, (SceneState::GenEditState)p_edit_state, nodes);
+
+	TypedArray<Node> ret;
+	ret.resize(nodes.size());
+	for (uint32_t i = 0; i < nodes.size(); i++) {
+		_post_instantiate(nodes[i], p_edit_state != GEN_EDIT_STATE_DISABLED);
+		ret[i] = nodes[i];
 	}
 
-	if (!is_built_in()) {
-		s->set_scene_file_path(get_path());
+	return ret;
+}
+
+void PackedScene::_post_instantiate(Node *p_node, bool p_editable) const {
+	if (p_editable) {
+		p_node->set_scene_instance_state(state);
 	}
 
-	s->notification(Node::NOTIFICATION_SCENE_INSTANTIATED);
+	if (!is_built_in()) {
+		p_node->set_scene_file_path(get_path());
+	}
 
-	return s;
+	p_node->notification(Node::NOTIFICATION_SCENE_INSTANTIATED);
 }
 
 void PackedScene::replace_state(Ref<SceneState> p_by) {
@@ -2272,6 +2413,7 @@ void PackedScene::reset_state() {
 void PackedScene::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("pack", "path"), &PackedScene::pack);
 	ClassDB::bind_method(D_METHOD("instantiate", "edit_state"), &PackedScene::instantiate, DEFVAL(GEN_EDIT_STATE_DISABLED));
+	ClassDB::bind_method(D_METHOD("instantiate_multiple", "count", "edit_state"), &PackedScene::instantiate_multiple, DEFVAL(GEN_EDIT_STATE_DISABLED));
 	ClassDB::bind_method(D_METHOD("can_instantiate"), &PackedScene::can_instantiate);
 	ClassDB::bind_method(D_METHOD("_set_bundled_scene", "scene"), &PackedScene::_set_bundled_scene);
 	ClassDB::bind_method(D_METHOD("_get_bundled_scene"), &PackedScene::_get_bundled_scene);
@@ -89,6 +89,30 @@ class SceneState : public RefCounted {
 
 	Vector<ConnectionData> connections;
 
+	// Constructors, setters and connection binds resolved the first time the scene is instantiated at runtime,
+	// so later instances skip the lookups by name. Entries left null fall back to the generic path.
+	struct InstantiationPlan {
+		struct PropertyPlan {
+			MethodBind *setter = nullptr;
+			int index = -1;
+		};
+
+		struct NodePlan {
+			ClassDB::CreationFunc creation_func = nullptr;
+			LocalVector<PropertyPlan> properties;
+		};
+
+		LocalVector<NodePlan> nodes;
+		LocalVector<Vector<Variant>> connection_binds;
+	};
+
+	mutable InstantiationPlan instantiation_plan;
+	mutable bool instantiation_plan_built = false;
+	mutable BinaryMutex instantiation_plan_mutex;
+
+	const InstantiationPlan *_get_instantiation_plan() const;
+	void _clear_instantiation_plan();
+
 	Error _parse_node(Node *p_owner, Node *p_node, int p_parent_idx, HashMap<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map);
 	Error _parse_connections(Node *p_owner, Node *p_node, HashMap<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map);
 
@@ -130,6 +154,10 @@ public:
 		GEN_EDIT_STATE_MAIN_INHERITED,
 	};
 
+private:
+	Node *_instantiate(GenEditState p_edit_state, const InstantiationPlan *p_plan) const;
+
+public:
 	struct PackState {
 		Ref<SceneState> state;
 		int node = -1;
@@ -156,6 +184,7 @@ public:
 
 	bool can_instantiate() const;
 	Node *instantiate(GenEditState p_edit_state) const;
+	void instantiate_multiple(int p_count, GenEditState p_edit_state, LocalVector<Node *> &r_nodes) const;
 
 	Array setup_resources_in_array(Array &array_to_scan, const SceneState::NodeData &n, HashMap<Ref<Resource>, Ref<Resource>> &resources_local_to_sub_scene, Node *node, const StringName sname, HashMap<Ref<Resource>, Ref<Resource>> &resources_local_to_scene, int i, Node **ret_nodes, SceneState::GenEditState p_edit_state) const;
 	Dictionary setup_resources_in_dictionary(Dictionary &p_dictionary_to_scan, const SceneState::NodeData &p_n, HashMap<Ref<Resource>, Ref<Resource>> &p_resources_local_to_sub_scene, Node *p_node, const StringName p_sname, HashMap<Ref<Resource>, Ref<Resource>> &p_resources_local_to_scene, int p_i, Node **p_ret_nodes, SceneState::GenEditState p_edit_state) const;
@@ -238,6 +267,8 @@ class PackedScene : public Resource {
 	void _set_bundled_scene(const Dictionary &p_scene);
 	Dictionary _get_bundled_scene() const;
 
+	void _post_instantiate(Node *p_node, bool p_editable) const;
+
 protected:
 	virtual bool editor_can_reload_from_file() override { return false; } // this is handled by editor better
 	static void _bind_methods();
@@ -257,6 +288,7 @@ public:
 
 	bool can_instantiate() const;
 	Node *instantiate(GenEditState p_edit_state = GEN_EDIT_STATE_DISABLED) const;
+	TypedArray<Node> instantiate_multiple(int p_count, GenEditState p_edit_state = GEN_EDIT_STATE_DISABLED) const;
 
 	void recreate_state();
 	void replace_state(Ref<SceneState> p_by);
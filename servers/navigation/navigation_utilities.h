@@ -38,6 +38,7 @@ namespace NavigationUtilities {
 
 enum PathfindingAlgorithm {
 	PATHFINDING_ALGORITHM_ASTAR = 0,
+	PATHFINDING_ALGORITHM_HIERARCHICAL_ASTAR,
 };
 
 enum PathPostProcessing {
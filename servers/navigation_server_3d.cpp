@@ -31,6 +31,7 @@
 #include "navigation_server_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
 #include "scene/main/node.h"
 #include "servers/navigation/navigation_globals.h"
 
@@ -73,6 +74,8 @@ void NavigationServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("map_get_random_point", "map", "navigation_layers", "uniformly"), &NavigationServer3D::map_get_random_point);
 
 	ClassDB::bind_method(D_METHOD("query_path", "parameters", "result"), &NavigationServer3D::query_path);
+	ClassDB::bind_method(D_METHOD("query_paths", "parameters", "results"), &NavigationServer3D::query_paths);
+	ClassDB::bind_method(D_METHOD("query_paths_async", "parameters", "results", "callback"), &NavigationServer3D::query_paths_async, DEFVAL(Callable()));
 
 	ClassDB::bind_method(D_METHOD("region_create"), &NavigationServer3D::region_create);
 	ClassDB::bind_method(D_METHOD("region_set_enabled", "region", "enabled"), &NavigationServer3D::region_set_enabled);
@@ -251,6 +254,10 @@ NavigationServer3D::NavigationServer3D() {
 	GLOBAL_DEF("navigation/baking/thread_model/baking_use_multiple_threads", true);
 	GLOBAL_DEF("navigation/baking/thread_model/baking_use_high_priority_threads", true);
 
+	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "navigation/world/map_cluster_size", PROPERTY_HINT_RANGE, "0.1,1000,0.1,or_greater,suffix:m"), 32.0);
+	GLOBAL_DEF("navigation/world/map_use_cluster_graph", false);
+	GLOBAL_DEF("navigation/world/map_use_incremental_sync", false);
+
 #ifdef DEBUG_ENABLED
 	debug_navigation_edge_connection_color = GLOBAL_DEF("debug/shapes/navigation/edge_connection_color", Color(1.0, 0.0, 1.0, 1.0));
 	debug_navigation_geometry_edge_color = GLOBAL_DEF("debug/shapes/navigation/geometry_edge_color", Color(0.5, 1.0, 1.0, 1.0));
@@ -294,6 +301,7 @@ NavigationServer3D::NavigationServer3D() {
 }
 
 NavigationServer3D::~NavigationServer3D() {
+	_finish_path_query_batches();
 	singleton = nullptr;
 }
 
@@ -947,6 +955,155 @@ void NavigationServer3D::query_path(const Ref<NavigationPathQueryParameters3D> &
 	p_query_result->set_path_owner_ids(_query_result.path_owner_ids);
 }
 
+bool NavigationServer3D::_prepare_path_query_batch(PathQueryBatch &r_batch, const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results) const {
+	ERR_FAIL_COND_V_MSG(p_query_parameters.size() != p_query_results.size(), false, "The number of path query parameters and results must match.");
+
+	const uint32_t query_count = p_query_parameters.size();
+
+	// Snapshot the parameters on the calling thread so the objects can be reused while the queries run.
+	r_batch.parameters.resize(query_count);
+	r_batch.results.resize(query_count);
+	for (uint32_t i = 0; i < query_count; i++) {
+		const Ref<NavigationPathQueryParameters3D> query_parameters = p_query_parameters[i];
+		const Ref<NavigationPathQueryResult3D> query_result = p_query_results[i];
+		ERR_FAIL_COND_V_MSG(query_parameters.is_null(), false, vformat("Path query parameters at index %d are null.", i));
+		ERR_FAIL_COND_V_MSG(query_result.is_null(), false, vformat("Path query result at index %d is null.", i));
+		r_batch.parameters[i] = query_parameters->get_parameters();
+	}
+	r_batch.query_results = p_query_results;
+
+	// Each task runs a contiguous range of queries, so consecutive queries on the same map share the map lock.
+	const uint32_t thread_count = MAX(WorkerThreadPool::get_singleton()->get_thread_count(), 1);
+	r_batch.chunk_size = MAX((query_count + thread_count - 1) / thread_count, 1u);
+	r_batch.chunk_count = (query_count + r_batch.chunk_size - 1) / r_batch.chunk_size;
+
+	_pin_path_query_maps(r_batch.parameters, r_batch.maps);
+
+	return true;
+}
+
+void NavigationServer3D::_query_paths_batch_task(uint32_t p_chunk, PathQueryBatch *p_batch) const {
+	const uint32_t begin = p_chunk * p_batch->chunk_size;
+	const uint32_t count = MIN(p_batch->chunk_size, p_batch->parameters.size() - begin);
+	_query_pinned_paths(p_batch->maps.is_empty() ? nullptr : p_batch->maps.ptr() + begin, p_batch->parameters.ptr() + begin, p_batch->results.ptr() + begin, count);
+}
+
+void NavigationServer3D::_query_paths_async_task(uint32_t p_chunk, PathQueryBatch *p_batch) {
+	_query_paths_batch_task(p_chunk, p_batch);
+
+	if (p_batch->pending.decrement() == 0) {
+		// Last task of the batch, the maps are released before the group completes so waiting for it is enough to free them.
+		_unpin_path_query_maps(p_batch->maps);
+		callable_mp(this, &NavigationServer3D::_query_paths_async_finished).call_deferred(p_batch->id);
+	}
+}
+
+void NavigationServer3D::_query_pinned_paths(void *const *p_maps, const NavigationUtilities::PathQueryParameters *p_parameters, NavigationUtilities::PathQueryResult *r_results, uint32_t p_count) const {
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_results[i] = _query_path(p_parameters[i]);
+	}
+}
+
+void NavigationServer3D::_apply_path_query_batch_results(const PathQueryBatch &p_batch) {
+	for (uint32_t i = 0; i < p_batch.results.size(); i++) {
+		Ref<NavigationPathQueryResult3D> query_result = p_batch.query_results[i];
+		const NavigationUtilities::PathQueryResult &result = p_batch.results[i];
+
+		query_result->set_path(result.path);
+		query_result->set_path_types(result.path_types);
+		query_result->set_path_rids(result.path_rids);
+		query_result->set_path_owner_ids(result.path_owner_ids);
+	}
+}
+
+void NavigationServer3D::query_paths(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results) const {
+	PathQueryBatch batch;
+	if (!_prepare_path_query_batch(batch, p_query_parameters, p_query_results)) {
+		return;
+	}
+
+	if (batch.chunk_count > 0) {
+		WorkerThreadPool::GroupID group_id = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavigationServer3D::_query_paths_batch_task, &batch, batch.chunk_count, -1, true, SNAME("NavigationPathQueries"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_id);
+	}
+	_unpin_path_query_maps(batch.maps);
+
+	_apply_path_query_batch_results(batch);
+}
+
+void NavigationServer3D::query_paths_async(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback) {
+	PathQueryBatch *batch = memnew(PathQueryBatch);
+	if (!_prepare_path_query_batch(*batch, p_query_parameters, p_query_results)) {
+		memdelete(batch);
+		return;
+	}
+	batch->callback = p_callback;
+
+	MutexLock lock(path_query_batches_mutex);
+	batch->id = ++path_query_batch_id;
+	path_query_batches.insert(batch->id, batch);
+
+	// The extra pending count is held by this call so the batch can't finish before the group id is stored.
+	// The group id is stored under the lock, as _wait_for_path_query_batches() may be called from another thread.
+	batch->pending.set(batch->chunk_count + 1);
+	if (batch->chunk_count > 0) {
+		batch->group_id = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavigationServer3D::_query_paths_async_task, batch, batch->chunk_count, -1, true, SNAME("NavigationPathQueriesAsync"));
+	}
+	if (batch->pending.decrement() == 0) {
+		_unpin_path_query_maps(batch->maps);
+		callable_mp(this, &NavigationServer3D::_query_paths_async_finished).call_deferred(batch->id);
+	}
+}
+
+void NavigationServer3D::_query_paths_async_finished(uint64_t p_batch_id) {
+	PathQueryBatch *batch = nullptr;
+	{
+		MutexLock lock(path_query_batches_mutex);
+		PathQueryBatch **batch_ptr = path_query_batches.getptr(p_batch_id);
+		if (!batch_ptr) {
+			// Already finished by _finish_path_query_batches().
+			return;
+		}
+		batch = *batch_ptr;
+		path_query_batches.erase(p_batch_id);
+
+		if (batch->group_id != -1) {
+			// All elements are processed at this point, this only releases the group.
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(batch->group_id);
+			batch->group_id = -1;
+		}
+	}
+
+	_apply_path_query_batch_results(*batch);
+
+	if (batch->callback.is_valid()) {
+		batch->callback.call();
+	}
+
+	memdelete(batch);
+}
+
+void NavigationServer3D::_wait_for_path_query_batches() {
+	MutexLock lock(path_query_batches_mutex);
+	for (KeyValue<uint64_t, PathQueryBatch *> &E : path_query_batches) {
+		if (E.value->group_id != -1) {
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(E.value->group_id);
+			E.value->group_id = -1;
+		}
+	}
+}
+
+void NavigationServer3D::_finish_path_query_batches() {
+	MutexLock lock(path_query_batches_mutex);
+	for (KeyValue<uint64_t, PathQueryBatch *> &E : path_query_batches) {
+		if (E.value->group_id != -1) {
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(E.value->group_id);
+		}
+		memdelete(E.value);
+	}
+	path_query_batches.clear();
+}
+
 ///////////////////////////////////////////////////////
 
 NavigationServer3DCallback NavigationServer3DManager::create_callback = nullptr;
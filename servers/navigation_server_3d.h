@@ -347,6 +347,14 @@ public:
 
 	virtual NavigationUtilities::PathQueryResult _query_path(const NavigationUtilities::PathQueryParameters &p_parameters) const = 0;
 
+	/// Returns customized navigation paths for a batch of query parameters objects.
+	/// The queries are spread over the WorkerThreadPool, the call blocks until all of them are done.
+	void query_paths(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results) const;
+
+	/// Same as query_paths() but returns immediately.
+	/// The result objects are updated and the callback is called on the main thread once all queries are done.
+	void query_paths_async(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback = Callable());
+
 #ifndef _3D_DISABLED
 	virtual void parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable()) = 0;
 	virtual void bake_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) = 0;
@@ -380,7 +388,46 @@ public:
 	void set_debug_enabled(bool p_enabled);
 	bool get_debug_enabled() const;
 
+protected:
+	/// Waits for all pending asynchronous path query batches. Must be called before the server stops answering queries.
+	void _finish_path_query_batches();
+
+	/// Waits until the queries of the pending asynchronous path query batches are done, their results are still applied on the main thread.
+	void _wait_for_path_query_batches();
+
+	/// Resolves the maps of a path query batch on the thread that submits it, one per query.
+	/// The maps must stay alive until they are unpinned, so the queries can run on other threads without looking up RIDs.
+	virtual void _pin_path_query_maps(const LocalVector<NavigationUtilities::PathQueryParameters> &p_parameters, LocalVector<void *> &r_maps) const {}
+	virtual void _unpin_path_query_maps(const LocalVector<void *> &p_maps) const {}
+
+	/// Runs a range of queries of a batch. `p_maps` are the pinned maps of the queries, or null when the server doesn't pin them.
+	virtual void _query_pinned_paths(void *const *p_maps, const NavigationUtilities::PathQueryParameters *p_parameters, NavigationUtilities::PathQueryResult *r_results, uint32_t p_count) const;
+
 private:
+	struct PathQueryBatch {
+		uint64_t id = 0;
+		int64_t group_id = -1;
+		LocalVector<NavigationUtilities::PathQueryParameters> parameters;
+		LocalVector<NavigationUtilities::PathQueryResult> results;
+		LocalVector<void *> maps;
+		TypedArray<NavigationPathQueryResult3D> query_results;
+		Callable callback;
+		/// Queries run by each task of the group.
+		uint32_t chunk_size = 0;
+		uint32_t chunk_count = 0;
+		SafeNumeric<uint32_t> pending;
+	};
+
+	Mutex path_query_batches_mutex;
+	HashMap<uint64_t, PathQueryBatch *> path_query_batches;
+	uint64_t path_query_batch_id = 0;
+
+	bool _prepare_path_query_batch(PathQueryBatch &r_batch, const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results) const;
+	void _query_paths_batch_task(uint32_t p_chunk, PathQueryBatch *p_batch) const;
+	void _query_paths_async_task(uint32_t p_chunk, PathQueryBatch *p_batch);
+	void _query_paths_async_finished(uint64_t p_batch_id);
+	static void _apply_path_query_batch_results(const PathQueryBatch &p_batch);
+
 	bool debug_enabled = false;
 
 #ifdef DEBUG_ENABLED
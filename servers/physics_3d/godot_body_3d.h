@@ -90,6 +90,10 @@ class GodotBody3D : public GodotCollisionObject3D {
 
 	real_t still_time = 0.0;
 
+	// Swept motion computed by integrate_forces(), registered in the broadphase by finish_integrate_forces().
+	Vector3 integrated_motion;
+	bool integrated_motion_pending = false;
+
 	Vector3 applied_force;
 	Vector3 applied_torque;
 
@@ -316,8 +320,13 @@ public:
 	void set_axis_lock(PhysicsServer3D::BodyAxis p_axis, bool lock);
 	bool is_axis_locked(PhysicsServer3D::BodyAxis p_axis) const;
 
+	// The integrate methods only touch this body and can run on worker threads.
+	// Their finish counterparts update the broadphase and the space lists, so
+	// they must run on the physics thread in active list order.
 	void integrate_forces(real_t p_step);
+	void finish_integrate_forces();
 	void integrate_velocities(real_t p_step);
+	void finish_integrate_velocities();
 
 	_FORCE_INLINE_ Vector3 get_velocity_in_local_point(const Vector3 &rel_pos) const {
 		return linear_velocity + angular_velocity.cross(rel_pos - center_of_mass);
@@ -40,6 +40,7 @@
 #define ISLAND_COUNT_RESERVE 128
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
+#define BODY_COUNT_RESERVE 1024
 
 void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
@@ -112,11 +113,24 @@ void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, Local
 	}
 }
 
+void GodotStep3D::_integrate_forces(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_forces(delta);
+}
+
 void GodotStep3D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
 	GodotConstraint3D *constraint = all_constraints[p_constraint_index];
 	constraint->setup(delta);
 }
 
+void GodotStep3D::_setup_island(uint32_t p_island_index, void *p_userdata) {
+	// Constraints in the same island can report contacts on the same bodies,
+	// setting them up in island order keeps the reported contacts stable.
+	const LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[p_island_index];
+	for (GodotConstraint3D *constraint : constraint_island) {
+		constraint->setup(delta);
+	}
+}
+
 void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const {
 	uint32_t constraint_count = p_constraint_island.size();
 	uint32_t valid_constraint_count = 0;
@@ -158,21 +172,39 @@ void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 	}
 }
 
-void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const {
+void GodotStep3D::_integrate_velocities(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_velocities(delta);
+}
+
+void GodotStep3D::_solve_soft_body_constraints(uint32_t p_soft_body_index, void *p_userdata) {
+	active_soft_bodies[p_soft_body_index]->solve_constraints(delta);
+}
+
+void GodotStep3D::_sleep_test_island(uint32_t p_island_index, void *p_userdata) {
+	const LocalVector<GodotBody3D *> &body_island = body_islands[p_island_index];
+
 	bool can_sleep = true;
 
-	uint32_t body_count = p_body_island.size();
+	uint32_t body_count = body_island.size();
 	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
-		GodotBody3D *body = p_body_island[body_index];
+		GodotBody3D *body = body_island[body_index];
 
 		if (!body->sleep_test(delta)) {
 			can_sleep = false;
 		}
 	}
 
+	body_island_can_sleep[p_island_index] = can_sleep;
+}
+
+void GodotStep3D::_check_suspend(uint32_t p_island_index) {
+	const LocalVector<GodotBody3D *> &body_island = body_islands[p_island_index];
+	bool can_sleep = body_island_can_sleep[p_island_index];
+
 	// Put all to sleep or wake up everyone.
+	uint32_t body_count = body_island.size();
 	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
-		GodotBody3D *body = p_body_island[body_index];
+		GodotBody3D *body = body_island[body_index];
 
 		bool active = body->is_active();
 
@@ -203,15 +235,25 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	int active_count = 0;
 
+	active_bodies.clear();
 	const SelfList<GodotBody3D> *b = body_list->first();
 	while (b) {
-		b->self()->integrate_forces(p_delta);
+		active_bodies.push_back(b->self());
 		b = b->next();
 		active_count++;
 	}
 
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_integrate_forces, nullptr, active_bodies.size(), -1, true, SNAME("Physics3DIntegrateForces"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Broadphase moves are applied in list order, so pairs are always reported in the same order.
+	for (GodotBody3D *body : active_bodies) {
+		body->finish_integrate_forces();
+	}
+
 	/* UPDATE SOFT BODY MOTION */
 
+	// Warning: This doesn't run on threads, because soft bodies update the broadphase while predicting motion.
 	const SelfList<GodotSoftBody3D> *sb = soft_body_list->first();
 	while (sb) {
 		sb->self()->predict_motion(p_delta);
@@ -343,9 +385,19 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
-	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	if (!p_space->is_deterministic_simulation()) {
+		uint32_t total_constraint_count = all_constraints.size();
+		group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else if (soft_body_list->first()) {
+		// Soft body contacts can wake up bodies, which isn't thread-safe, so keep everything in order.
+		for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+			_setup_island(island_index);
+		}
+	} else {
+		group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSetupIslands"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -375,27 +427,44 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* INTEGRATE VELOCITIES */
 
+	// Bodies can be woken up while setting up constraints, so the active list needs to be gathered again.
+	active_bodies.clear();
 	b = body_list->first();
 	while (b) {
-		const SelfList<GodotBody3D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n;
+		active_bodies.push_back(b->self());
+		b = b->next();
+	}
+
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_integrate_velocities, nullptr, active_bodies.size(), -1, true, SNAME("Physics3DIntegrateVelocities"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Warning: This can remove bodies from the active list and update the broadphase, so it doesn't run on threads.
+	for (GodotBody3D *body : active_bodies) {
+		body->finish_integrate_velocities();
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
 
+	body_island_can_sleep.resize(body_island_count);
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_sleep_test_island, nullptr, body_island_count, -1, true, SNAME("Physics3DSleepTestIslands"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
 	for (uint32_t island_index = 0; island_index < body_island_count; ++island_index) {
-		_check_suspend(body_islands[island_index]);
+		_check_suspend(island_index);
 	}
 
 	/* UPDATE SOFT BODY CONSTRAINTS */
 
+	active_soft_bodies.clear();
 	sb = soft_body_list->first();
 	while (sb) {
-		sb->self()->solve_constraints(p_delta);
+		active_soft_bodies.push_back(sb->self());
 		sb = sb->next();
 	}
 
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_soft_body_constraints, nullptr, active_soft_bodies.size(), -1, true, SNAME("Physics3DSoftBodyConstraints"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_INTEGRATE_VELOCITIES, profile_endtime - profile_begtime);
@@ -412,6 +481,7 @@ GodotStep3D::GodotStep3D() {
 	body_islands.reserve(BODY_ISLAND_COUNT_RESERVE);
 	constraint_islands.reserve(ISLAND_COUNT_RESERVE);
 	all_constraints.reserve(CONSTRAINT_COUNT_RESERVE);
+	active_bodies.reserve(BODY_COUNT_RESERVE);
 }
 
 GodotStep3D::~GodotStep3D() {
@@ -32,6 +32,8 @@
 #define TEST_FILE_ACCESS_H
 
 #include "core/io/file_access.h"
+#include "core/io/file_access_compressed.h"
+#include "core/io/file_access_memory.h"
 #include "tests/test_macros.h"
 #include "tests/test_utils.h"
 
@@ -107,6 +109,74 @@ TEST_CASE("[FileAccess] Get as UTF-8 String") {
 	CHECK(s_cr == "Hello darkness\rMy old friend\rI've come to talk\rWith you again\r");
 	CHECK(s_cr_nocr == "Hello darknessMy old friendI've come to talkWith you again");
 }
+
+TEST_CASE("[FileAccess] Mapped view") {
+	Ref<FileAccess> f = FileAccess::open(TestUtils::get_data_path("testdata.csv"), FileAccess::READ);
+	REQUIRE(!f.is_null());
+
+	const uint8_t *view = f->get_mapped_view();
+#ifdef UNIX_ENABLED
+	REQUIRE_MESSAGE(view != nullptr, "Files opened for reading should be mappable on Unix.");
+#endif
+	if (view) {
+		Vector<uint8_t> contents = f->get_buffer(f->get_length());
+		CHECK(memcmp(view, contents.ptr(), contents.size()) == 0);
+		CHECK_MESSAGE(f->get_mapped_view() == view, "The mapping should be reused.");
+	}
+
+	Ref<FileAccess> fw = FileAccess::open(TestUtils::get_temp_path("mapped_view.txt"), FileAccess::WRITE);
+	REQUIRE(!fw.is_null());
+	fw->store_string("Hello");
+	CHECK_MESSAGE(fw->get_mapped_view() == nullptr, "Files opened for writing should not be mapped.");
+}
+
+TEST_CASE("[FileAccess] Compressed blocks") {
+	// Enough blocks for large reads to be decompressed on worker threads.
+	const uint32_t block_size = 4096;
+	Vector<uint8_t> data;
+	data.resize(block_size * 300 + 123);
+	for (int i = 0; i < data.size(); i++) {
+		data.write[i] = (i * 7 + i / 1000) % 251;
+	}
+
+	Vector<uint8_t> compressed = FileAccessCompressed::compress_blocks(data.ptr(), data.size(), "TEST", Compression::MODE_ZSTD, block_size);
+	REQUIRE(compressed.size() > 0);
+	CHECK(compressed.size() < data.size());
+
+	Ref<FileAccessMemory> fm;
+	fm.instantiate();
+	REQUIRE(fm->open_custom(compressed.ptr(), compressed.size()) == OK);
+	char magic[5] = {};
+	fm->get_buffer((uint8_t *)magic, 4);
+	CHECK(String(magic) == "TEST");
+
+	Ref<FileAccessCompressed> fc;
+	fc.instantiate();
+	fc->configure("TEST");
+	REQUIRE(fc->open_after_magic(fm) == OK);
+	CHECK(fc->get_length() == (uint64_t)data.size());
+
+	// Read a few bytes to leave the first block partially consumed, then the rest at once.
+	Vector<uint8_t> read;
+	read.resize(data.size());
+	CHECK(fc->get_buffer(read.ptrw(), 10) == 10);
+	CHECK(fc->get_buffer(read.ptrw() + 10, data.size() - 10) == (uint64_t)data.size() - 10);
+	CHECK(read == data);
+	CHECK_FALSE(fc->eof_reached());
+	CHECK(fc->get_position() == (uint64_t)data.size());
+
+	// Reading past the end only returns what's left.
+	CHECK(fc->get_buffer(read.ptrw(), 16) == 0);
+	CHECK(fc->eof_reached());
+
+	// Seek back into the middle and read across several blocks.
+	const uint64_t from = block_size * 5 + 17;
+	fc->seek(from);
+	CHECK(fc->get_buffer(read.ptrw(), block_size * 200) == block_size * 200);
+	CHECK(memcmp(read.ptr(), data.ptr() + from, block_size * 200) == 0);
+	CHECK(fc->get_8() == data[from + block_size * 200]);
+}
+
 } // namespace TestFileAccess
 
 #endif // TEST_FILE_ACCESS_H
@@ -0,0 +1,223 @@
+/**************************************************************************/
+/*  test_io_scheduler.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_IO_SCHEDULER_H
+#define TEST_IO_SCHEDULER_H
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/io_scheduler.h"
+#include "core/os/os.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestIOScheduler {
+
+#ifdef THREADS_ENABLED
+struct PathWaiter {
+	Vector<String> paths;
+	SafeNumeric<int> done;
+
+	void wait_for(int p_index) {
+		IOScheduler::get_singleton()->wait(paths[p_index]);
+		if (!IOScheduler::get_singleton()->is_pending(paths[p_index])) {
+			done.increment();
+		}
+	}
+};
+
+struct ThreadWaiter {
+	String path;
+	SafeFlag returned;
+
+	static void wait_func(void *p_userdata) {
+		ThreadWaiter *waiter = (ThreadWaiter *)p_userdata;
+		IOScheduler::get_singleton()->wait(waiter->path);
+		waiter->returned.set();
+	}
+};
+
+// Records the files the I/O thread reads, and holds it on one of them until released.
+struct ReadObserver {
+	String held_path;
+	Semaphore held;
+	Semaphore release;
+
+	BinaryMutex mutex;
+	Vector<String> read_paths;
+
+	static void on_read(const String &p_path, void *p_userdata) {
+		ReadObserver *observer = (ReadObserver *)p_userdata;
+		{
+			MutexLock lock(observer->mutex);
+			observer->read_paths.push_back(p_path);
+		}
+		if (p_path == observer->held_path) {
+			observer->held.post();
+			observer->release.wait();
+		}
+	}
+
+	bool was_read(const String &p_path) {
+		MutexLock lock(mutex);
+		return read_paths.has(p_path);
+	}
+};
+#endif
+
+TEST_CASE("[IOScheduler] Prefetch and wait") {
+	IOScheduler *scheduler = IOScheduler::get_singleton();
+	REQUIRE(scheduler);
+	REQUIRE_FALSE(scheduler->is_running());
+
+	const String path = TestUtils::get_temp_path("io_scheduler.bin");
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		Vector<uint8_t> data;
+		data.resize(1024 * 1024);
+		data.fill(7);
+		f->store_buffer(data);
+	}
+
+	SUBCASE("Requests are ignored while not running") {
+		scheduler->prefetch(path);
+		CHECK_FALSE(scheduler->is_pending(path));
+		// Must not block.
+		scheduler->wait(path);
+	}
+
+#ifdef THREADS_ENABLED
+	SUBCASE("Waiting returns once the file is read") {
+		scheduler->init();
+		CHECK(scheduler->is_running());
+
+		Vector<String> paths;
+		paths.push_back(path);
+		paths.push_back(TestUtils::get_temp_path("io_scheduler_missing.bin"));
+		scheduler->prefetch(paths);
+		for (const String &p : paths) {
+			scheduler->wait(p);
+			CHECK_FALSE(scheduler->is_pending(p));
+		}
+
+		scheduler->finish();
+		CHECK_FALSE(scheduler->is_running());
+	}
+
+	SUBCASE("Waiting from pool tasks returns once the file is read") {
+		scheduler->init();
+
+		// More tasks than threads, so some of them run while others yield on the same thread.
+		const int task_count = WorkerThreadPool::get_singleton()->get_thread_count() * 4;
+		PathWaiter waiter;
+		for (int i = 0; i < task_count; i++) {
+			waiter.paths.push_back(i % 2 ? path : TestUtils::get_temp_path("io_scheduler_missing_" + itos(i) + ".bin"));
+		}
+		scheduler->prefetch(waiter.paths);
+
+		Vector<WorkerThreadPool::TaskID> tasks;
+		for (int i = 0; i < task_count; i++) {
+			tasks.push_back(WorkerThreadPool::get_singleton()->add_template_task(&waiter, &PathWaiter::wait_for, i));
+		}
+		for (WorkerThreadPool::TaskID task : tasks) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+		}
+		CHECK(waiter.done.get() == task_count);
+
+		scheduler->finish();
+	}
+
+	SUBCASE("Waiting on a file being read returns once the read is over") {
+		ReadObserver observer;
+		observer.held_path = path;
+		scheduler->set_read_callback(&ReadObserver::on_read, &observer);
+		scheduler->init();
+
+		scheduler->prefetch(path);
+		observer.held.wait();
+
+		ThreadWaiter waiter;
+		waiter.path = path;
+		Thread thread;
+		thread.start(&ThreadWaiter::wait_func, &waiter);
+		OS::get_singleton()->delay_usec(10000);
+		CHECK_FALSE_MESSAGE(waiter.returned.is_set(), "Waiting on a file being read should block until the read is over.");
+		CHECK(scheduler->is_pending(path));
+
+		observer.release.post();
+		thread.wait_to_finish();
+		CHECK(waiter.returned.is_set());
+		CHECK_FALSE(scheduler->is_pending(path));
+
+		scheduler->finish();
+		scheduler->set_read_callback(nullptr, nullptr);
+	}
+
+	SUBCASE("Requests dropped by a waiter are never read") {
+		ReadObserver observer;
+		observer.held_path = path;
+		scheduler->set_read_callback(&ReadObserver::on_read, &observer);
+		scheduler->init();
+
+		// Requested together, so they are read in one batch, in path order, after the held one.
+		const String dropped_path = TestUtils::get_temp_path("io_scheduler_dropped.bin");
+		const String last_path = TestUtils::get_temp_path("io_scheduler_last.bin");
+		Vector<String> paths;
+		paths.push_back(last_path);
+		paths.push_back(dropped_path);
+		paths.push_back(path);
+		scheduler->prefetch(paths);
+		observer.held.wait();
+
+		// Still queued, so the waiter takes it over and returns right away.
+		scheduler->wait(dropped_path);
+		CHECK_FALSE(scheduler->is_pending(dropped_path));
+
+		observer.release.post();
+		while (scheduler->is_pending(last_path)) {
+			OS::get_singleton()->delay_usec(1000);
+		}
+		CHECK(observer.was_read(last_path));
+		CHECK_FALSE_MESSAGE(observer.was_read(dropped_path), "Dropped requests should be skipped by the I/O thread.");
+
+		scheduler->finish();
+		scheduler->set_read_callback(nullptr, nullptr);
+	}
+#endif
+
+	DirAccess::remove_file_or_error(path);
+}
+
+} // namespace TestIOScheduler
+
+#endif // TEST_IO_SCHEDULER_H
@@ -31,8 +31,10 @@
 #ifndef TEST_PCK_PACKER_H
 #define TEST_PCK_PACKER_H
 
+#include "core/io/dir_access.h"
 #include "core/io/file_access_pack.h"
 #include "core/io/pck_packer.h"
+#include "core/object/script_language.h"
 #include "core/os/os.h"
 
 #include "tests/test_utils.h"
@@ -117,6 +119,110 @@ TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 			f->get_length() <= 27000,
 			"The generated non-empty PCK file shouldn't be too large.");
 }
+
+TEST_CASE("[PCKPacker] Pack a PCK file with compressed files") {
+	PCKPacker pck_packer;
+	const String output_pck_path = TestUtils::get_temp_path("output_compressed.pck");
+	CHECK_MESSAGE(
+			pck_packer.pck_start(output_pck_path) == OK,
+			"Starting a PCK file should return an OK error code.");
+
+	const String base_dir = OS::get_singleton()->get_executable_path().get_base_dir();
+	const String source_path = base_dir.path_join("../core/object/object.cpp");
+
+	CHECK_MESSAGE(
+			pck_packer.add_file("object.cpp", source_path, false, true) == OK,
+			"Adding a compressed file to the PCK should return an OK error code.");
+	CHECK_MESSAGE(
+			pck_packer.flush() == OK,
+			"Flushing the PCK should return an OK error code.");
+
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(output_pck_path, FileAccess::READ, &err);
+	REQUIRE_MESSAGE(
+			err == OK,
+			"The generated PCK file should be opened successfully.");
+	CHECK(f->get_32() == PACK_HEADER_MAGIC);
+	CHECK_MESSAGE(
+			f->get_32() == PACK_FORMAT_VERSION,
+			"PCK files with compressed files should use the current format version.");
+	CHECK_MESSAGE(
+			f->get_length() < FileAccess::get_file_as_bytes(source_path).size(),
+			"The generated PCK file should be smaller than the file it contains.");
+}
+
+static Vector<uint8_t> _make_pack_test_data() {
+	// Compressible, and large enough to span several compressed blocks.
+	Vector<uint8_t> data;
+	data.resize(200000);
+	for (int i = 0; i < data.size(); i++) {
+		data.write[i] = (i % 97) ^ ((i / 4096) & 0x0F);
+	}
+	return data;
+}
+
+static void _check_pack_round_trip(bool p_compress) {
+	const Vector<uint8_t> data = _make_pack_test_data();
+	const String source_path = TestUtils::get_temp_path("pck_round_trip_source.bin");
+	{
+		Ref<FileAccess> f = FileAccess::open(source_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(data);
+	}
+
+	// Encrypted files are read back with the key the engine was built with.
+	const String key = String::hex_encode_buffer(script_encryption_key, 32);
+	const String suffix = p_compress ? "compressed" : "raw";
+	const String output_pck_path = TestUtils::get_temp_path("output_round_trip_" + suffix + ".pck");
+	const String plain_path = "res://pck_round_trip/" + suffix + "/plain.bin";
+	const String encrypted_path = "res://pck_round_trip/" + suffix + "/encrypted.bin";
+
+	PCKPacker pck_packer;
+	REQUIRE(pck_packer.pck_start(output_pck_path, 32, key) == OK);
+	REQUIRE(pck_packer.add_file(plain_path, source_path, false, p_compress) == OK);
+	REQUIRE(pck_packer.add_file(encrypted_path, source_path, true, p_compress) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	{
+		Ref<FileAccess> f = FileAccess::open(output_pck_path, FileAccess::READ);
+		REQUIRE(f.is_valid());
+		CHECK(f->get_32() == PACK_HEADER_MAGIC);
+		CHECK_MESSAGE(
+				f->get_32() == (p_compress ? PACK_FORMAT_VERSION : PACK_FORMAT_VERSION_NO_COMPRESSION),
+				"Only PCK files with compressed files should need the newer format version.");
+	}
+
+	REQUIRE(PackedData::get_singleton()->add_pack(output_pck_path, true, 0) == OK);
+
+	const String paths[] = { plain_path, encrypted_path };
+	for (const String &path : paths) {
+		PackedData::PackedFile packed_file;
+		REQUIRE(PackedData::get_singleton()->get_packed_file(path, packed_file));
+		CHECK(packed_file.compressed == p_compress);
+		CHECK(packed_file.encrypted == (path == encrypted_path));
+
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+		REQUIRE_MESSAGE(f.is_valid(), "Files should be readable from the loaded PCK.");
+		CHECK(f->get_length() == (uint64_t)data.size());
+		CHECK_MESSAGE(f->get_buffer(f->get_length()) == data, "Files read from the PCK should match their source.");
+
+		// Seek back into the middle, past the first compressed block.
+		const uint64_t from = 100003;
+		f->seek(from);
+		CHECK(f->get_8() == data[from]);
+		CHECK(f->get_position() == from + 1);
+	}
+
+	DirAccess::remove_absolute(source_path);
+}
+
+TEST_CASE("[PCKPacker] Read back files from a PCK file") {
+	_check_pack_round_trip(false);
+}
+
+TEST_CASE("[PCKPacker] Read back compressed files from a PCK file") {
+	_check_pack_round_trip(true);
+}
 } // namespace TestPCKPacker
 
 #endif // TEST_PCK_PACKER_H
@@ -34,6 +34,7 @@
 #include "core/io/resource.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
 #include "thirdparty/doctest/doctest.h"
@@ -166,6 +167,61 @@ TEST_CASE("[Resource] Breaking circular references on save") {
 	// Break circular reference to avoid memory leak
 	resource_c->remove_meta("next");
 }
+
+TEST_CASE("[Resource] Loading binary resources with many sub-resources") {
+	// Large enough files have their sub-resources decoded on several threads when the worker
+	// thread pool has more than one, small ones are always decoded on the loading thread.
+	// Both should give back the same resources.
+	const int child_count = 16;
+	int data_size = 0;
+	SUBCASE("Small file, decoded on the loading thread") {
+		data_size = 1024;
+	}
+	SUBCASE("Large file, decoded on worker threads") {
+		data_size = 128 * 1024;
+		if (WorkerThreadPool::get_singleton()->get_thread_count() < 2) {
+			MESSAGE("The worker thread pool has a single thread, sub-resources are decoded on the loading thread.");
+		}
+	}
+
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_name("Root");
+	Ref<Resource> previous = resource;
+	for (int i = 0; i < child_count; i++) {
+		Ref<Resource> child = memnew(Resource);
+		child->set_name(itos(i));
+		PackedByteArray data;
+		data.resize(data_size);
+		for (int j = 0; j < data_size; j++) {
+			data.write[j] = (i + j) % 256;
+		}
+		child->set_meta("data", data);
+		previous->set_meta("next", child);
+		previous = child;
+	}
+
+	const String save_path_binary = TestUtils::get_temp_path(vformat("resource_sub_resources_%d.res", data_size));
+	REQUIRE(ResourceSaver::save(resource, save_path_binary) == OK);
+
+	Ref<Resource> loaded = ResourceLoader::load(save_path_binary, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(loaded.is_valid());
+	CHECK(loaded->get_name() == "Root");
+
+	for (int i = 0; i < child_count; i++) {
+		loaded = loaded->get_meta("next");
+		REQUIRE_MESSAGE(loaded.is_valid(), "Sub-resources should reference each other as they did when saved.");
+		CHECK(loaded->get_name() == itos(i));
+
+		PackedByteArray data = loaded->get_meta("data");
+		REQUIRE(data.size() == data_size);
+		bool data_matches = true;
+		for (int j = 0; j < data_size; j++) {
+			data_matches = data_matches && data[j] == (i + j) % 256;
+		}
+		CHECK_MESSAGE(data_matches, "Sub-resource data should be loaded back unchanged.");
+	}
+	CHECK_FALSE(loaded->has_meta("next"));
+}
 } // namespace TestResource
 
 #endif // TEST_RESOURCE_H
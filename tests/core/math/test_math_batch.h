@@ -0,0 +1,264 @@
+/**************************************************************************/
+/*  test_math_batch.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_MATH_BATCH_H
+#define TEST_MATH_BATCH_H
+
+#include "core/math/math_batch.h"
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "core/templates/local_vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMathBatch {
+
+Vector3 random_vector3(RandomPCG &p_rng) {
+	return Vector3(p_rng.random(-100.0, 100.0), p_rng.random(-100.0, 100.0), p_rng.random(-100.0, 100.0));
+}
+
+Transform3D random_transform(RandomPCG &p_rng) {
+	Basis basis = Basis::from_euler(Vector3(p_rng.random(-Math_PI, Math_PI), p_rng.random(-Math_PI, Math_PI), p_rng.random(-Math_PI, Math_PI)));
+	basis.scale(Vector3(p_rng.random(0.5, 2.0), p_rng.random(0.5, 2.0), p_rng.random(0.5, 2.0)));
+	return Transform3D(basis, random_vector3(p_rng));
+}
+
+AABB random_aabb(RandomPCG &p_rng) {
+	return AABB(random_vector3(p_rng), Vector3(p_rng.random(0.0, 10.0), p_rng.random(0.0, 10.0), p_rng.random(0.0, 10.0)));
+}
+
+// Odd count, so that the SIMD tail handling gets exercised too.
+const uint32_t COUNT = 67;
+
+TEST_CASE("[MathBatch] Transform vectors") {
+	RandomPCG rng(42);
+	const Transform3D transform = random_transform(rng);
+
+	LocalVector<Vector3> src;
+	LocalVector<real_t> x, y, z;
+	for (uint32_t i = 0; i < COUNT; i++) {
+		const Vector3 v = random_vector3(rng);
+		src.push_back(v);
+		x.push_back(v.x);
+		y.push_back(v.y);
+		z.push_back(v.z);
+	}
+
+	LocalVector<Vector3> dst;
+	dst.resize(COUNT);
+	MathBatch::xform_vector3(transform, src.ptr(), dst.ptr(), COUNT);
+
+	LocalVector<real_t> rx, ry, rz;
+	rx.resize(COUNT);
+	ry.resize(COUNT);
+	rz.resize(COUNT);
+	MathBatch::xform_vector3_soa(transform, x.ptr(), y.ptr(), z.ptr(), rx.ptr(), ry.ptr(), rz.ptr(), COUNT);
+
+	bool aos_matches = true;
+	bool soa_matches = true;
+	for (uint32_t i = 0; i < COUNT; i++) {
+		const Vector3 expected = transform.xform(src[i]);
+		aos_matches = aos_matches && dst[i].is_equal_approx(expected);
+		soa_matches = soa_matches && Vector3(rx[i], ry[i], rz[i]).is_equal_approx(expected);
+	}
+	CHECK_MESSAGE(aos_matches, "Batched Vector3 transform should match Transform3D::xform().");
+	CHECK_MESSAGE(soa_matches, "Batched SoA Vector3 transform should match Transform3D::xform().");
+
+	// In-place transform.
+	MathBatch::xform_vector3(transform, src.ptr(), src.ptr(), COUNT);
+	bool in_place_matches = true;
+	for (uint32_t i = 0; i < COUNT; i++) {
+		in_place_matches = in_place_matches && src[i].is_equal_approx(dst[i]);
+	}
+	CHECK_MESSAGE(in_place_matches, "Transforming vectors in place should give the same results.");
+}
+
+TEST_CASE("[MathBatch] Transform and merge AABBs") {
+	RandomPCG rng(1337);
+	const Transform3D transform = random_transform(rng);
+
+	LocalVector<AABB> src;
+	LocalVector<Transform3D> transforms;
+	for (uint32_t i = 0; i < COUNT; i++) {
+		src.push_back(random_aabb(rng));
+		transforms.push_back(random_transform(rng));
+	}
+
+	LocalVector<AABB> dst;
+	dst.resize(COUNT);
+	MathBatch::xform_aabb(transform, src.ptr(), dst.ptr(), COUNT);
+	bool matches = true;
+	for (uint32_t i = 0; i < COUNT; i++) {
+		matches = matches && dst[i].is_equal_approx(transform.xform(src[i]));
+	}
+	CHECK_MESSAGE(matches, "Batched AABB transform should match Transform3D::xform().");
+
+	MathBatch::xform_aabbs(transforms.ptr(), src.ptr(), dst.ptr(), COUNT);
+	matches = true;
+	for (uint32_t i = 0; i < COUNT; i++) {
+		matches = matches && dst[i].is_equal_approx(transforms[i].xform(src[i]));
+	}
+	CHECK_MESSAGE(matches, "Batched per-element AABB transform should match Transform3D::xform().");
+
+	AABB expected = src[0];
+	for (uint32_t i = 1; i < COUNT; i++) {
+		expected.merge_with(src[i]);
+	}
+	CHECK_MESSAGE(MathBatch::merge_aabbs(src.ptr(), COUNT).is_equal_approx(expected), "Batched AABB merge should match AABB::merge_with().");
+	CHECK_MESSAGE(MathBatch::merge_aabbs(src.ptr(), 1).is_equal_approx(src[0]), "Merging a single AABB should return it unchanged.");
+	CHECK_MESSAGE(MathBatch::merge_aabbs(src.ptr(), 0) == AABB(), "Merging no AABBs should return an empty AABB.");
+}
+
+TEST_CASE("[MathBatch] Multiply transforms and bases") {
+	RandomPCG rng(7);
+	const Transform3D parent = random_transform(rng);
+
+	LocalVector<Transform3D> a, b;
+	LocalVector<Basis> basis_a, basis_b;
+	for (uint32_t i = 0; i < COUNT; i++) {
+		a.push_back(random_transform(rng));
+		b.push_back(random_transform(rng));
+		basis_a.push_back(a[i].basis);
+		basis_b.push_back(b[i].basis);
+	}
+
+	LocalVector<Transform3D> dst;
+	dst.resize(COUNT);
+	MathBatch::multiply_transforms(parent, b.ptr(), dst.ptr(), COUNT);
+	bool matches = true;
+	for (uint32_t i = 0; i < COUNT; i++) {
+		matches = matches && dst[i].is_equal_approx(parent * b[i]);
+	}
+	CHECK_MESSAGE(matches, "Multiplying by a parent transform should match Transform3D::operator*().");
+
+	MathBatch::multiply_transforms(a.ptr(), b.ptr(), dst.ptr(), COUNT);
+	matches = true;
+	for (uint32_t i = 0; i < COUNT; i++) {
+		matches = matches && dst[i].is_equal_approx(a[i] * b[i]);
+	}
+	CHECK_MESSAGE(matches, "Pairwise transform multiplication should match Transform3D::operator*().");
+
+	LocalVector<Basis> basis_dst;
+	basis_dst.resize(COUNT);
+	MathBatch::multiply_bases(basis_a.ptr(), basis_b.ptr(), basis_dst.ptr(), COUNT);
+	matches = true;
+	for (uint32_t i = 0; i < COUNT; i++) {
+		matches = matches && basis_dst[i].is_equal_approx(basis_a[i] * basis_b[i]);
+	}
+	CHECK_MESSAGE(matches, "Pairwise basis multiplication should match Basis::operator*().");
+}
+
+TEST_CASE("[MathBatch][Benchmark] Batched and scalar kernels" * doctest::skip()) {
+	const uint32_t count = 1 << 16;
+	const int rounds = 100;
+
+	RandomPCG rng(1);
+	const Transform3D transform = random_transform(rng);
+	LocalVector<Vector3> vectors;
+	LocalVector<real_t> x, y, z;
+	LocalVector<AABB> aabbs;
+	LocalVector<Transform3D> transforms;
+	for (uint32_t i = 0; i < count; i++) {
+		vectors.push_back(random_vector3(rng));
+		x.push_back(vectors[i].x);
+		y.push_back(vectors[i].y);
+		z.push_back(vectors[i].z);
+		aabbs.push_back(random_aabb(rng));
+		transforms.push_back(random_transform(rng));
+	}
+	LocalVector<Vector3> vector_dst;
+	vector_dst.resize(count);
+	// Separate outputs, transforming in place would grow the values towards infinity over the rounds.
+	LocalVector<real_t> x_dst, y_dst, z_dst;
+	x_dst.resize(count);
+	y_dst.resize(count);
+	z_dst.resize(count);
+	LocalVector<AABB> aabb_dst;
+	aabb_dst.resize(count);
+	LocalVector<Transform3D> transform_dst;
+	transform_dst.resize(count);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int r = 0; r < rounds; r++) {
+		for (uint32_t i = 0; i < count; i++) {
+			vector_dst[i] = transform.xform(vectors[i]);
+		}
+	}
+	const uint64_t scalar_vector_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int r = 0; r < rounds; r++) {
+		MathBatch::xform_vector3(transform, vectors.ptr(), vector_dst.ptr(), count);
+	}
+	const uint64_t batch_vector_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int r = 0; r < rounds; r++) {
+		MathBatch::xform_vector3_soa(transform, x.ptr(), y.ptr(), z.ptr(), x_dst.ptr(), y_dst.ptr(), z_dst.ptr(), count);
+	}
+	const uint64_t batch_soa_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int r = 0; r < rounds; r++) {
+		for (uint32_t i = 0; i < count; i++) {
+			aabb_dst[i] = transforms[i].xform(aabbs[i]);
+		}
+	}
+	const uint64_t scalar_aabb_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int r = 0; r < rounds; r++) {
+		MathBatch::xform_aabbs(transforms.ptr(), aabbs.ptr(), aabb_dst.ptr(), count);
+	}
+	const uint64_t batch_aabb_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int r = 0; r < rounds; r++) {
+		for (uint32_t i = 0; i < count; i++) {
+			transform_dst[i] = transform * transforms[i];
+		}
+	}
+	const uint64_t scalar_transform_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int r = 0; r < rounds; r++) {
+		MathBatch::multiply_transforms(transform, transforms.ptr(), transform_dst.ptr(), count);
+	}
+	const uint64_t batch_transform_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	MESSAGE(vformat("SIMD: %s, %d elements x %d rounds.", MathBatch::get_simd_name(), count, rounds));
+	MESSAGE(vformat("Vector3 xform: scalar %d usec, batched %d usec, batched SoA %d usec.", scalar_vector_usec, batch_vector_usec, batch_soa_usec));
+	MESSAGE(vformat("AABB xform: scalar %d usec, batched %d usec.", scalar_aabb_usec, batch_aabb_usec));
+	MESSAGE(vformat("Transform3D multiply: scalar %d usec, batched %d usec.", scalar_transform_usec, batch_transform_usec));
+}
+
+} // namespace TestMathBatch
+
+#endif // TEST_MATH_BATCH_H
@@ -324,6 +324,22 @@ TEST_CASE("[Object] Absent name getter") {
 			"The returned value should equal nil variant.");
 }
 
+class _SignalReceiver : public Object {
+	GDCLASS(_SignalReceiver, Object);
+
+public:
+	Object *source = nullptr;
+	_SignalReceiver *disconnect_on_call = nullptr;
+	int calls = 0;
+
+	void on_signal() {
+		calls++;
+		if (disconnect_on_call) {
+			source->disconnect("my_custom_signal", callable_mp(disconnect_on_call, &_SignalReceiver::on_signal));
+		}
+	}
+};
+
 TEST_CASE("[Object] Signals") {
 	Object object;
 
@@ -442,6 +458,37 @@ TEST_CASE("[Object] Signals") {
 		SIGNAL_UNWATCH(&object, "my_custom_signal");
 	}
 
+	SUBCASE("Changing connections while emitting should only affect the next emission") {
+		_SignalReceiver first;
+		_SignalReceiver second;
+		first.source = &object;
+		first.disconnect_on_call = &second;
+		object.connect("my_custom_signal", callable_mp(&first, &_SignalReceiver::on_signal));
+		object.connect("my_custom_signal", callable_mp(&second, &_SignalReceiver::on_signal));
+
+		CHECK(object.emit_signal("my_custom_signal") == OK);
+		CHECK(first.calls == 1);
+		CHECK(second.calls == 1);
+		CHECK_FALSE(object.is_connected("my_custom_signal", callable_mp(&second, &_SignalReceiver::on_signal)));
+
+		first.disconnect_on_call = nullptr;
+		CHECK(object.emit_signal("my_custom_signal") == OK);
+		CHECK(first.calls == 2);
+		CHECK(second.calls == 1);
+
+		object.connect("my_custom_signal", callable_mp(&second, &_SignalReceiver::on_signal), Object::CONNECT_ONE_SHOT);
+		object.emit_signal("my_custom_signal");
+		object.emit_signal("my_custom_signal");
+		CHECK(first.calls == 4);
+		CHECK(second.calls == 2);
+	}
+
+	SUBCASE("Emitting to a method that does not exist should be skipped") {
+		Object target;
+		object.connect("my_custom_signal", Callable(&target, "nonexistent_method"));
+		CHECK(object.emit_signal("my_custom_signal") == OK);
+	}
+
 	SUBCASE("Connecting and then disconnecting many signals should not leave anything behind") {
 		List<Object::Connection> signal_connections;
 		Object targets[100];
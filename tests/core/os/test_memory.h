@@ -0,0 +1,94 @@
+/**************************************************************************/
+/*  test_memory.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_MEMORY_H
+#define TEST_MEMORY_H
+
+#include "core/os/memory.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMemory {
+
+static void fill(uint8_t *p_data, size_t p_size) {
+	for (size_t i = 0; i < p_size; i++) {
+		p_data[i] = uint8_t(i * 7 + 3);
+	}
+}
+
+static bool check(const uint8_t *p_data, size_t p_size) {
+	for (size_t i = 0; i < p_size; i++) {
+		if (p_data[i] != uint8_t(i * 7 + 3)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST_CASE("[Memory] Realloc keeps the contents") {
+	// Sizes crossing the small object size classes and the system allocator in both directions.
+	const size_t sizes[] = { 1, 24, 40, 200, 480, 600, 4096, 300, 8, 1 };
+
+	uint8_t *data = (uint8_t *)memalloc(sizes[0]);
+	fill(data, sizes[0]);
+	for (size_t i = 1; i < std::size(sizes); i++) {
+		data = (uint8_t *)memrealloc(data, sizes[i]);
+		REQUIRE(data != nullptr);
+		CHECK_MESSAGE(check(data, MIN(sizes[i - 1], sizes[i])), vformat("Contents should be kept when resizing from %d to %d bytes.", (int64_t)sizes[i - 1], (int64_t)sizes[i]));
+		fill(data, sizes[i]);
+	}
+	memfree(data);
+}
+
+TEST_CASE("[Memory] Arrays") {
+	for (int count : { 1, 5, 60, 1000 }) {
+		uint64_t *array = memnew_arr(uint64_t, count);
+		CHECK(memarr_len(array) == (size_t)count);
+		for (int i = 0; i < count; i++) {
+			array[i] = i;
+		}
+		CHECK(array[count - 1] == (uint64_t)count - 1);
+		memdelete_arr(array);
+	}
+}
+
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+TEST_CASE("[Memory] Small object allocator statistics") {
+	void *small = memalloc(32);
+	CHECK(Memory::get_small_object_reserved() > 0);
+	CHECK(Memory::get_small_object_used() > 0);
+	CHECK(Memory::get_small_object_used() <= Memory::get_small_object_reserved());
+	memfree(small);
+}
+#endif
+
+} // namespace TestMemory
+
+#endif // TEST_MEMORY_H
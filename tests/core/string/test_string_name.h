@@ -0,0 +1,107 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_STRING_NAME_H
+#define TEST_STRING_NAME_H
+
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+#include "core/templates/safe_refcount.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Identity") {
+	const StringName a = "test_string_name_identity";
+	const StringName b = String("test_string_name_identity");
+	const StringName c = StringName(StaticCString::create("test_string_name_identity"));
+
+	CHECK(a == b);
+	CHECK(a == c);
+	CHECK(a.data_unique_pointer() == b.data_unique_pointer());
+	CHECK(StringName::search("test_string_name_identity") == a);
+	CHECK(StringName::search("test_string_name_missing") == StringName());
+}
+
+constexpr int THREADED_NAME_COUNT = 256;
+constexpr int THREADED_ROUNDS = 50;
+
+struct ThreadedInterning {
+	const StringName *expected = nullptr;
+	int index = 0;
+	SafeNumeric<uint32_t> *mismatches = nullptr;
+};
+
+void _intern_names(void *p_userdata) {
+	ThreadedInterning *work = static_cast<ThreadedInterning *>(p_userdata);
+	for (int round = 0; round < THREADED_ROUNDS; round++) {
+		for (int i = 0; i < THREADED_NAME_COUNT; i++) {
+			StringName shared = vformat("test_string_name_shared_%d", i);
+			if (shared.data_unique_pointer() != work->expected[i].data_unique_pointer()) {
+				work->mismatches->increment();
+			}
+
+			// Names created and released concurrently by other threads too.
+			StringName transient = vformat("test_string_name_transient_%d", (i + work->index) % THREADED_NAME_COUNT);
+			if (transient != vformat("test_string_name_transient_%d", (i + work->index) % THREADED_NAME_COUNT)) {
+				work->mismatches->increment();
+			}
+		}
+	}
+}
+
+TEST_CASE("[StringName] Interning from several threads") {
+	StringName expected[THREADED_NAME_COUNT];
+	for (int i = 0; i < THREADED_NAME_COUNT; i++) {
+		expected[i] = vformat("test_string_name_shared_%d", i);
+	}
+
+	constexpr int THREAD_COUNT = 8;
+	SafeNumeric<uint32_t> mismatches;
+	ThreadedInterning works[THREAD_COUNT];
+	Thread threads[THREAD_COUNT];
+	for (int i = 0; i < THREAD_COUNT; i++) {
+		works[i].expected = expected;
+		works[i].index = i;
+		works[i].mismatches = &mismatches;
+		threads[i].start(_intern_names, &works[i]);
+	}
+	for (int i = 0; i < THREAD_COUNT; i++) {
+		threads[i].wait_to_finish();
+	}
+
+	CHECK_MESSAGE(mismatches.get() == 0, "Every thread should get the same StringName data for the same string.");
+	CHECK_MESSAGE(StringName::search("test_string_name_transient_0") == StringName(), "Names no longer referenced should be released.");
+}
+
+} // namespace TestStringName
+
+#endif // TEST_STRING_NAME_H
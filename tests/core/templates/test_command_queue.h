@@ -446,6 +446,151 @@ TEST_CASE("[Stress][CommandQueue] Stress test command queue") {
 	ProjectSettings::get_singleton()->set_setting(COMMAND_QUEUE_SETTING,
 			ProjectSettings::get_singleton()->property_get_revert(COMMAND_QUEUE_SETTING));
 }
+
+class MultiProducerState {
+public:
+	static const int PRODUCER_COUNT = 4;
+	static const int COMMANDS_PER_PRODUCER = 2000;
+
+	CommandQueueMT command_queue;
+	Thread producer_threads[PRODUCER_COUNT];
+	SafeNumeric<int> producers_done;
+	SafeFlag handoff_pushed;
+
+	// Only touched by the flushing thread.
+	LocalVector<int> last_index;
+	int executed = 0;
+	int order_errors = 0;
+	bool handoff_first_ran = false;
+	bool handoff_order_correct = false;
+
+	void record(int p_producer, int p_index) {
+		if (p_index != last_index[p_producer] + 1) {
+			order_errors++;
+		}
+		last_index[p_producer] = p_index;
+		executed++;
+	}
+
+	void handoff_first() {
+		handoff_first_ran = true;
+	}
+
+	void handoff_second() {
+		handoff_order_correct = handoff_first_ran;
+	}
+
+	static void producer_loop(void *p_userdata);
+};
+
+struct MultiProducerArgs {
+	MultiProducerState *state = nullptr;
+	int index = 0;
+};
+
+void MultiProducerState::producer_loop(void *p_userdata) {
+	MultiProducerArgs *args = static_cast<MultiProducerArgs *>(p_userdata);
+	MultiProducerState *state = args->state;
+	for (int i = 0; i < COMMANDS_PER_PRODUCER; i++) {
+		state->command_queue.push(state, &MultiProducerState::record, args->index, i);
+		if (i == COMMANDS_PER_PRODUCER / 2) {
+			// Commands pushed after observing another thread's push must run after it.
+			if (args->index == 0) {
+				state->command_queue.push(state, &MultiProducerState::handoff_first);
+				state->handoff_pushed.set();
+			} else if (args->index == 1) {
+				while (!state->handoff_pushed.is_set()) {
+					OS::get_singleton()->delay_usec(1);
+				}
+				state->command_queue.push(state, &MultiProducerState::handoff_second);
+			}
+		}
+		if (args->index == 2 && i % 100 == 0) {
+			state->command_queue.push_and_sync(state, &MultiProducerState::record, args->index, ++i);
+		}
+	}
+	state->producers_done.increment();
+}
+
+TEST_CASE("[CommandQueue] Commands from multiple producer threads run in push order") {
+	MultiProducerState state;
+	state.last_index.resize(MultiProducerState::PRODUCER_COUNT);
+	for (int &index : state.last_index) {
+		index = -1;
+	}
+
+	MultiProducerArgs args[MultiProducerState::PRODUCER_COUNT];
+	for (int i = 0; i < MultiProducerState::PRODUCER_COUNT; i++) {
+		args[i].state = &state;
+		args[i].index = i;
+		state.producer_threads[i].start(&MultiProducerState::producer_loop, &args[i]);
+	}
+
+	// Flush concurrently with the producers, like a server thread would.
+	while (state.producers_done.get() < MultiProducerState::PRODUCER_COUNT) {
+		state.command_queue.flush_if_pending();
+	}
+	for (int i = 0; i < MultiProducerState::PRODUCER_COUNT; i++) {
+		state.producer_threads[i].wait_to_finish();
+	}
+	state.command_queue.flush_all();
+
+	CHECK_MESSAGE(state.executed == MultiProducerState::PRODUCER_COUNT * MultiProducerState::COMMANDS_PER_PRODUCER,
+			"All commands pushed by all producers should have run exactly once.");
+	CHECK_MESSAGE(state.order_errors == 0,
+			"Commands of each producer should run in the order they were pushed.");
+	CHECK_MESSAGE(state.handoff_order_correct,
+			"A command pushed after another thread's push should run after it.");
+}
+
+struct ShortLivedProducerState {
+	static const int THREAD_COUNT = 64;
+	static const int COMMANDS_PER_THREAD = 16;
+
+	CommandQueueMT command_queue;
+	SafeNumeric<int> executed;
+
+	void record() {
+		executed.increment();
+	}
+
+	static void push_commands(void *p_state) {
+		ShortLivedProducerState *state = static_cast<ShortLivedProducerState *>(p_state);
+		for (int i = 0; i < COMMANDS_PER_THREAD; i++) {
+			state->command_queue.push(state, &ShortLivedProducerState::record);
+		}
+	}
+};
+
+TEST_CASE("[CommandQueue] Producers of exited threads are retired and reused") {
+	ShortLivedProducerState state;
+
+	// Push from many threads that exit right away, a few at a time.
+	const int threads_per_wave = 8;
+	for (int wave = 0; wave < ShortLivedProducerState::THREAD_COUNT / threads_per_wave; wave++) {
+		Thread threads[threads_per_wave];
+		for (Thread &thread : threads) {
+			thread.start(&ShortLivedProducerState::push_commands, &state);
+		}
+		for (Thread &thread : threads) {
+			thread.wait_to_finish();
+		}
+		state.command_queue.flush_all();
+		CHECK_MESSAGE(state.command_queue.get_producer_count() == 0,
+				"The producers of the exited threads should be retired once their commands ran.");
+	}
+
+	CHECK_MESSAGE(state.executed.get() == ShortLivedProducerState::THREAD_COUNT * ShortLivedProducerState::COMMANDS_PER_THREAD,
+			"All commands pushed by the short-lived threads should have run exactly once.");
+
+	// A live thread keeps its producer.
+	state.command_queue.push(&state, &ShortLivedProducerState::record);
+	CHECK(state.command_queue.get_producer_count() == 1);
+	state.command_queue.flush_all();
+	CHECK(state.command_queue.get_producer_count() == 1);
+	CHECK(state.executed.get() == ShortLivedProducerState::THREAD_COUNT * ShortLivedProducerState::COMMANDS_PER_THREAD + 1);
+}
+
 } // namespace TestCommandQueue
 
 #endif // TEST_COMMAND_QUEUE_H
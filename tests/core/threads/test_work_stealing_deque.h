@@ -0,0 +1,276 @@
+/**************************************************************************/
+/*  test_work_stealing_deque.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_WORK_STEALING_DEQUE_H
+#define TEST_WORK_STEALING_DEQUE_H
+
+#include "core/os/mutex.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+#include "core/templates/work_stealing_deque.h"
+
+#include "tests/test_macros.h"
+
+namespace TestWorkStealingDeque {
+
+struct StealState {
+	WorkStealingDeque<uint32_t, 256> deque;
+	LocalVector<SafeNumeric<uint32_t>> consumed;
+	SafeFlag owner_done;
+};
+
+static void steal_thread(void *p_userdata) {
+	StealState *state = (StealState *)p_userdata;
+	uint32_t value = 0;
+	while (true) {
+		if (state->deque.steal(value)) {
+			state->consumed[value].increment();
+		} else if (state->owner_done.is_set() && state->deque.is_empty()) {
+			break;
+		}
+	}
+}
+
+TEST_CASE("[WorkStealingDeque] Push, pop and steal") {
+	WorkStealingDeque<uint32_t, 4> deque;
+	uint32_t value = 0;
+	CHECK(deque.is_empty());
+	CHECK_FALSE(deque.pop(value));
+	CHECK_FALSE(deque.steal(value));
+
+	for (uint32_t i = 1; i <= 4; i++) {
+		CHECK(deque.push(i));
+	}
+	CHECK_FALSE_MESSAGE(deque.push(5), "A full deque should reject new elements.");
+
+	// The owner pops the newest elements, thieves steal the oldest ones.
+	CHECK(deque.pop(value));
+	CHECK_EQ(value, 4u);
+	CHECK(deque.steal(value));
+	CHECK_EQ(value, 1u);
+	CHECK(deque.pop(value));
+	CHECK_EQ(value, 3u);
+	CHECK(deque.steal(value));
+	CHECK_EQ(value, 2u);
+	CHECK(deque.is_empty());
+
+	// Wrapping around the ring buffer.
+	for (uint32_t i = 10; i < 14; i++) {
+		CHECK(deque.push(i));
+	}
+	CHECK(deque.steal(value));
+	CHECK_EQ(value, 10u);
+	CHECK(deque.push(14));
+	CHECK(deque.pop(value));
+	CHECK_EQ(value, 14u);
+}
+
+TEST_CASE("[WorkStealingDeque] Every element is consumed exactly once with concurrent thieves") {
+	const uint32_t element_count = 100000;
+	const int thief_count = 3;
+
+	StealState state;
+	state.consumed.resize(element_count);
+
+	Thread thieves[thief_count];
+	for (int i = 0; i < thief_count; i++) {
+		thieves[i].start(steal_thread, &state);
+	}
+
+	uint32_t value = 0;
+	for (uint32_t i = 0; i < element_count; i++) {
+		while (!state.deque.push(i)) {
+			// Full, make room by consuming from the owner side.
+			if (state.deque.pop(value)) {
+				state.consumed[value].increment();
+			}
+		}
+		if (i % 3 == 0 && state.deque.pop(value)) {
+			state.consumed[value].increment();
+		}
+	}
+	while (state.deque.pop(value)) {
+		state.consumed[value].increment();
+	}
+	state.owner_done.set();
+
+	for (int i = 0; i < thief_count; i++) {
+		thieves[i].wait_to_finish();
+	}
+
+	bool all_consumed_once = true;
+	for (uint32_t i = 0; i < element_count; i++) {
+		all_consumed_once &= state.consumed[i].get() == 1;
+	}
+	CHECK(all_consumed_once);
+}
+
+// Compares a single mutex-guarded queue against per-thread work-stealing deques,
+// as used by WorkerThreadPool, when many small work items are processed. Both are driven
+// by plain threads, this measures the queues alone and not WorkerThreadPool.
+// Skipped by default, run with `--test --test-case="*[Benchmark]*" --no-skip`.
+
+static const uint32_t BENCHMARK_ITEMS = 1 << 20;
+static const uint32_t BENCHMARK_ITEM_COST = 32;
+
+static _FORCE_INLINE_ uint32_t benchmark_work(uint32_t p_item) {
+	uint32_t hash = p_item;
+	for (uint32_t i = 0; i < BENCHMARK_ITEM_COST; i++) {
+		hash = hash_murmur3_one_32(hash);
+	}
+	return hash;
+}
+
+struct BenchmarkState {
+	uint32_t thread_count = 0;
+	SafeNumeric<uint32_t> processed;
+	SafeNumeric<uint32_t> checksum;
+
+	// Shared queue.
+	BinaryMutex mutex;
+	uint32_t next_item = 0;
+
+	// Work stealing.
+	LocalVector<WorkStealingDeque<uint32_t> *> deques;
+};
+
+struct BenchmarkThread {
+	BenchmarkState *state = nullptr;
+	uint32_t index = 0;
+	Thread thread;
+};
+
+static void benchmark_shared_queue_thread(void *p_userdata) {
+	BenchmarkThread *bt = (BenchmarkThread *)p_userdata;
+	BenchmarkState *state = bt->state;
+	uint32_t checksum = 0;
+	uint32_t processed = 0;
+	while (true) {
+		uint32_t item;
+		{
+			MutexLock lock(state->mutex);
+			if (state->next_item == BENCHMARK_ITEMS) {
+				break;
+			}
+			item = state->next_item++;
+		}
+		checksum ^= benchmark_work(item);
+		processed++;
+	}
+	state->checksum.add(checksum);
+	state->processed.add(processed);
+}
+
+static void benchmark_work_stealing_thread(void *p_userdata) {
+	BenchmarkThread *bt = (BenchmarkThread *)p_userdata;
+	BenchmarkState *state = bt->state;
+	WorkStealingDeque<uint32_t> &own_deque = *state->deques[bt->index];
+	uint32_t checksum = 0;
+	uint32_t processed = 0;
+
+	// Half of the threads post all the work, the other half only steals.
+	if (bt->index % 2 == 0) {
+		const uint32_t producers = (state->thread_count + 1) / 2;
+		const uint32_t begin = (bt->index / 2) * BENCHMARK_ITEMS / producers;
+		const uint32_t end = (bt->index / 2 + 1) * BENCHMARK_ITEMS / producers;
+		for (uint32_t item = begin; item < end; item++) {
+			if (!own_deque.push(item)) {
+				checksum ^= benchmark_work(item);
+				processed++;
+			}
+		}
+	}
+
+	while (state->processed.get() + processed < BENCHMARK_ITEMS) {
+		uint32_t item;
+		bool found = own_deque.pop(item);
+		for (uint32_t i = 1; !found && i < state->thread_count; i++) {
+			found = state->deques[(bt->index + i) % state->thread_count]->steal(item);
+		}
+		if (!found) {
+			// Publish progress so the other threads can tell when everything is done.
+			state->processed.add(processed);
+			processed = 0;
+			continue;
+		}
+		checksum ^= benchmark_work(item);
+		processed++;
+	}
+	state->checksum.add(checksum);
+	state->processed.add(processed);
+}
+
+static uint64_t run_benchmark(uint32_t p_thread_count, bool p_work_stealing) {
+	BenchmarkState state;
+	state.thread_count = p_thread_count;
+	if (p_work_stealing) {
+		for (uint32_t i = 0; i < p_thread_count; i++) {
+			state.deques.push_back(memnew(WorkStealingDeque<uint32_t>));
+		}
+	}
+
+	LocalVector<BenchmarkThread> threads;
+	threads.resize(p_thread_count);
+
+	const uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+	for (uint32_t i = 0; i < p_thread_count; i++) {
+		threads[i].state = &state;
+		threads[i].index = i;
+		threads[i].thread.start(p_work_stealing ? benchmark_work_stealing_thread : benchmark_shared_queue_thread, &threads[i]);
+	}
+	for (uint32_t i = 0; i < p_thread_count; i++) {
+		threads[i].thread.wait_to_finish();
+	}
+	const uint64_t elapsed_usec = OS::get_singleton()->get_ticks_usec() - begin_usec;
+
+	CHECK_EQ(state.processed.get(), BENCHMARK_ITEMS);
+
+	for (WorkStealingDeque<uint32_t> *deque : state.deques) {
+		memdelete(deque);
+	}
+	return elapsed_usec;
+}
+
+TEST_CASE("[WorkStealingDeque][Benchmark] Scaling of a raw shared queue and raw work-stealing deques, without WorkerThreadPool" * doctest::skip()) {
+	const uint32_t thread_counts[] = { 8, 32, 64 };
+	for (uint32_t thread_count : thread_counts) {
+		const uint64_t shared_queue_usec = run_benchmark(thread_count, false);
+		const uint64_t work_stealing_usec = run_benchmark(thread_count, true);
+		MESSAGE(vformat("%d threads: shared queue %d usec, work-stealing deques %d usec (%.2fx).",
+				thread_count, shared_queue_usec, work_stealing_usec, double(shared_queue_usec) / MAX(work_stealing_usec, uint64_t(1))));
+	}
+}
+
+} // namespace TestWorkStealingDeque
+
+#endif // TEST_WORK_STEALING_DEQUE_H
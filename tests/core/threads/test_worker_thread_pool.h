@@ -107,6 +107,45 @@ TEST_CASE("[WorkerThreadPool] Process elements using group tasks") {
 	}
 }
 
+static void static_first_stage_test(void *p_arg) {
+	OS::get_singleton()->delay_usec(100);
+	counter[0].set(1);
+}
+static void static_second_stage_group_test(void *p_arg, uint32_t p_index) {
+	// Counts the elements that ran after the first stage.
+	if (counter[0].get() == 1) {
+		counter[1].increment();
+	}
+}
+static void static_third_stage_test(void *p_arg) {
+	*((bool *)p_arg) = counter[1].get() == counter[2].get();
+}
+TEST_CASE("[WorkerThreadPool] Run tasks and group tasks after their dependencies") {
+	for (int iterations = 0; iterations < 100; iterations++) {
+		const int count = Math::pow(2.0f, Math::random(0.0f, 5.0f));
+		const int tasks = Math::pow(2.0f, Math::random(0.0f, 5.0f));
+		const bool low_priority = Math::rand() % 2;
+
+		counter.clear();
+		counter.resize(3);
+		counter[2].set(count);
+		bool third_stage_after_second = false;
+
+		WorkerThreadPool::TaskID first = WorkerThreadPool::get_singleton()->add_native_task(static_first_stage_test, nullptr, !low_priority);
+		Vector<WorkerThreadPool::TaskID> second_dependencies = { first };
+		WorkerThreadPool::GroupID second = WorkerThreadPool::get_singleton()->add_native_group_task_with_dependencies(static_second_stage_group_test, nullptr, count, second_dependencies, tasks, low_priority);
+		Vector<WorkerThreadPool::TaskID> third_dependencies = { first, second };
+		WorkerThreadPool::TaskID third = WorkerThreadPool::get_singleton()->add_native_task_with_dependencies(static_third_stage_test, &third_stage_after_second, third_dependencies, !low_priority);
+
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(third);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(second);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(first);
+
+		CHECK_EQ(counter[1].get(), count);
+		CHECK(third_stage_after_second);
+	}
+}
+
 static void static_test_daemon(void *p_arg) {
 	while (!exit.is_set()) {
 		counter[0].add(1);
@@ -31,6 +31,7 @@
 #ifndef TEST_PACKED_SCENE_H
 #define TEST_PACKED_SCENE_H
 
+#include "scene/2d/node_2d.h"
 #include "scene/resources/packed_scene.h"
 
 #include "tests/test_macros.h"
@@ -150,6 +151,51 @@ TEST_CASE("[PackedScene] Instantiate Packed Scene With Children") {
 	memdelete(instance);
 }
 
+TEST_CASE("[PackedScene] Instantiate Multiple") {
+	// Create a scene to pack.
+	Node *scene = memnew(Node);
+	scene->set_name("TestScene");
+
+	Node2D *child = memnew(Node2D);
+	child->set_name("Child");
+	child->set_position(Vector2(4, 2));
+	scene->add_child(child);
+	child->set_owner(scene);
+	child->connect(SNAME("renamed"), Callable(scene, "set_name").bind("Renamed"), Object::CONNECT_PERSIST);
+
+	// Pack the scene.
+	PackedScene packed_scene;
+	packed_scene.pack(scene);
+
+	// Instantiate several copies at once, and a second batch that reuses the cached plan.
+	for (int batch = 0; batch < 2; batch++) {
+		TypedArray<Node> copies = packed_scene.instantiate_multiple(3);
+		REQUIRE(copies.size() == 3);
+
+		for (int i = 0; i < copies.size(); i++) {
+			Node *copy = Object::cast_to<Node>(copies[i]);
+			REQUIRE(copy != nullptr);
+			CHECK(copy->get_name() == "TestScene");
+			REQUIRE(copy->get_child_count() == 1);
+
+			Node2D *copy_child = Object::cast_to<Node2D>(copy->get_child(0));
+			REQUIRE(copy_child != nullptr);
+			CHECK(copy_child->get_owner() == copy);
+			CHECK(copy_child->get_position() == Vector2(4, 2));
+
+			// The connection and its bound argument are set up for every copy.
+			copy_child->emit_signal(SNAME("renamed"));
+			CHECK(copy->get_name() == "Renamed");
+
+			memdelete(copy);
+		}
+	}
+
+	CHECK(packed_scene.instantiate_multiple(0).is_empty());
+
+	memdelete(scene);
+}
+
 TEST_CASE("[PackedScene] Set Path") {
 	// Create a scene to pack.
 	Node *scene = memnew(Node);
@@ -32,6 +32,7 @@
 #define TEST_TIMER_H
 
 #include "scene/main/timer.h"
+#include "scene/main/timer_queue.h"
 
 #include "tests/test_macros.h"
 
@@ -212,6 +213,167 @@ TEST_CASE("[SceneTree][Timer] Check Timer timeout signal") {
 	memdelete(test_timer);
 }
 
+TEST_CASE("[SceneTree][Timer] Check Timer restarts and pauses") {
+	Timer *test_timer = memnew(Timer);
+	SceneTree::get_singleton()->get_root()->add_child(test_timer);
+	SIGNAL_WATCH(test_timer, SNAME("timeout"));
+
+	Array signal_args;
+	signal_args.push_back(Array());
+
+	SUBCASE("[Timer] Timer that is not one shot keeps its phase") {
+		test_timer->start(0.1);
+
+		SceneTree::get_singleton()->process(0.15);
+		SIGNAL_CHECK(SNAME("timeout"), signal_args);
+		CHECK(Math::is_equal_approx(test_timer->get_time_left(), 0.05));
+		CHECK_FALSE(test_timer->is_stopped());
+
+		SceneTree::get_singleton()->process(0.06);
+		SIGNAL_CHECK(SNAME("timeout"), signal_args);
+	}
+
+	SUBCASE("[Timer] One shot Timer stops after timing out") {
+		test_timer->set_one_shot(true);
+		test_timer->start(0.1);
+
+		SceneTree::get_singleton()->process(0.2);
+		SIGNAL_CHECK(SNAME("timeout"), signal_args);
+		CHECK(test_timer->is_stopped());
+
+		SceneTree::get_singleton()->process(0.2);
+		SIGNAL_CHECK_FALSE(SNAME("timeout"));
+	}
+
+	SUBCASE("[Timer] Paused Timer keeps its time left") {
+		test_timer->start(0.1);
+		SceneTree::get_singleton()->process(0.05);
+
+		test_timer->set_paused(true);
+		SceneTree::get_singleton()->process(0.2);
+		SIGNAL_CHECK_FALSE(SNAME("timeout"));
+		CHECK(Math::is_equal_approx(test_timer->get_time_left(), 0.05));
+
+		test_timer->set_paused(false);
+		SceneTree::get_singleton()->process(0.06);
+		SIGNAL_CHECK(SNAME("timeout"), signal_args);
+	}
+
+	SUBCASE("[Timer] Timer doesn't run while the tree is paused") {
+		test_timer->start(0.1);
+
+		SceneTree::get_singleton()->set_pause(true);
+		SceneTree::get_singleton()->process(0.2);
+		SIGNAL_CHECK_FALSE(SNAME("timeout"));
+		CHECK(Math::is_equal_approx(test_timer->get_time_left(), 0.1));
+
+		test_timer->set_process_mode(Node::PROCESS_MODE_ALWAYS);
+		SceneTree::get_singleton()->process(0.2);
+		SIGNAL_CHECK(SNAME("timeout"), signal_args);
+
+		SceneTree::get_singleton()->set_pause(false);
+	}
+
+	SUBCASE("[Timer] Timer doesn't run outside of the tree") {
+		test_timer->start(0.1);
+		SceneTree::get_singleton()->get_root()->remove_child(test_timer);
+		SceneTree::get_singleton()->process(0.2);
+		SIGNAL_CHECK_FALSE(SNAME("timeout"));
+		CHECK(Math::is_equal_approx(test_timer->get_time_left(), 0.1));
+
+		SceneTree::get_singleton()->get_root()->add_child(test_timer);
+		SceneTree::get_singleton()->process(0.2);
+		SIGNAL_CHECK(SNAME("timeout"), signal_args);
+	}
+
+	SIGNAL_UNWATCH(test_timer, SNAME("timeout"));
+	memdelete(test_timer);
+}
+
+TEST_CASE("[SceneTree][SceneTreeTimer] Check SceneTreeTimer timeout") {
+	Ref<SceneTreeTimer> timer = SceneTree::get_singleton()->create_timer(0.1);
+	SIGNAL_WATCH(timer.ptr(), SNAME("timeout"));
+
+	Array signal_args;
+	signal_args.push_back(Array());
+
+	SceneTree::get_singleton()->physics_process(0.2);
+	SIGNAL_CHECK_FALSE(SNAME("timeout"));
+
+	SceneTree::get_singleton()->process(0.05);
+	SIGNAL_CHECK_FALSE(SNAME("timeout"));
+	CHECK(Math::is_equal_approx(timer->get_time_left(), 0.05));
+
+	timer->set_time_left(0.2);
+	SceneTree::get_singleton()->process(0.1);
+	SIGNAL_CHECK_FALSE(SNAME("timeout"));
+
+	SceneTree::get_singleton()->process(0.15);
+	SIGNAL_CHECK(SNAME("timeout"), signal_args);
+	CHECK(timer->get_time_left() == 0.0);
+
+	SIGNAL_UNWATCH(timer.ptr(), SNAME("timeout"));
+}
+
+static LocalVector<int> timer_queue_fired;
+
+static void _timer_queue_timeout(Object *p_owner, double p_time_left) {
+	timer_queue_fired.push_back((int)(intptr_t)p_owner);
+}
+
+TEST_CASE("[TimerQueue] Timeouts are dispatched in start order") {
+	TimerQueue queue;
+	TimerQueue::Entry entries[4];
+	for (int i = 0; i < 4; i++) {
+		entries[i].owner = (Object *)(intptr_t)i;
+		entries[i].callback = &_timer_queue_timeout;
+	}
+	timer_queue_fired.clear();
+
+	const uint32_t idle = TimerQueue::get_clock(false, false, false);
+	const uint32_t physics = TimerQueue::get_clock(true, false, false);
+	queue.start(&entries[0], idle, 0.3);
+	queue.start(&entries[1], physics, 0.1);
+	queue.start(&entries[2], idle, 0.2);
+	queue.start(&entries[3], idle, 5.0);
+	CHECK(queue.get_active_count() == 4);
+
+	queue.advance(idle, 0.5);
+	queue.advance(physics, 0.5);
+	queue.dispatch_expired();
+
+	REQUIRE(timer_queue_fired.size() == 3);
+	CHECK(timer_queue_fired[0] == 0);
+	CHECK(timer_queue_fired[1] == 1);
+	CHECK(timer_queue_fired[2] == 2);
+	CHECK_FALSE(entries[0].is_active());
+	CHECK(entries[3].is_active());
+	CHECK(Math::is_equal_approx(queue.get_time_left(&entries[3]), 4.5));
+
+	CHECK(Math::is_equal_approx(queue.stop(&entries[3]), 4.5));
+	CHECK(queue.get_active_count() == 0);
+}
+
+TEST_CASE("[TimerQueue] Stopped timers are not dispatched") {
+	TimerQueue queue;
+	TimerQueue::Entry entries[2];
+	for (int i = 0; i < 2; i++) {
+		entries[i].owner = (Object *)(intptr_t)i;
+		entries[i].callback = &_timer_queue_timeout;
+	}
+	timer_queue_fired.clear();
+
+	queue.start(&entries[0], 0, 0.1);
+	queue.start(&entries[1], 0, 0.1);
+	queue.advance(0, 0.1);
+	queue.stop(&entries[1]);
+	queue.dispatch_expired();
+
+	REQUIRE(timer_queue_fired.size() == 1);
+	CHECK(timer_queue_fired[0] == 0);
+	CHECK(queue.get_active_count() == 0);
+}
+
 } // namespace TestTimer
 
 #endif // TEST_TIMER_H
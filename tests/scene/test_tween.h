@@ -0,0 +1,106 @@
+/**************************************************************************/
+/*  test_tween.h                                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_TWEEN_H
+#define TEST_TWEEN_H
+
+#include "scene/2d/node_2d.h"
+#include "scene/animation/tween.h"
+#include "scene/main/window.h"
+
+#include "tests/test_macros.h"
+
+namespace TestTween {
+
+TEST_CASE("[SceneTree][Tween] PropertyTweener interpolates typed properties") {
+	Node2D *node = memnew(Node2D);
+	SceneTree::get_singleton()->get_root()->add_child(node);
+
+	Ref<Tween> tween = node->create_tween();
+	tween->set_parallel(true);
+	tween->tween_property(node, NodePath("position"), Vector2(100, 200), 1.0);
+	tween->tween_property(node, NodePath("rotation"), 2.0, 1.0);
+	tween->tween_property(node, NodePath("modulate"), Color(0, 0, 0, 0), 1.0);
+	tween->tween_property(node, NodePath("position:x"), 50.0, 2.0).ptr()->set_delay(1.0);
+
+	SceneTree::get_singleton()->process(0.5);
+	CHECK(node->get_position().is_equal_approx(Vector2(50, 100)));
+	CHECK(Math::is_equal_approx(node->get_rotation(), (real_t)1.0));
+	CHECK(node->get_modulate().is_equal_approx(Color(0.5, 0.5, 0.5, 0.5)));
+
+	SceneTree::get_singleton()->process(0.5);
+	CHECK(node->get_position().is_equal_approx(Vector2(100, 200)));
+	CHECK(Math::is_equal_approx(node->get_rotation(), (real_t)2.0));
+	CHECK(node->get_modulate().is_equal_approx(Color(0, 0, 0, 0)));
+
+	// Subproperties go through Object::set_indexed().
+	SceneTree::get_singleton()->process(1.0);
+	CHECK(Math::is_equal_approx(node->get_position().x, (real_t)75.0));
+
+	SceneTree::get_singleton()->process(1.0);
+	CHECK(Math::is_equal_approx(node->get_position().x, (real_t)50.0));
+	CHECK_FALSE(tween->is_running());
+
+	memdelete(node);
+}
+
+TEST_CASE("[SceneTree][Tween] Finished Tweens are removed from the SceneTree") {
+	Node *node = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(node);
+
+	const int initial_count = SceneTree::get_singleton()->get_processed_tweens().size();
+
+	Ref<Tween> short_tween = node->create_tween();
+	short_tween->tween_interval(0.1);
+	Ref<Tween> long_tween = node->create_tween();
+	long_tween->tween_interval(1.0);
+	CHECK(SceneTree::get_singleton()->get_processed_tweens().size() == initial_count + 2);
+
+	// Finished Tweens are removed on the next frame.
+	SceneTree::get_singleton()->process(0.5);
+	CHECK_FALSE(short_tween->is_running());
+	CHECK(SceneTree::get_singleton()->get_processed_tweens().size() == initial_count + 2);
+
+	SceneTree::get_singleton()->process(0.1);
+	CHECK_FALSE(short_tween->is_valid());
+	TypedArray<Tween> processed = SceneTree::get_singleton()->get_processed_tweens();
+	REQUIRE(processed.size() == initial_count + 1);
+	CHECK(processed[initial_count] == Variant(long_tween));
+
+	SceneTree::get_singleton()->process(1.0);
+	SceneTree::get_singleton()->process(0.1);
+	CHECK(SceneTree::get_singleton()->get_processed_tweens().size() == initial_count);
+
+	memdelete(node);
+}
+
+} // namespace TestTween
+
+#endif // TEST_TWEEN_H
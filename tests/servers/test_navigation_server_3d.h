@@ -31,6 +31,8 @@
 #ifndef TEST_NAVIGATION_SERVER_3D_H
 #define TEST_NAVIGATION_SERVER_3D_H
 
+#include "core/config/project_settings.h"
+#include "core/object/message_queue.h"
 #include "modules/navigation/nav_utils.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/resources/3d/primitive_meshes.h"
@@ -790,9 +792,272 @@ TEST_SUITE("[Navigation]") {
 			CHECK_EQ(query_result->get_path_owner_ids().size(), 0);
 		}
 
+		SUBCASE("Batched queries should yield the same results as single queries") {
+			TypedArray<NavigationPathQueryParameters3D> batch_parameters;
+			TypedArray<NavigationPathQueryResult3D> batch_results;
+			for (int i = 0; i < 16; i++) {
+				Ref<NavigationPathQueryParameters3D> query_parameters = memnew(NavigationPathQueryParameters3D);
+				query_parameters->set_map(map);
+				query_parameters->set_start_position(Vector3(i * 0.5, 0, 0));
+				query_parameters->set_target_position(Vector3(10, 0, 10 - i * 0.5));
+				query_parameters->set_navigation_layers(i % 4 == 3 ? 2 : 1);
+				batch_parameters.push_back(query_parameters);
+				batch_results.push_back(memnew(NavigationPathQueryResult3D));
+			}
+			navigation_server->query_paths(batch_parameters, batch_results);
+
+			for (int i = 0; i < batch_parameters.size(); i++) {
+				Ref<NavigationPathQueryResult3D> query_result = memnew(NavigationPathQueryResult3D);
+				navigation_server->query_path(batch_parameters[i], query_result);
+				const Ref<NavigationPathQueryResult3D> batch_result = batch_results[i];
+				CHECK_EQ(batch_result->get_path(), query_result->get_path());
+				CHECK_EQ(batch_result->get_path_types(), query_result->get_path_types());
+				CHECK_EQ(batch_result->get_path_rids(), query_result->get_path_rids());
+				CHECK_EQ(batch_result->get_path_owner_ids(), query_result->get_path_owner_ids());
+			}
+		}
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D][SceneTree] Asynchronous batched queries should keep their map alive") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+
+		Array arr;
+		arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(arr, Vector3(10.0, 0.001, 10.0));
+		source_geometry->add_mesh_array(arr, Transform3D());
+		navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		RID other_region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->region_set_map(other_region, map);
+		navigation_server->region_set_navigation_mesh(other_region, navigation_mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		TypedArray<NavigationPathQueryParameters3D> batch_parameters;
+		TypedArray<NavigationPathQueryResult3D> batch_results;
+		for (int i = 0; i < 256; i++) {
+			Ref<NavigationPathQueryParameters3D> query_parameters = memnew(NavigationPathQueryParameters3D);
+			query_parameters->set_map(map);
+			query_parameters->set_start_position(Vector3(-4.5 + (i % 16) * 0.5, 0, -4.5));
+			query_parameters->set_target_position(Vector3(4.5, 0, 4.5 - (i % 16) * 0.5));
+			batch_parameters.push_back(query_parameters);
+			batch_results.push_back(memnew(NavigationPathQueryResult3D));
+		}
+
+		CallableMock callback_mock;
+		navigation_server->query_paths_async(batch_parameters, batch_results, callable_mp(&callback_mock, &CallableMock::function1).bind(Variant()));
+
+		// Change the map while the batch is in flight, freeing waits for the queries using the map.
+		navigation_server->region_set_transform(other_region, Transform3D(Basis(), Vector3(20, 0, 0)));
+		navigation_server->free(region);
+		navigation_server->free(other_region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+		CHECK_EQ(callback_mock.function1_calls, 0);
+
+		MessageQueue::get_singleton()->flush();
+		CHECK_EQ(callback_mock.function1_calls, 1);
+		for (int i = 0; i < batch_results.size(); i++) {
+			const Ref<NavigationPathQueryResult3D> batch_result = batch_results[i];
+			CHECK_NE(batch_result->get_path().size(), 0);
+		}
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should relink changed regions with incremental sync") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		ProjectSettings::get_singleton()->set_setting("navigation/world/map_use_incremental_sync", true);
+
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		Vector<Vector3> vertices;
+		vertices.push_back(Vector3(0, 0, 0));
+		vertices.push_back(Vector3(10, 0, 0));
+		vertices.push_back(Vector3(10, 0, 10));
+		vertices.push_back(Vector3(0, 0, 10));
+		navigation_mesh->set_vertices(vertices);
+		Vector<int> polygon;
+		polygon.push_back(0);
+		polygon.push_back(3);
+		polygon.push_back(2);
+		polygon.push_back(1);
+		navigation_mesh->add_polygon(polygon);
+
+		RID map = navigation_server->map_create();
+		RID region_a = navigation_server->region_create();
+		RID region_b = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region_a, map);
+		navigation_server->region_set_map(region_b, map);
+		navigation_server->region_set_navigation_mesh(region_a, navigation_mesh);
+		navigation_server->region_set_navigation_mesh(region_b, navigation_mesh);
+		navigation_server->region_set_transform(region_b, Transform3D(Basis(), Vector3(10, 0, 0)));
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		SUBCASE("Adjacent regions should be connected") {
+			Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(1, 0, 5), Vector3(19, 0, 5), true);
+			REQUIRE_NE(path.size(), 0);
+			CHECK(path[path.size() - 1].is_equal_approx(Vector3(19, 0, 5)));
+			CHECK_EQ(navigation_server->map_get_iteration_id(map), 1);
+		}
+
+		SUBCASE("Moved regions should be disconnected and connected again") {
+			navigation_server->region_set_transform(region_b, Transform3D(Basis(), Vector3(100, 0, 0)));
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(1, 0, 5), Vector3(109, 0, 5), true);
+			REQUIRE_NE(path.size(), 0);
+			CHECK_FALSE(path[path.size() - 1].is_equal_approx(Vector3(109, 0, 5)));
+
+			navigation_server->region_set_transform(region_b, Transform3D(Basis(), Vector3(10, 0, 0)));
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			path = navigation_server->map_get_path(map, Vector3(1, 0, 5), Vector3(19, 0, 5), true);
+			REQUIRE_NE(path.size(), 0);
+			CHECK(path[path.size() - 1].is_equal_approx(Vector3(19, 0, 5)));
+			CHECK_EQ(navigation_server->map_get_iteration_id(map), 3);
+		}
+
+		SUBCASE("Unchanged regions should stay connected when another region is added") {
+			RID region_c = navigation_server->region_create();
+			navigation_server->region_set_map(region_c, map);
+			navigation_server->region_set_navigation_mesh(region_c, navigation_mesh);
+			navigation_server->region_set_transform(region_c, Transform3D(Basis(), Vector3(0, 0, 10)));
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(19, 0, 5), Vector3(5, 0, 19), true);
+			REQUIRE_NE(path.size(), 0);
+			CHECK(path[path.size() - 1].is_equal_approx(Vector3(5, 0, 19)));
+			navigation_server->free(region_c);
+		}
+
+		navigation_server->free(region_b);
+		navigation_server->free(region_a);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+		ProjectSettings::get_singleton()->set_setting("navigation/world/map_use_incremental_sync", false);
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should find closest points on maps with many polygons") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// A 20x20 grid of 1x1 quads covering (0, 0, 0) to (20, 0, 20).
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		Vector<Vector3> vertices;
+		for (int z = 0; z <= 20; z++) {
+			for (int x = 0; x <= 20; x++) {
+				vertices.push_back(Vector3(x, 0, z));
+			}
+		}
+		navigation_mesh->set_vertices(vertices);
+		for (int z = 0; z < 20; z++) {
+			for (int x = 0; x < 20; x++) {
+				Vector<int> polygon;
+				polygon.push_back(z * 21 + x);
+				polygon.push_back((z + 1) * 21 + x);
+				polygon.push_back((z + 1) * 21 + x + 1);
+				polygon.push_back(z * 21 + x + 1);
+				navigation_mesh->add_polygon(polygon);
+			}
+		}
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		CHECK(navigation_server->map_get_closest_point(map, Vector3(5.5, 3, 7.25)).is_equal_approx(Vector3(5.5, 0, 7.25)));
+		CHECK(navigation_server->map_get_closest_point(map, Vector3(-10, -2, 4.5)).is_equal_approx(Vector3(0, 0, 4.5)));
+		CHECK(navigation_server->map_get_closest_point(map, Vector3(100, 50, 100)).is_equal_approx(Vector3(20, 0, 20)));
+		CHECK_EQ(navigation_server->map_get_closest_point_owner(map, Vector3(12.3, 1, 3.2)), region);
+		CHECK(navigation_server->map_get_closest_point_to_segment(map, Vector3(3.5, 2, 3.5), Vector3(3.5, -2, 3.5), true).is_equal_approx(Vector3(3.5, 0, 3.5)));
+		CHECK(navigation_server->map_get_closest_point_to_segment(map, Vector3(-5, 1, 10.5), Vector3(-2, 1, 10.5), false).is_equal_approx(Vector3(0, 0, 10.5)));
+
+		Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(0.5, 1, 0.5), Vector3(30, 1, 19.5), true);
+		REQUIRE_NE(path.size(), 0);
+		CHECK(path[0].is_equal_approx(Vector3(0.5, 0, 0.5)));
+		CHECK(path[path.size() - 1].is_equal_approx(Vector3(20, 0, 19.5)));
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should find hierarchical paths around obstacles") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		ProjectSettings::get_singleton()->set_setting("navigation/world/map_use_cluster_graph", true);
+		ProjectSettings::get_singleton()->set_setting("navigation/world/map_cluster_size", 4.0);
+
+		// A 20x20 grid of 1x1 quads with a wall at x = 10 that can only be passed at the far end.
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		Vector<Vector3> vertices;
+		for (int z = 0; z <= 20; z++) {
+			for (int x = 0; x <= 20; x++) {
+				vertices.push_back(Vector3(x, 0, z));
+			}
+		}
+		navigation_mesh->set_vertices(vertices);
+		for (int z = 0; z < 20; z++) {
+			for (int x = 0; x < 20; x++) {
+				if (x == 10 && z < 18) {
+					continue;
+				}
+				Vector<int> polygon;
+				polygon.push_back(z * 21 + x);
+				polygon.push_back((z + 1) * 21 + x);
+				polygon.push_back((z + 1) * 21 + x + 1);
+				polygon.push_back(z * 21 + x + 1);
+				navigation_mesh->add_polygon(polygon);
+			}
+		}
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		Ref<NavigationPathQueryParameters3D> query_parameters = memnew(NavigationPathQueryParameters3D);
+		query_parameters->set_map(map);
+		query_parameters->set_start_position(Vector3(0.5, 0, 0.5));
+		query_parameters->set_target_position(Vector3(19.5, 0, 0.5));
+		Ref<NavigationPathQueryResult3D> query_result = memnew(NavigationPathQueryResult3D);
+		navigation_server->query_path(query_parameters, query_result);
+		const Vector<Vector3> flat_path = query_result->get_path();
+
+		query_parameters->set_pathfinding_algorithm(NavigationPathQueryParameters3D::PATHFINDING_ALGORITHM_HIERARCHICAL_ASTAR);
+		navigation_server->query_path(query_parameters, query_result);
+		const Vector<Vector3> hierarchical_path = query_result->get_path();
+
+		REQUIRE_NE(hierarchical_path.size(), 0);
+		CHECK(hierarchical_path[0].is_equal_approx(Vector3(0.5, 0, 0.5)));
+		CHECK(hierarchical_path[hierarchical_path.size() - 1].is_equal_approx(Vector3(19.5, 0, 0.5)));
+
+		real_t flat_length = 0.0;
+		for (int i = 1; i < flat_path.size(); i++) {
+			flat_length += flat_path[i - 1].distance_to(flat_path[i]);
+		}
+		real_t hierarchical_length = 0.0;
+		for (int i = 1; i < hierarchical_path.size(); i++) {
+			hierarchical_length += hierarchical_path[i - 1].distance_to(hierarchical_path[i]);
+		}
+		// The path must go around the wall, but is not required to be the shortest.
+		CHECK_GT(hierarchical_length, 36.0);
+		CHECK_LT(hierarchical_length, flat_length * 1.2);
+
 		navigation_server->free(region);
 		navigation_server->free(map);
 		navigation_server->process(0.0); // Give server some cycles to commit.
+		ProjectSettings::get_singleton()->set_setting("navigation/world/map_use_cluster_graph", false);
+		ProjectSettings::get_singleton()->set_setting("navigation/world/map_cluster_size", 32.0);
 	}
 
 	// FIXME: The race condition mentioned below is actually a problem and fails on CI (GH-90613).
@@ -0,0 +1,118 @@
+/**************************************************************************/
+/*  test_physics_server_3d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_3D_H
+#define TEST_PHYSICS_SERVER_3D_H
+
+#include "core/config/project_settings.h"
+#include "servers/physics_server_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer3D {
+
+// Drops a few piles of boxes on a floor and returns the box transforms after the given number of steps.
+// The piles are far enough apart to be solved as separate islands.
+static LocalVector<Transform3D> simulate_box_piles(bool p_deterministic, int p_steps) {
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/deterministic_simulation", p_deterministic);
+
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+
+	RID floor_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(floor_shape, Vector3(50, 0.5, 50));
+	RID floor = physics_server->body_create();
+	physics_server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	physics_server->body_add_shape(floor, floor_shape);
+	physics_server->body_set_space(floor, space);
+
+	RID box_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	LocalVector<RID> boxes;
+	for (int pile = 0; pile < 4; pile++) {
+		for (int level = 0; level < 6; level++) {
+			RID box = physics_server->body_create();
+			physics_server->body_set_mode(box, PhysicsServer3D::BODY_MODE_RIGID);
+			physics_server->body_add_shape(box, box_shape);
+			// Offset and rotate the boxes a little so the piles collapse.
+			const Vector3 position(pile * 10.0 + level * 0.15, 1.0 + level * 1.1, (level % 2) * 0.2);
+			physics_server->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(Vector3(0, 1, 0), level * 0.3), position));
+			physics_server->body_set_space(box, space);
+			boxes.push_back(box);
+		}
+	}
+
+	for (int i = 0; i < p_steps; i++) {
+		physics_server->step(1.0 / 60.0);
+	}
+
+	LocalVector<Transform3D> transforms;
+	for (const RID &box : boxes) {
+		transforms.push_back(physics_server->body_get_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM));
+		physics_server->free(box);
+	}
+	physics_server->free(floor);
+	physics_server->free(box_shape);
+	physics_server->free(floor_shape);
+	physics_server->free(space);
+
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/deterministic_simulation", false);
+
+	return transforms;
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Deterministic simulation should be reproducible") {
+	const LocalVector<Transform3D> first_run = simulate_box_piles(true, 120);
+	const LocalVector<Transform3D> second_run = simulate_box_piles(true, 120);
+
+	REQUIRE_EQ(first_run.size(), second_run.size());
+	for (uint32_t i = 0; i < first_run.size(); i++) {
+		// Bit for bit, not approximately.
+		CHECK_EQ(first_run[i], second_run[i]);
+	}
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Parallel constraint setup should match the island ordered setup") {
+	// The deterministic mode sets up the constraints island by island in order, which gives the same result as a serial setup
+	// since islands never share bodies. The default mode sets up each constraint as a separate task.
+	const LocalVector<Transform3D> ordered_run = simulate_box_piles(true, 120);
+	const LocalVector<Transform3D> parallel_run = simulate_box_piles(false, 120);
+
+	REQUIRE_EQ(ordered_run.size(), parallel_run.size());
+	for (uint32_t i = 0; i < ordered_run.size(); i++) {
+		CHECK(ordered_run[i].origin.is_equal_approx(parallel_run[i].origin));
+		CHECK(ordered_run[i].basis.is_equal_approx(parallel_run[i].basis));
+	}
+}
+
+} // namespace TestPhysicsServer3D
+
+#endif // TEST_PHYSICS_SERVER_3D_H